@@ -29,15 +29,156 @@
     POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <mutex>
+#include <vector>
+
 #include "cm256.h"
+#include "cm256matrices.h"
+
+/*
+    Decoder cache
+
+    Least recently used set of decoder matrices.  The key is made of the
+    original count followed by the indices of the recovery blocks then of the
+    original blocks in the order the decoder uses them, which determines both
+    the original elimination matrix and the LDU decomposition.  Entries are
+    few so a linear search is enough.
+*/
+class CM256::CM256DecoderCache
+{
+public:
+    CM256DecoderCache(int entries) :
+        m_entryCount(entries),
+        m_useCount(0),
+        m_hits(0),
+        m_misses(0)
+    {
+        m_entries = new Entry[entries];
+    }
+
+    ~CM256DecoderCache()
+    {
+        for (int i = 0; i < m_entryCount; ++i) {
+            delete[] m_entries[i].Matrix;
+        }
+
+        delete[] m_entries;
+    }
+
+    int getEntryCount() const { return m_entryCount; }
+
+    void getStats(unsigned long long& hits, unsigned long long& misses)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        hits = m_hits;
+        misses = m_misses;
+    }
+
+    // Copies the matrices of 'key' into 'matrix' and returns true when cached
+    bool get(const uint8_t* key, int keyBytes, uint8_t* matrix, int matrixBytes)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (int i = 0; i < m_entryCount; ++i)
+        {
+            Entry& entry = m_entries[i];
+
+            if (entry.KeyBytes == keyBytes && entry.MatrixBytes == matrixBytes && memcmp(entry.Key, key, keyBytes) == 0)
+            {
+                memcpy(matrix, entry.Matrix, matrixBytes);
+                entry.LastUse = ++m_useCount;
+                m_hits++;
+                return true;
+            }
+        }
+
+        m_misses++;
+        return false;
+    }
+
+    // Stores the matrices of 'key' in place of the least recently used entry
+    void put(const uint8_t* key, int keyBytes, const uint8_t* matrix, int matrixBytes)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Entry* victim = m_entries;
+
+        for (int i = 1; i < m_entryCount; ++i)
+        {
+            if (m_entries[i].LastUse < victim->LastUse) {
+                victim = &m_entries[i];
+            }
+        }
+
+        if (victim->MatrixCapacity < matrixBytes)
+        {
+            delete[] victim->Matrix;
+            victim->Matrix = new uint8_t[matrixBytes];
+            victim->MatrixCapacity = matrixBytes;
+        }
 
-CM256::CM256()
+        memcpy(victim->Key, key, keyBytes);
+        memcpy(victim->Matrix, matrix, matrixBytes);
+        victim->KeyBytes = keyBytes;
+        victim->MatrixBytes = matrixBytes;
+        victim->LastUse = ++m_useCount;
+    }
+
+private:
+    struct Entry
+    {
+        Entry() : KeyBytes(0), Matrix(nullptr), MatrixBytes(0), MatrixCapacity(0), LastUse(0) {}
+
+        uint8_t Key[258];
+        int KeyBytes;
+        uint8_t* Matrix;
+        int MatrixBytes;
+        int MatrixCapacity;
+        unsigned long long LastUse;
+    };
+
+    Entry* m_entries;
+    int m_entryCount;
+    unsigned long long m_useCount;
+    unsigned long long m_hits;
+    unsigned long long m_misses;
+    std::mutex m_mutex;
+};
+
+CM256::CM256() :
+    m_tileBytes(0),
+    m_decoderCache(nullptr),
+    m_threadPool(nullptr),
+    m_ownedThreadPool(nullptr)
 {
     m_initialized = m_gf256Ctx.isInitialized();
 }
 
 CM256::~CM256()
 {
+    delete m_decoderCache;
+    delete m_ownedThreadPool;
+}
+
+void CM256::setThreadCount(int threadCount, int firstCpu)
+{
+    setThreadPool(nullptr);
+
+    if (threadCount > 0)
+    {
+        m_ownedThreadPool = new CM256Pool(threadCount, firstCpu);
+        m_threadPool = m_ownedThreadPool;
+    }
+}
+
+void CM256::setThreadPool(CM256Pool* pool)
+{
+    if (m_ownedThreadPool != pool)
+    {
+        delete m_ownedThreadPool;
+        m_ownedThreadPool = nullptr;
+    }
+
+    m_threadPool = pool;
 }
 
 /*
@@ -89,12 +230,18 @@ CM256::~CM256()
     a_ij = 1 / (x_i - y_j), where x_i and y_j are sets of GF(256) values
     that do not intersect.
 
-    We select x_i and y_j to just be incrementing numbers for the
-    purposes of this library.  Further optimizations may yield matrices
-    with more 1 elements, but the benefit seems relatively small.
+    CM256Matrix keeps x_i and y_j by block index.  MatrixDefault selects
+    incrementing numbers: each block index is its own parameter, so
+    the y_j of the originals range from 0...(originalCount - 1) and the
+    x_i of the recovery rows from originalCount...(originalCount +
+    recoveryCount - 1).  In byte mode every element other than 0 and 1
+    costs the same, and no row but the first can hold more than a single
+    1, so other parameters would not make it faster.
 
-    The x_i values range from 0...(originalCount - 1).
-    The y_j values range from originalCount...(originalCount + recoveryCount - 1).
+    MatrixOptimized takes x_i and y_j from a table searched offline by
+    cm256_matrix_search, and multiplies each row after the first by a
+    scale as allowed by (5), so that the 8x8 bit matrices of the elements
+    have fewer ones for the XOR-only bit-matrix mode.
 
     We then improve the Cauchy matrix by dividing each column by the
     first row element of that column.  The result is an invertible
@@ -115,21 +262,118 @@ CM256::~CM256()
     a_ij = (y_j + x_0) div (x_i + y_j) in GF(256)
 */
 
+// The matrix type is one of the known ones
+static inline bool cm256_known_matrix(CM256::MatrixType matrix)
+{
+    return matrix == CM256::MatrixDefault || matrix == CM256::MatrixOptimized;
+}
+
+bool CM256::CM256Matrix::Initialize(cm256_encoder_params params)
+{
+    OriginalCount = params.OriginalCount;
+    Scaled = false;
+
+    for (int i = 0; i < 256; ++i)
+    {
+        Parameter[i] = static_cast<uint8_t>(i);
+        Scale[i] = 1;
+    }
+
+    if (!cm256_known_matrix(params.Matrix))
+    {
+        return false;
+    }
+    if (params.Matrix == MatrixDefault)
+    {
+        return true;
+    }
+
+    // Smallest code of the table containing this one: the first rows and
+    // columns of a Cauchy matrix are a Cauchy matrix too.
+    static const int entryCount = sizeof(CM256MatrixEntries) / sizeof(CM256MatrixEntries[0]);
+
+    for (int e = 0; e < entryCount; ++e)
+    {
+        const CM256MatrixEntry& entry = CM256MatrixEntries[e];
+
+        if (entry.OriginalCount < params.OriginalCount || entry.RecoveryCount < params.RecoveryCount)
+        {
+            continue;
+        }
+
+        const uint8_t* x = CM256MatrixParameters + entry.Offset;
+        const uint8_t* y = x + entry.RecoveryCount;
+        const uint8_t* scales = y + entry.OriginalCount;
+
+        for (int i = 0; i < params.RecoveryCount; ++i)
+        {
+            Parameter[params.OriginalCount + i] = x[i];
+            Scale[params.OriginalCount + i] = scales[i];
+        }
+
+        for (int j = 0; j < params.OriginalCount; ++j)
+        {
+            Parameter[j] = y[j];
+        }
+
+        Scaled = true;
+        break;
+    }
+
+    return true;
+}
+
 //-----------------------------------------------------------------------------
 // Encoding
 
+// Size of the original data tiles the automatic tile size aims at
+static const int CM256TileCacheBytes = 128 * 1024;
+
+int CM256::cm256_get_tile_bytes(cm256_encoder_params params) const
+{
+    int tileBytes = m_tileBytes;
+
+    if (tileBytes == 0)
+    {
+        // Blocks small enough for all the originals to stay in cache are not tiled
+        if (params.OriginalCount <= 0 || params.BlockBytes <= CM256TileCacheBytes / params.OriginalCount) {
+            return params.BlockBytes;
+        }
+
+        tileBytes = CM256TileCacheBytes / params.OriginalCount;
+
+        // Below this the per-tile overhead outweighs the cache savings
+        if (tileBytes < 2048) {
+            tileBytes = 2048;
+        }
+    }
+
+    // A tile of at least the block is the whole block, which also keeps the
+    // rounding below from overflowing
+    if (tileBytes >= params.BlockBytes) {
+        return params.BlockBytes;
+    }
+
+    // Keep the tiles on whole vectors so that only the last one has a tail
+    tileBytes = (tileBytes + 63) & ~63;
+
+    return tileBytes < params.BlockBytes ? tileBytes : params.BlockBytes;
+}
+
 void CM256::cm256_encode_block(
-    cm256_encoder_params params, // Encoder parameters
-    cm256_block* originals,      // Array of pointers to original blocks
-    int recoveryBlockIndex,      // Return value from cm256_get_recovery_block_index()
-    void* recoveryBlock)         // Output recovery block
+    cm256_encoder_params params,      // Encoder parameters
+    const void* const* originals,     // Original data at the same offset as recoveryBlock
+    const uint8_t* matrixRow,         // Matrix row of the block, unused for the first one
+    int recoveryBlockIndex,           // Return value from cm256_get_recovery_block_index()
+    void* recoveryBlock,              // Output recovery block
+    int bytes)                        // Number of bytes to encode
 {
     // If only one block of input data,
     if (params.OriginalCount == 1)
     {
         // No meaningful operation here, degenerate to outputting the same data each time.
 
-        memcpy(recoveryBlock, originals[0].Block, params.BlockBytes);
+        memcpy(recoveryBlock, originals[0], bytes);
         return;
     }
     // else OriginalCount >= 2:
@@ -139,40 +383,62 @@ void CM256::cm256_encode_block(
     // so it is merely a parity of the original data.
     if (recoveryBlockIndex == params.OriginalCount)
     {
-        gf256_ctx::gf256_addset_mem(recoveryBlock, originals[0].Block, originals[1].Block, params.BlockBytes);
-        for (int j = 2; j < params.OriginalCount; ++j)
-        {
-            gf256_ctx::gf256_add_mem(recoveryBlock, originals[j].Block, params.BlockBytes);
-        }
+        gf256_ctx::gf256_addset_multi_mem(recoveryBlock, originals, params.OriginalCount, bytes);
         return;
     }
 
     // TBD: Faster algorithms seem to exist for computing this matrix-vector product.
 
-    // Start the x_0 values arbitrarily from the original count.
-    const uint8_t x_0 = static_cast<uint8_t>(params.OriginalCount);
+    // The recovery block is read and written once per group of originals
+    m_gf256Ctx.gf256_mul_multi_mem(recoveryBlock, matrixRow, originals, params.OriginalCount, bytes);
+}
+
+CM256::CM256EncoderPlan::CM256EncoderPlan() :
+    TileBytes(0)
+{
+    Params.BlockBytes = 0;
+    Params.OriginalCount = 0;
+    Params.RecoveryCount = 0;
+    Params.Matrix = MatrixDefault;
+}
 
-    // For other rows:
+int CM256::cm256_init_encoder_plan(
+    cm256_encoder_params params, // Encoder parameters
+    CM256EncoderPlan& plan)      // Plan to initialize
+{
+    // Validate input:
+    if (params.OriginalCount <= 0 ||
+        params.RecoveryCount <= 0 ||
+        params.BlockBytes <= 0)
+    {
+        return -1;
+    }
+    if (params.OriginalCount + params.RecoveryCount > 256)
     {
-        const uint8_t x_i = static_cast<uint8_t>(recoveryBlockIndex);
+        return -2;
+    }
 
-        // Unroll first operation for speed
-        {
-            const uint8_t y_0 = 0;
-            const uint8_t matrixElement = m_gf256Ctx.getMatrixElement(x_i, x_0, y_0);
+    CM256Matrix matrix;
+    if (!matrix.Initialize(params))
+    {
+        return -1;
+    }
 
-            m_gf256Ctx.gf256_mul_mem(recoveryBlock, originals[0].Block, matrixElement, params.BlockBytes);
-        }
+    uint8_t* matrixRow = plan.Matrix;
 
+    for (int block = 1; block < params.RecoveryCount; ++block, matrixRow += params.OriginalCount)
+    {
         // For each original data column,
-        for (int j = 1; j < params.OriginalCount; ++j)
+        for (int j = 0; j < params.OriginalCount; ++j)
         {
-            const uint8_t y_j = static_cast<uint8_t>(j);
-            const uint8_t matrixElement = m_gf256Ctx.getMatrixElement(x_i, x_0, y_j);
-
-            m_gf256Ctx.gf256_muladd_mem(recoveryBlock, matrixElement, originals[j].Block, params.BlockBytes);
+            matrixRow[j] = matrix.Element(m_gf256Ctx, params.OriginalCount + block, j);
         }
     }
+
+    plan.Params = params;
+    plan.TileBytes = cm256_get_tile_bytes(params);
+
+    return 0;
 }
 
 int CM256::cm256_encode(
@@ -180,150 +446,618 @@ int CM256::cm256_encode(
     cm256_block* originals,      // Array of pointers to original blocks
     void* recoveryBlocks)        // Output recovery blocks end-to-end
 {
-    // Validate input:
-    if (params.OriginalCount <= 0 ||
-        params.RecoveryCount <= 0 ||
-        params.BlockBytes <= 0)
+    CM256EncoderPlan plan;
+    const int result = cm256_init_encoder_plan(params, plan);
+
+    if (result != 0)
     {
-        return -1;
+        return result;
     }
-    if (params.OriginalCount + params.RecoveryCount > 256)
+
+    return cm256_encode(plan, originals, recoveryBlocks);
+}
+
+int CM256::cm256_encode(
+    cm256_encoder_params params, // Encoder params
+    const void* originals,       // First original block
+    int originalStride,          // Bytes from one original block to the next
+    void* recoveryBlocks,        // First output recovery block
+    int recoveryStride)          // Bytes from one recovery block to the next
+{
+    CM256EncoderPlan plan;
+    const int result = cm256_init_encoder_plan(params, plan);
+
+    if (result != 0)
     {
-        return -2;
+        return result;
+    }
+
+    return cm256_encode(plan, originals, originalStride, recoveryBlocks, recoveryStride);
+}
+
+// Work below which a frame is not split across threads, in bytes multiplied
+static const long long CM256ParallelMinWork = 1024 * 1024;
+// Smallest byte range given to a thread when splitting the blocks
+static const int CM256ParallelMinBytes = 4096;
+
+// Description of a frame split across the threads
+struct CM256EncodeJob
+{
+    CM256* cm256;
+    const CM256::CM256EncoderPlan* plan;
+    const void* const* originals;
+    void* recoveryBlocks;
+    int recoveryStride;
+    int bytes;           // Bytes of the blocks from the pointers
+    int rangeBytes;      // Bytes per task when split by byte ranges, 0 when split by recovery blocks
+    int blocksPerTask;   // Recovery blocks per task when split by recovery blocks
+};
+
+// Description of a decode split across the threads by byte ranges
+struct CM256DecodeJob
+{
+    CM256::CM256Decoder* decoder;
+    int rangeBytes;
+    int tileBytes;
+};
+
+// Erasures up to which the decoder applies the inverse of their rows directly
+// rather than the LDU decomposition
+static const int CM256SmallErasures = 4;
+// Bytes of each row staged on the stack when decoding them in place
+static const int CM256SmallChunkBytes = 1024;
+
+int CM256::cm256_encode(
+    const CM256EncoderPlan& plan, // Plan from cm256_init_encoder_plan()
+    cm256_block* originals,       // Array of pointers to original blocks
+    void* recoveryBlocks)         // Output recovery blocks end-to-end
+{
+    if (plan.TileBytes <= 0)
+    {
+        return -1;
     }
     if (!originals || !recoveryBlocks)
     {
         return -3;
     }
 
-    uint8_t* recoveryBlock = static_cast<uint8_t*>(recoveryBlocks);
+    const void* originalBlocks[256];
 
-    for (int block = 0; block < params.RecoveryCount; ++block, recoveryBlock += params.BlockBytes)
+    for (int j = 0; j < plan.Params.OriginalCount; ++j)
     {
-        cm256_encode_block(params, originals, (params.OriginalCount + block), recoveryBlock);
+        originalBlocks[j] = originals[j].Block;
     }
 
+    cm256_encode_blocks(plan, originalBlocks, recoveryBlocks, plan.Params.BlockBytes, plan.Params.BlockBytes);
     return 0;
 }
 
+int CM256::cm256_encode(
+    const CM256EncoderPlan& plan, // Plan from cm256_init_encoder_plan()
+    const void* originals,        // First original block
+    int originalStride,           // Bytes from one original block to the next
+    void* recoveryBlocks,         // First output recovery block
+    int recoveryStride)           // Bytes from one recovery block to the next
+{
+    if (plan.TileBytes <= 0 ||
+        originalStride < plan.Params.BlockBytes ||
+        recoveryStride < plan.Params.BlockBytes)
+    {
+        return -1;
+    }
+    if (!originals || !recoveryBlocks)
+    {
+        return -3;
+    }
+
+    const void* originalBlocks[256];
 
-//-----------------------------------------------------------------------------
-// Decoding
+    for (int j = 0; j < plan.Params.OriginalCount; ++j)
+    {
+        originalBlocks[j] = static_cast<const uint8_t*>(originals) + (size_t) j * originalStride;
+    }
 
-CM256::CM256Decoder::CM256Decoder(gf256_ctx& gf256Ctx) :
-            RecoveryCount(0),
-            OriginalCount(0),
-            m_gf256Ctx(gf256Ctx)
-{
+    cm256_encode_blocks(plan, originalBlocks, recoveryBlocks, recoveryStride, plan.Params.BlockBytes);
+    return 0;
 }
 
-CM256::CM256Decoder::~CM256Decoder()
+int CM256::cm256_encode(
+    cm256_encoder_params params,            // Encoder params
+    const cm256_segmented_block* originals, // Array of original blocks
+    void* recoveryBlocks)                   // Output recovery blocks end-to-end
 {
-}
+    CM256EncoderPlan plan;
+    const int result = cm256_init_encoder_plan(params, plan);
 
-bool CM256::CM256Decoder::Initialize(cm256_encoder_params& params, cm256_block* blocks)
-{
-    Params = params;
+    if (result != 0)
+    {
+        return result;
+    }
 
-    cm256_block* block = blocks;
-    OriginalCount = 0;
-    RecoveryCount = 0;
+    return cm256_encode(plan, originals, recoveryBlocks);
+}
 
-    // Initialize erasures to zeros
-    for (int ii = 0; ii < params.OriginalCount; ++ii)
+int CM256::cm256_encode(
+    const CM256EncoderPlan& plan,           // Plan from cm256_init_encoder_plan()
+    const cm256_segmented_block* originals, // Array of original blocks
+    void* recoveryBlocks)                   // Output recovery blocks end-to-end
+{
+    if (plan.TileBytes <= 0)
     {
-        ErasuresIndices[ii] = 0;
+        return -1;
+    }
+    if (!originals || !recoveryBlocks)
+    {
+        return -3;
     }
 
-    // For each input block,
-    for (int ii = 0; ii < params.OriginalCount; ++ii, ++block)
+    const cm256_encoder_params& params = plan.Params;
+
+    // Current segment of each original and the block offset at which it ends
+    int segment[256];
+    int segmentEnd[256];
+
+    for (int j = 0; j < params.OriginalCount; ++j)
     {
-        int row = block->Index;
+        const cm256_segmented_block& original = originals[j];
+        int blockBytes = 0;
 
-        // If it is an original block,
-        if (row < params.OriginalCount)
+        if (!original.Segments || original.SegmentCount <= 0)
         {
-            Original[OriginalCount++] = block;
+            return -3;
+        }
 
-            if (ErasuresIndices[row] != 0)
+        for (int k = 0; k < original.SegmentCount; ++k)
+        {
+            if (original.Segments[k].Bytes < 0 || (original.Segments[k].Bytes > 0 && !original.Segments[k].Data))
             {
-                // Error out if two row indices repeat
-                return false;
+                return -5;
             }
 
-            ErasuresIndices[row] = 1;
+            blockBytes += original.Segments[k].Bytes;
         }
-        else
+
+        if (blockBytes != params.BlockBytes)
         {
-            Recovery[RecoveryCount++] = block;
+            return -5;
         }
+
+        segment[j] = 0;
+        segmentEnd[j] = original.Segments[0].Bytes;
     }
 
-    // Identify erasures
-    for (int ii = 0, indexCount = 0; ii < 256; ++ii)
+    // Encode the spans between consecutive segment boundaries of any original
+    const void* spanOriginals[256];
+    int offset = 0;
+
+    while (offset < params.BlockBytes)
     {
-        if (!ErasuresIndices[ii])
-        {
-            ErasuresIndices[indexCount] = static_cast<uint8_t>( ii );
+        int end = params.BlockBytes;
 
-            if (++indexCount >= RecoveryCount)
+        for (int j = 0; j < params.OriginalCount; ++j)
+        {
+            // Skip the segments that end here, empty ones included
+            while (segmentEnd[j] <= offset)
             {
-                break;
+                segmentEnd[j] += originals[j].Segments[++segment[j]].Bytes;
+            }
+
+            const cm256_segment& current = originals[j].Segments[segment[j]];
+            spanOriginals[j] = static_cast<const uint8_t*>(current.Data) + current.Bytes - (segmentEnd[j] - offset);
+
+            if (segmentEnd[j] < end) {
+                end = segmentEnd[j];
             }
         }
+
+        cm256_encode_blocks(plan, spanOriginals, static_cast<uint8_t*>(recoveryBlocks) + offset, params.BlockBytes, end - offset);
+        offset = end;
     }
 
-    return true;
+    return 0;
 }
 
-void CM256::CM256Decoder::DecodeM1()
+void CM256::cm256_encode_blocks(
+    const CM256EncoderPlan& plan,     // Encoder plan
+    const void* const* originals,     // Array of pointers to original blocks
+    void* recoveryBlocks,             // First output recovery block
+    int recoveryStride,               // Bytes from one recovery block to the next
+    int bytes)                        // Number of bytes from the pointers
 {
-    // XOR all other blocks into the recovery block
-    uint8_t* outBlock = static_cast<uint8_t*>(Recovery[0]->Block);
-    const uint8_t* inBlock = nullptr;
+    const cm256_encoder_params& params = plan.Params;
+    const long long work = (long long) params.OriginalCount * params.RecoveryCount * bytes;
+    int taskCount = m_threadPool ? m_threadPool->getThreadCount() + 1 : 1;
 
-    // For each block,
-    for (int ii = 0; ii < OriginalCount; ++ii)
-    {
-        const uint8_t* inBlock2 = static_cast<const uint8_t*>(Original[ii]->Block);
+    if (work / CM256ParallelMinWork < taskCount) {
+        taskCount = (int) (work / CM256ParallelMinWork);
+    }
 
-        if (!inBlock)
-        {
-            inBlock = inBlock2;
-        }
-        else
-        {
-            // outBlock ^= inBlock ^ inBlock2
-            gf256_ctx::gf256_add2_mem(outBlock, inBlock, inBlock2, Params.BlockBytes);
-            inBlock = nullptr;
-        }
+    if (taskCount <= 1)
+    {
+        cm256_encode_range(plan, originals, recoveryBlocks, recoveryStride, 0, bytes, 0, params.RecoveryCount);
+        return;
     }
 
-    // Complete XORs
-    if (inBlock)
+    CM256EncodeJob job;
+    job.cm256 = this;
+    job.plan = &plan;
+    job.originals = originals;
+    job.recoveryBlocks = recoveryBlocks;
+    job.recoveryStride = recoveryStride;
+    job.bytes = bytes;
+
+    if (bytes >= taskCount * CM256ParallelMinBytes)
+    {
+        // Byte ranges: each thread reads its own part of the originals,
+        // kept on whole vectors like the tiles
+        job.rangeBytes = ((bytes + taskCount - 1) / taskCount + 63) & ~63;
+        job.blocksPerTask = params.RecoveryCount;
+        taskCount = (bytes + job.rangeBytes - 1) / job.rangeBytes;
+    }
+    else
     {
-        gf256_ctx::gf256_add_mem(outBlock, inBlock, Params.BlockBytes);
+        // Groups of recovery blocks: each thread reads all the originals
+        job.rangeBytes = 0;
+        job.blocksPerTask = (params.RecoveryCount + taskCount - 1) / taskCount;
+        taskCount = (params.RecoveryCount + job.blocksPerTask - 1) / job.blocksPerTask;
     }
 
-    // Recover the index it corresponds to
-    Recovery[0]->Index = ErasuresIndices[0];
+    m_threadPool->run(cm256_encode_task, &job, taskCount);
 }
 
-// Generate the LU decomposition of the matrix
-void CM256::CM256Decoder::GenerateLDUDecomposition(uint8_t* matrix_L, uint8_t* diag_D, uint8_t* matrix_U)
+void CM256::cm256_encode_task(void* arg, int index)
 {
-    // Schur-type-direct-Cauchy algorithm 2.5 from
-    // "Pivoting and Backward Stability of Fast Algorithms for Solving Cauchy Linear Equations"
-    // T. Boros, T. Kailath, V. Olshevsky
-    // Modified for practical use.  I folded the diagonal parts of U/L matrices into the
-    // diagonal one to reduce the number of multiplications to perform against the input data,
-    // and organized the triangle matrices in memory to allow for faster SSE3 GF multiplications.
-
-    // Matrix size NxN
-    const int N = RecoveryCount;
+    const CM256EncodeJob& job = *static_cast<const CM256EncodeJob*>(arg);
+    const cm256_encoder_params& params = job.plan->Params;
 
-    // Generators
-    uint8_t g[256], b[256];
+    if (job.rangeBytes > 0)
+    {
+        const int offset = index * job.rangeBytes;
+        const int bytes = job.bytes - offset < job.rangeBytes ? job.bytes - offset : job.rangeBytes;
+        job.cm256->cm256_encode_range(*job.plan, job.originals, job.recoveryBlocks, job.recoveryStride, offset, bytes, 0, params.RecoveryCount);
+    }
+    else
+    {
+        const int firstBlock = index * job.blocksPerTask;
+        const int blockCount = params.RecoveryCount - firstBlock < job.blocksPerTask ? params.RecoveryCount - firstBlock : job.blocksPerTask;
+        job.cm256->cm256_encode_range(*job.plan, job.originals, job.recoveryBlocks, job.recoveryStride, 0, job.bytes, firstBlock, blockCount);
+    }
+}
+
+void CM256::cm256_encode_range(
+    const CM256EncoderPlan& plan,     // Encoder plan
+    const void* const* originals,     // Array of pointers to original blocks
+    void* recoveryBlocks,             // First output recovery block
+    int recoveryStride,               // Bytes from one recovery block to the next
+    int offset,                       // Start of the range in the blocks
+    int bytes,                        // Number of bytes of the range
+    int firstBlock,                   // First recovery block
+    int blockCount)                   // Number of recovery blocks
+{
+    const cm256_encoder_params& params = plan.Params;
+
+    // Each tile of the originals is read once for all the recovery blocks
+    const int tileBytes = plan.TileBytes;
+    const int end = offset + bytes;
+    const void* tileOriginals[256];
+
+    for (int tileOffset = offset; tileOffset < end; tileOffset += tileBytes)
+    {
+        const int tileEnd = end - tileOffset < tileBytes ? end : tileOffset + tileBytes;
+        uint8_t* recoveryBlock = static_cast<uint8_t*>(recoveryBlocks) + (size_t) firstBlock * recoveryStride + tileOffset;
+
+        for (int j = 0; j < params.OriginalCount; ++j)
+        {
+            tileOriginals[j] = static_cast<const uint8_t*>(originals[j]) + tileOffset;
+        }
+
+        for (int block = firstBlock; block < firstBlock + blockCount; ++block, recoveryBlock += recoveryStride)
+        {
+            // The first block has no stored matrix row
+            const uint8_t* matrixRow = block > 0 ? plan.Matrix + (block - 1) * params.OriginalCount : nullptr;
+            cm256_encode_block(params, tileOriginals, matrixRow, (params.OriginalCount + block), recoveryBlock, tileEnd - tileOffset);
+        }
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Streaming encoder
+
+CM256::CM256StreamEncoder::CM256StreamEncoder(CM256& cm256) :
+    m_cm256(cm256),
+    m_plan(nullptr),
+    m_recoveryBlocks(nullptr),
+    m_recoveryStride(0),
+    m_addedCount(0)
+{
+}
+
+int CM256::CM256StreamEncoder::begin_frame(const CM256EncoderPlan& plan, void* recoveryBlocks)
+{
+    return begin_frame(plan, recoveryBlocks, plan.Params.BlockBytes);
+}
+
+int CM256::CM256StreamEncoder::begin_frame(const CM256EncoderPlan& plan, void* recoveryBlocks, int recoveryStride)
+{
+    m_plan = nullptr;
+
+    if (plan.TileBytes <= 0 || recoveryStride < plan.Params.BlockBytes)
+    {
+        return -1;
+    }
+    if (!recoveryBlocks)
+    {
+        return -3;
+    }
+
+    m_plan = &plan;
+    m_recoveryBlocks = static_cast<uint8_t*>(recoveryBlocks);
+    m_recoveryStride = recoveryStride;
+    m_addedCount = 0;
+    memset(m_added, 0, sizeof(m_added));
+
+    return 0;
+}
+
+int CM256::CM256StreamEncoder::add_original(int index, const void* originalBlock)
+{
+    if (!m_plan)
+    {
+        return -4;
+    }
+    if (!originalBlock)
+    {
+        return -3;
+    }
+
+    const cm256_encoder_params& params = m_plan->Params;
+
+    if (index < 0 || index >= params.OriginalCount || m_added[index])
+    {
+        return -5;
+    }
+
+    m_added[index] = 1;
+    const bool first = m_addedCount++ == 0;
+    gf256_ctx& gf256Ctx = m_cm256.m_gf256Ctx;
+
+    // If only one block of input data, the recovery blocks are copies of it
+    if (params.OriginalCount == 1)
+    {
+        for (int block = 0; block < params.RecoveryCount; ++block)
+        {
+            memcpy(m_recoveryBlocks + (size_t) block * m_recoveryStride, originalBlock, params.BlockBytes);
+        }
+
+        return 1;
+    }
+
+    // The first row of the matrix is all ones: parity of the originals
+    if (first)
+    {
+        memcpy(m_recoveryBlocks, originalBlock, params.BlockBytes);
+    }
+    else
+    {
+        gf256_ctx::gf256_add_mem(m_recoveryBlocks, originalBlock, params.BlockBytes);
+    }
+
+    // Other rows take the column of the original in the plan matrix
+    if (params.RecoveryCount > 1)
+    {
+        void* recoveryBlocks[256];
+        uint8_t matrixColumn[256];
+        const int count = params.RecoveryCount - 1;
+
+        for (int i = 0; i < count; ++i)
+        {
+            recoveryBlocks[i] = m_recoveryBlocks + (size_t) (i + 1) * m_recoveryStride;
+            matrixColumn[i] = m_plan->Matrix[i * params.OriginalCount + index];
+        }
+
+        if (first)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                gf256Ctx.gf256_mul_mem(recoveryBlocks[i], originalBlock, matrixColumn[i], params.BlockBytes);
+            }
+        }
+        else
+        {
+            gf256Ctx.gf256_muladd_multi_dest_mem(recoveryBlocks, matrixColumn, originalBlock, count, params.BlockBytes);
+        }
+    }
+
+    return is_complete() ? 1 : 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Decoding
+
+void CM256::setDecoderCacheSize(int entries)
+{
+    delete m_decoderCache;
+    m_decoderCache = entries > 0 ? new CM256DecoderCache(entries) : nullptr;
+}
+
+int CM256::getDecoderCacheSize() const
+{
+    return m_decoderCache ? m_decoderCache->getEntryCount() : 0;
+}
+
+void CM256::getDecoderCacheStats(unsigned long long& hits, unsigned long long& misses) const
+{
+    hits = 0;
+    misses = 0;
+
+    if (m_decoderCache) {
+        m_decoderCache->getStats(hits, misses);
+    }
+}
+
+CM256::CM256Decoder::CM256Decoder(gf256_ctx& gf256Ctx) :
+            RecoveryCount(0),
+            OriginalCount(0),
+            MatrixOriginals(nullptr),
+            MatrixL(nullptr),
+            DiagD(nullptr),
+            MatrixU(nullptr),
+            MatrixSmall(nullptr),
+            OriginalsEliminated(false),
+            Outputs(nullptr),
+            PreserveRecovery(false),
+            m_gf256Ctx(gf256Ctx)
+{
+}
+
+CM256::CM256Decoder::~CM256Decoder()
+{
+}
+
+bool CM256::CM256Decoder::Initialize(cm256_encoder_params& params, cm256_block* blocks)
+{
+    cm256_block* blockPointers[256];
+
+    for (int ii = 0; ii < params.OriginalCount; ++ii)
+    {
+        blockPointers[ii] = &blocks[ii];
+    }
+
+    return Initialize(params, blockPointers);
+}
+
+bool CM256::CM256Decoder::Initialize(cm256_encoder_params& params, cm256_block* const* blocks)
+{
+    Params = params;
+
+    if (!Matrix.Initialize(params))
+    {
+        return false;
+    }
+
+    OriginalCount = 0;
+    RecoveryCount = 0;
+
+    // Recovery row indices received
+    uint8_t recoveryRows[256] = { 0 };
+
+    // Initialize erasures to zeros
+    for (int ii = 0; ii < params.OriginalCount; ++ii)
+    {
+        ErasuresIndices[ii] = 0;
+    }
+
+    // For each input block,
+    for (int ii = 0; ii < params.OriginalCount; ++ii)
+    {
+        cm256_block* block = blocks[ii];
+        int row = block->Index;
+
+        // If it is an original block,
+        if (row < params.OriginalCount)
+        {
+            Original[OriginalCount++] = block;
+
+            if (ErasuresIndices[row] != 0)
+            {
+                // Error out if two row indices repeat
+                return false;
+            }
+
+            ErasuresIndices[row] = 1;
+        }
+        else
+        {
+            if (recoveryRows[row] != 0)
+            {
+                // Error out if two row indices repeat, the rows would be singular
+                return false;
+            }
+
+            recoveryRows[row] = 1;
+            Recovery[RecoveryCount++] = block;
+        }
+    }
+
+    // Identify erasures
+    for (int ii = 0, indexCount = 0; ii < 256; ++ii)
+    {
+        if (!ErasuresIndices[ii])
+        {
+            ErasuresIndices[indexCount] = static_cast<uint8_t>( ii );
+
+            if (++indexCount >= RecoveryCount)
+            {
+                break;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool CM256::CM256Decoder::HasOutputs() const
+{
+    for (int i = 0; i < RecoveryCount; ++i)
+    {
+        if (!Outputs[ErasuresIndices[i]]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool CM256::CM256Decoder::FirstRecoveryOnly() const
+{
+    return RecoveryCount == 1 && !OriginalsEliminated && Recovery[0]->Index == Params.OriginalCount;
+}
+
+void CM256::CM256Decoder::DecodeM1(int offset, int bytes)
+{
+    // XOR all other blocks into the recovery block
+    const void* inBlocks[256];
+
+    if (Outputs)
+    {
+        // Sum the recovery block and the originals straight into the output
+        inBlocks[0] = static_cast<const uint8_t*>(Recovery[0]->Block) + offset;
+
+        for (int ii = 0; ii < OriginalCount; ++ii)
+        {
+            inBlocks[ii + 1] = static_cast<const uint8_t*>(Original[ii]->Block) + offset;
+        }
+
+        gf256_ctx::gf256_addset_multi_mem(static_cast<uint8_t*>(Outputs[ErasuresIndices[0]]) + offset, inBlocks, OriginalCount + 1, bytes);
+        return;
+    }
+
+    // For each block,
+    for (int ii = 0; ii < OriginalCount; ++ii)
+    {
+        inBlocks[ii] = static_cast<const uint8_t*>(Original[ii]->Block) + offset;
+    }
+
+    gf256_ctx::gf256_add_multi_mem(static_cast<uint8_t*>(Recovery[0]->Block) + offset, inBlocks, OriginalCount, bytes);
+}
+
+// Generate the LU decomposition of the matrix
+void CM256::CM256Decoder::GenerateLDUDecomposition(uint8_t* matrix_L, uint8_t* diag_D, uint8_t* matrix_U)
+{
+    // Schur-type-direct-Cauchy algorithm 2.5 from
+    // "Pivoting and Backward Stability of Fast Algorithms for Solving Cauchy Linear Equations"
+    // T. Boros, T. Kailath, V. Olshevsky
+    // Modified for practical use.  I folded the diagonal parts of U/L matrices into the
+    // diagonal one to reduce the number of multiplications to perform against the input data,
+    // and organized the triangle matrices in memory to allow for faster SSE3 GF multiplications.
+
+    // Matrix size NxN
+    const int N = RecoveryCount;
+
+    // Generators
+    uint8_t g[256], b[256];
     for (int i = 0; i < N; ++i)
     {
         g[i] = 1;
@@ -336,14 +1070,15 @@ void CM256::CM256Decoder::GenerateLDUDecomposition(uint8_t* matrix_L, uint8_t* d
     uint8_t* last_U = matrix_U + ((N - 1) * N) / 2 - 1;
     int firstOffset_U = 0;
 
-    // Start the x_0 values arbitrarily from the original count.
-    const uint8_t x_0 = static_cast<uint8_t>(Params.OriginalCount);
+    // Cauchy parameters of the blocks
+    const uint8_t* parameter = Matrix.Parameter;
+    const uint8_t x_0 = parameter[Params.OriginalCount];
 
     // Unrolling k = 0 just makes it slower for some reason.
     for (int k = 0; k < N - 1; ++k)
     {
-        const uint8_t x_k = Recovery[k]->Index;
-        const uint8_t y_k = ErasuresIndices[k];
+        const uint8_t x_k = parameter[Recovery[k]->Index];
+        const uint8_t y_k = parameter[ErasuresIndices[k]];
 
         // D_kk = (x_k + y_k)
         // L_kk = g[k] / (x_k + y_k)
@@ -360,8 +1095,8 @@ void CM256::CM256Decoder::GenerateLDUDecomposition(uint8_t* matrix_L, uint8_t* d
         uint8_t* row_U = rotated_row_U;
         for (int j = k + 1; j < N; ++j)
         {
-            const uint8_t x_j = Recovery[j]->Index;
-            const uint8_t y_j = ErasuresIndices[j];
+            const uint8_t x_j = parameter[Recovery[j]->Index];
+            const uint8_t y_j = parameter[ErasuresIndices[j]];
 
             // L_jk = g[j] / (x_j + y_k)
             // U_kj = b[j] / (x_k + y_j)
@@ -399,15 +1134,15 @@ void CM256::CM256Decoder::GenerateLDUDecomposition(uint8_t* matrix_L, uint8_t* d
     uint8_t* row_U = matrix_U;
     for (int j = N - 1; j > 0; --j)
     {
-        const uint8_t y_j = ErasuresIndices[j];
+        const uint8_t y_j = parameter[ErasuresIndices[j]];
         const int count = j;
 
         m_gf256Ctx.gf256_mul_mem(row_U, row_U, gf256_ctx::gf256_add(x_0, y_j), count);
         row_U += count;
     }
 
-    const uint8_t x_n = Recovery[N - 1]->Index;
-    const uint8_t y_n = ErasuresIndices[N - 1];
+    const uint8_t x_n = parameter[Recovery[N - 1]->Index];
+    const uint8_t y_n = parameter[ErasuresIndices[N - 1]];
 
     // D_nn = 1 / (x_n + y_n)
     // L_nn = g[N-1]
@@ -417,115 +1152,510 @@ void CM256::CM256Decoder::GenerateLDUDecomposition(uint8_t* matrix_L, uint8_t* d
 
     // diag_D[N-1] = L_nn * D_nn * U_nn
     diag_D[N - 1] = m_gf256Ctx.gf256_div(m_gf256Ctx.gf256_mul(L_nn, U_nn), gf256_ctx::gf256_add(x_n, y_n));
+
+    // Scaled rows: S * L * D * U = (S * L / S) * (S * D) * U
+    if (Matrix.Scaled)
+    {
+        const uint8_t* scale = Matrix.Scale;
+        uint8_t* element_L = matrix_L - ((N - 1) * N) / 2;
+
+        for (int k = 0; k < N - 1; ++k)
+        {
+            const uint8_t s_k = scale[Recovery[k]->Index];
+
+            for (int j = k + 1; j < N; ++j, ++element_L)
+            {
+                *element_L = m_gf256Ctx.gf256_div(m_gf256Ctx.gf256_mul(*element_L, scale[Recovery[j]->Index]), s_k);
+            }
+        }
+
+        for (int k = 0; k < N; ++k)
+        {
+            diag_D[k] = m_gf256Ctx.gf256_mul(diag_D[k], scale[Recovery[k]->Index]);
+        }
+    }
 }
 
-void CM256::CM256Decoder::Decode()
+bool CM256::CM256Decoder::GenerateDecodingMatrix(uint8_t* matrix)
 {
-    // Matrix size is NxN, where N is the number of recovery blocks used.
     const int N = RecoveryCount;
+    const int originalCount = OriginalsEliminated ? 0 : OriginalCount;
+    const int sourceCount = N + originalCount;
 
-    // Start the x_0 values arbitrarily from the original count.
-    const uint8_t x_0 = static_cast<uint8_t>(Params.OriginalCount);
+    // Rows of the erasures with the identity on their right, then the same
+    // rows over the received originals
+    uint8_t stackRows[CM256SmallErasures * (2 * CM256SmallErasures + 256)];
+    std::vector<uint8_t> dynamicRows;
+    uint8_t* inverse = stackRows;
 
-    // Eliminate original data from the the recovery rows
-    for (int originalIndex = 0; originalIndex < OriginalCount; ++originalIndex)
+    if (N > CM256SmallErasures)
     {
-        const uint8_t* inBlock = static_cast<const uint8_t*>(Original[originalIndex]->Block);
-        const uint8_t inRow = Original[originalIndex]->Index;
+        dynamicRows.resize((size_t) N * (2 * N + originalCount));
+        inverse = dynamicRows.data();
+    }
 
-        for (int recoveryIndex = 0; recoveryIndex < N; ++recoveryIndex)
-        {
-            uint8_t* outBlock = static_cast<uint8_t*>(Recovery[recoveryIndex]->Block);
-            const uint8_t x_i = Recovery[recoveryIndex]->Index;
-            const uint8_t y_j = inRow;
-            const uint8_t matrixElement = m_gf256Ctx.getMatrixElement(x_i, x_0, y_j);
+    uint8_t* originals = inverse + (size_t) N * 2 * N;
+    memset(inverse, 0, (size_t) N * 2 * N);
+
+    for (int i = 0; i < N; ++i)
+    {
+        uint8_t* row = inverse + (size_t) i * 2 * N;
+
+        for (int j = 0; j < N; ++j) {
+            row[j] = Matrix.Element(m_gf256Ctx, Recovery[i]->Index, ErasuresIndices[j]);
+        }
 
-            m_gf256Ctx.gf256_muladd_mem(outBlock, matrixElement, inBlock, Params.BlockBytes);
+        row[N + i] = 1;
+        row = originals + (size_t) i * originalCount;
+
+        for (int j = 0; j < originalCount; ++j) {
+            row[j] = Matrix.Element(m_gf256Ctx, Recovery[i]->Index, Original[j]->Index);
         }
     }
 
-    // Allocate matrix
-    static const int StackAllocSize = 2048;
-    uint8_t stackMatrix[StackAllocSize];
-    uint8_t* dynamicMatrix = nullptr;
-    uint8_t* matrix = stackMatrix;
-    const int requiredSpace = N * N;
-    if (requiredSpace > StackAllocSize)
+    // Gauss-Jordan elimination leaves the inverse on the right.  The rows of a
+    // few erasures are too short for the kernels and are worked element-wise.
+    for (int column = 0; column < N; ++column)
     {
-        dynamicMatrix = new uint8_t[requiredSpace];
-        matrix = dynamicMatrix;
-    }
+        int pivot = column;
 
-    /*
-        Compute matrix decomposition:
+        while (pivot < N && inverse[(size_t) pivot * 2 * N + column] == 0) {
+            ++pivot;
+        }
 
-            G = L * D * U
+        // Only repeated or invalid rows leave a column without a pivot
+        if (pivot == N) {
+            return false;
+        }
 
-        L is lower-triangular, diagonal is all ones.
-        D is a diagonal matrix.
-        U is upper-triangular, diagonal is all ones.
-    */
-    uint8_t* matrix_U = matrix;
-    uint8_t* diag_D = matrix_U + (N - 1) * N / 2;
+        uint8_t* pivotRow = inverse + (size_t) pivot * 2 * N;
+        uint8_t* columnRow = inverse + (size_t) column * 2 * N;
+
+        if (pivot != column) {
+            gf256_ctx::gf256_memswap(pivotRow, columnRow, 2 * N);
+        }
+
+        if (N <= CM256SmallErasures)
+        {
+            const uint8_t pivotInverse = m_gf256Ctx.gf256_inv(columnRow[column]);
+
+            for (int c = 0; c < 2 * N; ++c) {
+                columnRow[c] = m_gf256Ctx.gf256_mul(columnRow[c], pivotInverse);
+            }
+        }
+        else
+        {
+            m_gf256Ctx.gf256_div_mem(columnRow, columnRow, columnRow[column], 2 * N);
+        }
+
+        for (int i = 0; i < N; ++i)
+        {
+            uint8_t* row = inverse + (size_t) i * 2 * N;
+            const uint8_t y = row[column];
+
+            if (i == column || y == 0) {
+                continue;
+            }
+
+            if (N <= CM256SmallErasures)
+            {
+                for (int c = 0; c < 2 * N; ++c) {
+                    row[c] ^= m_gf256Ctx.gf256_mul(y, columnRow[c]);
+                }
+            }
+            else
+            {
+                m_gf256Ctx.gf256_muladd_mem(row, y, columnRow, 2 * N);
+            }
+        }
+    }
+
+    // Applied to the recovery rows with the originals eliminated, the inverse
+    // gives the coefficients of the originals: the inverse times their rows.
+    for (int i = 0; i < N; ++i)
+    {
+        const uint8_t* inverseRow = inverse + (size_t) i * 2 * N + N;
+        uint8_t* row = matrix + (size_t) i * sourceCount;
+
+        memcpy(row, inverseRow, N);
+
+        if (originalCount == 0) {
+            continue;
+        }
+
+        m_gf256Ctx.gf256_mul_mem(row + N, originals, inverseRow[0], originalCount);
+
+        for (int k = 1; k < N; ++k) {
+            m_gf256Ctx.gf256_muladd_mem(row + N, inverseRow[k], originals + (size_t) k * originalCount, originalCount);
+        }
+    }
+
+    return true;
+}
+
+bool CM256::CM256Decoder::Decode(int tileBytes, CM256DecoderCache* cache, CM256Pool* pool)
+{
+    // Matrix size is NxN, where N is the number of recovery blocks used.
+    const int N = RecoveryCount;
+
+    // Allocate matrices: original elimination rows, unless the originals were
+    // already eliminated, then LDU decomposition
+    static const int StackAllocSize = 16384;
+    uint8_t stackMatrix[StackAllocSize];
+    uint8_t* dynamicMatrix = nullptr;
+    uint8_t* matrix = stackMatrix;
+    const int eliminationSpace = OriginalsEliminated ? 0 : N * OriginalCount;
+    const bool xorOnly = FirstRecoveryOnly();
+    const bool small = N <= CM256SmallErasures;
+    const int requiredSpace = small ? N * (N + (OriginalsEliminated ? 0 : OriginalCount)) : eliminationSpace + N * N;
+    if (requiredSpace > StackAllocSize && !xorOnly)
+    {
+        dynamicMatrix = new uint8_t[requiredSpace];
+        matrix = dynamicMatrix;
+    }
+
+    uint8_t* matrix_U = matrix + eliminationSpace;
+    uint8_t* diag_D = matrix_U + (N - 1) * N / 2;
     uint8_t* matrix_L = diag_D + N;
-    GenerateLDUDecomposition(matrix_L, diag_D, matrix_U);
+
+    MatrixOriginals = matrix;
+    MatrixL = matrix_L;
+    DiagD = diag_D;
+    MatrixU = matrix_U;
+    MatrixSmall = small ? matrix : nullptr;
+
+    // The matrices only depend on the code and the indices of the blocks received
+    uint8_t key[258];
+    int keyBytes = 0;
+
+    if (cache && !xorOnly)
+    {
+        key[keyBytes++] = static_cast<uint8_t>(Params.OriginalCount);
+        key[keyBytes++] = static_cast<uint8_t>(Params.Matrix);
+
+        // The optimized parameters are picked by the recovery count too
+        if (Params.Matrix == MatrixOptimized) {
+            key[keyBytes++] = static_cast<uint8_t>(Params.RecoveryCount);
+        }
+
+        for (int recoveryIndex = 0; recoveryIndex < N; ++recoveryIndex) {
+            key[keyBytes++] = Recovery[recoveryIndex]->Index;
+        }
+
+        for (int originalIndex = 0; originalIndex < OriginalCount; ++originalIndex) {
+            key[keyBytes++] = Original[originalIndex]->Index;
+        }
+    }
+
+    // A single erasure recovered with the first recovery block needs no
+    // matrix: it is the XOR of the blocks received.
+    if (!xorOnly && small && (!cache || !cache->get(key, keyBytes, matrix, requiredSpace)))
+    {
+        // A few erasures are solved with one pass per erasure over all the
+        // blocks, each computing its original straight from the recovery rows.
+        if (!GenerateDecodingMatrix(matrix))
+        {
+            delete[] dynamicMatrix;
+            return false;
+        }
+
+        if (cache) {
+            cache->put(key, keyBytes, matrix, requiredSpace);
+        }
+    }
+    else if (!xorOnly && !small && (!cache || !cache->get(key, keyBytes, matrix, requiredSpace)))
+    {
+        // Original elimination matrix, one row of OriginalCount elements per recovery row
+        uint8_t* matrixRow = matrix;
+
+        for (int recoveryIndex = 0; recoveryIndex < N && !OriginalsEliminated; ++recoveryIndex, matrixRow += OriginalCount)
+        {
+            for (int originalIndex = 0; originalIndex < OriginalCount; ++originalIndex)
+            {
+                matrixRow[originalIndex] = Matrix.Element(m_gf256Ctx, Recovery[recoveryIndex]->Index, Original[originalIndex]->Index);
+            }
+        }
+
+        /*
+            Compute matrix decomposition:
+
+                G = L * D * U
+
+            L is lower-triangular, diagonal is all ones.
+            D is a diagonal matrix.
+            U is upper-triangular, diagonal is all ones.
+        */
+        GenerateLDUDecomposition(matrix_L, diag_D, matrix_U);
+
+        if (cache) {
+            cache->put(key, keyBytes, matrix, requiredSpace);
+        }
+    }
+
+    // Every phase is column-independent, so large blocks are split into byte
+    // ranges decoded concurrently, all sharing the matrices.
+    const long long work = (long long) (OriginalCount + N) * N * Params.BlockBytes;
+    int taskCount = pool ? pool->getThreadCount() + 1 : 1;
+
+    if (work / CM256ParallelMinWork < taskCount) {
+        taskCount = (int) (work / CM256ParallelMinWork);
+    }
+    if (Params.BlockBytes / CM256ParallelMinBytes < taskCount) {
+        taskCount = Params.BlockBytes / CM256ParallelMinBytes;
+    }
+
+    if (taskCount <= 1)
+    {
+        DecodeTiles(0, Params.BlockBytes, tileBytes);
+    }
+    else
+    {
+        CM256DecodeJob job;
+        job.decoder = this;
+        job.rangeBytes = ((Params.BlockBytes + taskCount - 1) / taskCount + 63) & ~63;
+        job.tileBytes = tileBytes;
+        taskCount = (Params.BlockBytes + job.rangeBytes - 1) / job.rangeBytes;
+
+        pool->run(DecodeTask, &job, taskCount);
+    }
+
+    for (int i = 0; i < N && !Outputs; ++i)
+    {
+        Recovery[i]->Index = ErasuresIndices[i];
+    }
+
+    delete[] dynamicMatrix;
+    return true;
+}
+
+void CM256::CM256Decoder::DecodeTiles(int offset, int bytes, int tileBytes)
+{
+    // Run all the phases on a tile of the blocks while it is in cache
+    // before moving to the next one.
+    const int end = offset + bytes;
+
+    for (int tileOffset = offset; tileOffset < end; tileOffset += tileBytes)
+    {
+        DecodeRange(tileOffset, end - tileOffset < tileBytes ? end - tileOffset : tileBytes);
+    }
+}
+
+void CM256::CM256Decoder::DecodeTask(void* arg, int index)
+{
+    const CM256DecodeJob& job = *static_cast<const CM256DecodeJob*>(arg);
+    const int offset = index * job.rangeBytes;
+    const int blockBytes = job.decoder->Params.BlockBytes;
+
+    job.decoder->DecodeTiles(offset, blockBytes - offset < job.rangeBytes ? blockBytes - offset : job.rangeBytes, job.tileBytes);
+}
+
+void CM256::CM256Decoder::DecodeRange(int offset, int bytes)
+{
+    if (FirstRecoveryOnly())
+    {
+        DecodeM1(offset, bytes);
+        return;
+    }
+
+    if (MatrixSmall)
+    {
+        DecodeSmallRange(offset, bytes);
+        return;
+    }
+
+    // Matrix size is NxN, where N is the number of recovery blocks used.
+    const int N = RecoveryCount;
+
+    // Data of the range in the original and recovery blocks, and in the
+    // blocks receiving the result of each row
+    const void* inBlocks[256];
+    uint8_t* recoveryBlocks[256];
+    uint8_t* outputBlocks[256];
+
+    for (int originalIndex = 0; originalIndex < OriginalCount; ++originalIndex)
+    {
+        inBlocks[originalIndex] = static_cast<const uint8_t*>(Original[originalIndex]->Block) + offset;
+    }
+
+    for (int recoveryIndex = 0; recoveryIndex < N; ++recoveryIndex)
+    {
+        recoveryBlocks[recoveryIndex] = static_cast<uint8_t*>(Recovery[recoveryIndex]->Block) + offset;
+        outputBlocks[recoveryIndex] = Outputs ? static_cast<uint8_t*>(Outputs[ErasuresIndices[recoveryIndex]]) + offset : recoveryBlocks[recoveryIndex];
+    }
+
+    // Eliminate original data from the the recovery rows
+    // Like the encoder, each recovery row takes all the original blocks in
+    // one multi-source pass.
+    const uint8_t* matrixRow = MatrixOriginals;
+
+    if (Outputs && PreserveRecovery)
+    {
+        // Work in the outputs from the first pass: each one is set to its
+        // recovery block plus the original terms, the recovery block being
+        // the last source with a coefficient of 1.
+        uint8_t coefficients[256];
+        inBlocks[OriginalCount] = nullptr;
+
+        for (int recoveryIndex = 0; recoveryIndex < N; ++recoveryIndex, matrixRow += OriginalCount)
+        {
+            if (OriginalsEliminated || OriginalCount == 0)
+            {
+                memcpy(outputBlocks[recoveryIndex], recoveryBlocks[recoveryIndex], bytes);
+                continue;
+            }
+
+            memcpy(coefficients, matrixRow, OriginalCount);
+            coefficients[OriginalCount] = 1;
+            inBlocks[OriginalCount] = recoveryBlocks[recoveryIndex];
+            m_gf256Ctx.gf256_mul_multi_mem(outputBlocks[recoveryIndex], coefficients, inBlocks, OriginalCount + 1, bytes);
+        }
+
+        for (int recoveryIndex = 0; recoveryIndex < N; ++recoveryIndex)
+        {
+            recoveryBlocks[recoveryIndex] = outputBlocks[recoveryIndex];
+        }
+    }
+
+    for (int recoveryIndex = 0; recoveryIndex < N && !OriginalsEliminated && !PreserveRecovery; ++recoveryIndex, matrixRow += OriginalCount)
+    {
+        m_gf256Ctx.gf256_muladd_multi_mem(recoveryBlocks[recoveryIndex], matrixRow, inBlocks, OriginalCount, bytes);
+    }
 
     /*
         Eliminate lower left triangle.
     */
+    void* outBlocks[256];
+    const uint8_t* matrix_L = MatrixL;
+
     // For each column,
     for (int j = 0; j < N - 1; ++j)
     {
-        const void* block_j = Recovery[j]->Block;
+        const void* block_j = recoveryBlocks[j];
 
         // For each row,
         for (int i = j + 1; i < N; ++i)
         {
-            void* block_i = Recovery[i]->Block;
-            const uint8_t c_ij = *matrix_L++; // Matrix elements are stored column-first, top-down.
-
-            m_gf256Ctx.gf256_muladd_mem(block_i, c_ij, block_j, Params.BlockBytes);
+            outBlocks[i - (j + 1)] = recoveryBlocks[i];
         }
+
+        // Matrix elements are stored column-first, top-down.
+        const int count = N - (j + 1);
+        m_gf256Ctx.gf256_muladd_multi_dest_mem(outBlocks, matrix_L, block_j, count, bytes);
+        matrix_L += count;
     }
 
     /*
         Eliminate diagonal.
+
+        With outputs this pass moves the rows from the recovery blocks to the
+        outputs, the last pass then works in the outputs.
     */
     for (int i = 0; i < N; ++i)
     {
-        void* block = Recovery[i]->Block;
-
-        Recovery[i]->Index = ErasuresIndices[i];
-
-        m_gf256Ctx.gf256_div_mem(block, block, diag_D[i], Params.BlockBytes);
+        m_gf256Ctx.gf256_div_mem(outputBlocks[i], recoveryBlocks[i], DiagD[i], bytes);
     }
 
     /*
         Eliminate upper right triangle.
     */
+    const uint8_t* matrix_U = MatrixU;
+
     for (int j = N - 1; j >= 1; --j)
     {
-        const void* block_j = Recovery[j]->Block;
+        const void* block_j = outputBlocks[j];
 
         for (int i = j - 1; i >= 0; --i)
         {
-            void* block_i = Recovery[i]->Block;
-            const uint8_t c_ij = *matrix_U++; // Matrix elements are stored column-first, bottom-up.
+            outBlocks[(j - 1) - i] = outputBlocks[i];
+        }
+
+        // Matrix elements are stored column-first, bottom-up.
+        m_gf256Ctx.gf256_muladd_multi_dest_mem(outBlocks, matrix_U, block_j, j, bytes);
+        matrix_U += j;
+    }
+}
+
+void CM256::CM256Decoder::DecodeSmallRange(int offset, int bytes)
+{
+    const int N = RecoveryCount;
+    const int sourceCount = N + (OriginalsEliminated ? 0 : OriginalCount);
+
+    // Every row takes the recovery blocks then the originals
+    const void* inBlocks[256];
 
-            m_gf256Ctx.gf256_muladd_mem(block_i, c_ij, block_j, Params.BlockBytes);
+    for (int recoveryIndex = 0; recoveryIndex < N; ++recoveryIndex)
+    {
+        inBlocks[recoveryIndex] = static_cast<const uint8_t*>(Recovery[recoveryIndex]->Block) + offset;
+    }
+
+    for (int originalIndex = 0; originalIndex < sourceCount - N; ++originalIndex)
+    {
+        inBlocks[N + originalIndex] = static_cast<const uint8_t*>(Original[originalIndex]->Block) + offset;
+    }
+
+    if (Outputs)
+    {
+        // The outputs do not overlap the blocks
+        for (int i = 0; i < N; ++i)
+        {
+            uint8_t* output = static_cast<uint8_t*>(Outputs[ErasuresIndices[i]]) + offset;
+            m_gf256Ctx.gf256_mul_multi_mem(output, MatrixSmall + i * sourceCount, inBlocks, sourceCount, bytes);
         }
+
+        return;
     }
 
-    delete[] dynamicMatrix;
+    if (N == 1)
+    {
+        // The recovery block scaled in place is the first term of its row
+        uint8_t* recoveryBlock = static_cast<uint8_t*>(Recovery[0]->Block) + offset;
+        m_gf256Ctx.gf256_mul_mem(recoveryBlock, recoveryBlock, MatrixSmall[0], bytes);
+        m_gf256Ctx.gf256_muladd_multi_mem(recoveryBlock, MatrixSmall + 1, inBlocks + 1, sourceCount - 1, bytes);
+        return;
+    }
+
+    // Each row reads every recovery block the rows are written to, so the rows
+    // of a chunk are staged on the stack before they replace the recovery data.
+    GF256_ALIGNED uint8_t rows[CM256SmallErasures][CM256SmallChunkBytes];
+
+    for (int chunkOffset = 0; chunkOffset < bytes; chunkOffset += CM256SmallChunkBytes)
+    {
+        const int chunkBytes = bytes - chunkOffset < CM256SmallChunkBytes ? bytes - chunkOffset : CM256SmallChunkBytes;
+
+        for (int i = 0; i < N; ++i)
+        {
+            m_gf256Ctx.gf256_mul_multi_mem(rows[i], MatrixSmall + i * sourceCount, inBlocks, sourceCount, chunkBytes);
+        }
+
+        for (int i = 0; i < N; ++i)
+        {
+            memcpy(static_cast<uint8_t*>(Recovery[i]->Block) + offset + chunkOffset, rows[i], chunkBytes);
+        }
+
+        for (int j = 0; j < sourceCount; ++j)
+        {
+            inBlocks[j] = static_cast<const uint8_t*>(inBlocks[j]) + chunkBytes;
+        }
+    }
 }
 
 int CM256::cm256_decode(
     cm256_encoder_params params, // Encoder params
     cm256_block* blocks)         // Array of 'originalCount' blocks as described above
+{
+    return cm256_decode(params, blocks, nullptr, false);
+}
+
+int CM256::cm256_decode(
+    cm256_encoder_params params, // Encoder params
+    cm256_block* blocks,         // Array of 'originalCount' blocks as described above
+    void* const* outputs,        // Output block of each original index
+    bool preserveRecovery)       // Leave the recovery blocks untouched
 {
     if (params.OriginalCount <= 0 ||
         params.RecoveryCount <= 0 ||
-        params.BlockBytes <= 0)
+        params.BlockBytes <= 0 ||
+        !cm256_known_matrix(params.Matrix))
     {
         return -1;
     }
@@ -538,11 +1668,34 @@ int CM256::cm256_decode(
         return -3;
     }
 
+    return cm256_decode_blocks(params, blocks, outputs, preserveRecovery, m_decoderCache, m_threadPool);
+}
+
+int CM256::cm256_decode_blocks(
+    cm256_encoder_params params, // Encoder params
+    cm256_block* blocks,         // Array of 'originalCount' blocks as described above
+    void* const* outputs,        // Output block of each original index or nullptr
+    bool preserveRecovery,       // Leave the recovery blocks untouched
+    CM256DecoderCache* cache,    // Decoder cache or nullptr
+    CM256Pool* pool)             // Thread pool or nullptr
+{
     // If there is only one block,
     if (params.OriginalCount == 1)
     {
         // It is the same block repeated
-        blocks[0].Index = 0;
+        if (!outputs)
+        {
+            blocks[0].Index = 0;
+        }
+        else if (blocks[0].Index != 0)
+        {
+            if (!outputs[0]) {
+                return -3;
+            }
+
+            memcpy(outputs[0], blocks[0].Block, params.BlockBytes);
+        }
+
         return 0;
     }
 
@@ -558,14 +1711,1292 @@ int CM256::cm256_decode(
         return 0;
     }
 
-    // If m=1,
-    if (params.RecoveryCount == 1)
+    state.Outputs = outputs;
+    state.PreserveRecovery = outputs && preserveRecovery;
+
+    if (outputs && !state.HasOutputs())
     {
-        state.DecodeM1();
-        return 0;
+        return -3;
+    }
+
+    return state.Decode(cm256_get_tile_bytes(params), cache, pool) ? 0 : -5;
+}
+
+int CM256::cm256_decode(
+    cm256_encoder_params params, // Encoder params
+    void* blocks,                // First received block
+    int blockStride,             // Bytes from one block to the next
+    unsigned char* indices)      // Block index of each block
+{
+    if (params.OriginalCount <= 0 ||
+        params.OriginalCount > 256 ||
+        blockStride < params.BlockBytes)
+    {
+        return -1;
+    }
+    if (!blocks || !indices)
+    {
+        return -3;
+    }
+
+    cm256_block blockDescriptors[256];
+
+    for (int ii = 0; ii < params.OriginalCount; ++ii)
+    {
+        blockDescriptors[ii].Block = static_cast<uint8_t*>(blocks) + (size_t) ii * blockStride;
+        blockDescriptors[ii].Index = indices[ii];
+    }
+
+    const int result = cm256_decode(params, blockDescriptors);
+
+    for (int ii = 0; ii < params.OriginalCount && result == 0; ++ii)
+    {
+        indices[ii] = blockDescriptors[ii].Index;
+    }
+
+    return result;
+}
+
+
+//-----------------------------------------------------------------------------
+// Variable-length blocks
+
+// Largest block size whose lengths fit in the 2 coded bytes
+static const int CM256VariableMaxBlockBytes = 65535;
+
+// Span boundaries are kept on multiples of this, the ends of the originals in
+// between are handled one original at a time
+static const int CM256VariableSpanBytes = 256;
+
+// Order the originals by decreasing length, so that at any offset the
+// originals not yet in their zero tail come first
+static void cm256_sort_by_length(const int* lengths, int count, uint8_t* order)
+{
+    for (int j = 0; j < count; ++j)
+    {
+        int k = j;
+
+        for (; k > 0 && lengths[order[k - 1]] < lengths[j]; --k) {
+            order[k] = order[k - 1];
+        }
+
+        order[k] = static_cast<uint8_t>(j);
+    }
+}
+
+// Next span of the blocks from 'start': the first 'full' originals in 'order'
+// cover all of [start, end) and the next ones up to 'active' end inside it.
+// 'active' carries over from the previous span, K to begin with.
+static void cm256_next_span(const int* lengths, const uint8_t* order, int blockBytes, int start, int& active, int& full, int& end)
+{
+    while (active > 0 && lengths[order[active - 1]] <= start) {
+        active--;
+    }
+
+    if (active == 0)
+    {
+        full = 0;
+        end = blockBytes;
+        return;
+    }
+
+    // Up to the shortest active original all of them are there
+    const int shortest = lengths[order[active - 1]];
+    end = shortest - shortest % CM256VariableSpanBytes;
+    full = active;
+
+    if (end > start) {
+        return;
+    }
+
+    // Otherwise one span size with the originals ending inside it apart
+    end = start + CM256VariableSpanBytes < blockBytes ? start + CM256VariableSpanBytes : blockBytes;
+
+    while (full > 0 && lengths[order[full - 1]] < end) {
+        full--;
+    }
+}
+
+int CM256::cm256_encode_variable(
+    cm256_encoder_params params, // Encoder params
+    cm256_block* originals,      // Array of pointers to original blocks
+    const int* originalBytes,    // Length of each original block
+    void* recoveryBlocks)        // Output recovery blocks end-to-end
+{
+    CM256EncoderPlan plan;
+    const int result = cm256_init_encoder_plan(params, plan);
+
+    if (result != 0)
+    {
+        return result;
+    }
+
+    return cm256_encode_variable(plan, originals, originalBytes, recoveryBlocks);
+}
+
+int CM256::cm256_encode_variable(
+    const CM256EncoderPlan& plan, // Plan from cm256_init_encoder_plan()
+    cm256_block* originals,       // Array of pointers to original blocks
+    const int* originalBytes,     // Length of each original block
+    void* recoveryBlocks)         // Output recovery blocks end-to-end
+{
+    const cm256_encoder_params& params = plan.Params;
+
+    if (plan.TileBytes <= 0 || params.BlockBytes > CM256VariableMaxBlockBytes)
+    {
+        return -1;
+    }
+    if (!originals || !originalBytes || !recoveryBlocks)
+    {
+        return -3;
+    }
+
+    for (int j = 0; j < params.OriginalCount; ++j)
+    {
+        if (originalBytes[j] < 0 || originalBytes[j] > params.BlockBytes)
+        {
+            return -5;
+        }
+        if (originalBytes[j] > 0 && !originals[j].Block)
+        {
+            return -3;
+        }
+    }
+
+    const int K = params.OriginalCount;
+    const int R = params.RecoveryCount;
+    const int recoveryBytes = cm256_get_variable_recovery_bytes(params);
+    uint8_t order[256];
+    cm256_sort_by_length(originalBytes, K, order);
+
+    // Matrix rows in that order.  The first row, and all of them for a single
+    // original, are ones.
+    uint8_t matrix[128 * 128];
+
+    for (int j = 0; j < K; ++j)
+    {
+        matrix[j] = 1;
+
+        for (int block = 1; block < R; ++block)
+        {
+            matrix[block * K + j] = K == 1 ? 1 : plan.Matrix[(block - 1) * K + order[j]];
+        }
+    }
+
+    // Set 'bytes' bytes of each recovery block from 'offset' from the first 'count' sources
+    auto encodeRows = [&](const void* const* sources, int count, int offset, int bytes)
+    {
+        uint8_t* recoveryBlock = static_cast<uint8_t*>(recoveryBlocks) + offset;
+
+        for (int block = 0; block < R; ++block, recoveryBlock += recoveryBytes)
+        {
+            if (count == 0) {
+                memset(recoveryBlock, 0, bytes);
+            } else if (block == 0 || K == 1) {
+                gf256_ctx::gf256_addset_multi_mem(recoveryBlock, sources, count, bytes);
+            } else {
+                m_gf256Ctx.gf256_mul_multi_mem(recoveryBlock, matrix + block * K, sources, count, bytes);
+            }
+        }
+    };
+
+    const void* tileOriginals[256];
+    void* columnBlocks[256];
+    uint8_t matrixColumn[256];
+    int active = K, full, end;
+
+    // The originals already in their zero tail are left out
+    for (int start = 0; start < params.BlockBytes; start = end)
+    {
+        cm256_next_span(originalBytes, order, params.BlockBytes, start, active, full, end);
+
+        for (int tileOffset = start; tileOffset < end; tileOffset += plan.TileBytes)
+        {
+            for (int j = 0; j < full; ++j)
+            {
+                tileOriginals[j] = static_cast<const uint8_t*>(originals[order[j]].Block) + tileOffset;
+            }
+
+            encodeRows(tileOriginals, full, tileOffset, end - tileOffset < plan.TileBytes ? end - tileOffset : plan.TileBytes);
+        }
+
+        // Originals ending inside the span are added to all the recovery blocks
+        for (int j = full; j < active; ++j)
+        {
+            for (int block = 0; block < R; ++block)
+            {
+                columnBlocks[block] = static_cast<uint8_t*>(recoveryBlocks) + block * recoveryBytes + start;
+                matrixColumn[block] = matrix[block * K + j];
+            }
+
+            m_gf256Ctx.gf256_muladd_multi_dest_mem(columnBlocks, matrixColumn,
+                    static_cast<const uint8_t*>(originals[order[j]].Block) + start, R, originalBytes[order[j]] - start);
+        }
+    }
+
+    // Coded lengths, little-endian
+    uint8_t lengths[256][2];
+
+    for (int j = 0; j < K; ++j)
+    {
+        lengths[j][0] = static_cast<uint8_t>(originalBytes[order[j]]);
+        lengths[j][1] = static_cast<uint8_t>(originalBytes[order[j]] >> 8);
+        tileOriginals[j] = lengths[j];
+    }
+
+    encodeRows(tileOriginals, K, params.BlockBytes, recoveryBytes - params.BlockBytes);
+
+    return 0;
+}
+
+int CM256::cm256_decode_variable(
+    cm256_encoder_params params, // Encoder params
+    cm256_block* blocks,         // Array of 'originalCount' blocks
+    int* blockBytes)             // Length of each original, set for the recovered ones
+{
+    if (params.OriginalCount <= 0 ||
+        params.RecoveryCount <= 0 ||
+        params.BlockBytes <= 0 ||
+        params.BlockBytes > CM256VariableMaxBlockBytes ||
+        !cm256_known_matrix(params.Matrix))
+    {
+        return -1;
+    }
+    if (params.OriginalCount + params.RecoveryCount > 256)
+    {
+        return -2;
+    }
+    if (!blocks || !blockBytes)
+    {
+        return -3;
+    }
+
+    const int recoveryBytes = cm256_get_variable_recovery_bytes(params);
+    bool recovered[256];
+
+    for (int ii = 0; ii < params.OriginalCount; ++ii)
+    {
+        recovered[ii] = blocks[ii].Index >= params.OriginalCount;
+
+        if (!recovered[ii] && (blockBytes[ii] < 0 || blockBytes[ii] > params.BlockBytes))
+        {
+            return -5;
+        }
+    }
+
+    // If there is only one block, it is the same block repeated
+    if (params.OriginalCount == 1)
+    {
+        blocks[0].Index = 0;
+    }
+    else
+    {
+        // The recovery blocks are solved over the data and the coded lengths
+        cm256_encoder_params codedParams = params;
+        codedParams.BlockBytes = recoveryBytes;
+
+        CM256Decoder state(m_gf256Ctx);
+
+        if (!state.Initialize(codedParams, blocks))
+        {
+            return -5;
+        }
+
+        // If nothing is erased,
+        if (state.RecoveryCount <= 0)
+        {
+            return 0;
+        }
+
+        // Received originals by decreasing length
+        const int K = state.OriginalCount;
+        const int N = state.RecoveryCount;
+        int lengths[256];
+        uint8_t order[256];
+
+        for (int j = 0; j < K; ++j)
+        {
+            lengths[j] = blockBytes[state.Original[j] - blocks];
+        }
+
+        cm256_sort_by_length(lengths, K, order);
+
+        // Original elimination rows in that order
+        uint8_t matrix[128 * 128];
+
+        for (int j = 0; j < K; ++j)
+        {
+            for (int i = 0; i < N; ++i)
+            {
+                matrix[i * K + j] = state.Matrix.Element(m_gf256Ctx, state.Recovery[i]->Index, state.Original[order[j]]->Index);
+            }
+        }
+
+        // Eliminate the received originals from the recovery blocks, skipping
+        // their zero tails, a tile of the originals at a time
+        const int tileBytes = cm256_get_tile_bytes(params);
+        const void* tileOriginals[256];
+        void* columnBlocks[256];
+        uint8_t matrixColumn[256];
+        int active = K, full, end;
+
+        for (int start = 0; start < params.BlockBytes && active > 0; start = end)
+        {
+            cm256_next_span(lengths, order, params.BlockBytes, start, active, full, end);
+
+            for (int tileOffset = start; tileOffset < end && full > 0; tileOffset += tileBytes)
+            {
+                const int bytes = end - tileOffset < tileBytes ? end - tileOffset : tileBytes;
+
+                for (int j = 0; j < full; ++j)
+                {
+                    tileOriginals[j] = static_cast<const uint8_t*>(state.Original[order[j]]->Block) + tileOffset;
+                }
+
+                for (int i = 0; i < N; ++i)
+                {
+                    m_gf256Ctx.gf256_muladd_multi_mem(static_cast<uint8_t*>(state.Recovery[i]->Block) + tileOffset,
+                            matrix + i * K, tileOriginals, full, bytes);
+                }
+            }
+
+            // Originals ending inside the span
+            for (int j = full; j < active; ++j)
+            {
+                for (int i = 0; i < N; ++i)
+                {
+                    columnBlocks[i] = static_cast<uint8_t*>(state.Recovery[i]->Block) + start;
+                    matrixColumn[i] = matrix[i * K + j];
+                }
+
+                m_gf256Ctx.gf256_muladd_multi_dest_mem(columnBlocks, matrixColumn,
+                        static_cast<const uint8_t*>(state.Original[order[j]]->Block) + start, N, lengths[order[j]] - start);
+            }
+        }
+
+        // Coded lengths, little-endian
+        uint8_t codedLengths[256][2];
+
+        for (int j = 0; j < K; ++j)
+        {
+            codedLengths[j][0] = static_cast<uint8_t>(lengths[order[j]]);
+            codedLengths[j][1] = static_cast<uint8_t>(lengths[order[j]] >> 8);
+            tileOriginals[j] = codedLengths[j];
+        }
+
+        for (int i = 0; i < N && K > 0; ++i)
+        {
+            m_gf256Ctx.gf256_muladd_multi_mem(static_cast<uint8_t*>(state.Recovery[i]->Block) + params.BlockBytes,
+                    matrix + i * K, tileOriginals, K, recoveryBytes - params.BlockBytes);
+        }
+
+        state.OriginalsEliminated = true;
+
+        if (!state.Decode(cm256_get_tile_bytes(codedParams), m_decoderCache, m_threadPool))
+        {
+            return -5;
+        }
+    }
+
+    // Recovered lengths
+    for (int ii = 0; ii < params.OriginalCount; ++ii)
+    {
+        if (recovered[ii])
+        {
+            const uint8_t* length = static_cast<const uint8_t*>(blocks[ii].Block) + params.BlockBytes;
+            blockBytes[ii] = length[0] | (length[1] << 8);
+
+            if (blockBytes[ii] > params.BlockBytes)
+            {
+                return -5;
+            }
+        }
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Batches
+
+// Most frames of a batch encoded interleaved, bounds the pointer arrays
+static const int CM256BatchMaxInterleave = 8;
+// Entries of the decoder cache of a batch when the codec has none
+static const int CM256BatchCacheEntries = 8;
+
+// Description of a batch split across the threads by groups of frames
+struct CM256BatchJob
+{
+    CM256* cm256;
+    const CM256::CM256EncoderPlan* plan;
+    const CM256::cm256_encode_job* jobs;
+    CM256::cm256_encoder_params params = {};
+    CM256::cm256_block* const* frames;
+    CM256::CM256DecoderCache* cache;
+    int* results;
+    int frameCount;
+    int framesPerTask;
+};
+
+// Number of pool tasks for a batch of 'frameCount' frames of 'work' each
+static int cm256_batch_task_count(CM256Pool* pool, long long work, int frameCount)
+{
+    if (!pool || frameCount <= 1 || work >= CM256ParallelMinWork) {
+        return 1;
+    }
+
+    long long taskCount = work * frameCount / CM256ParallelMinWork;
+
+    if (taskCount > pool->getThreadCount() + 1) {
+        taskCount = pool->getThreadCount() + 1;
+    }
+
+    return taskCount > 1 ? (int) taskCount : 1;
+}
+
+int CM256::cm256_encode_batch(
+    cm256_encoder_params params,  // Encoder parameters
+    const cm256_encode_job* jobs, // Array of frames
+    int jobCount)                 // Number of frames
+{
+    CM256EncoderPlan plan;
+    const int result = cm256_init_encoder_plan(params, plan);
+
+    if (result != 0)
+    {
+        return result;
+    }
+
+    return cm256_encode_batch(plan, jobs, jobCount);
+}
+
+int CM256::cm256_encode_batch(
+    const CM256EncoderPlan& plan,  // Plan from cm256_init_encoder_plan()
+    const cm256_encode_job* jobs,  // Array of frames
+    int jobCount)                  // Number of frames
+{
+    if (plan.TileBytes <= 0 || jobCount < 0)
+    {
+        return -1;
+    }
+    if (!jobs && jobCount > 0)
+    {
+        return -3;
+    }
+
+    for (int i = 0; i < jobCount; ++i)
+    {
+        if (!jobs[i].Originals || !jobs[i].RecoveryBlocks)
+        {
+            return -3;
+        }
+    }
+
+    const cm256_encoder_params& params = plan.Params;
+    const long long work = (long long) params.OriginalCount * params.RecoveryCount * params.BlockBytes;
+    const int taskCount = cm256_batch_task_count(m_threadPool, work, jobCount);
+
+    if (work >= CM256ParallelMinWork)
+    {
+        // Large frames are split across the threads one at a time
+        const void* originalBlocks[256];
+
+        for (int i = 0; i < jobCount; ++i)
+        {
+            for (int j = 0; j < params.OriginalCount; ++j)
+            {
+                originalBlocks[j] = jobs[i].Originals[j].Block;
+            }
+
+            cm256_encode_blocks(plan, originalBlocks, jobs[i].RecoveryBlocks, params.BlockBytes, params.BlockBytes);
+        }
+    }
+    else if (taskCount > 1)
+    {
+        CM256BatchJob job;
+        job.cm256 = this;
+        job.plan = &plan;
+        job.jobs = jobs;
+        job.frameCount = jobCount;
+        job.framesPerTask = (jobCount + taskCount - 1) / taskCount;
+        m_threadPool->run(cm256_encode_batch_task, &job, (jobCount + job.framesPerTask - 1) / job.framesPerTask);
+    }
+    else
+    {
+        cm256_encode_frames(plan, jobs, jobCount);
+    }
+
+    return 0;
+}
+
+void CM256::cm256_encode_batch_task(void* arg, int index)
+{
+    const CM256BatchJob& job = *static_cast<const CM256BatchJob*>(arg);
+    const int firstFrame = index * job.framesPerTask;
+    const int frameCount = job.frameCount - firstFrame < job.framesPerTask ? job.frameCount - firstFrame : job.framesPerTask;
+
+    job.cm256->cm256_encode_frames(*job.plan, job.jobs + firstFrame, frameCount);
+}
+
+void CM256::cm256_encode_frames(
+    const CM256EncoderPlan& plan,     // Encoder plan
+    const cm256_encode_job* jobs,     // Array of frames
+    int jobCount)                     // Number of frames
+{
+    const cm256_encoder_params& params = plan.Params;
+    const int tileBytes = plan.TileBytes < params.BlockBytes ? plan.TileBytes : params.BlockBytes;
+
+    // Frames whose tiles of originals fit in cache together are encoded one
+    // recovery row of each in turn, so the multiplication tables of a row
+    // are loaded once for the group
+    int groupCount = CM256TileCacheBytes / (params.OriginalCount * tileBytes);
+
+    if (groupCount > CM256BatchMaxInterleave) {
+        groupCount = CM256BatchMaxInterleave;
+    } else if (groupCount < 1) {
+        groupCount = 1;
+    }
+
+    const void* tileOriginals[CM256BatchMaxInterleave][256];
+
+    for (int first = 0; first < jobCount; first += groupCount)
+    {
+        const int frameCount = jobCount - first < groupCount ? jobCount - first : groupCount;
+        const cm256_encode_job* group = jobs + first;
+
+        for (int tileOffset = 0; tileOffset < params.BlockBytes; tileOffset += tileBytes)
+        {
+            const int bytes = params.BlockBytes - tileOffset < tileBytes ? params.BlockBytes - tileOffset : tileBytes;
+
+            for (int i = 0; i < frameCount; ++i)
+            {
+                for (int j = 0; j < params.OriginalCount; ++j)
+                {
+                    tileOriginals[i][j] = static_cast<const uint8_t*>(group[i].Originals[j].Block) + tileOffset;
+                }
+            }
+
+            for (int block = 0; block < params.RecoveryCount; ++block)
+            {
+                // The first block has no stored matrix row
+                const uint8_t* matrixRow = block > 0 ? plan.Matrix + (block - 1) * params.OriginalCount : nullptr;
+
+                for (int i = 0; i < frameCount; ++i)
+                {
+                    uint8_t* recoveryBlock = static_cast<uint8_t*>(group[i].RecoveryBlocks) + block * params.BlockBytes + tileOffset;
+                    cm256_encode_block(params, tileOriginals[i], matrixRow, (params.OriginalCount + block), recoveryBlock, bytes);
+                }
+            }
+        }
+    }
+}
+
+int CM256::cm256_decode_batch(
+    cm256_encoder_params params,  // Encoder parameters
+    cm256_block* const* frames,   // Array of frames of 'originalCount' blocks
+    int frameCount)               // Number of frames
+{
+    if (params.OriginalCount <= 0 ||
+        params.RecoveryCount <= 0 ||
+        params.BlockBytes <= 0 ||
+        frameCount < 0 ||
+        !cm256_known_matrix(params.Matrix))
+    {
+        return -1;
+    }
+    if (params.OriginalCount + params.RecoveryCount > 256)
+    {
+        return -2;
+    }
+    if (!frames && frameCount > 0)
+    {
+        return -3;
+    }
+
+    // Loss patterns repeat across the frames of a batch, keep their matrices
+    // for the batch when the codec does not keep them for longer
+    CM256DecoderCache* batchCache = nullptr;
+
+    if (!m_decoderCache && params.RecoveryCount > 1 && frameCount > 1) {
+        batchCache = new CM256DecoderCache(CM256BatchCacheEntries);
+    }
+
+    CM256DecoderCache* cache = m_decoderCache ? m_decoderCache : batchCache;
+    const long long work = (long long) params.OriginalCount * params.RecoveryCount * params.BlockBytes;
+    const int taskCount = cm256_batch_task_count(m_threadPool, work, frameCount);
+    int result = 0;
+
+    if (taskCount > 1)
+    {
+        std::vector<int> results(frameCount, 0);
+        CM256BatchJob job;
+        job.cm256 = this;
+        job.params = params;
+        job.frames = frames;
+        job.cache = cache;
+        job.results = results.data();
+        job.frameCount = frameCount;
+        job.framesPerTask = (frameCount + taskCount - 1) / taskCount;
+        m_threadPool->run(cm256_decode_batch_task, &job, (frameCount + job.framesPerTask - 1) / job.framesPerTask);
+
+        for (int i = 0; i < frameCount && result == 0; ++i) {
+            result = results[i];
+        }
+    }
+    else
+    {
+        for (int i = 0; i < frameCount; ++i)
+        {
+            const int frameResult = frames[i] ? cm256_decode_blocks(params, frames[i], nullptr, false, cache, m_threadPool) : -3;
+
+            if (result == 0) {
+                result = frameResult;
+            }
+        }
+    }
+
+    delete batchCache;
+    return result;
+}
+
+void CM256::cm256_decode_batch_task(void* arg, int index)
+{
+    const CM256BatchJob& job = *static_cast<const CM256BatchJob*>(arg);
+    const int firstFrame = index * job.framesPerTask;
+    const int lastFrame = job.frameCount - firstFrame < job.framesPerTask ? job.frameCount : firstFrame + job.framesPerTask;
+
+    for (int i = firstFrame; i < lastFrame; ++i)
+    {
+        // The frames are small, each is decoded on a single thread
+        job.results[i] = job.frames[i] ? job.cm256->cm256_decode_blocks(job.params, job.frames[i], nullptr, false, job.cache, nullptr) : -3;
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Bit-matrix mode
+
+// Number of bits set in a word
+static inline int cm256_popcount(uint64_t x)
+{
+#if defined(__GNUC__)
+    return __builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<int>((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// Index of the lowest bit set in a non-zero word
+static inline int cm256_lowest_bit(uint64_t x)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(x);
+#else
+    return cm256_popcount((x & (0 - x)) - 1);
+#endif
+}
+
+/*
+    XOR schedule of a bit-matrix
+
+    Greedy schedule in the manner of Jerasure's smart schedules: the next
+    output packet computed is the cheapest one, either summed from the input
+    packets of its row or derived from an output packet already computed
+    plus the inputs where their rows differ.
+*/
+class CM256::CM256BitMatrixPlan::Schedule
+{
+public:
+    // Schedule the expansion of the 'rows' x 'columns' GF(256) 'matrix', or
+    // just sum each row from the inputs if not 'smart'
+    void Build(gf256_ctx& gf256Ctx, const uint8_t* matrix, int rows, int columns, bool smart);
+
+    // Compute the output packets from the input packets, 'bytes' bytes of each
+    void Run(const uint8_t* const* inputs, uint8_t* const* outputs, int bytes) const;
+
+    // Number of input and output packets
+    int InputCount;
+    int OutputCount;
+
+    // Output packet of each step and its sources from SourceStart[step] to
+    // SourceStart[step + 1]: input packets, then output packets from InputCount
+    std::vector<uint16_t> Order;
+    std::vector<int> SourceStart;
+    std::vector<uint16_t> Sources;
+    int MaxSources;
+
+    int XorCount;
+    int DenseXorCount;
+};
+
+void CM256::CM256BitMatrixPlan::Schedule::Build(gf256_ctx& gf256Ctx, const uint8_t* matrix, int rows, int columns, bool smart)
+{
+    InputCount = 8 * columns;
+    OutputCount = 8 * rows;
+
+    // Bit i of coefficient * 2^j says whether input bit j goes into output
+    // bit i, the 8 bits of a row for a coefficient make one byte of the row
+    const int words = (InputCount + 63) / 64;
+    std::vector<uint64_t> bits((size_t) OutputCount * words, 0);
+
+    for (int row = 0; row < rows; ++row)
+    {
+        for (int column = 0; column < columns; ++column)
+        {
+            const uint8_t coefficient = matrix[row * columns + column];
+            uint8_t rowBytes[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+            for (int j = 0; j < 8; ++j)
+            {
+                const uint8_t product = gf256Ctx.gf256_mul(coefficient, static_cast<uint8_t>(1 << j));
+
+                for (int i = 0; i < 8; ++i) {
+                    rowBytes[i] |= ((product >> i) & 1) << j;
+                }
+            }
+
+            for (int i = 0; i < 8; ++i) {
+                bits[(size_t) (8 * row + i) * words + column / 8] |= (uint64_t) rowBytes[i] << (8 * (column % 8));
+            }
+        }
+    }
+
+    // Cost of each output packet in sources, and the output it derives from
+    std::vector<int> cost(OutputCount);
+    std::vector<int> from(OutputCount, -1);
+    std::vector<uint8_t> done(OutputCount, 0);
+
+    DenseXorCount = 0;
+
+    for (int output = 0; output < OutputCount; ++output)
+    {
+        const uint64_t* row = bits.data() + (size_t) output * words;
+        cost[output] = 0;
+
+        for (int w = 0; w < words; ++w) {
+            cost[output] += cm256_popcount(row[w]);
+        }
+
+        DenseXorCount += cost[output] - 1;
+    }
+
+    Order.clear();
+    SourceStart.clear();
+    Sources.clear();
+    XorCount = 0;
+    MaxSources = 0;
+
+    for (int step = 0; step < OutputCount; ++step)
+    {
+        int best = smart ? -1 : step;
+
+        for (int output = 0; output < OutputCount && smart; ++output)
+        {
+            if (!done[output] && (best < 0 || cost[output] < cost[best])) {
+                best = output;
+            }
+        }
+
+        const uint64_t* row = bits.data() + (size_t) best * words;
+        const uint64_t* base = from[best] >= 0 ? bits.data() + (size_t) from[best] * words : nullptr;
+
+        Order.push_back(static_cast<uint16_t>(best));
+        SourceStart.push_back(static_cast<int>(Sources.size()));
+
+        if (base) {
+            Sources.push_back(static_cast<uint16_t>(InputCount + from[best]));
+        }
+
+        for (int w = 0; w < words; ++w)
+        {
+            uint64_t word = base ? row[w] ^ base[w] : row[w];
+
+            while (word)
+            {
+                Sources.push_back(static_cast<uint16_t>(64 * w + cm256_lowest_bit(word)));
+                word &= word - 1;
+            }
+        }
+
+        const int count = static_cast<int>(Sources.size()) - SourceStart.back();
+        XorCount += count - 1;
+        MaxSources = count > MaxSources ? count : MaxSources;
+        done[best] = 1;
+
+        // Outputs closer to this one than to their current source derive from it
+        for (int output = 0; output < OutputCount && smart; ++output)
+        {
+            if (done[output]) {
+                continue;
+            }
+
+            const uint64_t* other = bits.data() + (size_t) output * words;
+            int distance = 1;
+
+            for (int w = 0; w < words && distance < cost[output]; ++w) {
+                distance += cm256_popcount(other[w] ^ row[w]);
+            }
+
+            if (distance < cost[output])
+            {
+                cost[output] = distance;
+                from[output] = best;
+            }
+        }
+    }
+
+    SourceStart.push_back(static_cast<int>(Sources.size()));
+}
+
+void CM256::CM256BitMatrixPlan::Schedule::Run(const uint8_t* const* inputs, uint8_t* const* outputs, int bytes) const
+{
+    std::vector<const void*> sources(MaxSources);
+
+    for (int step = 0; step < OutputCount; ++step)
+    {
+        const int first = SourceStart[step];
+        const int count = SourceStart[step + 1] - first;
+
+        for (int k = 0; k < count; ++k)
+        {
+            const int source = Sources[first + k];
+            sources[k] = source < InputCount ? inputs[source] : outputs[source - InputCount];
+        }
+
+        gf256_ctx::gf256_addset_multi_mem(outputs[Order[step]], sources.data(), count, bytes);
+    }
+}
+
+CM256::CM256BitMatrixPlan::CM256BitMatrixPlan() :
+    TileBytes(0),
+    XorCount(0),
+    DenseXorCount(0),
+    m_schedule(new Schedule())
+{
+    Params.BlockBytes = 0;
+    Params.OriginalCount = 0;
+    Params.RecoveryCount = 0;
+    Params.Matrix = MatrixDefault;
+}
+
+CM256::CM256BitMatrixPlan::~CM256BitMatrixPlan()
+{
+    delete m_schedule;
+}
+
+// Smallest block size the decoder schedules its XORs for
+static const int CM256BitMatrixSmartDecodeBytes = 8192;
+
+// Bytes of each packet processed at a time, for the tile size of whole blocks
+static int cm256_bitmatrix_tile_bytes(int blockTileBytes, int packetBytes)
+{
+    const int tileBytes = ((blockTileBytes / 8) + 63) & ~63;
+    return tileBytes < packetBytes ? tileBytes : packetBytes;
+}
+
+int CM256::cm256_init_bitmatrix_plan(
+    cm256_encoder_params params, // Encoder parameters
+    CM256BitMatrixPlan& plan)    // Plan to initialize
+{
+    // Validate input:
+    if (params.OriginalCount <= 0 ||
+        params.RecoveryCount <= 0 ||
+        params.BlockBytes <= 0 ||
+        (params.BlockBytes % 8) != 0)
+    {
+        return -1;
+    }
+    if (params.OriginalCount + params.RecoveryCount > 256)
+    {
+        return -2;
+    }
+
+    CM256Matrix cauchy;
+    if (!cauchy.Initialize(params))
+    {
+        return -1;
+    }
+
+    // The first row is all ones, as in the GF(256) layout.
+    std::vector<uint8_t> matrix((size_t) params.RecoveryCount * params.OriginalCount, 1);
+
+    for (int block = 1; block < params.RecoveryCount; ++block)
+    {
+        for (int j = 0; j < params.OriginalCount; ++j) {
+            matrix[block * params.OriginalCount + j] = cauchy.Element(m_gf256Ctx, params.OriginalCount + block, j);
+        }
+    }
+
+    plan.m_schedule->Build(m_gf256Ctx, matrix.data(), params.RecoveryCount, params.OriginalCount, true);
+    plan.Params = params;
+    plan.TileBytes = cm256_bitmatrix_tile_bytes(cm256_get_tile_bytes(params), params.BlockBytes / 8);
+    plan.XorCount = plan.m_schedule->XorCount;
+    plan.DenseXorCount = plan.m_schedule->DenseXorCount;
+
+    return 0;
+}
+
+void CM256::cm256_bitmatrix_run(
+    const CM256BitMatrixPlan::Schedule& schedule, // Schedule to run
+    const uint8_t* const* inputs,                 // Input blocks
+    uint8_t* outputs,                             // First output block
+    int outputStride,                             // Bytes from one output block to the next
+    int packetBytes,                              // Bytes of each packet
+    int tileBytes)                                // Bytes of each packet processed at a time
+{
+    std::vector<const uint8_t*> inputPackets(schedule.InputCount);
+    std::vector<uint8_t*> outputPackets(schedule.OutputCount);
+
+    for (int offset = 0; offset < packetBytes; offset += tileBytes)
+    {
+        const int bytes = packetBytes - offset < tileBytes ? packetBytes - offset : tileBytes;
+
+        for (int packet = 0; packet < schedule.InputCount; ++packet) {
+            inputPackets[packet] = inputs[packet / 8] + (packet % 8) * packetBytes + offset;
+        }
+
+        for (int packet = 0; packet < schedule.OutputCount; ++packet) {
+            outputPackets[packet] = outputs + (size_t) (packet / 8) * outputStride + (packet % 8) * packetBytes + offset;
+        }
+
+        schedule.Run(inputPackets.data(), outputPackets.data(), bytes);
+    }
+}
+
+int CM256::cm256_encode_bitmatrix(
+    const CM256BitMatrixPlan& plan, // Plan from cm256_init_bitmatrix_plan()
+    cm256_block* originals,         // Array of pointers to original blocks
+    void* recoveryBlocks)           // Output recovery blocks end-to-end
+{
+    const cm256_encoder_params& params = plan.Params;
+
+    if (plan.TileBytes <= 0)
+    {
+        return -1;
+    }
+    if (!originals || !recoveryBlocks)
+    {
+        return -3;
+    }
+
+    uint8_t* recovery = static_cast<uint8_t*>(recoveryBlocks);
+
+    // If only one block of input data,
+    if (params.OriginalCount == 1)
+    {
+        // No meaningful operation here, degenerate to outputting the same data each time.
+        for (int block = 0; block < params.RecoveryCount; ++block) {
+            memcpy(recovery + block * params.BlockBytes, originals[0].Block, params.BlockBytes);
+        }
+
+        return 0;
+    }
+
+    std::vector<const uint8_t*> inputs(params.OriginalCount);
+
+    for (int j = 0; j < params.OriginalCount; ++j) {
+        inputs[j] = static_cast<const uint8_t*>(originals[j].Block);
+    }
+
+    cm256_bitmatrix_run(*plan.m_schedule, inputs.data(), recovery, params.BlockBytes, params.BlockBytes / 8, plan.TileBytes);
+    return 0;
+}
+
+int CM256::cm256_encode_bitmatrix(
+    cm256_encoder_params params, // Encoder parameters
+    cm256_block* originals,      // Array of pointers to original blocks
+    void* recoveryBlocks)        // Output recovery blocks end-to-end
+{
+    CM256BitMatrixPlan plan;
+    const int result = cm256_init_bitmatrix_plan(params, plan);
+
+    if (result != 0)
+    {
+        return result;
+    }
+
+    return cm256_encode_bitmatrix(plan, originals, recoveryBlocks);
+}
+
+int CM256::cm256_decode_bitmatrix(
+    cm256_encoder_params params, // Encoder parameters
+    cm256_block* blocks)         // Array of 'originalCount' blocks as described above
+{
+    if (params.OriginalCount <= 0 ||
+        params.RecoveryCount <= 0 ||
+        params.BlockBytes <= 0 ||
+        (params.BlockBytes % 8) != 0 ||
+        !cm256_known_matrix(params.Matrix))
+    {
+        return -1;
+    }
+    if (params.OriginalCount + params.RecoveryCount > 256)
+    {
+        return -2;
+    }
+    if (!blocks)
+    {
+        return -3;
+    }
+
+    // If there is only one block,
+    if (params.OriginalCount == 1)
+    {
+        // It is the same block repeated
+        blocks[0].Index = 0;
+        return 0;
+    }
+
+    CM256Decoder state(m_gf256Ctx);
+    if (!state.Initialize(params, blocks))
+    {
+        return -5;
+    }
+
+    // If nothing is erased,
+    const int N = state.RecoveryCount;
+    if (N <= 0)
+    {
+        return 0;
+    }
+
+    /*
+        With E the erased originals, O the received ones and R the recovery
+        blocks received, R = C_E * E + C_O * O so E = C_E^-1 * R + C_E^-1 * C_O * O.
+        Invert C_E by Gauss-Jordan elimination next to the identity.
+    */
+    const int K = params.OriginalCount;
+
+    // Decoding matrix over the recovery blocks then the received originals
+    std::vector<uint8_t> matrix((size_t) N * K);
+
+    if (!state.GenerateDecodingMatrix(matrix.data()))
+    {
+        return -5;
+    }
+
+    // The schedule is worked out for each decode, which only pays when the
+    // XORs it saves are long enough
+    CM256BitMatrixPlan::Schedule schedule;
+    schedule.Build(m_gf256Ctx, matrix.data(), N, K, params.BlockBytes >= CM256BitMatrixSmartDecodeBytes);
+
+    std::vector<const uint8_t*> inputs(K);
+
+    for (int i = 0; i < N; ++i) {
+        inputs[i] = static_cast<const uint8_t*>(state.Recovery[i]->Block);
+    }
+
+    for (int j = 0; j < state.OriginalCount; ++j) {
+        inputs[N + j] = static_cast<const uint8_t*>(state.Original[j]->Block);
+    }
+
+    // The recovery blocks are inputs until the end, the erased originals are
+    // decoded aside and copied over them
+    std::vector<uint8_t> outputs((size_t) N * params.BlockBytes);
+    const int packetBytes = params.BlockBytes / 8;
+
+    cm256_bitmatrix_run(schedule, inputs.data(), outputs.data(), params.BlockBytes, packetBytes,
+            cm256_bitmatrix_tile_bytes(cm256_get_tile_bytes(params), packetBytes));
+
+    for (int i = 0; i < N; ++i)
+    {
+        memcpy(state.Recovery[i]->Block, outputs.data() + (size_t) i * params.BlockBytes, params.BlockBytes);
+        state.Recovery[i]->Index = state.ErasuresIndices[i];
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Streaming decoder
+
+CM256::CM256StreamDecoder::CM256StreamDecoder(CM256& cm256) :
+    m_cm256(cm256),
+    m_originalCount(0),
+    m_recoveryCount(0),
+    m_begun(false)
+{
+    m_params.BlockBytes = 0;
+    m_params.OriginalCount = 0;
+    m_params.RecoveryCount = 0;
+    m_params.Matrix = MatrixDefault;
+}
+
+int CM256::CM256StreamDecoder::begin_frame(cm256_encoder_params params)
+{
+    m_begun = false;
+
+    if (params.OriginalCount <= 0 ||
+        params.RecoveryCount <= 0 ||
+        params.BlockBytes <= 0)
+    {
+        return -1;
+    }
+    if (params.OriginalCount + params.RecoveryCount > 256)
+    {
+        return -2;
+    }
+    if (!m_matrix.Initialize(params))
+    {
+        return -1;
+    }
+
+    m_params = params;
+    m_originalCount = 0;
+    m_recoveryCount = 0;
+    memset(m_received, 0, sizeof(m_received));
+    m_begun = true;
+
+    return 0;
+}
+
+int CM256::CM256StreamDecoder::add_block(cm256_block* block)
+{
+    if (!m_begun)
+    {
+        return -4;
+    }
+    if (!block || !block->Block)
+    {
+        return -3;
+    }
+
+    // Blocks beyond the ones needed are ignored
+    if (is_complete())
+    {
+        return 1;
+    }
+
+    const int row = block->Index;
+
+    if (row >= m_params.OriginalCount + m_params.RecoveryCount || m_received[row])
+    {
+        return -5;
+    }
+
+    m_received[row] = 1;
+
+    gf256_ctx& gf256Ctx = m_cm256.m_gf256Ctx;
+    uint8_t matrixColumn[256];
+
+    if (row < m_params.OriginalCount)
+    {
+        // Eliminate the original from the recovery blocks received so far
+        if (m_recoveryCount > 0)
+        {
+            void* recoveryBlocks[256];
+
+            for (int i = 0; i < m_recoveryCount; ++i)
+            {
+                recoveryBlocks[i] = m_recovery[i]->Block;
+                matrixColumn[i] = m_matrix.Element(gf256Ctx, m_recovery[i]->Index, row);
+            }
+
+            gf256Ctx.gf256_muladd_multi_dest_mem(recoveryBlocks, matrixColumn, block->Block, m_recoveryCount, m_params.BlockBytes);
+        }
+
+        m_originals[m_originalCount++] = block;
+    }
+    else
+    {
+        // Eliminate the originals received so far from the recovery block
+        if (m_originalCount > 0 && m_params.OriginalCount > 1)
+        {
+            const void* originalBlocks[256];
+
+            for (int j = 0; j < m_originalCount; ++j)
+            {
+                originalBlocks[j] = m_originals[j]->Block;
+                matrixColumn[j] = m_matrix.Element(gf256Ctx, row, m_originals[j]->Index);
+            }
+
+            gf256Ctx.gf256_muladd_multi_mem(block->Block, matrixColumn, originalBlocks, m_originalCount, m_params.BlockBytes);
+        }
+
+        m_recovery[m_recoveryCount++] = block;
+    }
+
+    return is_complete() ? 1 : 0;
+}
+
+int CM256::CM256StreamDecoder::finish()
+{
+    return finish(nullptr);
+}
+
+int CM256::CM256StreamDecoder::finish(void* const* outputs)
+{
+    if (!m_begun || !is_complete())
+    {
+        return -4;
+    }
+
+    // If there is only one block, it is the same block repeated
+    if (m_params.OriginalCount == 1)
+    {
+        if (!outputs)
+        {
+            (m_originalCount ? m_originals[0] : m_recovery[0])->Index = 0;
+        }
+        else if (m_recoveryCount)
+        {
+            if (!outputs[0]) {
+                return -3;
+            }
+
+            memcpy(outputs[0], m_recovery[0]->Block, m_params.BlockBytes);
+        }
+
+        m_begun = false;
+        return 0;
+    }
+
+    m_begun = false;
+
+    // If nothing is erased,
+    if (m_recoveryCount == 0)
+    {
+        return 0;
+    }
+
+    // Originals first then recovery blocks, as they were eliminated
+    cm256_block* blocks[256];
+
+    for (int j = 0; j < m_originalCount; ++j)
+    {
+        blocks[j] = m_originals[j];
+    }
+
+    for (int i = 0; i < m_recoveryCount; ++i)
+    {
+        blocks[m_originalCount + i] = m_recovery[i];
+    }
+
+    CM256Decoder state(m_cm256.m_gf256Ctx);
+
+    if (!state.Initialize(m_params, blocks))
+    {
+        return -5;
+    }
+
+    state.OriginalsEliminated = true;
+    state.Outputs = outputs;
+
+    if (outputs && !state.HasOutputs())
+    {
+        m_begun = true;
+        return -3;
+    }
+
+    if (!state.Decode(m_cm256.cm256_get_tile_bytes(m_params), m_cm256.m_decoderCache, m_cm256.m_threadPool))
+    {
+        return -5;
     }
 
-    // Decode for m>1
-    state.Decode();
     return 0;
 }
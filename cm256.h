@@ -34,12 +34,23 @@
 
 #include <assert.h>
 #include "gf256.h"
+#include "cm256pool.h"
 #include "export.h"
 
 class CM256CC_API CM256
 {
 public:
+    // Recovery matrix of a code, see CM256Matrix.  Both ends must use the same.
+    // Any int is a valid value so that unknown ones can be checked and rejected.
+    enum MatrixType : int
+    {
+        MatrixDefault = 0, // Cauchy matrix of incrementing parameters
+        MatrixOptimized    // Parameters from cm256_matrix_search, cheaper in the bit-matrix mode
+    };
+
     // Encoder parameters
+    // Zero-initialize them, for example with 'cm256_encoder_params params = {};',
+    // so that the fields not set keep their default: 0 is MatrixDefault.
     typedef struct cm256_encoder_params_t {
         // Original block count < 256
         int OriginalCount;
@@ -49,6 +60,9 @@ public:
 
         // Number of bytes per block (all blocks are the same size in bytes)
         int BlockBytes;
+
+        // Recovery matrix, 0 for MatrixDefault
+        MatrixType Matrix;
     } cm256_encoder_params;
 
     // Descriptor for data block
@@ -66,11 +80,99 @@ public:
         // Ignored during encoding, required during decoding.
     } cm256_block;
 
+    // Contiguous part of a block
+    typedef struct cm256_segment_t {
+        // Pointer to the data of the segment
+        const void* Data;
+
+        // Number of bytes of the segment
+        int Bytes;
+    } cm256_segment;
+
+    // Descriptor for an original block made of several segments, for example
+    // a header and a payload held in different buffers.  The segments follow
+    // each other in the block and their sizes add up to BlockBytes.
+    typedef struct cm256_segmented_block_t {
+        // Array of the segments of the block
+        const cm256_segment* Segments;
+
+        // Number of segments in the array
+        int SegmentCount;
+    } cm256_segmented_block;
+
+    // One frame of a batch encode
+    typedef struct cm256_encode_job_t {
+        // Array of 'originalCount' original blocks
+        cm256_block* Originals;
+
+        // Output recovery blocks end-to-end
+        void* RecoveryBlocks;
+    } cm256_encode_job;
+
     CM256();
     ~CM256();
 
+    CM256(const CM256&) = delete;
+    CM256& operator=(const CM256&) = delete;
+
     bool isInitialized() const { return m_initialized; };
 
+    /*
+     * Encoder and decoder tiling
+     *
+     * The encoder splits the blocks into column tiles of 'tileBytes' bytes and
+     * computes all the recovery rows of a tile before moving to the next one,
+     * so that each original is read from memory once rather than once per
+     * recovery block.  The decoder likewise runs all its elimination phases on
+     * a tile before moving to the next one.  The output does not depend on
+     * the tile size.
+     *
+     * 0 (the default) selects the tile size from the encoder parameters so that
+     * a tile of all the originals stays in the L2 cache.  Other values are
+     * rounded up to a multiple of 64 bytes.  A value of at least BlockBytes
+     * encodes one full recovery block at a time.
+     */
+    void setTileBytes(int tileBytes) { m_tileBytes = tileBytes < 0 ? 0 : tileBytes; }
+    int getTileBytes() const { return m_tileBytes; }
+
+    // Tile size actually used to encode or decode with these parameters
+    int cm256_get_tile_bytes(cm256_encoder_params params) const;
+
+    /*
+     * Decoder cache
+     *
+     * The decoder matrices only depend on which original and recovery blocks
+     * were received, so when the same loss pattern repeats from frame to frame
+     * they can be reused instead of computed again.  The cache keeps the
+     * matrices of the 'entries' most recently used patterns and is shared by
+     * the threads decoding with this object.
+     *
+     * 0 (the default) disables the cache.  Changing the size clears it and
+     * its counters.
+     */
+    void setDecoderCacheSize(int entries);
+    int getDecoderCacheSize() const;
+
+    // Number of decodes that found or did not find their matrices in the cache
+    void getDecoderCacheStats(unsigned long long& hits, unsigned long long& misses) const;
+
+    /*
+     * Worker threads
+     *
+     * With a pool, frames large enough to benefit are encoded by its threads
+     * together with the calling thread: large blocks are split into byte
+     * ranges and smaller ones into groups of recovery blocks.  Decoding splits
+     * large blocks into byte ranges.  Smaller frames are processed by the
+     * calling thread alone.  The output is the same.
+     *
+     * setThreadCount() starts a pool owned by this object, 0 stops it.  See
+     * CM256Pool for 'firstCpu'.  setThreadPool() uses a pool owned by the
+     * caller, which may be shared with other objects, nullptr to stop using it.
+     */
+    void setThreadCount(int threadCount, int firstCpu = -1);
+    void setThreadPool(CM256Pool* pool);
+    CM256Pool* getThreadPool() const { return m_threadPool; }
+
     /*
      * Cauchy MDS GF(256) encode
      *
@@ -88,7 +190,8 @@ public:
      *
      * When transmitting the data, the block index of the data should be sent,
      * and the recovery block index is also needed.  The decoder should also
-     * be provided with the values of originalCount, recoveryCount and blockBytes.
+     * be provided with the values of originalCount, recoveryCount and blockBytes,
+     * and with the same matrix type if it is not the default.
      *
      * Example wire format:
      * [originalCount(1 byte)] [recoveryCount(1 byte)]
@@ -96,10 +199,8 @@ public:
      *
      * Be careful not to mix blocks from different encoders.
      *
-     * It is possible to support variable-length data by including the original
-     * data length at the front of each message in 2 bytes, such that when it is
-     * recovered after a loss the data length is available in the block data and
-     * the remaining bytes of padding can be neglected.
+     * For variable-length data see cm256_encode_variable(), which encodes the
+     * data lengths along with the data without padding the originals.
      *
      * Returns 0 on success, and any other code indicates failure.
      */
@@ -108,6 +209,148 @@ public:
         cm256_block* originals,      // Array of pointers to original blocks
         void* recoveryBlocks);       // Output recovery blocks end-to-end
 
+    /*
+     * Recovery matrix
+     *
+     * Cauchy parameters of the recovery matrix of a code, by block index: the
+     * element of recovery block r for original j is
+     *
+     *     Scale[r] * (Parameter[OriginalCount] + Parameter[j]) / (Parameter[r] + Parameter[j])
+     *
+     * which is 1 for the first recovery block, the XOR of the originals.
+     *
+     * MatrixDefault uses the block indices as parameters and no scales.  With
+     * MatrixOptimized the parameters and scales come from a table computed
+     * offline by cm256_matrix_search so that the bit matrices of the elements
+     * have fewer ones, which is fewer XORs for cm256_encode_bitmatrix().  A
+     * code that is not in the table takes the first parameters of the
+     * smallest one that contains it, and codes larger than all of them keep
+     * the default parameters.  The GF(256) kernels spend the same on every
+     * element other than 0 and 1, and an MDS matrix cannot have more than one
+     * 1 in a row besides the first, so cm256_encode() runs at the same speed
+     * with both.
+     */
+    class CM256CC_API CM256Matrix
+    {
+    public:
+        // Parameters of params.Matrix.  Returns false for an unknown matrix type.
+        bool Initialize(cm256_encoder_params params);
+
+        // Element of recovery block 'recoveryIndex' for original 'originalIndex'
+        uint8_t Element(gf256_ctx& gf256Ctx, int recoveryIndex, int originalIndex) const
+        {
+            const uint8_t element = gf256Ctx.getMatrixElement(Parameter[recoveryIndex], Parameter[OriginalCount], Parameter[originalIndex]);
+            return Scaled ? gf256Ctx.gf256_mul(element, Scale[recoveryIndex]) : element;
+        }
+
+        // Original count of the code
+        int OriginalCount;
+
+        // Some scale is not 1
+        bool Scaled;
+
+        // x_i of the recovery blocks and y_j of the originals
+        uint8_t Parameter[256];
+
+        // Scale of each recovery block
+        uint8_t Scale[256];
+    };
+
+    /*
+     * Encoder plan
+     *
+     * Holds what the encoder works out from its parameters: the Cauchy matrix
+     * coefficients and the tile size.  When the same parameters are used for
+     * every frame, build it once with cm256_init_encoder_plan() and encode with
+     * it so that each frame goes straight to the block computations.
+     */
+    class CM256CC_API CM256EncoderPlan
+    {
+    public:
+        CM256EncoderPlan();
+
+        // Encoder parameters
+        cm256_encoder_params Params;
+
+        // Column tile size, 0 until the plan is initialized
+        int TileBytes;
+
+        // Matrix rows of the recovery blocks after the first one (which is all
+        // ones), OriginalCount elements each.  OriginalCount + RecoveryCount <= 256
+        // so this is less than 128 x 128.
+        uint8_t Matrix[128 * 128];
+    };
+
+    /*
+     * Initialize an encoder plan for these parameters, with the tile size
+     * currently set on this object.
+     *
+     * Returns 0 on success, and any other code indicates failure with the same
+     * codes as cm256_encode().
+     */
+    int cm256_init_encoder_plan(
+        cm256_encoder_params params, // Encoder parameters
+        CM256EncoderPlan& plan);     // Plan to initialize
+
+    /*
+     * Cauchy MDS GF(256) encode with a plan
+     *
+     * Same as cm256_encode() with the parameters the plan was initialized with.
+     *
+     * Returns 0 on success, and any other code indicates failure.
+     */
+    int cm256_encode(
+        const CM256EncoderPlan& plan, // Plan from cm256_init_encoder_plan()
+        cm256_block* originals,       // Array of pointers to original blocks
+        void* recoveryBlocks);        // Output recovery blocks end-to-end
+
+    /*
+     * Cauchy MDS GF(256) encode of blocks at a fixed stride
+     *
+     * Same as cm256_encode() for originals and recovery blocks laid out every
+     * 'originalStride' and 'recoveryStride' bytes from 'originals' and
+     * 'recoveryBlocks', for example the payloads of an array of packets with
+     * a header, so that no block descriptors need to be set up and the
+     * recovery blocks can be written straight into the outgoing packets.
+     * The strides must be at least BlockBytes.
+     *
+     * Returns 0 on success, and any other code indicates failure.
+     */
+    int cm256_encode(
+        cm256_encoder_params params, // Encoder parameters
+        const void* originals,       // First original block
+        int originalStride,          // Bytes from one original block to the next
+        void* recoveryBlocks,        // First output recovery block
+        int recoveryStride);         // Bytes from one recovery block to the next
+
+    int cm256_encode(
+        const CM256EncoderPlan& plan, // Plan from cm256_init_encoder_plan()
+        const void* originals,        // First original block
+        int originalStride,           // Bytes from one original block to the next
+        void* recoveryBlocks,         // First output recovery block
+        int recoveryStride);          // Bytes from one recovery block to the next
+
+    /*
+     * Cauchy MDS GF(256) encode of segmented blocks
+     *
+     * Same as cm256_encode() for originals made of segments, read where they
+     * are instead of being copied into contiguous blocks first.  The blocks
+     * are encoded in spans over which no original crosses a segment boundary,
+     * so segments aligned across the originals keep the spans long.
+     *
+     * Returns 0 on success, -5 if the segments of an original do not add up
+     * to BlockBytes, and any other code indicates failure as for cm256_encode().
+     */
+    int cm256_encode(
+        cm256_encoder_params params,            // Encoder parameters
+        const cm256_segmented_block* originals, // Array of original blocks
+        void* recoveryBlocks);                  // Output recovery blocks end-to-end
+
+    int cm256_encode(
+        const CM256EncoderPlan& plan,           // Plan from cm256_init_encoder_plan()
+        const cm256_segmented_block* originals, // Array of original blocks
+        void* recoveryBlocks);                  // Output recovery blocks end-to-end
+
     /*
      * Cauchy MDS GF(256) decode
      *
@@ -124,12 +367,311 @@ public:
      * Recovery blocks will be replaced with original data and the Index
      * will be updated to indicate the original block that was recovered.
      *
+     * A single erasure recovered with the first recovery block is the XOR of
+     * the blocks received, and up to 4 erasures are solved with a direct
+     * inverse so that each one costs about one recovery row of the encoder.
+     *
      * Returns 0 on success, and any other code indicates failure.
      */
     int cm256_decode(
         cm256_encoder_params params, // Encoder parameters
         cm256_block* blocks);        // Array of 'originalCount' blocks as described above
 
+    /*
+     * Cauchy MDS GF(256) decode into the caller's buffers
+     *
+     * Same as cm256_decode() except that each erased original is written to
+     * outputs[original index] instead of the recovery block that recovered it,
+     * so the data needs no copy into place afterwards.  The final pass of the
+     * decoder writes the outputs directly.  Only the outputs of the erased
+     * originals are written, and they must not overlap the blocks.  The block
+     * Index members are not changed.
+     *
+     * The recovery blocks are used as scratch space, unless 'preserveRecovery'
+     * is true in which case they are left untouched and the decoder works in
+     * the outputs from its first pass.  A null 'outputs' decodes in place like
+     * cm256_decode().
+     *
+     * Returns 0 on success, -3 if an output needed is null, and any other code
+     * indicates failure as for cm256_decode().
+     */
+    int cm256_decode(
+        cm256_encoder_params params,   // Encoder parameters
+        cm256_block* blocks,           // Array of 'originalCount' blocks as described above
+        void* const* outputs,          // Output block of each original index
+        bool preserveRecovery = false); // Leave the recovery blocks untouched
+
+    /*
+     * Cauchy MDS GF(256) decode of blocks at a fixed stride
+     *
+     * Same as cm256_decode() for 'originalCount' received blocks laid out
+     * every 'blockStride' bytes from 'blocks', with the block index of each
+     * one in 'indices'.  The recovery blocks are replaced with original data
+     * and their entry in 'indices' updated.  The stride must be at least
+     * BlockBytes.
+     *
+     * Returns 0 on success, and any other code indicates failure.
+     */
+    int cm256_decode(
+        cm256_encoder_params params, // Encoder parameters
+        void* blocks,                // First received block
+        int blockStride,             // Bytes from one block to the next
+        unsigned char* indices);     // Block index of each block
+
+    /*
+     * Cauchy MDS GF(256) encode of variable-length blocks
+     *
+     * Each original has its own length of at most BlockBytes, and is encoded
+     * as if it were padded with zeros up to BlockBytes without the padding
+     * being read or written: the zero tails are skipped by the encoder.  The
+     * lengths are encoded too, in 2 more bytes at the end of each recovery
+     * block, so BlockBytes is at most 65535 and the recovery blocks are
+     * cm256_get_variable_recovery_bytes() bytes long.  Only the lengths need
+     * to be sent with the originals, not their padding.
+     *
+     * Returns 0 on success, -5 if a length is out of range, and any other code
+     * indicates failure as for cm256_encode().
+     */
+    int cm256_encode_variable(
+        cm256_encoder_params params, // Encoder parameters
+        cm256_block* originals,      // Array of pointers to original blocks
+        const int* originalBytes,    // Length of each original block
+        void* recoveryBlocks);       // Output recovery blocks end-to-end
+
+    int cm256_encode_variable(
+        const CM256EncoderPlan& plan, // Plan from cm256_init_encoder_plan()
+        cm256_block* originals,       // Array of pointers to original blocks
+        const int* originalBytes,     // Length of each original block
+        void* recoveryBlocks);        // Output recovery blocks end-to-end
+
+    /*
+     * Cauchy MDS GF(256) decode of variable-length blocks
+     *
+     * Same as cm256_decode() for blocks from cm256_encode_variable().
+     * 'blockBytes' holds the length of each original received, only that many
+     * bytes of it are read.  The recovery blocks, of
+     * cm256_get_variable_recovery_bytes() bytes, are replaced with original
+     * data zero-padded to BlockBytes and their length is set in 'blockBytes'.
+     *
+     * Returns 0 on success, -5 for invalid block indices or lengths, and any
+     * other code indicates failure as for cm256_decode().
+     */
+    int cm256_decode_variable(
+        cm256_encoder_params params, // Encoder parameters
+        cm256_block* blocks,         // Array of 'originalCount' blocks
+        int* blockBytes);            // Length of each original, set for the recovered ones
+
+    /*
+     * Batches of frames
+     *
+     * Encode or decode several independent frames with the same parameters
+     * in one call, for example one frame per channel or a backlog of frames.
+     * The parameters are checked and the coefficients set up once for the
+     * batch.  Frames whose originals fit in cache together are encoded
+     * interleaved, one recovery row of each frame in turn, and the decoder
+     * matrices of a loss pattern are reused within the batch even without a
+     * decoder cache.  With a thread pool, frames too small to be split are
+     * spread across the threads.
+     *
+     * The encoder returns 0 on success, and any other code indicates failure
+     * as for cm256_encode() before any frame is encoded.  The decoder decodes
+     * every frame it can and returns 0 if all were decoded, otherwise the
+     * code from cm256_decode() for the first frame that failed.
+     */
+    int cm256_encode_batch(
+        const CM256EncoderPlan& plan,  // Plan from cm256_init_encoder_plan()
+        const cm256_encode_job* jobs,  // Array of frames
+        int jobCount);                 // Number of frames
+
+    int cm256_encode_batch(
+        cm256_encoder_params params,   // Encoder parameters
+        const cm256_encode_job* jobs,  // Array of frames
+        int jobCount);                 // Number of frames
+
+    int cm256_decode_batch(
+        cm256_encoder_params params,   // Encoder parameters
+        cm256_block* const* frames,    // Array of frames of 'originalCount' blocks
+        int frameCount);               // Number of frames
+
+    /*
+     * XOR-only bit-matrix mode
+     *
+     * Each block is cut into 8 packets of BlockBytes / 8 bytes, packet b
+     * holding bit b of the field elements, so that multiplying by a matrix
+     * coefficient is XORing packets as given by its 8 x 8 bit-matrix.  The
+     * Cauchy matrix expands to an 8 * RecoveryCount x 8 * OriginalCount
+     * bit-matrix computed with the wide XOR kernels alone, which suits CPUs
+     * whose byte shuffles are slow or missing.  The XORs are scheduled once
+     * per plan so that an output packet close to one already computed is
+     * derived from it rather than summed from the originals.
+     *
+     * The recovery blocks differ from those of cm256_encode() and can only be
+     * decoded by cm256_decode_bitmatrix().  BlockBytes must be a multiple of 8.
+     */
+    class CM256CC_API CM256BitMatrixPlan
+    {
+    public:
+        CM256BitMatrixPlan();
+        ~CM256BitMatrixPlan();
+
+        CM256BitMatrixPlan(const CM256BitMatrixPlan&) = delete;
+        CM256BitMatrixPlan& operator=(const CM256BitMatrixPlan&) = delete;
+
+        // Encoder parameters
+        cm256_encoder_params Params;
+
+        // Bytes of each packet processed at a time, 0 until the plan is initialized
+        int TileBytes;
+
+        // Packet XORs of the schedule, and of the bit-matrix rows summed one by one
+        int XorCount;
+        int DenseXorCount;
+
+    private:
+        friend class CM256;
+        class Schedule;
+        Schedule* m_schedule;
+    };
+
+    /*
+     * Initialize a bit-matrix plan for these parameters, with the tile size
+     * currently set on this object.
+     *
+     * Returns 0 on success, -1 also if BlockBytes is not a multiple of 8, and
+     * any other code indicates failure as for cm256_encode().
+     */
+    int cm256_init_bitmatrix_plan(
+        cm256_encoder_params params, // Encoder parameters
+        CM256BitMatrixPlan& plan);   // Plan to initialize
+
+    /*
+     * Cauchy MDS GF(256) encode with XORs only
+     *
+     * Same as cm256_encode() in the bit-matrix layout.
+     *
+     * Returns 0 on success, and any other code indicates failure.
+     */
+    int cm256_encode_bitmatrix(
+        const CM256BitMatrixPlan& plan, // Plan from cm256_init_bitmatrix_plan()
+        cm256_block* originals,         // Array of pointers to original blocks
+        void* recoveryBlocks);          // Output recovery blocks end-to-end
+
+    int cm256_encode_bitmatrix(
+        cm256_encoder_params params,    // Encoder parameters
+        cm256_block* originals,         // Array of pointers to original blocks
+        void* recoveryBlocks);          // Output recovery blocks end-to-end
+
+    /*
+     * Cauchy MDS GF(256) decode with XORs only
+     *
+     * Same as cm256_decode() for blocks from cm256_encode_bitmatrix().  The
+     * decoding matrix of the loss pattern is inverted in GF(256), expanded
+     * and scheduled at each call.
+     *
+     * Returns 0 on success, and any other code indicates failure.
+     */
+    int cm256_decode_bitmatrix(
+        cm256_encoder_params params, // Encoder parameters
+        cm256_block* blocks);        // Array of 'originalCount' blocks as described above
+
+    /*
+     * Streaming encoder
+     *
+     * Computes the recovery blocks of a frame while its originals are
+     * produced: add_original() multiplies each original into all the recovery
+     * blocks while it is still in cache, and the recovery blocks are complete
+     * as soon as the last original is added.
+     *
+     * Call begin_frame() with a plan from cm256_init_encoder_plan() and the
+     * output recovery blocks end-to-end as for cm256_encode(), then
+     * add_original() once for each original in any order.  The plan and the
+     * recovery blocks must stay valid until the last original is added, the
+     * originals only during the add_original() call.
+     */
+    class CM256CC_API CM256StreamEncoder
+    {
+    public:
+        CM256StreamEncoder(CM256& cm256);
+
+        // Start a frame, any frame in progress is dropped.
+        // Returns 0 on success, and any other code indicates failure.
+        int begin_frame(const CM256EncoderPlan& plan, void* recoveryBlocks);
+
+        // Same with the recovery blocks every 'recoveryStride' bytes, at least
+        // BlockBytes, from 'recoveryBlocks'
+        int begin_frame(const CM256EncoderPlan& plan, void* recoveryBlocks, int recoveryStride);
+
+        // Add original 'index' of the frame.  Returns 0 when more originals are
+        // needed, 1 when the recovery blocks are complete, -3 for a null block,
+        // -4 if no frame was begun and -5 for an invalid or repeated index.
+        int add_original(int index, const void* originalBlock);
+
+        bool is_complete() const { return m_plan && m_addedCount == m_plan->Params.OriginalCount; }
+
+    private:
+        CM256& m_cm256;
+        const CM256EncoderPlan* m_plan;
+        uint8_t* m_recoveryBlocks;
+        int m_recoveryStride;
+        int m_addedCount;
+        uint8_t m_added[256];
+    };
+
+    /*
+     * Streaming decoder
+     *
+     * Decodes a frame as its blocks arrive instead of all at once: each
+     * original is eliminated from the recovery blocks already received, and
+     * each recovery block from the originals already received, so that only
+     * the final solve is left to finish().
+     *
+     * Call begin_frame() then add_block() for each block received until it
+     * returns 1, and then finish().  As with cm256_decode() the recovery
+     * blocks are modified in place and finish() replaces them with the
+     * original data and updates their Index.  The blocks, and the data they
+     * point to, must stay valid until finish() returns.
+     *
+     * The tile size, decoder cache and threads of the CM256 object are used.
+     */
+    class CM256CC_API CM256StreamDecoder
+    {
+    public:
+        CM256StreamDecoder(CM256& cm256);
+
+        // Start a frame, any frame in progress is dropped.
+        // Returns 0 on success, and any other code indicates failure.
+        int begin_frame(cm256_encoder_params params);
+
+        // Add a received block.  Returns 0 when more blocks are needed, 1 when
+        // finish() can be called (blocks added after that are ignored), -3 for
+        // a null block, -4 if no frame was begun and -5 for an invalid or
+        // repeated block index.
+        int add_block(cm256_block* block);
+
+        // Recover the erased originals.
+        // Returns 0 on success, -4 if the frame does not have enough blocks.
+        int finish();
+
+        // Recover the erased originals into outputs[original index], see the
+        // cm256_decode() with outputs, nullptr for finish().  Returns 0 on
+        // success, -3 if an output needed is null, -4 if the frame does not
+        // have enough blocks.
+        int finish(void* const* outputs);
+
+        bool is_complete() const { return m_originalCount + m_recoveryCount >= m_params.OriginalCount; }
+
+    private:
+        CM256& m_cm256;
+        cm256_encoder_params m_params;
+        CM256Matrix m_matrix;
+        cm256_block* m_originals[256];
+        int m_originalCount;
+        cm256_block* m_recovery[256];
+        int m_recoveryCount;
+        uint8_t m_received[256];
+        bool m_begun;
+    };
+
     /*
      * Commodity functions
      */
@@ -147,7 +689,15 @@ public:
         return (unsigned char)(originalBlockIndex);
     }
 
+    // Size of the recovery blocks of cm256_encode_variable(): the data and the coded length
+    static inline int cm256_get_variable_recovery_bytes(cm256_encoder_params params)
+    {
+        return params.BlockBytes + 2;
+    }
+
 private:
+    class CM256DecoderCache;
+
     class CM256CC_API CM256Decoder
     {
     public:
@@ -168,32 +718,149 @@ private:
         // Row indices that were erased
         uint8_t ErasuresIndices[256];
 
+        // Recovery matrix of Params
+        CM256Matrix Matrix;
+
+        // Original elimination matrix and LDU decomposition, valid during Decode()
+        const uint8_t* MatrixOriginals;
+        const uint8_t* MatrixL;
+        const uint8_t* DiagD;
+        const uint8_t* MatrixU;
+
+        // Decoding matrix of a few erasures, valid during Decode(), or nullptr:
+        // one row per erasure over the recovery blocks then the originals
+        const uint8_t* MatrixSmall;
+
         // Initialize the decoder
         bool Initialize(cm256_encoder_params& params, cm256_block* blocks);
+        bool Initialize(cm256_encoder_params& params, cm256_block* const* blocks);
+
+        // The original data was already eliminated from the recovery blocks
+        bool OriginalsEliminated;
+
+        // Output of each original index, nullptr to recover in the recovery blocks
+        void* const* Outputs;
+
+        // With Outputs, do not modify the recovery blocks
+        bool PreserveRecovery;
+
+        // The outputs of the erased originals are not null
+        bool HasOutputs() const;
 
-        // Decode m=1 case
-        void DecodeM1();
+        // The only erasure is recovered with the first recovery block (all ones)
+        bool FirstRecoveryOnly() const;
 
-        // Decode for m>1 case
-        void Decode();
+        // Decode 'bytes' bytes from 'offset' of a single erasure recovered
+        // with the first recovery block
+        void DecodeM1(int offset, int bytes);
+
+        // Decode 'tileBytes' bytes of all the blocks at a time
+        // The matrices are looked up in and added to 'cache' if not null
+        // Large blocks are split into byte ranges decoded on 'pool' if not null
+        // Returns false, with the blocks untouched, if the rows received are singular
+        bool Decode(int tileBytes, CM256DecoderCache* cache, CM256Pool* pool);
+
+        // Decode 'bytes' bytes from 'offset' of the blocks, 'tileBytes' bytes at a time
+        void DecodeTiles(int offset, int bytes, int tileBytes);
+
+        // CM256Pool task decoding one byte range
+        static void DecodeTask(void* arg, int index);
+
+        // Run all the elimination phases on 'bytes' bytes of the blocks from 'offset'
+        // Note: the matrices must have been set up by Decode()
+        void DecodeRange(int offset, int bytes);
+
+        // Decode 'bytes' bytes from 'offset' of the blocks with MatrixSmall
+        void DecodeSmallRange(int offset, int bytes);
 
         // Generate the LU decomposition of the matrix
         void GenerateLDUDecomposition(uint8_t* matrix_L, uint8_t* diag_D, uint8_t* matrix_U);
 
+        // Generate the decoding matrix: the inverse of the rows of the erasures
+        // fused with the original elimination, one row per erasure over the
+        // recovery blocks then the originals
+        // Returns false if the rows of the erasures are singular
+        bool GenerateDecodingMatrix(uint8_t* matrix);
+
     private:
         gf256_ctx& m_gf256Ctx;
     };
 
-    // Encode one block.
+    // Encode 'bytes' bytes of the blocks with the plan, splitting the work
+    // across the threads if worth it
+    // Note: This function does not validate input, use with care.
+    void cm256_encode_blocks(
+        const CM256EncoderPlan& plan,     // Encoder plan
+        const void* const* originals,     // Array of pointers to original blocks
+        void* recoveryBlocks,             // First output recovery block
+        int recoveryStride,               // Bytes from one recovery block to the next
+        int bytes);                       // Number of bytes from the pointers
+
+    // Encode 'bytes' bytes from 'offset' of 'blockCount' recovery blocks from 'firstBlock'
+    // Note: This function does not validate input, use with care.
+    void cm256_encode_range(
+        const CM256EncoderPlan& plan,     // Encoder plan
+        const void* const* originals,     // Array of pointers to original blocks
+        void* recoveryBlocks,             // First output recovery block
+        int recoveryStride,               // Bytes from one recovery block to the next
+        int offset,                       // Start of the range in the blocks
+        int bytes,                        // Number of bytes of the range
+        int firstBlock,                   // First recovery block
+        int blockCount);                  // Number of recovery blocks
+
+    // Encode 'jobCount' frames on the calling thread, interleaved by groups
+    // Note: This function does not validate input, use with care.
+    void cm256_encode_frames(
+        const CM256EncoderPlan& plan,     // Encoder plan
+        const cm256_encode_job* jobs,     // Array of frames
+        int jobCount);                    // Number of frames
+
+    // CM256Pool task encoding a group of frames of a batch
+    static void cm256_encode_batch_task(void* arg, int index);
+
+    // Decode one frame with the decoder cache and threads given
+    int cm256_decode_blocks(
+        cm256_encoder_params params,      // Encoder parameters
+        cm256_block* blocks,              // Array of 'originalCount' blocks
+        void* const* outputs,             // Output block of each original index or nullptr
+        bool preserveRecovery,            // Leave the recovery blocks untouched
+        CM256DecoderCache* cache,         // Decoder cache or nullptr
+        CM256Pool* pool);                 // Thread pool or nullptr
+
+    // CM256Pool task decoding a group of frames of a batch
+    static void cm256_decode_batch_task(void* arg, int index);
+
+    // CM256Pool task encoding one part of a frame
+    static void cm256_encode_task(void* arg, int index);
+
+    // Run a bit-matrix schedule over whole blocks, one tile of each packet at a time
+    static void cm256_bitmatrix_run(
+        const CM256BitMatrixPlan::Schedule& schedule, // Schedule to run
+        const uint8_t* const* inputs,                 // Input blocks
+        uint8_t* outputs,                             // First output block
+        int outputStride,                             // Bytes from one output block to the next
+        int packetBytes,                              // Bytes of each packet
+        int tileBytes);                               // Bytes of each packet processed at a time
+
+    friend struct CM256DecodeJob;
+    friend struct CM256BatchJob;
+
+    // Encode 'bytes' bytes of one block.
     // Note: This function does not validate input, use with care.
     void cm256_encode_block(
-        cm256_encoder_params params, // Encoder parameters
-        cm256_block* originals,      // Array of pointers to original blocks
-        int recoveryBlockIndex,      // Return value from cm256_get_recovery_block_index()
-        void* recoveryBlock);        // Output recovery block
+        cm256_encoder_params params,      // Encoder parameters
+        const void* const* originals,     // Original data at the same offset as recoveryBlock
+        const uint8_t* matrixRow,         // Matrix row of the block, unused for the first one
+        int recoveryBlockIndex,           // Return value from cm256_get_recovery_block_index()
+        void* recoveryBlock,              // Output recovery block
+        int bytes);                       // Number of bytes to encode
 
     gf256_ctx m_gf256Ctx;
     bool m_initialized;
+    int m_tileBytes;
+    CM256DecoderCache* m_decoderCache;
+    CM256Pool* m_threadPool;
+    CM256Pool* m_ownedThreadPool;
 };
 
 
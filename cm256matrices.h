@@ -0,0 +1,505 @@
+// Generated by cm256_matrix_search, do not edit.
+//
+// Cauchy parameters of CM256::MatrixOptimized by original and recovery
+// count: x_i of each recovery row, y_j of each original, then the scale
+// s_i of each recovery row.  The comments give the ones of the bit matrices
+// of the default and of the optimized matrix.
+
+#ifndef CM256MATRICES_H
+#define CM256MATRICES_H
+
+static const uint8_t CM256MatrixParameters[] = {
+    2,14,177,213,1,106, // 2+2: 77 -> 35
+    2,157,166,0,1,1,116,83, // 2+3: 128 -> 54
+    2,231,110,32,0,238,1,213,55,8, // 2+4: 175 -> 76
+    2,212,4,119,157,0,199,1,106,2,157,119, // 2+5: 256 -> 98
+    2,109,166,116,157,94,0,1,1,36,83,58,116,94, // 2+6: 308 -> 123
+    2,92,109,166,94,157,116,0,1,1,23,36,83,94,116,58, // 2+7: 362 -> 148
+    2,92,166,94,119,116,157,109,0,1,1,23,83,94,233,58,116,36, // 2+8: 415 -> 174
+    232,4,85,53,144,1,56, // 3+2: 108 -> 54
+    3,128,187,43,20,249,1,61,9, // 3+3: 199 -> 98
+    3,51,247,25,0,242,36,1,70,150,170, // 3+4: 265 -> 139
+    3,176,239,72,121,0,179,98,1,171,158,112,77, // 3+5: 370 -> 197
+    3,33,5,60,245,196,0,156,15,1,26,3,87,83,135, // 3+6: 448 -> 241
+    3,190,211,159,253,0,146,199,6,2,1,227,120,157,78,2,109, // 3+7: 535 -> 288
+    3,177,236,235,249,70,113,222,80,1,35,1,83,208,118,124,88,69,243, // 3+8: 625 -> 341
+    4,5,164,96,205,88,1,55, // 4+2: 157 -> 76
+    4,107,14,155,113,183,6,1,109,12, // 4+3: 279 -> 142
+    4,185,214,205,55,1,182,250,1,227,59,120, // 4+4: 410 -> 215
+    4,86,25,187,44,47,194,106,3,1,57,79,107,204, // 4+5: 539 -> 266
+    4,112,255,115,91,229,117,1,2,3,1,222,36,26,9,25, // 4+6: 643 -> 379
+    4,244,87,125,210,227,221,64,92,225,3,1,207,14,236,43,80,213, // 4+7: 764 -> 443
+    4,78,69,7,150,8,96,207,238,58,2,186,1,101,125,155,119,3,255,64, // 4+8: 882 -> 515
+    5,6,80,17,215,32,231,1,48, // 5+2: 182 -> 98
+    5,149,7,114,185,1,237,4,1,127,3, // 5+3: 344 -> 172
+    5,64,7,238,221,112,191,216,10,1,56,203,192, // 5+4: 481 -> 253
+    5,121,54,141,150,72,18,43,3,4,1,129,19,113,233, // 5+5: 644 -> 394
+    5,175,118,254,164,224,0,126,115,3,71,1,70,78,176,164,128, // 5+6: 800 -> 480
+    5,60,230,12,134,196,225,0,11,2,3,4,1,185,226,2,65,197,53, // 5+7: 965 -> 576
+    199,0,38,218,133,105,164,93,190,1,2,3,234,1,164,238,145,197,189,82,55, // 5+8: 1070 -> 644
+    6,7,161,115,106,151,154,5,1,197, // 6+2: 234 -> 124
+    6,209,8,121,44,1,0,4,23,1,79,6, // 6+3: 424 -> 244
+    6,162,163,164,4,132,72,161,160,5,1,2,3,10, // 6+4: 588 -> 343
+    6,177,148,10,4,0,236,115,184,98,5,1,145,145,161,98, // 6+5: 781 -> 435
+    6,31,24,227,219,38,191,249,94,125,194,52,1,172,87,247,135,230, // 6+6: 967 -> 598
+    6,13,151,137,115,70,7,0,107,114,251,135,5,1,48,33,51,233,170,198, // 6+7: 1144 -> 734
+    6,128,234,143,68,69,56,42,0,67,130,13,185,5,1,59,137,248,246,59,99,222, // 6+8: 1345 -> 857
+    7,95,160,220,232,106,177,247,197,1,25, // 7+2: 258 -> 150
+    7,8,9,15,1,0,19,22,5,6,1,165,6, // 7+3: 492 -> 312
+    7,254,33,183,0,170,156,53,142,217,248,1,204,135,93, // 7+4: 711 -> 439
+    7,193,9,240,168,0,1,72,149,69,5,128,1,2,3,37,231, // 7+5: 938 -> 609
+    7,3,9,92,27,1,0,198,186,110,228,246,170,1,78,12,107,27,115, // 7+6: 1164 -> 742
+    7,184,0,2,11,13,205,158,1,214,3,4,208,166,1,24,12,166,164,7,85, // 7+7: 1374 -> 888
+    7,228,91,152,113,198,193,251,0,147,2,77,4,5,6,1,55,239,233,232,195,197,37, // 7+8: 1551 -> 1012
+    8,9,248,159,113,176,81,236,140,135,1,36, // 8+2: 320 -> 176
+    8,9,10,0,149,64,31,239,135,61,218,1,81,174, // 8+3: 581 -> 323
+    8,143,228,11,99,2,22,66,244,63,192,7,1,27,233,99, // 8+4: 842 -> 525
+    8,120,58,63,159,111,186,7,104,6,209,38,124,1,27,121,193,51, // 8+5: 1098 -> 634
+    8,109,126,79,128,57,85,121,179,44,118,76,196,161,1,117,161,212,3,151, // 8+6: 1354 -> 867
+    8,9,10,214,164,223,69,238,1,255,3,147,242,25,232,1,127,253,113,98,115,149, // 8+7: 1613 -> 1047
+    8,112,245,71,196,158,116,243,126,4,30,230,101,5,252,7,1,11,10,181,32,88,193,169, // 8+8: 1868 -> 1253
+    9,10,202,217,74,114,249,90,148,37,198,1,13, // 9+2: 344 -> 202
+    9,10,30,50,87,225,32,143,107,34,246,1,1,163,242, // 9+3: 645 -> 376
+    9,10,11,59,97,141,129,172,179,27,182,203,88,1,78,117,83, // 9+4: 915 -> 585
+    9,10,250,187,47,222,3,0,214,110,87,116,109,210,1,88,29,108,44, // 9+5: 1195 -> 809
+    9,171,156,12,222,14,15,19,10,13,175,172,139,144,8,1,164,127,83,189,6, // 9+6: 1487 -> 990
+    9,69,162,109,87,22,215,0,205,2,107,105,5,186,7,12,1,67,83,92,149,32,137, // 9+7: 1786 -> 1217
+    9,158,11,252,214,228,68,5,0,1,70,79,4,78,81,46,221,1,65,89,27,172,66,33,110, // 9+8: 2062 -> 1413
+    10,93,24,1,172,155,39,225,241,29,175,216,1,76, // 10+2: 397 -> 228
+    10,11,12,0,5,2,237,21,216,73,205,239,66,1,142,165, // 10+3: 707 -> 443
+    10,11,221,141,229,105,231,110,4,56,250,170,8,109,1,55,204,247, // 10+4: 1009 -> 709
+    10,229,12,5,210,0,160,25,226,121,172,6,137,8,9,1,154,6,40,73, // 10+5: 1346 -> 913
+    10,67,217,148,81,15,122,63,200,143,4,43,247,36,225,186,1,235,198,222,75,144, // 10+6: 1654 -> 1174
+    10,32,51,135,146,59,162,152,114,170,84,4,58,108,190,57,39,1,30,63,47,132,190,212, // 10+7: 1971 -> 1386
+    10,205,52,167,63,239,216,69,50,31,236,128,131,5,95,112,134,93,1,240,179,37,200,255,109,181, // 10+8: 2253 -> 1571
+    11,12,13,169,171,158,120,18,149,219,252,28,40,1,190, // 11+2: 427 -> 255
+    11,12,13,5,220,2,149,210,69,99,202,219,169,78,1,245,210, // 11+3: 777 -> 470
+    11,12,243,152,69,219,171,169,207,43,232,111,15,2,33,1,245,186,148, // 11+4: 1099 -> 764
+    11,180,12,208,229,136,174,2,205,239,125,101,49,8,237,10,1,137,6,109,33, // 11+5: 1460 -> 948
+    11,12,108,86,80,176,66,220,43,195,81,235,110,73,8,101,10,1,12,231,19,176,114, // 11+6: 1778 -> 1206
+    11,229,163,14,15,146,142,13,7,242,54,9,200,3,152,62,58,121,1,59,62,122,167,210,47, // 11+7: 2136 -> 1467
+    11,26,170,14,71,195,25,28,154,1,2,221,197,19,23,96,8,147,226,1,28,250,6,79,75,245,123, // 11+8: 2484 -> 1786
+    75,13,46,81,69,3,104,164,129,35,199,23,201,101,1,167, // 12+2: 477 -> 282
+    12,13,14,57,241,73,4,10,97,128,211,150,145,120,19,1,237,246, // 12+3: 860 -> 565
+    12,13,138,208,179,32,11,241,4,73,6,136,45,56,184,68,1,81,118,177, // 12+4: 1252 -> 862
+    12,116,140,15,16,240,251,141,161,232,167,157,64,121,35,122,44,1,247,61,138,29, // 12+5: 1641 -> 1108
+    12,19,74,178,203,13,222,73,248,241,79,51,10,39,88,4,247,6,1,204,187,92,165,71, // 12+6: 2002 -> 1367
+    12,149,14,15,173,57,18,185,46,107,254,196,5,191,71,97,211,137,73,1,32,211,153,72,60,189, // 12+7: 2399 -> 1700
+    12,70,232,82,22,173,18,184,250,17,9,3,251,85,26,11,67,202,10,210,1,241,94,194,168,245,9,207, // 12+8: 2804 -> 1983
+    142,14,242,177,144,201,178,27,123,200,163,120,7,233,62,1,145, // 13+2: 507 -> 309
+    13,14,15,169,132,116,236,125,228,146,251,8,51,135,186,170,1,196,151, // 13+3: 930 -> 597
+    13,11,224,164,174,158,72,24,203,227,241,33,96,219,14,46,26,1,55,45,94, // 13+4: 1327 -> 910
+    13,105,194,20,17,78,1,53,145,3,178,2,35,66,108,10,55,39,1,46,198,236,123, // 13+5: 1744 -> 1255
+    13,251,15,119,40,1,205,132,170,51,197,165,19,186,8,28,72,112,68,1,201,198,90,105,171, // 13+6: 2192 -> 1465
+    13,70,34,191,115,201,220,231,167,217,96,227,84,99,58,12,90,218,106,59,1,217,215,43,199,74,68, // 13+7: 2628 -> 1857
+    13,139,245,105,82,127,197,22,106,129,2,166,138,169,6,143,1,99,10,78,122,1,5,184,205,98,51,199,6, // 13+8: 3047 -> 2178
+    14,15,17,1,243,119,236,186,174,138,8,251,106,170,150,117,1,198, // 14+2: 554 -> 336
+    14,15,13,17,11,202,236,148,43,6,119,8,220,231,91,233,59,1,142,12, // 14+3: 1022 -> 670
+    86,15,104,17,90,71,227,149,96,5,174,199,55,9,10,247,215,131,1,160,88,93, // 14+4: 1494 -> 988
+    14,103,45,17,18,79,58,2,32,111,222,46,72,169,3,223,209,82,5,1,253,220,74,211, // 14+5: 1967 -> 1350
+    14,15,24,17,78,193,0,220,119,233,4,166,6,248,8,75,246,32,201,184,1,133,193,90,144,6, // 14+6: 2392 -> 1687
+    14,15,124,185,100,60,127,17,151,49,203,201,5,6,215,87,243,233,94,84,35,1,142,75,148,137,106,77, // 14+7: 2850 -> 1951
+    14,0,200,30,167,245,192,21,72,148,251,213,133,7,199,207,8,9,28,127,12,13,1,3,196,139,101,144,128,4, // 14+8: 3257 -> 2380
+    15,16,200,131,161,3,4,83,214,59,202,208,33,216,128,165,236,1,74, // 15+2: 635 -> 364
+    15,142,17,132,71,111,129,81,135,6,87,8,92,34,50,123,21,14,1,169,208, // 15+3: 1142 -> 742
+    15,182,236,147,99,196,187,247,68,101,220,47,4,84,10,7,12,219,81,1,78,246,153, // 15+4: 1603 -> 1106
+    15,16,254,18,161,128,193,120,214,4,5,33,55,126,168,10,78,249,31,155,1,180,132,120,66, // 15+5: 2104 -> 1442
+    15,227,238,27,19,246,141,35,21,3,89,193,6,110,23,73,188,253,168,53,14,1,71,140,86,124,248, // 15+6: 2547 -> 1828
+    15,16,98,200,254,239,117,122,33,2,3,4,150,129,7,241,9,128,31,194,168,50,1,148,226,36,200,29,223, // 15+7: 3046 -> 2242
+    15,6,206,18,19,197,76,22,147,248,244,38,11,1,183,84,8,9,86,242,121,13,233,1,80,197,26,15,103,242,149, // 15+8: 3537 -> 2556
+    16,17,119,1,202,220,133,250,82,128,62,115,204,153,225,13,108,245,1,29, // 16+2: 666 -> 392
+    16,237,18,91,9,160,151,47,181,206,155,214,130,15,227,6,12,165,120,1,130,156, // 16+3: 1178 -> 791
+    16,17,78,19,0,23,84,199,98,214,82,68,236,250,4,11,139,197,49,119,1,129,130,119, // 16+4: 1708 -> 1173
+    16,17,219,19,71,222,86,165,152,4,199,114,90,204,9,231,11,23,13,158,175,1,159,184,39,237, // 16+5: 2230 -> 1614
+    16,20,18,179,108,242,80,252,9,187,68,94,181,158,191,75,63,11,12,121,14,40,1,59,139,195,202,131, // 16+6: 2738 -> 1966
+    16,17,53,202,192,6,22,238,181,151,118,251,214,252,92,10,82,148,11,4,75,180,39,1,105,175,185,54,226,198, // 16+7: 3290 -> 2421
+    16,145,18,139,196,202,158,115,122,165,2,245,178,108,6,49,251,138,225,94,120,101,107,15,1,86,127,24,49,118,178,2, // 16+8: 3852 -> 2715
+    17,177,166,1,22,249,247,170,165,117,104,106,160,201,115,3,198,60,112,1,39, // 17+2: 677 -> 421
+    17,18,19,164,111,84,129,123,151,254,188,47,210,160,146,222,82,177,15,66,1,57,81, // 17+3: 1229 -> 837
+    17,143,67,215,33,245,44,231,251,106,249,187,8,209,102,170,149,230,131,203,89,1,246,195,214, // 17+4: 1751 -> 1259
+    17,18,38,111,37,183,56,53,26,4,243,232,220,239,9,121,58,230,39,139,44,11,1,126,222,216,223, // 17+5: 2297 -> 1676
+    17,117,140,198,201,22,99,24,105,159,4,175,207,7,172,52,10,138,145,128,149,20,115,1,136,76,73,100,197, // 17+6: 2896 -> 2083
+    17,148,10,147,234,226,23,52,169,27,176,186,158,253,189,81,65,98,173,20,137,14,15,142,1,225,60,21,145,155,196, // 17+7: 3488 -> 2487
+    17,94,158,32,62,109,216,128,183,160,12,3,221,47,96,135,70,42,10,9,140,132,14,66,92,1,69,246,193,189,102,54,62, // 17+8: 4027 -> 2922
+    18,19,129,211,95,197,113,51,88,167,99,183,229,238,12,80,110,84,212,44,1,115, // 18+2: 743 -> 450
+    18,254,20,94,58,62,221,42,110,6,7,73,9,87,183,195,116,55,196,49,17,1,158,211, // 18+3: 1346 -> 898
+    18,116,61,21,235,205,127,123,147,238,41,143,98,163,64,0,134,92,33,15,180,9,1,36,137,174, // 18+4: 1955 -> 1319
+    18,1,20,191,35,218,165,229,243,87,61,10,123,15,187,64,11,49,116,228,2,203,110,1,21,168,31,124, // 18+5: 2558 -> 1799
+    175,19,91,244,205,42,194,173,174,179,135,5,148,104,57,114,152,0,24,101,240,190,1,215,1,124,144,235,162,193, // 18+6: 3118 -> 2287
+    18,19,229,21,105,179,178,0,202,69,166,4,189,30,127,109,211,180,47,5,76,238,96,16,63,1,240,162,34,151,77,200, // 18+7: 3661 -> 2730
+    18,165,111,199,26,193,156,92,143,57,169,78,170,152,80,37,221,35,175,11,124,41,14,115,204,86,1,139,4,33,232,245,116,209, // 18+8: 4239 -> 3199
+    19,20,156,239,135,3,126,97,35,111,212,231,17,227,65,103,83,230,153,46,77,1,68, // 19+2: 798 -> 479
+    19,134,83,79,57,2,132,119,229,44,6,161,9,175,81,87,102,133,111,243,182,48,1,254,121, // 19+3: 1441 -> 953
+    19,113,21,22,86,206,139,144,145,221,83,102,8,204,10,247,12,238,117,0,20,189,168,1,111,243,103, // 19+4: 2015 -> 1461
+    19,20,196,46,94,194,233,213,73,69,65,253,231,71,153,79,113,4,13,14,103,181,216,38,1,17,208,141,226, // 19+5: 2642 -> 1868
+    19,140,25,94,23,24,84,27,48,236,164,5,76,160,213,186,72,142,141,196,14,128,104,155,174,1,184,255,140,211,220, // 19+6: 3245 -> 2333
+    19,40,110,182,147,165,6,105,64,136,3,29,23,75,166,227,196,1,79,10,127,141,160,144,18,102,1,134,18,246,9,28,70, // 19+7: 3821 -> 2817
+    19,108,119,46,127,210,162,26,0,92,87,3,237,206,204,43,12,66,10,11,185,104,14,197,230,171,18,1,189,127,58,237,215,192,168, // 19+8: 4432 -> 3399
+    20,21,161,232,82,94,42,89,210,119,53,177,213,195,230,135,101,104,223,86,10,227,1,115, // 20+2: 823 -> 508
+    20,21,22,219,227,86,170,163,105,88,7,89,226,13,14,90,100,1,15,42,223,128,207,1,111,169, // 20+3: 1457 -> 987
+    20,38,22,23,0,1,108,246,100,49,219,4,196,54,235,111,198,34,19,15,237,234,105,25,1,58,169,96, // 20+4: 2118 -> 1540
+    20,21,89,86,24,171,1,230,185,170,107,35,219,28,133,83,186,12,78,100,176,103,174,18,236,1,85,153,157,220, // 20+5: 2764 -> 2006
+    20,124,40,23,8,240,10,131,2,185,254,173,6,112,12,9,143,186,58,95,49,61,237,37,47,85,1,193,150,150,49,43, // 20+6: 3377 -> 2533
+    20,132,83,23,210,32,38,112,51,199,117,39,24,17,7,66,207,71,67,87,13,58,149,221,232,34,253,1,39,68,92,251,169,245, // 20+7: 4037 -> 3010
+    20,95,22,250,24,213,152,27,255,1,245,2,229,167,11,193,116,253,129,183,40,241,200,9,242,17,156,162,1,100,47,75,151,250,192,178, // 20+8: 4702 -> 3586
+    21,22,115,91,158,140,90,183,241,232,255,162,178,156,3,171,184,43,212,225,185,19,135,1,155, // 21+2: 840 -> 538
+    21,46,23,233,153,182,111,173,114,104,227,101,105,47,11,55,113,14,15,60,221,96,255,22,1,56,62, // 21+3: 1514 -> 1045
+    21,22,23,229,47,186,2,3,4,27,237,254,178,114,184,162,93,68,211,41,196,51,158,82,126,1,248,78,15, // 21+4: 2160 -> 1575
+    21,219,25,24,26,222,194,84,43,83,200,190,99,165,186,249,29,247,109,67,1,231,76,117,89,20,1,207,228,201,201, // 21+5: 2840 -> 2122
+    21,79,23,152,25,26,175,1,53,3,167,202,166,55,20,47,102,248,70,4,249,52,19,41,127,176,108,1,184,252,232,197,244, // 21+6: 3543 -> 2754
+    21,22,23,135,36,26,27,158,18,2,103,156,247,125,7,211,249,5,137,19,29,166,242,186,229,53,41,20,1,6,78,37,108,56,123, // 21+7: 4247 -> 3253
+    21,203,23,191,70,132,34,77,162,131,155,89,109,20,209,145,126,22,43,252,172,173,160,13,47,177,18,240,35,1,184,237,132,216,146,232,247, // 21+8: 4873 -> 3713
+    22,23,0,165,91,253,217,5,64,102,158,101,239,225,12,13,224,203,249,191,76,3,220,221,1,241, // 22+2: 900 -> 568
+    22,226,235,0,62,2,34,119,37,108,7,12,125,206,49,45,13,161,192,163,231,11,29,115,21,1,75,232, // 22+3: 1629 -> 1108
+    22,23,24,25,80,133,138,71,4,1,112,110,8,103,10,92,217,17,30,26,113,221,53,179,193,156,1,115,220,133, // 22+4: 2340 -> 1699
+    22,104,161,25,164,0,83,11,225,114,166,204,242,249,248,49,245,31,86,56,37,16,17,107,91,211,153,1,152,158,210,90, // 22+5: 3050 -> 2283
+    22,23,79,212,99,27,251,1,55,159,229,193,201,3,8,165,74,46,133,82,237,15,221,17,0,85,228,164,1,129,131,11,230,51, // 22+6: 3745 -> 2844
+    22,105,24,118,233,157,159,25,241,223,3,45,1,6,230,81,167,10,114,82,88,126,37,68,34,18,227,20,107,1,123,123,140,48,124,181, // 22+7: 4411 -> 3354
+    22,87,24,25,77,27,245,86,157,1,138,3,187,149,110,7,242,50,10,19,68,136,104,132,152,23,141,60,20,182,1,20,161,26,207,24,64,66, // 22+8: 5137 -> 4022
+    23,24,163,45,168,3,88,81,6,157,64,179,141,68,54,53,215,38,245,17,22,252,105,233,31,1,165, // 23+2: 933 -> 599
+    23,24,25,88,147,251,31,163,5,6,95,149,244,252,187,27,43,158,138,16,17,20,3,30,21,22,1,14,12, // 23+3: 1706 -> 1185
+    23,24,25,173,26,157,163,3,5,101,6,15,31,147,250,88,38,252,231,149,16,17,65,30,104,21,22,1,14,6,61, // 23+4: 2434 -> 1775
+    23,24,25,26,143,0,83,2,46,156,175,87,7,11,133,186,36,74,139,100,205,16,253,152,215,104,166,51,1,52,123,8,222, // 23+5: 3178 -> 2344
+    23,181,122,26,158,28,54,248,2,3,249,202,99,58,82,223,35,175,12,251,4,115,194,60,200,51,252,21,133,1,142,154,249,29,54, // 23+6: 3929 -> 3018
+    23,82,25,86,27,222,228,158,117,153,80,4,135,148,7,151,223,10,11,115,134,14,136,89,22,127,163,20,68,215,1,219,123,121,216,91,13, // 23+7: 4628 -> 3641
+    23,12,230,209,78,21,243,191,123,242,171,254,4,46,194,196,167,183,10,156,98,202,128,133,170,80,220,40,231,120,252,1,61,136,141,49,63,5,133, // 23+8: 5326 -> 4141
+    24,25,84,239,85,3,238,13,215,197,211,175,2,11,66,171,14,144,210,104,78,247,177,243,225,107,1,241, // 24+2: 986 -> 630
+    24,25,26,177,1,238,3,46,13,176,84,85,195,239,11,211,215,38,175,140,90,104,2,86,166,253,101,1,222,169, // 24+3: 1759 -> 1218
+    24,25,26,211,28,101,235,3,115,215,238,122,38,166,171,11,84,13,56,195,104,175,97,78,20,21,18,249,1,241,151,151, // 24+4: 2550 -> 1875
+    24,239,26,27,28,157,8,121,205,23,40,33,207,32,56,90,34,159,127,50,167,57,245,189,39,168,53,7,103,1,143,252,238,75, // 24+5: 3328 -> 2484
+    24,172,26,35,221,152,250,1,14,173,4,222,70,116,8,130,10,232,12,147,175,2,196,9,156,167,155,22,189,247,1,132,156,65,115,72, // 24+6: 4092 -> 3111
+    24,222,26,27,28,144,30,67,180,188,195,118,84,6,239,140,126,229,166,145,13,231,254,29,40,97,19,20,21,109,175,1,185,99,123,48,160,151, // 24+7: 4903 -> 3819
+    24,103,112,147,70,67,199,100,155,184,162,140,54,108,210,190,8,233,116,118,151,188,85,123,50,247,49,19,178,44,149,219,1,120,168,37,41,255,151,108, // 24+8: 5720 -> 4350
+    25,73,20,72,170,212,19,5,3,7,232,40,131,24,134,226,211,190,67,17,231,13,176,86,27,163,177,1,11, // 25+2: 1002 -> 661
+    25,26,27,7,147,137,105,198,99,190,35,161,28,247,92,2,101,209,84,174,5,29,134,20,21,241,144,248,1,152,198, // 25+3: 1815 -> 1315
+    25,95,27,150,88,132,205,229,86,254,93,114,15,226,19,207,170,60,173,120,16,39,18,161,188,80,94,110,3,1,202,178,63, // 25+4: 2593 -> 1956
+    25,178,146,250,158,209,87,59,68,147,61,79,8,15,191,234,136,236,101,74,76,64,39,160,19,53,163,22,165,129,1,55,119,157,244, // 25+5: 3395 -> 2608
+    25,84,95,130,112,30,193,107,90,132,4,114,155,7,230,9,89,18,66,71,93,137,86,135,232,229,251,141,204,194,244,1,140,179,46,9,170, // 25+6: 4249 -> 3260
+    25,26,27,38,172,30,124,129,11,43,137,188,41,182,150,70,154,72,42,203,107,132,115,242,153,147,231,219,119,145,23,113,1,181,117,250,119,254,94, // 25+7: 5100 -> 3985
+    25,26,172,119,91,30,201,79,124,1,120,28,4,200,144,147,125,199,19,216,12,87,142,34,23,188,29,24,148,250,206,88,128,1,71,45,177,99,3,51,166, // 25+8: 5920 -> 4569
+    26,27,212,1,244,252,201,146,105,36,241,87,169,220,17,124,77,13,121,199,193,125,209,19,237,9,88,53,1,238, // 26+2: 1063 -> 692
+    26,27,149,36,76,209,88,77,124,233,13,9,1,0,237,47,83,3,15,84,17,68,19,87,160,222,53,252,130,1,145,247, // 26+3: 1925 -> 1388
+    26,112,28,29,184,57,226,77,203,106,83,235,243,149,13,190,213,101,205,15,65,14,50,19,58,176,1,191,54,25,1,103,211,199, // 26+4: 2789 -> 2023
+    26,73,28,29,30,48,142,65,221,8,88,6,135,10,109,217,231,138,174,14,61,190,244,18,155,255,157,68,42,24,145,1,228,142,87,164, // 26+5: 3648 -> 2763
+    26,92,233,29,20,31,187,12,174,48,4,3,22,222,247,28,235,202,205,13,90,129,196,17,86,19,97,21,84,5,24,25,1,102,184,197,196,244, // 26+6: 4464 -> 3461
+    26,233,180,53,38,123,73,5,163,21,118,67,92,214,145,117,136,149,181,178,14,200,36,108,18,79,19,17,205,156,111,34,25,1,131,100,61,84,67,26, // 26+7: 5311 -> 4132
+    26,230,214,29,30,219,138,200,231,222,115,11,169,5,111,246,112,75,206,107,117,47,37,113,8,183,64,137,50,82,189,114,93,158,1,246,120,202,173,130,96,232, // 26+8: 6162 -> 4784
+    27,28,230,239,69,3,32,107,162,7,60,189,143,73,49,25,48,134,170,231,111,245,145,19,226,64,248,38,180,1,87, // 27+2: 1117 -> 723
+    27,28,18,0,134,3,170,244,202,38,30,73,9,185,107,121,69,14,112,189,17,114,143,43,126,154,23,10,239,47,1,17,167, // 27+3: 2019 -> 1440
+    27,28,29,30,135,114,247,24,56,18,159,67,42,100,131,12,115,13,216,64,212,188,49,178,25,103,229,23,168,166,130,1,61,123,244, // 27+4: 2849 -> 2153
+    27,28,29,30,31,216,138,15,3,45,130,42,12,87,225,241,49,186,136,215,25,177,185,188,46,226,13,213,23,24,56,197,1,203,82,122,198, // 27+5: 3732 -> 2867
+    27,153,29,30,31,32,130,148,233,177,103,64,242,143,151,17,100,215,104,56,68,15,54,76,3,77,178,156,38,23,24,174,131,1,184,155,82,151,107, // 27+6: 4612 -> 3523
+    27,173,29,154,214,32,33,168,204,2,3,136,179,249,7,8,66,59,241,47,13,140,251,22,17,126,198,91,152,220,15,203,218,26,1,101,54,141,191,65,161, // 27+7: 5501 -> 4348
+    27,28,29,30,60,32,33,65,249,152,130,219,62,22,145,74,8,204,10,185,63,181,138,126,49,119,168,71,223,241,224,132,24,26,31,1,12,251,1,70,134,191,165, // 27+8: 6391 -> 4999
+    28,29,250,218,123,242,207,11,148,81,23,34,127,7,111,122,210,235,175,193,94,162,51,199,75,215,21,247,15,14,1,238, // 28+2: 1143 -> 754
+    28,29,30,159,146,211,6,188,80,101,7,111,108,215,9,239,165,34,15,234,209,74,171,73,17,126,35,162,150,117,10,1,175,104, // 28+3: 2038 -> 1465
+    28,29,30,147,85,61,117,239,78,10,92,7,108,9,107,255,34,80,125,101,16,6,188,156,35,15,22,74,150,209,171,211,1,175,104,57, // 28+4: 2960 -> 2193
+    28,29,137,31,169,12,62,159,81,242,221,228,7,132,147,73,83,72,114,136,15,162,127,218,170,41,201,108,183,75,14,0,94,1,145,221,111,233, // 28+5: 3908 -> 2972
+    28,29,30,87,165,33,221,148,2,97,201,81,94,7,196,9,195,185,12,69,35,15,136,126,152,250,108,21,235,98,193,191,198,34,1,119,31,123,82,133, // 28+6: 4815 -> 3780
+    28,29,43,207,158,33,34,165,240,2,120,61,135,231,7,86,163,238,241,41,201,108,143,237,90,15,8,40,81,185,236,24,235,195,71,1,230,35,207,23,228,189, // 28+7: 5745 -> 4458
+    28,29,30,82,171,54,34,200,78,255,100,59,121,66,6,7,73,18,19,23,194,234,150,151,16,111,91,44,71,138,144,239,108,81,211,27,1,205,77,121,99,51,255,126, // 28+8: 6570 -> 5290
+    29,30,159,1,39,212,174,97,226,101,8,9,89,102,231,86,179,15,16,251,40,125,205,147,207,250,56,178,72,116,230,1,205, // 29+2: 1165 -> 786
+    29,199,31,132,213,227,77,63,194,248,7,163,142,131,167,226,103,54,153,16,186,210,3,181,114,17,178,88,11,175,187,191,1,31,248, // 29+3: 2100 -> 1541
+    29,30,31,32,168,238,190,156,86,212,149,234,191,53,135,125,102,2,222,207,100,98,74,19,83,126,43,15,33,117,11,223,228,1,120,127,213, // 29+4: 3048 -> 2286
+    29,30,31,32,33,66,171,231,136,200,5,23,7,60,188,10,0,28,232,233,199,122,102,98,52,249,174,22,217,132,25,37,65,61,1,90,150,17,243, // 29+5: 4034 -> 3138
+    29,102,175,32,33,34,162,30,239,44,233,91,41,7,147,243,231,11,12,151,9,15,77,50,18,168,65,21,66,28,199,25,56,167,212,1,210,127,136,14,88, // 29+6: 4898 -> 3865
+    29,230,141,115,200,76,241,0,202,140,195,150,94,181,159,139,231,252,72,3,123,14,44,118,138,18,121,43,9,206,125,24,25,161,27,234,1,37,117,26,31,180,64, // 29+7: 5863 -> 4662
+    29,79,102,1,96,34,92,86,117,35,203,108,6,64,254,45,239,9,10,238,250,98,210,155,252,176,248,2,224,21,14,245,24,94,38,194,28,1,143,238,43,203,31,17,241, // 29+8: 6812 -> 5397
+    30,31,103,71,2,250,211,207,142,137,41,208,105,205,99,129,86,138,55,149,43,166,50,235,24,53,252,248,220,238,145,154,1,36, // 30+2: 1220 -> 818
+    30,31,32,124,237,245,83,205,5,182,216,8,109,73,11,4,146,17,12,113,233,140,48,151,21,145,194,203,71,248,223,213,173,1,145,53, // 30+3: 2234 -> 1630
+    30,165,32,115,146,155,13,170,4,37,151,237,8,122,10,215,11,18,149,150,123,130,192,86,195,194,193,168,206,27,6,17,239,24,1,55,255,77, // 30+4: 3120 -> 2408
+    30,110,32,33,70,17,167,2,74,139,21,51,155,44,209,226,11,189,148,73,249,96,146,18,52,134,228,14,23,154,25,220,181,6,29,1,156,255,10,247, // 30+5: 4134 -> 3207
+    30,89,178,33,34,200,83,1,2,18,234,219,58,3,38,149,125,11,23,207,14,172,4,63,167,104,231,21,226,228,5,209,249,194,62,238,1,14,12,5,84,109, // 30+6: 5113 -> 3982
+    30,105,32,11,34,35,36,104,237,225,137,4,71,6,8,94,83,245,155,151,188,206,118,165,129,240,77,231,148,91,198,156,97,189,44,28,9,1,151,101,145,129,38,213, // 30+7: 6087 -> 4873
+    30,145,175,209,202,31,36,37,16,249,169,225,231,5,226,46,183,47,10,211,83,13,127,220,159,8,142,205,20,21,22,79,90,2,82,128,116,228,1,160,227,137,3,47,131,180, // 30+8: 7076 -> 5636
+    31,32,82,214,185,3,173,229,6,127,135,215,10,162,166,13,53,232,47,227,219,211,97,39,22,15,24,147,69,188,28,221,165,1,5, // 31+2: 1173 -> 856
+    31,32,33,166,101,13,180,168,29,251,208,221,3,173,10,188,164,232,15,16,28,84,19,135,149,97,63,24,235,229,147,146,71,76,1,10,51, // 31+3: 2222 -> 1668
+    31,32,33,34,180,24,7,45,235,144,154,43,195,30,10,219,47,13,173,251,16,208,149,19,69,84,22,147,229,192,230,148,28,96,3,1,10,217,68, // 31+4: 3242 -> 2538
+    31,32,33,34,35,229,154,160,144,192,195,227,166,248,9,208,151,249,13,47,15,16,251,105,19,43,148,147,25,39,149,171,10,28,124,4,1,164,217,93,84, // 31+5: 4294 -> 3407
+    31,32,33,34,35,36,9,147,153,208,4,173,149,7,20,151,70,192,75,43,229,15,16,47,3,19,11,23,42,230,14,188,144,146,28,248,13,1,10,217,186,86,74, // 31+6: 5312 -> 4255
+    31,67,33,188,35,36,37,154,1,241,248,71,215,196,79,8,208,129,11,230,42,177,15,2,159,158,254,20,105,136,12,157,3,117,95,28,59,213,1,79,129,171,168,37,131, // 31+7: 6328 -> 5004
+    31,9,30,34,35,214,231,211,189,103,208,206,3,125,142,11,229,252,108,39,95,32,41,171,166,144,115,170,22,105,99,21,18,210,177,40,28,118,162,1,103,185,214,58,111,30,159, // 31+8: 7347 -> 5835
+    32,33,0,223,224,91,177,29,166,103,157,148,27,132,90,8,231,138,170,31,95,229,139,185,205,246,24,25,107,184,178,7,190,86,1,182, // 32+2: 1258 -> 882
+    32,33,34,192,198,182,132,12,29,86,99,8,95,10,229,190,157,11,137,223,27,13,0,246,201,107,170,224,25,187,254,16,148,139,68,1,66,140, // 32+3: 2313 -> 1716
+    32,33,34,35,0,184,138,178,247,20,6,39,254,246,10,219,7,251,3,54,100,95,129,98,22,117,80,164,239,25,230,224,24,139,187,31,1,139,111,232, // 32+4: 3374 -> 2619
+    32,166,34,35,201,0,164,2,144,1,100,39,185,184,9,133,245,7,98,126,230,137,20,73,138,71,120,127,10,27,129,26,89,124,209,217,31,1,227,168,232,221, // 32+5: 4409 -> 3436
+    32,239,34,35,36,163,234,107,133,115,2,244,1,7,8,9,185,39,157,13,14,65,141,17,123,72,20,48,111,18,176,25,254,62,82,201,178,31,1,129,200,233,78,142, // 32+6: 5416 -> 4342
+    32,185,34,197,219,37,38,87,1,139,44,175,66,165,7,8,127,10,183,12,222,110,76,204,17,18,157,20,82,140,147,52,99,65,4,193,114,30,176,1,178,50,196,79,175,75, // 32+7: 6452 -> 5226
+    32,33,53,181,193,186,103,39,13,149,219,222,216,223,95,197,8,170,10,172,243,93,118,220,34,138,18,19,56,41,22,49,60,25,190,23,28,29,5,86,1,107,173,87,60,139,68,39, // 32+8: 7532 -> 6119
+    48,49,79,250,2,15,132,172,46,115,47,247,162,185,123,119,240,124,198,170,18,77,169,30,151,146,216,16,236,177,103,117,207,205,126,51,34,52,61,87,230,111,148,82,42,101,90,54,234,69,1,61, // 48+2: 1924 -> 1417
+    48,71,50,51,56,226,2,201,179,246,6,7,231,9,182,11,174,229,141,28,83,90,191,85,44,21,66,114,123,16,26,27,0,29,8,228,32,33,132,64,202,208,214,39,155,165,215,153,150,45,120,100,1,206,70,145, // 48+4: 5082 -> 4080
+    48,49,50,51,52,247,54,61,240,8,214,172,110,223,6,101,102,9,66,11,42,94,171,14,16,91,85,175,183,39,22,26,60,25,19,92,28,154,103,21,238,211,230,35,145,167,38,199,72,30,31,235,64,40,46,123,1,192,222,194,251,186,204,247, // 48+8: 11384 -> 9579
+    48,115,219,211,52,93,64,29,56,59,25,193,136,113,7,179,161,210,207,3,227,60,6,180,69,171,11,195,12,9,203,95,90,36,121,32,223,237,68,99,158,71,169,186,10,173,213,243,188,33,2,252,129,53,101,202,38,246,87,154,163,249,83,47,1,224,51,145,246,111,140,196,3,147,219,65,129,117,200,207, // 48+16: 23928 -> 20450
+    48,49,93,222,52,153,136,123,209,155,154,103,196,251,7,217,64,158,253,142,84,62,66,205,198,219,174,139,14,110,224,225,6,67,53,175,10,11,12,13,150,23,16,248,208,19,43,212,22,76,24,25,91,51,183,33,254,143,97,173,211,35,36,237,38,39,40,94,151,3,131,116,202,125,1,24,32,138,151,168,207,242,47,168,195,11,46,74,119,189,192,237,183,100,103,58,209,119,27,242, // 48+26: 39500 -> 34291
+    48,151,204,231,218,236,181,240,0,143,220,229,160,40,168,244,199,164,47,155,192,113,154,81,180,193,72,167,237,120,194,212,153,1,239,233,216,2,132,7,53,235,137,11,213,149,196,188,52,17,18,15,189,21,22,23,42,5,223,86,28,85,140,73,84,101,182,35,36,12,238,39,205,41,30,16,44,51,225,29,1,119,67,76,153,175,233,95,255,93,225,242,149,74,83,243,99,176,55,117,243,102,34,156,130,104,151,203,111,205,12,214, // 48+32: 48712 -> 42857
+    64,65,146,212,2,3,90,157,7,149,8,182,115,230,12,238,154,126,195,134,42,207,201,228,141,93,50,237,68,244,30,127,52,11,92,60,34,66,35,155,38,39,161,76,138,168,231,45,103,80,220,111,156,193,110,170,44,72,67,135,63,221,167,61,117,191,1,223, // 64+2: 2610 -> 1972
+    64,65,66,100,106,248,4,133,173,114,52,154,8,120,78,148,129,144,222,15,16,207,187,55,20,85,56,73,216,25,26,230,79,29,235,176,32,33,72,81,36,37,229,101,60,2,221,77,10,45,136,24,48,49,50,51,183,224,67,213,243,190,58,59,27,203,134,214,1,189,89,168, // 64+4: 6664 -> 5596
+    64,65,66,67,68,69,70,71,50,22,216,3,4,5,6,245,148,243,179,211,147,203,14,15,16,27,246,62,20,21,9,91,137,25,73,93,28,29,200,171,187,111,140,214,78,82,120,160,40,41,196,98,44,45,182,163,151,134,206,139,95,178,153,235,56,37,173,59,150,129,143,63,1,62,66,127,230,233,159,179, // 64+8: 15044 -> 13026
+    64,90,66,102,159,69,70,57,72,73,227,195,116,53,31,125,213,148,173,249,4,5,65,136,154,137,111,107,184,163,14,3,16,177,18,233,20,21,243,198,30,226,26,167,151,28,120,206,114,186,39,35,61,176,38,45,40,41,153,133,44,156,29,47,50,49,82,182,187,13,208,165,188,200,58,59,214,134,135,17,1,36,132,192,113,129,210,122,63,181,152,249,148,58,13,73, // 64+16: 31592 -> 27939
+    64,248,66,67,106,69,108,76,107,190,236,113,191,54,116,179,30,125,48,88,122,85,53,202,152,126,115,135,139,3,89,55,123,172,91,9,10,16,155,7,14,15,132,73,18,29,20,128,22,80,176,60,255,96,28,197,199,31,74,33,160,35,36,171,77,165,40,68,82,134,44,243,46,161,196,49,50,212,156,131,175,120,181,57,58,234,233,61,62,63,1,111,69,176,173,158,116,231,206,75,9,182,96,249,213,181,205,196,226,44,31,174,209,146,211,193, // 64+26: 52326 -> 46528
+    64,127,218,149,57,69,70,130,183,239,233,75,54,237,151,132,110,81,209,71,111,250,133,116,35,86,12,201,173,202,77,106,178,1,82,3,4,5,6,200,8,39,185,165,190,199,14,15,241,211,68,175,20,21,179,16,24,25,9,27,196,115,247,101,210,150,34,89,177,126,38,90,40,205,129,166,44,45,229,7,147,49,249,108,28,73,41,55,56,18,176,42,230,61,62,63,1,161,251,233,91,79,159,172,90,13,6,44,175,157,72,108,101,135,71,43,175,37,79,161,199,137,253,49,224,207,121,96, // 64+32: 64800 -> 58234
+    96,97,0,161,2,227,160,5,6,7,208,9,15,112,12,162,19,173,211,99,199,239,139,46,110,225,61,74,171,129,136,29,159,206,234,123,34,35,42,252,144,166,40,254,44,151,108,45,189,243,184,216,198,51,150,53,115,152,182,57,132,38,168,33,62,196,64,205,66,197,68,167,188,232,72,58,194,10,237,212,78,79,43,100,193,83,181,85,186,183,124,154,20,244,200,187,94,95,1,54, // 96+2: 3868 -> 3153
+    96,97,98,99,251,113,47,131,203,245,152,234,10,230,107,228,244,231,209,197,112,121,236,227,20,11,156,195,237,201,77,179,28,214,30,16,36,33,34,147,66,91,128,44,86,166,108,177,105,45,110,200,204,49,46,183,52,158,194,153,88,248,65,172,154,75,62,155,7,48,235,141,68,161,70,71,72,73,74,208,76,170,191,250,80,81,213,83,84,85,243,3,175,164,90,181,190,92,27,103,1,40,159,230, // 96+4: 10038 -> 8664
+    96,67,98,99,100,101,102,103,218,245,224,50,116,187,211,86,49,184,10,115,205,13,14,108,16,247,18,154,53,198,180,23,21,197,26,27,28,31,30,229,47,214,240,227,36,157,38,39,195,41,46,58,171,1,239,12,48,221,128,32,241,33,216,217,56,57,35,59,238,203,231,63,181,65,107,131,162,251,118,178,72,73,206,236,135,25,190,246,80,81,82,83,160,149,144,3,153,89,90,243,210,93,94,95,1,107,200,217,126,113,74,254, // 96+8: 22576 -> 20230
+    96,97,159,206,100,140,17,103,207,105,146,107,108,203,110,175,248,1,154,191,4,169,232,76,52,9,10,11,200,41,14,3,16,180,18,236,20,135,153,23,137,192,249,167,157,198,30,229,32,128,158,6,109,253,78,179,40,168,42,165,115,247,46,47,48,49,213,51,98,53,54,244,56,57,126,59,246,184,22,138,64,65,111,238,68,69,70,190,231,73,74,75,161,77,145,152,178,81,254,43,251,85,79,204,88,250,90,60,92,93,50,2,1,26,65,39,185,146,216,39,136,62,173,57,209,151,181,157, // 96+16: 47528 -> 43120
+    96,162,6,230,127,8,28,106,143,216,215,107,81,46,235,40,252,223,137,115,42,134,118,80,120,121,207,72,153,142,4,138,213,183,19,218,190,195,234,196,14,132,224,17,238,189,20,164,22,136,24,53,123,186,241,152,30,31,172,176,197,35,36,229,38,177,144,41,175,188,117,45,58,47,48,237,192,51,52,146,11,55,56,57,250,59,60,97,9,63,5,65,32,111,68,69,70,71,54,73,170,75,49,124,77,171,227,253,185,83,248,179,191,87,108,89,90,91,92,93,209,155,1,213,95,111,226,65,38,11,138,131,91,45,66,172,250,196,28,36,4,65,84,150,131,237,111,32, // 96+26: 78650 -> 72057
+    96,35,40,157,180,137,102,103,200,132,46,97,166,53,170,147,106,71,227,115,243,98,37,119,254,121,112,193,19,17,163,127,0,161,219,236,4,5,85,7,8,213,164,11,203,231,14,250,184,42,23,54,125,175,171,83,43,216,126,149,28,214,70,31,210,223,34,111,150,242,26,39,226,138,239,68,44,45,187,47,48,190,145,51,114,110,1,141,56,215,253,59,60,195,158,21,240,65,208,67,255,249,72,235,199,211,74,75,76,197,82,79,146,81,113,153,84,192,122,87,88,89,99,182,92,63,94,174,1,96,107,232,91,127,218,252,149,221,6,77,102,173,36,31,232,167,116,250,70,137,201,76,184,188,72,222,33,86,25,7, // 96+32: 97408 -> 89516
+    128,129,130,1,244,240,106,5,226,37,139,144,164,39,115,13,14,15,227,17,45,55,20,21,22,212,201,236,26,234,28,215,59,50,239,136,34,183,56,151,38,135,40,41,142,180,44,157,46,47,132,66,222,85,52,138,217,187,252,57,58,219,156,61,62,78,159,36,54,67,96,246,229,140,72,233,253,208,76,77,48,131,80,122,82,83,84,248,193,202,88,197,179,211,102,218,121,221,224,97,238,99,100,101,216,153,104,137,87,95,250,109,200,111,112,113,126,33,116,182,0,145,162,103,149,120,124,181,3,127,1,126, // 128+2: 5128 -> 4440
+    128,129,130,131,249,1,234,3,4,5,180,97,122,9,10,11,185,13,14,15,64,77,18,232,150,197,136,208,173,236,26,142,28,78,30,8,144,138,34,215,70,37,179,39,40,151,239,199,149,45,227,47,219,17,50,187,52,53,54,134,159,57,58,189,48,254,62,35,107,65,148,67,194,145,188,55,22,73,74,250,252,186,146,200,80,251,82,46,114,141,113,140,181,153,255,36,92,162,94,0,224,25,98,190,100,101,168,103,157,66,106,61,245,109,31,217,112,242,116,115,203,117,206,182,120,233,56,192,63,125,126,127,1,100,234,246, // 128+4: 13428 -> 12003
+    128,214,147,126,132,133,134,95,0,140,2,146,171,5,6,7,8,141,130,11,221,121,246,15,16,144,26,19,20,21,154,109,232,166,12,218,28,29,30,31,51,227,138,35,27,37,118,39,241,104,42,43,94,45,46,108,40,49,158,225,153,129,220,55,56,57,196,60,163,74,62,63,64,86,148,67,68,69,177,180,72,107,127,75,76,61,78,50,80,112,82,83,181,253,25,87,245,89,79,255,211,164,215,182,96,145,247,84,100,167,102,103,188,105,9,159,71,77,110,111,252,113,114,143,229,193,101,119,120,216,122,176,124,125,240,88,1,153,52,52,184,255,133,115, // 128+8: 29840 -> 27526
+    128,129,119,105,180,244,235,9,136,234,138,139,140,141,142,143,0,1,147,3,154,5,6,162,8,163,10,11,12,13,70,28,16,206,18,19,227,21,231,184,200,29,174,27,215,82,31,213,32,33,228,35,253,44,38,190,40,41,42,126,194,117,46,47,48,185,50,146,171,53,63,106,218,249,58,219,199,61,195,59,64,55,221,67,68,170,150,71,251,73,74,204,76,56,122,79,75,226,158,83,192,65,86,144,137,198,240,91,92,157,94,175,96,236,78,60,100,101,181,189,104,156,186,107,108,109,225,220,112,113,114,81,116,7,118,178,120,201,45,183,103,191,52,127,1,168,221,109,104,232,195,94,115,13,101,131,115,205,19,211, // 128+16: 62960 -> 58713
+    128,179,212,5,176,133,134,125,182,137,138,224,140,141,142,159,242,185,146,175,254,100,231,151,152,229,204,1,49,164,67,245,6,7,8,21,139,11,244,13,14,149,16,17,18,161,70,222,250,201,247,78,158,64,28,54,30,237,32,33,163,170,36,37,38,190,240,75,42,43,25,27,15,47,48,63,136,246,52,191,3,89,40,57,58,59,197,193,12,97,154,87,66,0,61,69,46,71,72,215,74,200,118,77,110,79,80,143,82,199,84,85,183,73,221,35,90,203,92,227,119,95,96,148,98,99,101,107,102,188,169,105,104,162,157,109,233,208,112,132,44,232,116,117,34,86,56,230,2,123,124,186,126,127,1,151,114,86,22,221,142,28,198,232,148,23,210,253,255,6,135,218,234,128,7,22,73,64,237,115, // 128+26: 104322 -> 98044
+    128,95,130,171,132,119,170,226,247,137,57,191,189,59,43,60,134,41,212,185,196,193,27,202,190,235,54,155,234,145,158,159,0,210,2,177,213,5,254,7,8,58,201,11,12,162,238,194,239,240,205,228,126,223,22,169,24,69,214,186,28,46,203,161,241,33,225,198,36,47,38,167,40,25,133,39,44,206,149,51,48,49,50,17,204,53,243,55,111,211,253,230,23,61,62,35,21,180,138,231,68,64,70,71,72,73,74,229,76,77,78,216,80,81,182,83,63,85,84,249,199,89,255,91,92,139,94,227,219,236,179,15,26,101,102,103,1,125,242,217,108,109,110,32,112,113,114,115,187,117,118,18,120,121,122,123,175,176,127,184,1,29,73,237,128,50,74,142,202,39,217,74,64,48,207,183,101,250,88,209,192,119,113,99,143,31,3,124,233,99,120,4, // 128+32: 128992 -> 121592
+};
+
+// Original count, recovery count and offset of the parameters, sorted
+static const struct CM256MatrixEntry
+{
+    uint8_t OriginalCount;
+    uint8_t RecoveryCount;
+    uint16_t Offset;
+} CM256MatrixEntries[] = {
+    { 2, 2, 0 },
+    { 2, 3, 6 },
+    { 2, 4, 14 },
+    { 2, 5, 24 },
+    { 2, 6, 36 },
+    { 2, 7, 50 },
+    { 2, 8, 66 },
+    { 3, 2, 84 },
+    { 3, 3, 91 },
+    { 3, 4, 100 },
+    { 3, 5, 111 },
+    { 3, 6, 124 },
+    { 3, 7, 139 },
+    { 3, 8, 156 },
+    { 4, 2, 175 },
+    { 4, 3, 183 },
+    { 4, 4, 193 },
+    { 4, 5, 205 },
+    { 4, 6, 219 },
+    { 4, 7, 235 },
+    { 4, 8, 253 },
+    { 5, 2, 273 },
+    { 5, 3, 282 },
+    { 5, 4, 293 },
+    { 5, 5, 306 },
+    { 5, 6, 321 },
+    { 5, 7, 338 },
+    { 5, 8, 357 },
+    { 6, 2, 378 },
+    { 6, 3, 388 },
+    { 6, 4, 400 },
+    { 6, 5, 414 },
+    { 6, 6, 430 },
+    { 6, 7, 448 },
+    { 6, 8, 468 },
+    { 7, 2, 490 },
+    { 7, 3, 501 },
+    { 7, 4, 514 },
+    { 7, 5, 529 },
+    { 7, 6, 546 },
+    { 7, 7, 565 },
+    { 7, 8, 586 },
+    { 8, 2, 609 },
+    { 8, 3, 621 },
+    { 8, 4, 635 },
+    { 8, 5, 651 },
+    { 8, 6, 669 },
+    { 8, 7, 689 },
+    { 8, 8, 711 },
+    { 9, 2, 735 },
+    { 9, 3, 748 },
+    { 9, 4, 763 },
+    { 9, 5, 780 },
+    { 9, 6, 799 },
+    { 9, 7, 820 },
+    { 9, 8, 843 },
+    { 10, 2, 868 },
+    { 10, 3, 882 },
+    { 10, 4, 898 },
+    { 10, 5, 916 },
+    { 10, 6, 936 },
+    { 10, 7, 958 },
+    { 10, 8, 982 },
+    { 11, 2, 1008 },
+    { 11, 3, 1023 },
+    { 11, 4, 1040 },
+    { 11, 5, 1059 },
+    { 11, 6, 1080 },
+    { 11, 7, 1103 },
+    { 11, 8, 1128 },
+    { 12, 2, 1155 },
+    { 12, 3, 1171 },
+    { 12, 4, 1189 },
+    { 12, 5, 1209 },
+    { 12, 6, 1231 },
+    { 12, 7, 1255 },
+    { 12, 8, 1281 },
+    { 13, 2, 1309 },
+    { 13, 3, 1326 },
+    { 13, 4, 1345 },
+    { 13, 5, 1366 },
+    { 13, 6, 1389 },
+    { 13, 7, 1414 },
+    { 13, 8, 1441 },
+    { 14, 2, 1470 },
+    { 14, 3, 1488 },
+    { 14, 4, 1508 },
+    { 14, 5, 1530 },
+    { 14, 6, 1554 },
+    { 14, 7, 1580 },
+    { 14, 8, 1608 },
+    { 15, 2, 1638 },
+    { 15, 3, 1657 },
+    { 15, 4, 1678 },
+    { 15, 5, 1701 },
+    { 15, 6, 1726 },
+    { 15, 7, 1753 },
+    { 15, 8, 1782 },
+    { 16, 2, 1813 },
+    { 16, 3, 1833 },
+    { 16, 4, 1855 },
+    { 16, 5, 1879 },
+    { 16, 6, 1905 },
+    { 16, 7, 1933 },
+    { 16, 8, 1963 },
+    { 17, 2, 1995 },
+    { 17, 3, 2016 },
+    { 17, 4, 2039 },
+    { 17, 5, 2064 },
+    { 17, 6, 2091 },
+    { 17, 7, 2120 },
+    { 17, 8, 2151 },
+    { 18, 2, 2184 },
+    { 18, 3, 2206 },
+    { 18, 4, 2230 },
+    { 18, 5, 2256 },
+    { 18, 6, 2284 },
+    { 18, 7, 2314 },
+    { 18, 8, 2346 },
+    { 19, 2, 2380 },
+    { 19, 3, 2403 },
+    { 19, 4, 2428 },
+    { 19, 5, 2455 },
+    { 19, 6, 2484 },
+    { 19, 7, 2515 },
+    { 19, 8, 2548 },
+    { 20, 2, 2583 },
+    { 20, 3, 2607 },
+    { 20, 4, 2633 },
+    { 20, 5, 2661 },
+    { 20, 6, 2691 },
+    { 20, 7, 2723 },
+    { 20, 8, 2757 },
+    { 21, 2, 2793 },
+    { 21, 3, 2818 },
+    { 21, 4, 2845 },
+    { 21, 5, 2874 },
+    { 21, 6, 2905 },
+    { 21, 7, 2938 },
+    { 21, 8, 2973 },
+    { 22, 2, 3010 },
+    { 22, 3, 3036 },
+    { 22, 4, 3064 },
+    { 22, 5, 3094 },
+    { 22, 6, 3126 },
+    { 22, 7, 3160 },
+    { 22, 8, 3196 },
+    { 23, 2, 3234 },
+    { 23, 3, 3261 },
+    { 23, 4, 3290 },
+    { 23, 5, 3321 },
+    { 23, 6, 3354 },
+    { 23, 7, 3389 },
+    { 23, 8, 3426 },
+    { 24, 2, 3465 },
+    { 24, 3, 3493 },
+    { 24, 4, 3523 },
+    { 24, 5, 3555 },
+    { 24, 6, 3589 },
+    { 24, 7, 3625 },
+    { 24, 8, 3663 },
+    { 25, 2, 3703 },
+    { 25, 3, 3732 },
+    { 25, 4, 3763 },
+    { 25, 5, 3796 },
+    { 25, 6, 3831 },
+    { 25, 7, 3868 },
+    { 25, 8, 3907 },
+    { 26, 2, 3948 },
+    { 26, 3, 3978 },
+    { 26, 4, 4010 },
+    { 26, 5, 4044 },
+    { 26, 6, 4080 },
+    { 26, 7, 4118 },
+    { 26, 8, 4158 },
+    { 27, 2, 4200 },
+    { 27, 3, 4231 },
+    { 27, 4, 4264 },
+    { 27, 5, 4299 },
+    { 27, 6, 4336 },
+    { 27, 7, 4375 },
+    { 27, 8, 4416 },
+    { 28, 2, 4459 },
+    { 28, 3, 4491 },
+    { 28, 4, 4525 },
+    { 28, 5, 4561 },
+    { 28, 6, 4599 },
+    { 28, 7, 4639 },
+    { 28, 8, 4681 },
+    { 29, 2, 4725 },
+    { 29, 3, 4758 },
+    { 29, 4, 4793 },
+    { 29, 5, 4830 },
+    { 29, 6, 4869 },
+    { 29, 7, 4910 },
+    { 29, 8, 4953 },
+    { 30, 2, 4998 },
+    { 30, 3, 5032 },
+    { 30, 4, 5068 },
+    { 30, 5, 5106 },
+    { 30, 6, 5146 },
+    { 30, 7, 5188 },
+    { 30, 8, 5232 },
+    { 31, 2, 5278 },
+    { 31, 3, 5313 },
+    { 31, 4, 5350 },
+    { 31, 5, 5389 },
+    { 31, 6, 5430 },
+    { 31, 7, 5473 },
+    { 31, 8, 5518 },
+    { 32, 2, 5565 },
+    { 32, 3, 5601 },
+    { 32, 4, 5639 },
+    { 32, 5, 5679 },
+    { 32, 6, 5721 },
+    { 32, 7, 5765 },
+    { 32, 8, 5811 },
+    { 48, 2, 5859 },
+    { 48, 4, 5911 },
+    { 48, 8, 5967 },
+    { 48, 16, 6031 },
+    { 48, 26, 6111 },
+    { 48, 32, 6211 },
+    { 64, 2, 6323 },
+    { 64, 4, 6391 },
+    { 64, 8, 6463 },
+    { 64, 16, 6543 },
+    { 64, 26, 6639 },
+    { 64, 32, 6755 },
+    { 96, 2, 6883 },
+    { 96, 4, 6983 },
+    { 96, 8, 7087 },
+    { 96, 16, 7199 },
+    { 96, 26, 7327 },
+    { 96, 32, 7475 },
+    { 128, 2, 7635 },
+    { 128, 4, 7767 },
+    { 128, 8, 7903 },
+    { 128, 16, 8047 },
+    { 128, 26, 8207 },
+    { 128, 32, 8387 },
+};
+
+#endif // CM256MATRICES_H
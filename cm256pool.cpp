@@ -0,0 +1,216 @@
+/*
+    Copyright (c) 2016 Edouard M. Griffiths.  All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+    * Neither the name of CM256 nor the names of its contributors may be
+      used to endorse or promote products derived from this software without
+      specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+#include "cm256pool.h"
+
+class CM256Pool::Private
+{
+public:
+    Private() :
+        Stop(false),
+        Running(false),
+        Generation(0),
+        Active(0),
+        CurrentTask(nullptr),
+        CurrentArg(nullptr),
+        TaskCount(0),
+        NextIndex(0),
+        Pending(0)
+    {
+    }
+
+    // Take task indices until there are none left
+    void work(Task task, void* arg, int taskCount)
+    {
+        int index;
+
+        while ((index = NextIndex.fetch_add(1)) < taskCount)
+        {
+            task(arg, index);
+
+            if (Pending.fetch_sub(1) == 1)
+            {
+                std::lock_guard<std::mutex> lock(Mutex);
+                Done.notify_all();
+            }
+        }
+    }
+
+    void workerLoop()
+    {
+        unsigned long long seenGeneration = 0;
+
+        for (;;)
+        {
+            Task task;
+            void* arg;
+            int taskCount;
+
+            {
+                std::unique_lock<std::mutex> lock(Mutex);
+                Wake.wait(lock, [&] { return Stop || (Running && Generation != seenGeneration); });
+
+                if (Stop) {
+                    return;
+                }
+
+                // run() does not return before the workers that joined the job have left it
+                seenGeneration = Generation;
+                task = CurrentTask;
+                arg = CurrentArg;
+                taskCount = TaskCount;
+                Active++;
+            }
+
+            work(task, arg, taskCount);
+
+            std::lock_guard<std::mutex> lock(Mutex);
+
+            if (--Active == 0) {
+                Done.notify_all();
+            }
+        }
+    }
+
+    std::vector<std::thread> Threads;
+    std::mutex RunMutex;   // One run() at a time
+    std::mutex Mutex;      // Protects the job description, Running, Active and Stop
+    std::condition_variable Wake;
+    std::condition_variable Done;
+    bool Stop;
+    bool Running;
+    unsigned long long Generation;
+    int Active;
+    Task CurrentTask;
+    void* CurrentArg;
+    int TaskCount;
+    std::atomic<int> NextIndex;
+    std::atomic<int> Pending;
+};
+
+// Pin a thread to a CPU where the system supports it
+static void cm256_pool_set_affinity(std::thread& thread, int cpu)
+{
+#if defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(cpuSet), &cpuSet);
+#elif defined(_WIN32)
+    if (cpu < (int) (8 * sizeof(DWORD_PTR))) {
+        SetThreadAffinityMask((HANDLE) thread.native_handle(), ((DWORD_PTR) 1) << cpu);
+    }
+#else
+    (void) thread;
+    (void) cpu;
+#endif
+}
+
+CM256Pool::CM256Pool(int threadCount, int firstCpu) :
+    m_private(new Private()),
+    m_threadCount(threadCount)
+{
+    const int cpuCount = (int) std::thread::hardware_concurrency();
+
+    if (m_threadCount <= 0) {
+        m_threadCount = cpuCount > 1 ? cpuCount - 1 : 1;
+    }
+
+    for (int i = 0; i < m_threadCount; ++i)
+    {
+        m_private->Threads.push_back(std::thread(&Private::workerLoop, m_private));
+
+        if (firstCpu >= 0 && cpuCount > 0) {
+            cm256_pool_set_affinity(m_private->Threads.back(), (firstCpu + i) % cpuCount);
+        }
+    }
+}
+
+CM256Pool::~CM256Pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_private->Mutex);
+        m_private->Stop = true;
+    }
+
+    m_private->Wake.notify_all();
+
+    for (size_t i = 0; i < m_private->Threads.size(); ++i) {
+        m_private->Threads[i].join();
+    }
+
+    delete m_private;
+}
+
+void CM256Pool::run(Task task, void* arg, int taskCount)
+{
+    if (taskCount <= 0) {
+        return;
+    }
+
+    if (taskCount == 1)
+    {
+        task(arg, 0);
+        return;
+    }
+
+    std::lock_guard<std::mutex> runLock(m_private->RunMutex);
+
+    {
+        std::lock_guard<std::mutex> lock(m_private->Mutex);
+        m_private->CurrentTask = task;
+        m_private->CurrentArg = arg;
+        m_private->TaskCount = taskCount;
+        m_private->NextIndex = 0;
+        m_private->Pending = taskCount;
+        m_private->Generation++;
+        m_private->Running = true;
+    }
+
+    m_private->Wake.notify_all();
+
+    // The calling thread works too, then waits for the tasks taken by the workers
+    m_private->work(task, arg, taskCount);
+
+    std::unique_lock<std::mutex> lock(m_private->Mutex);
+    m_private->Done.wait(lock, [this] { return m_private->Pending == 0 && m_private->Active == 0; });
+    m_private->Running = false;
+}
@@ -0,0 +1,75 @@
+/*
+    Copyright (c) 2016 Edouard M. Griffiths.  All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+    * Neither the name of CM256 nor the names of its contributors may be
+      used to endorse or promote products derived from this software without
+      specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CM256POOL_H
+#define CM256POOL_H
+
+#include "export.h"
+
+/*
+ * Persistent worker threads for the codec
+ *
+ * The threads are created with the pool and wait for work between calls to
+ * run(), so splitting a frame across them costs a wake up rather than a
+ * thread creation.  A pool may be shared by several CM256 objects, the calls
+ * to run() are then serialized.
+ */
+class CM256CC_API CM256Pool
+{
+public:
+    // Function run for each task index, 'arg' is passed through from run()
+    typedef void (*Task)(void* arg, int index);
+
+    /*
+     * Start 'threadCount' worker threads, 0 for one less than the number of
+     * hardware threads since the thread calling run() takes part in the work.
+     *
+     * If 'firstCpu' is not negative worker i is pinned to CPU firstCpu + i
+     * (modulo the number of CPUs) where the system supports it.  This is only
+     * a hint, failures are ignored.
+     */
+    CM256Pool(int threadCount = 0, int firstCpu = -1);
+    ~CM256Pool();
+
+    CM256Pool(const CM256Pool&) = delete;
+    CM256Pool& operator=(const CM256Pool&) = delete;
+
+    // Number of worker threads, not counting the caller of run()
+    int getThreadCount() const { return m_threadCount; }
+
+    // Run task(arg, index) for index 0 to taskCount - 1 on the workers and the
+    // calling thread and return when they are all done.
+    void run(Task task, void* arg, int taskCount);
+
+private:
+    class Private;
+    Private* m_private;
+    int m_threadCount;
+};
+
+#endif // CM256POOL_H
@@ -0,0 +1,616 @@
+/*
+    Copyright (c) 2016 Edouard M. Griffiths.  All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+    * Neither the name of CM256 nor the names of its contributors may be
+      used to endorse or promote products derived from this software without
+      specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include <vector>
+
+#include "cm65536.h"
+#include "cm65536fft.h"
+
+// Size of the original data tiles the tile size aims at
+static const int CM65536TileCacheBytes = 128 * 1024;
+// Smallest tile, over which the multiplication tables built at each kernel
+// call are amortized
+static const int CM65536MinTileBytes = 4096;
+
+CM65536::CM65536() :
+    m_initialized(false),
+    m_engine(EngineCauchy),
+    m_fft(nullptr)
+{
+    m_initialized = m_gf65536Ctx.isInitialized();
+}
+
+CM65536::~CM65536()
+{
+    delete m_fft;
+}
+
+void CM65536::setEngine(Engine engine)
+{
+    if (engine == EngineFFT && !m_fft) {
+        m_fft = new CM65536FFT(m_gf65536Ctx);
+    }
+
+    m_engine = engine;
+}
+
+int CM65536::cm65536_get_tile_bytes(cm65536_encoder_params params)
+{
+    int tileBytes = (CM65536TileCacheBytes / params.OriginalCount) & ~63;
+
+    if (tileBytes < CM65536MinTileBytes) {
+        tileBytes = CM65536MinTileBytes;
+    }
+
+    return tileBytes < params.BlockBytes ? tileBytes : params.BlockBytes;
+}
+
+
+//-----------------------------------------------------------------------------
+// Encoding
+
+void CM65536::cm65536_encode_block(
+    cm65536_encoder_params params, // Encoder parameters
+    cm65536_block* originals,      // Array of pointers to original blocks
+    int recoveryBlockIndex,        // Return value from cm65536_get_recovery_block_index()
+    void* recoveryBlock)           // Output recovery block
+{
+    std::vector<const void*> originalBlocks(params.OriginalCount);
+
+    for (int j = 0; j < params.OriginalCount; ++j)
+    {
+        originalBlocks[j] = originals[j].Block;
+    }
+
+    // If only one block of input data,
+    if (params.OriginalCount == 1)
+    {
+        // No meaningful operation here, degenerate to outputting the same data each time.
+        memcpy(recoveryBlock, originals[0].Block, params.BlockBytes);
+        return;
+    }
+
+    // The first recovery block is the sum of the originals
+    if (recoveryBlockIndex == params.OriginalCount)
+    {
+        gf256_ctx::gf256_addset_multi_mem(recoveryBlock, originalBlocks.data(), params.OriginalCount, params.BlockBytes);
+        return;
+    }
+
+    // Start the x_0 values arbitrarily from the original count.
+    const uint16_t x_0 = static_cast<uint16_t>(params.OriginalCount);
+    const uint16_t x_i = static_cast<uint16_t>(recoveryBlockIndex);
+    std::vector<uint16_t> matrixRow(params.OriginalCount);
+
+    for (int j = 0; j < params.OriginalCount; ++j)
+    {
+        matrixRow[j] = m_gf65536Ctx.getMatrixElement(x_i, x_0, static_cast<uint16_t>(j));
+    }
+
+    m_gf65536Ctx.gf65536_mul_multi_mem(recoveryBlock, matrixRow.data(), originalBlocks.data(), params.OriginalCount, params.BlockBytes);
+}
+
+int CM65536::cm65536_encode(
+    cm65536_encoder_params params, // Encoder parameters
+    cm65536_block* originals,      // Array of pointers to original blocks
+    void* recoveryBlocks)          // Output recovery blocks end-to-end
+{
+    // Validate input:
+    if (params.OriginalCount <= 0 ||
+        params.RecoveryCount <= 0 ||
+        params.BlockBytes <= 0 ||
+        (params.BlockBytes & 1) != 0)
+    {
+        return -1;
+    }
+    if (params.OriginalCount + params.RecoveryCount > 65536)
+    {
+        return -2;
+    }
+    if (!originals || !recoveryBlocks)
+    {
+        return -3;
+    }
+
+    if (m_engine == EngineFFT)
+    {
+        if (!CM65536FFT::fits(params)) {
+            return -2;
+        }
+
+        m_fft->encode(params, originals, recoveryBlocks);
+        return 0;
+    }
+
+    std::vector<const void*> originalBlocks(params.OriginalCount);
+
+    for (int j = 0; j < params.OriginalCount; ++j)
+    {
+        originalBlocks[j] = originals[j].Block;
+    }
+
+    // Each tile of the originals is read once for all the recovery blocks
+    const int tileBytes = cm65536_get_tile_bytes(params);
+
+    for (int offset = 0; offset < params.BlockBytes; offset += tileBytes)
+    {
+        const int bytes = params.BlockBytes - offset < tileBytes ? params.BlockBytes - offset : tileBytes;
+        cm65536_encode_range(params, originalBlocks.data(), recoveryBlocks, offset, bytes);
+    }
+
+    return 0;
+}
+
+void CM65536::cm65536_encode_range(
+    cm65536_encoder_params params,    // Encoder parameters
+    const void* const* originals,     // Array of pointers to original blocks
+    void* recoveryBlocks,             // Output recovery blocks end-to-end
+    int offset,                       // Start of the range in the blocks
+    int bytes)                        // Number of bytes of the range
+{
+    std::vector<const void*> tileOriginals(params.OriginalCount);
+    uint8_t* recoveryBlock = static_cast<uint8_t*>(recoveryBlocks) + offset;
+
+    for (int j = 0; j < params.OriginalCount; ++j)
+    {
+        tileOriginals[j] = static_cast<const uint8_t*>(originals[j]) + offset;
+    }
+
+    // If only one block of input data,
+    if (params.OriginalCount == 1)
+    {
+        // No meaningful operation here, degenerate to outputting the same data each time.
+        for (int block = 0; block < params.RecoveryCount; ++block, recoveryBlock += params.BlockBytes)
+        {
+            memcpy(recoveryBlock, tileOriginals[0], bytes);
+        }
+
+        return;
+    }
+
+    // The first recovery block is the sum of the originals
+    gf256_ctx::gf256_addset_multi_mem(recoveryBlock, tileOriginals.data(), params.OriginalCount, bytes);
+    recoveryBlock += params.BlockBytes;
+
+    // Start the x_0 values arbitrarily from the original count.
+    const uint16_t x_0 = static_cast<uint16_t>(params.OriginalCount);
+    std::vector<uint16_t> matrixRow(params.OriginalCount);
+
+    for (int block = 1; block < params.RecoveryCount; ++block, recoveryBlock += params.BlockBytes)
+    {
+        const uint16_t x_i = static_cast<uint16_t>(params.OriginalCount + block);
+
+        for (int j = 0; j < params.OriginalCount; ++j)
+        {
+            matrixRow[j] = m_gf65536Ctx.getMatrixElement(x_i, x_0, static_cast<uint16_t>(j));
+        }
+
+        m_gf65536Ctx.gf65536_mul_multi_mem(recoveryBlock, matrixRow.data(), tileOriginals.data(), params.OriginalCount, bytes);
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Decoding
+
+class CM65536::CM65536Decoder
+{
+public:
+    CM65536Decoder(const gf65536_ctx& gf65536Ctx) :
+        m_gf65536Ctx(gf65536Ctx)
+    {
+    }
+
+    // Sort the blocks into originals and recovery blocks and list the erased
+    // original indices.  Returns false on invalid input.
+    bool Initialize(cm65536_encoder_params& params, cm65536_block* blocks);
+
+    // m = 1 special case
+    void DecodeM1();
+
+    // m > 1
+    void Decode();
+
+    // Number of received original and recovery blocks
+    int OriginalCount;
+    int RecoveryCount;
+
+private:
+    // Compute the LDU decomposition of the matrix of the erasures
+    void GenerateLDUDecomposition();
+
+    // Run all the decoding phases on a range of the blocks
+    void DecodeRange(int offset, int bytes);
+
+    const gf65536_ctx& m_gf65536Ctx;
+    cm65536_encoder_params Params;
+
+    std::vector<cm65536_block*> Original;
+    std::vector<cm65536_block*> Recovery;
+    std::vector<uint16_t> ErasuresIndices;
+
+    // Original elimination rows, then the lower triangle of L column by
+    // column top-down, the diagonal D, and the upper triangle of U column by
+    // column bottom-up
+    std::vector<uint16_t> MatrixOriginals;
+    std::vector<uint16_t> MatrixL;
+    std::vector<uint16_t> DiagD;
+    std::vector<uint16_t> MatrixU;
+};
+
+bool CM65536::CM65536Decoder::Initialize(cm65536_encoder_params& params, cm65536_block* blocks)
+{
+    Params = params;
+
+    OriginalCount = 0;
+    RecoveryCount = 0;
+
+    std::vector<uint8_t> received(params.OriginalCount, 0);
+    std::vector<uint8_t> recoveryReceived(params.RecoveryCount, 0);
+
+    // For each input block,
+    for (int ii = 0; ii < params.OriginalCount; ++ii)
+    {
+        cm65536_block* block = blocks + ii;
+        const int row = block->Index;
+
+        // If it is an original block,
+        if (row < params.OriginalCount)
+        {
+            if (received[row] != 0)
+            {
+                // Error out if two row indices repeat
+                return false;
+            }
+
+            received[row] = 1;
+            Original.push_back(block);
+            OriginalCount++;
+        }
+        else
+        {
+            const int recoveryRow = row - params.OriginalCount;
+
+            if (recoveryRow >= params.RecoveryCount || recoveryReceived[recoveryRow] != 0)
+            {
+                // Error out on unknown or repeated recovery rows: the
+                // matching Cauchy rows would make the matrix singular
+                return false;
+            }
+
+            recoveryReceived[recoveryRow] = 1;
+            Recovery.push_back(block);
+            RecoveryCount++;
+        }
+    }
+
+    // Identify erasures
+    for (int ii = 0; ii < params.OriginalCount; ++ii)
+    {
+        if (!received[ii])
+        {
+            ErasuresIndices.push_back(static_cast<uint16_t>(ii));
+        }
+    }
+
+    return true;
+}
+
+void CM65536::CM65536Decoder::DecodeM1()
+{
+    // XOR all other blocks into the recovery block
+    std::vector<const void*> inBlocks(OriginalCount);
+
+    for (int ii = 0; ii < OriginalCount; ++ii)
+    {
+        inBlocks[ii] = Original[ii]->Block;
+    }
+
+    gf256_ctx::gf256_add_multi_mem(Recovery[0]->Block, inBlocks.data(), OriginalCount, Params.BlockBytes);
+
+    // Recover the index it corresponds to
+    Recovery[0]->Index = ErasuresIndices[0];
+}
+
+void CM65536::CM65536Decoder::GenerateLDUDecomposition()
+{
+    // Same Schur-type-direct-Cauchy algorithm as CM256::CM256Decoder, see there
+    const int N = RecoveryCount;
+
+    MatrixL.resize((N - 1) * N / 2 + 1);
+    DiagD.resize(N);
+    MatrixU.resize((N - 1) * N / 2 + 1);
+
+    // Generators
+    std::vector<uint16_t> g(N, 1), b(N, 1);
+
+    // Temporary buffer for rotated row of U matrix
+    std::vector<uint16_t> rotated_row_U(N);
+    uint16_t* matrix_L = MatrixL.data();
+    const int last_U = ((N - 1) * N) / 2 - 1;
+    int firstOffset_U = 0;
+
+    // Start the x_0 values arbitrarily from the original count.
+    const uint16_t x_0 = static_cast<uint16_t>(Params.OriginalCount);
+
+    for (int k = 0; k < N - 1; ++k)
+    {
+        const uint16_t x_k = Recovery[k]->Index;
+        const uint16_t y_k = ErasuresIndices[k];
+
+        // D_kk = (x_k + y_k)
+        // L_kk = g[k] / (x_k + y_k)
+        // U_kk = b[k] * (x_0 + y_k) / (x_k + y_k)
+        const uint16_t D_kk = gf65536_ctx::gf65536_add(x_k, y_k);
+        const uint16_t L_kk = m_gf65536Ctx.gf65536_div(g[k], D_kk);
+        const uint16_t U_kk = m_gf65536Ctx.gf65536_mul(m_gf65536Ctx.gf65536_div(b[k], D_kk), gf65536_ctx::gf65536_add(x_0, y_k));
+
+        // diag_D[k] = D_kk * L_kk * U_kk
+        DiagD[k] = m_gf65536Ctx.gf65536_mul(D_kk, m_gf65536Ctx.gf65536_mul(L_kk, U_kk));
+
+        // Computing the k-th row of L and U, divided by L_kk and U_kk
+        const uint16_t inv_L_kk = m_gf65536Ctx.gf65536_inv(L_kk);
+        const uint16_t inv_U_kk = m_gf65536Ctx.gf65536_inv(U_kk);
+        uint16_t* row_U = rotated_row_U.data();
+
+        for (int j = k + 1; j < N; ++j)
+        {
+            const uint16_t x_j = Recovery[j]->Index;
+            const uint16_t y_j = ErasuresIndices[j];
+
+            // L_jk = g[j] / (x_j + y_k)
+            // U_kj = b[j] / (x_k + y_j)
+            const uint16_t L_jk = m_gf65536Ctx.gf65536_div(g[j], gf65536_ctx::gf65536_add(x_j, y_k));
+            const uint16_t U_kj = m_gf65536Ctx.gf65536_div(b[j], gf65536_ctx::gf65536_add(x_k, y_j));
+
+            *matrix_L++ = m_gf65536Ctx.gf65536_mul(L_jk, inv_L_kk);
+            *row_U++ = m_gf65536Ctx.gf65536_mul(U_kj, inv_U_kk);
+
+            // g[j] = g[j] * (x_j + x_k) / (x_j + y_k)
+            // b[j] = b[j] * (y_j + y_k) / (y_j + x_k)
+            g[j] = m_gf65536Ctx.gf65536_mul(g[j], m_gf65536Ctx.gf65536_div(gf65536_ctx::gf65536_add(x_j, x_k), gf65536_ctx::gf65536_add(x_j, y_k)));
+            b[j] = m_gf65536Ctx.gf65536_mul(b[j], m_gf65536Ctx.gf65536_div(gf65536_ctx::gf65536_add(y_j, y_k), gf65536_ctx::gf65536_add(y_j, x_k)));
+        }
+
+        // Copy U matrix row into place in memory.
+        uint16_t* output_U = MatrixU.data() + last_U + firstOffset_U;
+        row_U = rotated_row_U.data();
+        for (int j = k + 1; j < N; ++j)
+        {
+            *output_U = *row_U++;
+            output_U -= j;
+        }
+        firstOffset_U -= k + 2;
+    }
+
+    // Multiply diagonal matrix into U
+    uint16_t* row_U = MatrixU.data();
+    for (int j = N - 1; j > 0; --j)
+    {
+        const uint16_t x0_y_j = gf65536_ctx::gf65536_add(x_0, ErasuresIndices[j]);
+
+        for (int i = 0; i < j; ++i, ++row_U) {
+            *row_U = m_gf65536Ctx.gf65536_mul(*row_U, x0_y_j);
+        }
+    }
+
+    const uint16_t x_n = Recovery[N - 1]->Index;
+    const uint16_t y_n = ErasuresIndices[N - 1];
+
+    // D_nn = 1 / (x_n + y_n)
+    // L_nn = g[N-1]
+    // U_nn = b[N-1] * (x_0 + y_n)
+    const uint16_t L_nn = g[N - 1];
+    const uint16_t U_nn = m_gf65536Ctx.gf65536_mul(b[N - 1], gf65536_ctx::gf65536_add(x_0, y_n));
+
+    // diag_D[N-1] = L_nn * D_nn * U_nn
+    DiagD[N - 1] = m_gf65536Ctx.gf65536_div(m_gf65536Ctx.gf65536_mul(L_nn, U_nn), gf65536_ctx::gf65536_add(x_n, y_n));
+}
+
+void CM65536::CM65536Decoder::Decode()
+{
+    // Matrix size is NxN, where N is the number of recovery blocks used.
+    const int N = RecoveryCount;
+
+    // Start the x_0 values arbitrarily from the original count.
+    const uint16_t x_0 = static_cast<uint16_t>(Params.OriginalCount);
+
+    // Original elimination matrix, one row of OriginalCount elements per recovery row
+    MatrixOriginals.resize((size_t) N * OriginalCount);
+    uint16_t* matrixRow = MatrixOriginals.data();
+
+    for (int recoveryIndex = 0; recoveryIndex < N; ++recoveryIndex, matrixRow += OriginalCount)
+    {
+        const uint16_t x_i = Recovery[recoveryIndex]->Index;
+
+        for (int originalIndex = 0; originalIndex < OriginalCount; ++originalIndex)
+        {
+            const uint16_t y_j = Original[originalIndex]->Index;
+            matrixRow[originalIndex] = m_gf65536Ctx.getMatrixElement(x_i, x_0, y_j);
+        }
+    }
+
+    /*
+        Compute matrix decomposition:
+
+            G = L * D * U
+
+        L is lower-triangular, diagonal is all ones.
+        D is a diagonal matrix.
+        U is upper-triangular, diagonal is all ones.
+    */
+    GenerateLDUDecomposition();
+
+    // Run all the phases on a tile of the blocks while it is in cache
+    const int tileBytes = cm65536_get_tile_bytes(Params);
+
+    for (int offset = 0; offset < Params.BlockBytes; offset += tileBytes)
+    {
+        DecodeRange(offset, Params.BlockBytes - offset < tileBytes ? Params.BlockBytes - offset : tileBytes);
+    }
+
+    for (int i = 0; i < N; ++i)
+    {
+        Recovery[i]->Index = ErasuresIndices[i];
+    }
+}
+
+void CM65536::CM65536Decoder::DecodeRange(int offset, int bytes)
+{
+    // Matrix size is NxN, where N is the number of recovery blocks used.
+    const int N = RecoveryCount;
+
+    // Data of the range in the original and recovery blocks
+    std::vector<const void*> inBlocks(OriginalCount);
+    std::vector<uint8_t*> recoveryBlocks(N);
+    std::vector<void*> outBlocks(N);
+
+    for (int originalIndex = 0; originalIndex < OriginalCount; ++originalIndex)
+    {
+        inBlocks[originalIndex] = static_cast<const uint8_t*>(Original[originalIndex]->Block) + offset;
+    }
+
+    for (int recoveryIndex = 0; recoveryIndex < N; ++recoveryIndex)
+    {
+        recoveryBlocks[recoveryIndex] = static_cast<uint8_t*>(Recovery[recoveryIndex]->Block) + offset;
+    }
+
+    // Eliminate original data from the the recovery rows
+    const uint16_t* matrixRow = MatrixOriginals.data();
+
+    for (int recoveryIndex = 0; recoveryIndex < N; ++recoveryIndex, matrixRow += OriginalCount)
+    {
+        m_gf65536Ctx.gf65536_muladd_multi_mem(recoveryBlocks[recoveryIndex], matrixRow, inBlocks.data(), OriginalCount, bytes);
+    }
+
+    /*
+        Eliminate lower left triangle.
+    */
+    const uint16_t* matrix_L = MatrixL.data();
+
+    // For each column,
+    for (int j = 0; j < N - 1; ++j)
+    {
+        // For each row,
+        for (int i = j + 1; i < N; ++i)
+        {
+            outBlocks[i - (j + 1)] = recoveryBlocks[i];
+        }
+
+        // Matrix elements are stored column-first, top-down.
+        const int count = N - (j + 1);
+        m_gf65536Ctx.gf65536_muladd_multi_dest_mem(outBlocks.data(), matrix_L, recoveryBlocks[j], count, bytes);
+        matrix_L += count;
+    }
+
+    /*
+        Eliminate diagonal.
+    */
+    for (int i = 0; i < N; ++i)
+    {
+        m_gf65536Ctx.gf65536_div_mem(recoveryBlocks[i], recoveryBlocks[i], DiagD[i], bytes);
+    }
+
+    /*
+        Eliminate upper right triangle.
+    */
+    const uint16_t* matrix_U = MatrixU.data();
+
+    for (int j = N - 1; j >= 1; --j)
+    {
+        for (int i = j - 1; i >= 0; --i)
+        {
+            outBlocks[(j - 1) - i] = recoveryBlocks[i];
+        }
+
+        // Matrix elements are stored column-first, bottom-up.
+        m_gf65536Ctx.gf65536_muladd_multi_dest_mem(outBlocks.data(), matrix_U, recoveryBlocks[j], j, bytes);
+        matrix_U += j;
+    }
+}
+
+int CM65536::cm65536_decode(
+    cm65536_encoder_params params, // Encoder parameters
+    cm65536_block* blocks)         // Array of 'originalCount' blocks as described above
+{
+    if (params.OriginalCount <= 0 ||
+        params.RecoveryCount <= 0 ||
+        params.BlockBytes <= 0 ||
+        (params.BlockBytes & 1) != 0)
+    {
+        return -1;
+    }
+    if (params.OriginalCount + params.RecoveryCount > 65536)
+    {
+        return -2;
+    }
+    if (!blocks)
+    {
+        return -3;
+    }
+    if (m_engine == EngineFFT && !CM65536FFT::fits(params))
+    {
+        return -2;
+    }
+
+    // If there is only one block,
+    if (params.OriginalCount == 1)
+    {
+        // It is the same block repeated
+        blocks[0].Index = 0;
+        return 0;
+    }
+
+    if (m_engine == EngineFFT) {
+        return m_fft->decode(params, blocks);
+    }
+
+    CM65536Decoder state(m_gf65536Ctx);
+    if (!state.Initialize(params, blocks))
+    {
+        return -5;
+    }
+
+    // If nothing is erased,
+    if (state.RecoveryCount <= 0)
+    {
+        return 0;
+    }
+
+    // If m=1,
+    if (params.RecoveryCount == 1)
+    {
+        state.DecodeM1();
+        return 0;
+    }
+
+    // Decode for m>1
+    state.Decode();
+    return 0;
+}
@@ -0,0 +1,176 @@
+/*
+    Copyright (c) 2016 Edouard M. Griffiths.  All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+    * Neither the name of CM256 nor the names of its contributors may be
+      used to endorse or promote products derived from this software without
+      specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifndef CM65536_H
+#define CM65536_H
+
+#include <assert.h>
+#include <stdint.h>
+#include "gf65536.h"
+#include "export.h"
+
+/*
+ * Cauchy MDS codec over GF(65536)
+ *
+ * Same construction and decoder as CM256, with 16-bit field elements so that
+ * originals and recovery blocks may add up to 65536 blocks instead of 256.
+ * This keeps a large object or a long superframe in a single code rather
+ * than many independent ones, at the price of slower arithmetic than GF(256)
+ * and of decoder matrices that grow with the square of the erasure count.
+ *
+ * The blocks are sequences of 16-bit little-endian elements so BlockBytes
+ * must be even.  Error codes are those of CM256.
+ *
+ * An alternative engine, selected with setEngine(), computes a Reed-Solomon
+ * code with the additive FFT of Lin, Chung and Han in O(n log n) operations
+ * per element instead of the O(k * m) of the Cauchy matrix.  It pays for
+ * large codes, see cm65536_bench for the crossover.  The two engines produce
+ * different recovery blocks: the encoder and the decoder must use the same.
+ */
+class CM256CC_API CM65536
+{
+public:
+    // Encoder parameters
+    typedef struct cm65536_encoder_params_t {
+        // Original block count
+        int OriginalCount;
+
+        // Recovery block count, OriginalCount + RecoveryCount <= 65536
+        int RecoveryCount;
+
+        // Number of bytes per block, even (all blocks are the same size in bytes)
+        int BlockBytes;
+    } cm65536_encoder_params;
+
+    // Descriptor for data block
+    typedef struct cm65536_block_t {
+        // Pointer to data received.
+        void* Block;
+
+        // Block index.
+        // For original data, it will be in the range
+        //    [0..(originalCount-1)] inclusive.
+        // For recovery data, the first one's Index must be originalCount,
+        //    and it will be in the range
+        //    [originalCount..(originalCount+recoveryCount-1)] inclusive.
+        uint16_t Index;
+        // Ignored during encoding, required during decoding.
+    } cm65536_block;
+
+    // Code computed by the encoder and the decoder
+    enum Engine
+    {
+        EngineCauchy, // Cauchy matrix, the default
+        EngineFFT     // Additive FFT, OriginalCount + (RecoveryCount rounded up to a power of 2) <= 65536
+    };
+
+    CM65536();
+    ~CM65536();
+
+    CM65536(const CM65536&) = delete;
+    CM65536& operator=(const CM65536&) = delete;
+
+    bool isInitialized() const { return m_initialized; };
+
+    // Select the engine, building the FFT tables on first use
+    void setEngine(Engine engine);
+    Engine getEngine() const { return m_engine; }
+
+    /*
+     * Cauchy MDS GF(65536) encode
+     *
+     * This produces a set of recovery blocks that should be transmitted after the
+     * original data blocks, as for CM256::cm256_encode().
+     *
+     * Returns 0 on success, and any other code indicates failure.
+     */
+    int cm65536_encode(
+        cm65536_encoder_params params, // Encoder parameters
+        cm65536_block* originals,      // Array of pointers to original blocks
+        void* recoveryBlocks);         // Output recovery blocks end-to-end
+
+    // Encode one block with the Cauchy engine, whatever the engine selected.
+    // Note: This function does not validate input, use with care.
+    void cm65536_encode_block(
+        cm65536_encoder_params params, // Encoder parameters
+        cm65536_block* originals,      // Array of pointers to original blocks
+        int recoveryBlockIndex,        // Return value from cm65536_get_recovery_block_index()
+        void* recoveryBlock);          // Output recovery block
+
+    /*
+     * Cauchy MDS GF(65536) decode
+     *
+     * This recovers the original data from the recovery data in the provided
+     * blocks, in place, as for CM256::cm256_decode().
+     *
+     * Returns 0 on success, and any other code indicates failure.
+     */
+    int cm65536_decode(
+        cm65536_encoder_params params, // Encoder parameters
+        cm65536_block* blocks);        // Array of 'originalCount' blocks as described above
+
+    // Size of the column tiles encoded and decoded at once
+    static int cm65536_get_tile_bytes(cm65536_encoder_params params);
+
+    /*
+     * Commodity functions
+     */
+
+    // Compute the value to put in the Index member of cm65536_block
+    static inline uint16_t cm65536_get_recovery_block_index(cm65536_encoder_params params, int recoveryBlockIndex)
+    {
+        assert(recoveryBlockIndex >= 0 && recoveryBlockIndex < params.RecoveryCount);
+        return (uint16_t)(params.OriginalCount + recoveryBlockIndex);
+    }
+    static inline uint16_t cm65536_get_original_block_index(cm65536_encoder_params params, int originalBlockIndex)
+    {
+        (void) params;
+        assert(originalBlockIndex >= 0 && originalBlockIndex < params.OriginalCount);
+        return (uint16_t)(originalBlockIndex);
+    }
+
+private:
+    class CM65536Decoder;
+    class CM65536FFT;
+
+    // Encode 'bytes' bytes from 'offset' of all the recovery blocks
+    void cm65536_encode_range(
+        cm65536_encoder_params params,    // Encoder parameters
+        const void* const* originals,     // Array of pointers to original blocks
+        void* recoveryBlocks,             // Output recovery blocks end-to-end
+        int offset,                       // Start of the range in the blocks
+        int bytes);                       // Number of bytes of the range
+
+    gf65536_ctx m_gf65536Ctx;
+    bool m_initialized;
+    Engine m_engine;
+    CM65536FFT* m_fft;
+};
+
+#endif // CM65536_H
@@ -0,0 +1,451 @@
+/*
+    Copyright (c) 2016 Edouard M. Griffiths.  All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+    * Neither the name of CM256 nor the names of its contributors may be
+      used to endorse or promote products derived from this software without
+      specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include <string.h>
+
+#include "cm65536fft.h"
+
+// Cantor basis of GF(65536) for x^16 + x^5 + x^3 + x^2 + 1: beta_0 = 1 and
+// beta_i^2 + beta_i = beta_(i-1), so that the subspaces it spans are closed
+// under the maps of the transform layers
+static const uint16_t CM65536FFTCantorBasis[16] = {
+    0x0001, 0xACCA, 0x3C0E, 0x163E,
+    0xC582, 0xED2E, 0x914C, 0x4012,
+    0x6C98, 0x10D8, 0x6A72, 0xB900,
+    0xFDB8, 0xFB34, 0xFF38, 0x991E
+};
+
+// Order of the multiplicative group, logarithms are taken modulo this
+static const unsigned CM65536FFTModulus = 65535;
+
+// Size of the block tiles the transforms work on, at once in cache
+static const int CM65536FFTCacheBytes = 256 * 1024;
+// Smallest tile, over which the multiplication tables built at each kernel
+// call are amortized
+static const int CM65536FFTMinTileBytes = 4096;
+
+static inline int cm65536_fft_pow2(int x)
+{
+    int p = 1;
+
+    while (p < x) {
+        p <<= 1;
+    }
+
+    return p;
+}
+
+static int cm65536_fft_tile_bytes(int blockCount, int blockBytes)
+{
+    int tileBytes = (CM65536FFTCacheBytes / blockCount) & ~63;
+
+    if (tileBytes < CM65536FFTMinTileBytes) {
+        tileBytes = CM65536FFTMinTileBytes;
+    }
+
+    return tileBytes < blockBytes ? tileBytes : blockBytes;
+}
+
+// Walsh-Hadamard transform modulo 65535 of 'size' logarithms
+static void cm65536_fft_fwht(uint16_t* data, int size)
+{
+    for (int width = 1; width < size; width <<= 1)
+    {
+        for (int j = 0; j < size; j += width << 1)
+        {
+            for (int i = j; i < j + width; ++i)
+            {
+                const unsigned a = data[i];
+                const unsigned b = data[i + width];
+                data[i] = static_cast<uint16_t>((a + b) % CM65536FFTModulus);
+                data[i + width] = static_cast<uint16_t>((a + CM65536FFTModulus - b) % CM65536FFTModulus);
+            }
+        }
+    }
+}
+
+CM65536::CM65536FFT::CM65536FFT(const gf65536_ctx& gf65536Ctx) :
+    m_gf65536Ctx(gf65536Ctx),
+    m_logPoints(65536),
+    m_skew(CM65536FFTModulus),
+    m_logWalsh(2 * 65536 - 1)
+{
+    // Point i is the combination of the basis elements given by the bits of i
+    std::vector<uint16_t> points(65536);
+    points[0] = 0;
+
+    for (int b = 0; b < 16; ++b)
+    {
+        for (int j = 0; j < (1 << b); ++j) {
+            points[j + (1 << b)] = points[j] ^ CM65536FFTCantorBasis[b];
+        }
+    }
+
+    // Logarithms of the points and back, so that products of points are
+    // points again while the skew factors are built
+    std::vector<uint16_t> expPoints(65536);
+    m_logPoints[0] = CM65536FFTModulus;
+
+    for (int i = 1; i < 65536; ++i)
+    {
+        m_logPoints[i] = m_gf65536Ctx.GF65536_LOG_TABLE[points[i]];
+        expPoints[m_logPoints[i]] = static_cast<uint16_t>(i);
+    }
+
+    expPoints[CM65536FFTModulus] = expPoints[0];
+
+    // Point a times exp(log)
+    auto mulPoint = [&](uint16_t a, unsigned log) -> uint16_t {
+        return a ? expPoints[(m_logPoints[a] + log) % CM65536FFTModulus] : 0;
+    };
+
+    // Skew factors: the subspace polynomials of each layer evaluated at the
+    // points, normalized, see the reference code of the paper
+    uint16_t base[15];
+
+    for (int i = 1; i < 16; ++i) {
+        base[i - 1] = static_cast<uint16_t>(1 << i);
+    }
+
+    for (int m = 0; m < 15; ++m)
+    {
+        const int step = 1 << (m + 1);
+        m_skew[(1 << m) - 1] = 0;
+
+        for (int i = m; i < 15; ++i)
+        {
+            const int s = 1 << (i + 1);
+
+            for (int j = (1 << m) - 1; j < s; j += step) {
+                m_skew[j + s] = m_skew[j] ^ base[i];
+            }
+        }
+
+        base[m] = static_cast<uint16_t>(CM65536FFTModulus - m_logPoints[mulPoint(base[m], m_logPoints[base[m] ^ 1])]);
+
+        for (int i = m + 1; i < 15; ++i) {
+            base[i] = mulPoint(base[i], (m_logPoints[base[i] ^ 1] + base[m]) % CM65536FFTModulus);
+        }
+    }
+
+    for (unsigned i = 0; i < CM65536FFTModulus; ++i) {
+        m_skew[i] = m_logPoints[m_skew[i]];
+    }
+
+    // For each transform size n = 2^k the transform of the point logarithms,
+    // the point 0 counting for 1.  Transforming twice multiplies by n, which
+    // is undone here with its inverse 2^(16-k) modulo 65535.
+    for (int k = 0; k <= 16; ++k)
+    {
+        const int n = 1 << k;
+        uint16_t* logWalsh = m_logWalsh.data() + n - 1;
+
+        memcpy(logWalsh, m_logPoints.data(), n * sizeof(uint16_t));
+        logWalsh[0] = 0;
+        cm65536_fft_fwht(logWalsh, n);
+
+        for (int i = 0; i < n; ++i) {
+            logWalsh[i] = static_cast<uint16_t>((((unsigned) logWalsh[i]) << (16 - k)) % CM65536FFTModulus);
+        }
+    }
+}
+
+bool CM65536::CM65536FFT::fits(const cm65536_encoder_params& params)
+{
+    return params.OriginalCount + cm65536_fft_pow2(params.RecoveryCount) <= 65536;
+}
+
+void CM65536::CM65536FFT::mulLog(void* z, const void* x, unsigned log, int bytes) const
+{
+    m_gf65536Ctx.gf65536_mul_mem(z, x, m_gf65536Ctx.GF65536_EXP_TABLE[log], bytes);
+}
+
+void CM65536::CM65536FFT::ifft(uint8_t* const* data, int size, int truncated, int index, int bytes) const
+{
+    // The groups of butterflies past the data are zero in and out
+    for (int width = 1; width < size; width <<= 1)
+    {
+        for (int j = width; j - width < truncated; j += width << 1)
+        {
+            const unsigned skew = m_skew[j + index - 1];
+
+            for (int i = j - width; i < j; ++i)
+            {
+                gf256_ctx::gf256_add_mem(data[i + width], data[i], bytes);
+
+                if (skew != CM65536FFTModulus) {
+                    m_gf65536Ctx.gf65536_muladd_mem(data[i], m_gf65536Ctx.GF65536_EXP_TABLE[skew], data[i + width], bytes);
+                }
+            }
+        }
+    }
+}
+
+void CM65536::CM65536FFT::fft(uint8_t* const* data, int size, int truncated, int index, int bytes) const
+{
+    // The groups of butterflies past the outputs wanted are not needed
+    for (int width = size >> 1; width > 0; width >>= 1)
+    {
+        for (int j = width; j - width < truncated; j += width << 1)
+        {
+            const unsigned skew = m_skew[j + index - 1];
+
+            for (int i = j - width; i < j; ++i)
+            {
+                if (skew != CM65536FFTModulus) {
+                    m_gf65536Ctx.gf65536_muladd_mem(data[i], m_gf65536Ctx.GF65536_EXP_TABLE[skew], data[i + width], bytes);
+                }
+
+                gf256_ctx::gf256_add_mem(data[i + width], data[i], bytes);
+            }
+        }
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Encoding
+
+void CM65536::CM65536FFT::encode(const cm65536_encoder_params& params, const cm65536_block* originals, void* recoveryBlocks) const
+{
+    const int originalCount = params.OriginalCount;
+    const int recoveryCount = params.RecoveryCount;
+    uint8_t* recovery = static_cast<uint8_t*>(recoveryBlocks);
+
+    // If only one block of input data,
+    if (originalCount == 1)
+    {
+        // No meaningful operation here, degenerate to outputting the same data each time.
+        for (int block = 0; block < recoveryCount; ++block) {
+            memcpy(recovery + (size_t) block * params.BlockBytes, originals[0].Block, params.BlockBytes);
+        }
+
+        return;
+    }
+
+    // The recovery blocks are the first recoveryCount of the m points before
+    // the originals, the others are computed in a scratch buffer
+    const int m = cm65536_fft_pow2(recoveryCount);
+    const int chunkCount = (originalCount + m - 1) / m;
+    const int tileBytes = cm65536_fft_tile_bytes(chunkCount > 1 ? 2 * m : m, params.BlockBytes);
+    const int scratchCount = m - recoveryCount + (chunkCount > 1 ? m : 0);
+    std::vector<uint8_t> scratch((size_t) scratchCount * tileBytes);
+    std::vector<uint8_t*> work(m), chunk(m);
+
+    for (int offset = 0; offset < params.BlockBytes; offset += tileBytes)
+    {
+        const int bytes = params.BlockBytes - offset < tileBytes ? params.BlockBytes - offset : tileBytes;
+        uint8_t* scratchBlock = scratch.data();
+
+        for (int i = 0; i < m; ++i)
+        {
+            if (i < recoveryCount)
+            {
+                work[i] = recovery + (size_t) i * params.BlockBytes + offset;
+            }
+            else
+            {
+                work[i] = scratchBlock;
+                scratchBlock += tileBytes;
+            }
+        }
+
+        for (int i = 0; i < m && chunkCount > 1; ++i, scratchBlock += tileBytes) {
+            chunk[i] = scratchBlock;
+        }
+
+        // Sum the inverse transforms of the chunks of m originals at their
+        // points, zero padded, then evaluate at the recovery points
+        for (int c = 0; c < chunkCount; ++c)
+        {
+            uint8_t* const* target = c == 0 ? work.data() : chunk.data();
+
+            for (int i = 0; i < m; ++i)
+            {
+                const int originalIndex = c * m + i;
+
+                if (originalIndex < originalCount) {
+                    memcpy(target[i], static_cast<const uint8_t*>(originals[originalIndex].Block) + offset, bytes);
+                } else {
+                    memset(target[i], 0, bytes);
+                }
+            }
+
+            const int count = originalCount - c * m < m ? originalCount - c * m : m;
+            ifft(target, m, count, m + c * m, bytes);
+
+            for (int i = 0; i < m && c > 0; ++i) {
+                gf256_ctx::gf256_add_mem(work[i], chunk[i], bytes);
+            }
+        }
+
+        fft(work.data(), m, recoveryCount, 0, bytes);
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Decoding
+
+int CM65536::CM65536FFT::decode(const cm65536_encoder_params& params, cm65536_block* blocks) const
+{
+    const int originalCount = params.OriginalCount;
+    const int recoveryCount = params.RecoveryCount;
+    const int m = cm65536_fft_pow2(recoveryCount);
+    const int n = cm65536_fft_pow2(m + originalCount);
+
+    std::vector<cm65536_block*> original(originalCount, nullptr);
+    std::vector<cm65536_block*> recovery(recoveryCount, nullptr);
+    std::vector<cm65536_block*> outputs;
+
+    // Sort the blocks by point, error out on repeated or invalid indices
+    for (int ii = 0; ii < originalCount; ++ii)
+    {
+        cm65536_block* block = blocks + ii;
+        const int row = block->Index;
+
+        if (row < originalCount)
+        {
+            if (original[row]) {
+                return -5;
+            }
+
+            original[row] = block;
+        }
+        else
+        {
+            if (row - originalCount >= recoveryCount || recovery[row - originalCount]) {
+                return -5;
+            }
+
+            recovery[row - originalCount] = block;
+            outputs.push_back(block);
+        }
+    }
+
+    // If nothing is erased,
+    if (outputs.empty()) {
+        return 0;
+    }
+
+    /*
+        Error locator: for each point i the logarithm of the product of
+        (x_i + x_e) over the erased points e other than i.  The points not
+        transmitted, recovery points past recoveryCount, count as erased while
+        the zero padding past the originals is known.  The sums of logarithms
+        are a dyadic convolution, computed with Walsh-Hadamard transforms.
+    */
+    std::vector<uint16_t> locator(n, 0);
+
+    for (int i = 0; i < m; ++i) {
+        locator[i] = (i >= recoveryCount || !recovery[i]) ? 1 : 0;
+    }
+
+    for (int i = 0; i < originalCount; ++i) {
+        locator[m + i] = original[i] ? 0 : 1;
+    }
+
+    const uint16_t* logWalsh = m_logWalsh.data() + n - 1;
+    cm65536_fft_fwht(locator.data(), n);
+
+    for (int i = 0; i < n; ++i) {
+        locator[i] = static_cast<uint16_t>(((unsigned) locator[i] * logWalsh[i]) % CM65536FFTModulus);
+    }
+
+    cm65536_fft_fwht(locator.data(), n);
+
+    // Scale the received values by the locator, interpolate, take the formal
+    // derivative and evaluate: the erased values come out divided by their
+    // locator value
+    const int tileBytes = cm65536_fft_tile_bytes(n, params.BlockBytes);
+    std::vector<uint8_t> buffer((size_t) n * tileBytes);
+    std::vector<uint8_t*> work(n);
+
+    for (int i = 0; i < n; ++i) {
+        work[i] = buffer.data() + (size_t) i * tileBytes;
+    }
+
+    for (int offset = 0; offset < params.BlockBytes; offset += tileBytes)
+    {
+        const int bytes = params.BlockBytes - offset < tileBytes ? params.BlockBytes - offset : tileBytes;
+
+        for (int i = 0; i < n; ++i)
+        {
+            cm65536_block* block = nullptr;
+
+            if (i < recoveryCount) {
+                block = recovery[i];
+            } else if (i >= m && i < m + originalCount) {
+                block = original[i - m];
+            }
+
+            if (block) {
+                mulLog(work[i], static_cast<const uint8_t*>(block->Block) + offset, locator[i], bytes);
+            } else {
+                memset(work[i], 0, bytes);
+            }
+        }
+
+        ifft(work.data(), n, m + originalCount, 0, bytes);
+
+        // Formal derivative in the novel polynomial basis
+        for (int i = 1; i < n; ++i)
+        {
+            const int width = ((i ^ (i - 1)) + 1) >> 1;
+
+            for (int j = 0; j < width; ++j) {
+                gf256_ctx::gf256_add_mem(work[i - width + j], work[i + j], bytes);
+            }
+        }
+
+        fft(work.data(), n, m + originalCount, 0, bytes);
+
+        // The recovered originals replace the recovery blocks in order
+        int output = 0;
+
+        for (int i = 0; i < originalCount; ++i)
+        {
+            if (!original[i])
+            {
+                mulLog(static_cast<uint8_t*>(outputs[output++]->Block) + offset, work[m + i], CM65536FFTModulus - locator[m + i], bytes);
+            }
+        }
+    }
+
+    int output = 0;
+
+    for (int i = 0; i < originalCount; ++i)
+    {
+        if (!original[i]) {
+            outputs[output++]->Index = static_cast<uint16_t>(i);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+/*
+    Copyright (c) 2016 Edouard M. Griffiths.  All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+    * Neither the name of CM256 nor the names of its contributors may be
+      used to endorse or promote products derived from this software without
+      specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifndef CM65536FFT_H
+#define CM65536FFT_H
+
+#include <vector>
+
+#include "cm65536.h"
+
+/*
+ * Additive FFT engine of CM65536
+ *
+ * Reed-Solomon code of Lin, Chung and Han ("Novel polynomial basis and its
+ * application to Reed-Solomon erasure codes", FOCS 2014) over GF(65536).
+ * The codeword is evaluated on the points of the subspace spanned by a
+ * Cantor basis.  With m the recovery count rounded up to a power of 2, the
+ * recovery blocks take the first m points and original i the point m + i.
+ *
+ * Encoding costs O(k log m) and decoding O(n log n) block operations, n the
+ * power of 2 above m + k, against O(k * m) for the Cauchy matrix.
+ *
+ * The constants of the transforms are kept as logarithms, which do not
+ * depend on the basis the elements are written in, so the bulk operations
+ * are those of gf65536_ctx.
+ */
+class CM65536::CM65536FFT
+{
+public:
+    CM65536FFT(const gf65536_ctx& gf65536Ctx);
+
+    // Whether the code fits in the field
+    static bool fits(const cm65536_encoder_params& params);
+
+    // Same as CM65536::cm65536_encode() on validated parameters
+    void encode(const cm65536_encoder_params& params, const cm65536_block* originals, void* recoveryBlocks) const;
+
+    // Same as CM65536::cm65536_decode() on validated parameters
+    int decode(const cm65536_encoder_params& params, cm65536_block* blocks) const;
+
+private:
+    // Inverse transform of 'size' blocks at the points from 'index', the
+    // blocks from 'truncated' on being zero
+    void ifft(uint8_t* const* data, int size, int truncated, int index, int bytes) const;
+
+    // Forward transform of 'size' blocks at the points from 'index', only the
+    // first 'truncated' outputs being computed
+    void fft(uint8_t* const* data, int size, int truncated, int index, int bytes) const;
+
+    // Multiply by exp(log), the log being 65535 for 0
+    void mulLog(void* z, const void* x, unsigned log, int bytes) const;
+
+    const gf65536_ctx& m_gf65536Ctx;
+
+    // Logarithms of the points, 65535 for the point 0
+    std::vector<uint16_t> m_logPoints;
+
+    // Logarithms of the skew factors of the butterflies, 65535 for 0
+    std::vector<uint16_t> m_skew;
+
+    // Walsh-Hadamard transforms of the point logarithms for the transform
+    // sizes 1, 2, 4 ... 65536, end-to-end, to evaluate the error locator
+    std::vector<uint16_t> m_logWalsh;
+};
+
+#endif // CM65536FFT_H
@@ -0,0 +1,18 @@
+#include <stdint.h>
+#include <immintrin.h>
+#include <stdlib.h>
+#include <signal.h>
+
+void signalHandler(int signum) {
+    exit(signum); // SIGILL = 4
+}
+
+int main(int argc, char* argv[])
+{
+    signal(SIGILL, signalHandler);
+    uint8_t x[64] = {0};
+    __m512i y = _mm512_maskz_loadu_epi8(0x7f, x);
+    y = _mm512_shuffle_epi8(y, y);
+    _mm512_mask_storeu_epi8(x, 0x7f, y);
+    return x[0];
+}
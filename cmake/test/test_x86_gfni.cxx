@@ -0,0 +1,17 @@
+#include <stdint.h>
+#include <immintrin.h>
+#include <stdlib.h>
+#include <signal.h>
+
+void signalHandler(int signum) {
+    exit(signum); // SIGILL = 4
+}
+
+int main(int argc, char* argv[])
+{
+    signal(SIGILL, signalHandler);
+    __m128i x = _mm_set1_epi8(1);
+    __m128i a = _mm_set1_epi64x(0x0102040810204080LL); // identity
+    x = _mm_gf2p8affine_epi64_epi8(x, a, 0);
+    return _mm_cvtsi128_si32(x) == 0x01010101 ? 0 : 1;
+}
@@ -31,6 +31,14 @@
 
 #include "gf256.h"
 
+#if defined(USE_SSSE3)
+#ifdef _MSC_VER
+    #include <intrin.h> // __cpuidex
+#else
+    #include <cpuid.h> // __cpuid_count
+#endif
+#endif
+
 const uint8_t gf256_ctx::GF256_GEN_POLY[GF256_GEN_POLY_COUNT] = {
         0x8e, 0x95, 0x96, 0xa6, 0xaf, 0xb1, 0xb2, 0xb4,
         0xb8, 0xc3, 0xc6, 0xd4, 0xe1, 0xe7, 0xf3, 0xfa,
@@ -208,6 +216,33 @@ void gf256_ctx::gf256_inv_init()
         result = _mm_xor_si128(p_lo, p_hi)
 
     This crunches 16 bytes of x at a time, and the result can be stored in z.
+
+    With AVX2 the same sequence runs on 256-bit registers.  _mm256_shuffle_epi8
+    looks up each 128-bit lane separately, so the 16-byte TABLE_LO_y and
+    TABLE_HI_y are broadcast to both lanes and 32 bytes of x are crunched at a
+    time.  The 128-bit loop and the scalar code then handle the remainder.
+
+    With AVX-512BW the tables are broadcast to all four 128-bit lanes and 64
+    bytes are crunched at a time.  The final 1..63 bytes are handled by the
+    same sequence using masked loads and stores (_mm512_maskz_loadu_epi8 and
+    _mm512_mask_storeu_epi8), so no scalar code is needed.
+*/
+
+/*
+    Fast algorithm using the GFNI instruction set:
+
+    Multiplication by a constant y is linear over GF(2), so it is given by an
+    8x8 bit-matrix A_y whatever the generator polynomial is.  Column j of A_y
+    holds the bits of y * 2^j.  GF2P8AFFINEQB computes A * x for each byte x of
+    a register, where byte (7 - i) of the 64-bit matrix operand holds row i:
+
+        bit i of (x * y) = parity(A_y.byte[7 - i] & x)
+
+    This replaces the and/shift/2 x pshufb/xor sequence above by a single
+    instruction per register.  The native GF2P8MULB instruction cannot be used
+    since it is hard-wired to the AES polynomial 0x11B.
+
+    The 256 matrices take 2 KB and are built along with the MM256 tables.
 */
 
 /*
@@ -265,6 +300,24 @@ void gf256_ctx::gf256_muladd_mem_init()
             hi[7], hi[6], hi[5], hi[4], hi[3], hi[2], hi[1], hi[0]);
         _mm_store_si128(MM256_TABLE_LO_Y + y, table_lo);
         _mm_store_si128(MM256_TABLE_HI_Y + y, table_hi);
+
+        // Row i of the bit-matrix has bit j set when bit i of y * 2^j is set
+        uint64_t matrix = 0;
+
+        for (unsigned j = 0; j < 8; ++j)
+        {
+            const uint8_t column = gf256_mul(static_cast<uint8_t>(1 << j), static_cast<uint8_t>( y ));
+
+            for (unsigned i = 0; i < 8; ++i)
+            {
+                if (column & (1 << i))
+                {
+                    matrix |= (uint64_t)1 << ((7 - i) * 8 + j);
+                }
+            }
+        }
+
+        GF256_AFFINE_TABLE[y] = matrix;
     }
 }
 
@@ -307,30 +360,515 @@ int gf256_ctx::gf256_init_()
     gf256_muldiv_init();
     gf256_inv_init();
     gf256_muladd_mem_init();
+    gf256_architecture_init();
 
     initialized = true;
-    fprintf(stderr, "gf256_ctx::gf256_init_: initialized\n");
+    fprintf(stderr, "gf256_ctx::gf256_init_: initialized (%s)\n", gf256_simd_name(gf256_simd_level()));
     return 0;
 }
 
 //-----------------------------------------------------------------------------
-// Operations with context
+// Kernels
+//
+// Each bulk operation has one kernel per SIMD tier.  The baseline kernels use
+// SSSE3 or Neon and are always built.  The AVX2, AVX-512BW and GFNI kernels
+// are built when the compiler supports them (USE_AVX2, USE_AVX512BW and
+// USE_GFNI) and carry a GF256_TARGET_* attribute, so that the rest of the
+// library does not depend on these instruction sets.
+// The best kernels the CPU supports are bound at run time, see Dispatch below.
+//
+// Wider kernels run their main loop and hand the remaining bytes over to the
+// narrower kernel of the same operation.  Single-source multiply kernels are
+// only called for y >= 2, the special cases are handled by the gf256_ctx
+// members.
+
+// Multi-source kernels compute z[] (+)= sum of x_k[] * y_k for up to
+// GF256_MULTI_MAX sources per call, keeping the sum in registers so that the
+// destination is loaded and stored once per group instead of once per source.
+// 'add' selects between accumulating into z[] and overwriting it.
+static const int GF256_MULTI_MAX = 8;
+
+// Byte-wise multi-source multiply-add over z[begin..end), used for final bytes
+static void gf256_muladd_multi_bytes(const gf256_ctx& ctx, uint8_t * GF256_RESTRICT z, const uint8_t * y, const uint8_t * const * x, int count, int begin, int end, bool add)
+{
+    for (int i = begin; i < end; ++i)
+    {
+        uint8_t sum = add ? z[i] : 0;
 
-void gf256_ctx::gf256_mul_mem(void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, uint8_t y, int bytes)
+        for (int k = 0; k < count; ++k) {
+            sum ^= ctx.GF256_MUL_TABLE[((unsigned)y[k] << 8) + x[k][i]];
+        }
+
+        z[i] = sum;
+    }
+}
+
+// Byte-wise multi-source XOR over z[begin..end), used for final bytes
+static void gf256_add_multi_bytes(uint8_t * GF256_RESTRICT z, const uint8_t * const * x, int count, int begin, int end, bool add)
 {
-    // Use a single if-statement to handle special cases
-    if (y <= 1)
+    for (int i = begin; i < end; ++i)
     {
-        if (y == 0)
+        uint8_t sum = add ? z[i] : 0;
+
+        for (int k = 0; k < count; ++k) {
+            sum ^= x[k][i];
+        }
+
+        z[i] = sum;
+    }
+}
+
+// Multi-destination kernels compute z_k[] += x[] * y_k for up to
+// GF256_MULTI_DEST_MAX destinations per call, so that each source vector is
+// loaded and split into nibbles once for all of them.
+static const int GF256_MULTI_DEST_MAX = 4;
+
+// Byte-wise multi-destination multiply-add over [begin..end), used for final bytes
+static void gf256_muladd_multi_dest_bytes(const gf256_ctx& ctx, uint8_t * const * z, const uint8_t * y, const uint8_t * GF256_RESTRICT x, int count, int begin, int end)
+{
+    for (int k = 0; k < count; ++k)
+    {
+        const uint8_t * GF256_RESTRICT table = ctx.GF256_MUL_TABLE + ((unsigned)y[k] << 8);
+
+        for (int i = begin; i < end; ++i) {
+            z[k][i] ^= table[x[i]];
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Baseline kernels (Neon)
+//
+// Same algorithm as the SSSE3 kernels, written with native Neon intrinsics
+// rather than through sse2neon.h where _mm_shuffle_epi8 and _mm_srli_epi64
+// turn into emulation sequences.  The nibble lookup is a single VQTBL1Q on
+// AArch64 and two VTBL2 on ARMv7.  Main loops process 64 bytes to hide the
+// table lookup latency.
+
+#if defined(USE_NEON)
+
+// 16 parallel lookups of idx[i] (0..15) into table
+static GF256_FORCE_INLINE uint8x16_t gf256_neon_lookup(uint8x16_t table, uint8x16_t idx)
+{
+#if defined(__aarch64__)
+    return vqtbl1q_u8(table, idx);
+#else
+    uint8x8x2_t table2;
+    table2.val[0] = vget_low_u8(table);
+    table2.val[1] = vget_high_u8(table);
+    return vcombine_u8(vtbl2_u8(table2, vget_low_u8(idx)), vtbl2_u8(table2, vget_high_u8(idx)));
+#endif
+}
+
+// x * y for 16 bytes, see above comments for details
+static GF256_FORCE_INLINE uint8x16_t gf256_neon_mul(uint8x16_t table_lo_y, uint8x16_t table_hi_y, uint8x16_t clr_mask, uint8x16_t x)
+{
+    const uint8x16_t l0 = gf256_neon_lookup(table_lo_y, vandq_u8(x, clr_mask));
+    const uint8x16_t h0 = gf256_neon_lookup(table_hi_y, vshrq_n_u8(x, 4));
+    return veorq_u8(l0, h0);
+}
+
+static void gf256_mul_mem_neon(const gf256_ctx& ctx, void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, uint8_t y, int bytes)
+{
+    // Partial product tables; see above
+    const uint8x16_t table_lo_y = vld1q_u8(reinterpret_cast<const uint8_t*>(ctx.MM256_TABLE_LO_Y + y));
+    const uint8x16_t table_hi_y = vld1q_u8(reinterpret_cast<const uint8_t*>(ctx.MM256_TABLE_HI_Y + y));
+    const uint8x16_t clr_mask = vdupq_n_u8(0x0f);
+
+    uint8_t * GF256_RESTRICT z8 = reinterpret_cast<uint8_t*>(vz);
+    const uint8_t * GF256_RESTRICT x8 = reinterpret_cast<const uint8_t*>(vx);
+
+    // Handle multiples of 64 bytes
+    while (bytes >= 64)
+    {
+        const uint8x16_t x0 = vld1q_u8(x8);
+        const uint8x16_t x1 = vld1q_u8(x8 + 16);
+        const uint8x16_t x2 = vld1q_u8(x8 + 32);
+        const uint8x16_t x3 = vld1q_u8(x8 + 48);
+        vst1q_u8(z8, gf256_neon_mul(table_lo_y, table_hi_y, clr_mask, x0));
+        vst1q_u8(z8 + 16, gf256_neon_mul(table_lo_y, table_hi_y, clr_mask, x1));
+        vst1q_u8(z8 + 32, gf256_neon_mul(table_lo_y, table_hi_y, clr_mask, x2));
+        vst1q_u8(z8 + 48, gf256_neon_mul(table_lo_y, table_hi_y, clr_mask, x3));
+
+        x8 += 64;
+        z8 += 64;
+        bytes -= 64;
+    }
+
+    // Handle multiples of 16 bytes
+    while (bytes >= 16)
+    {
+        vst1q_u8(z8, gf256_neon_mul(table_lo_y, table_hi_y, clr_mask, vld1q_u8(x8)));
+
+        x8 += 16;
+        z8 += 16;
+        bytes -= 16;
+    }
+
+    // Handle final bytes
+    const uint8_t * GF256_RESTRICT table = ctx.GF256_MUL_TABLE + ((unsigned)y << 8);
+
+    for (int i = 0; i < bytes; ++i) {
+        z8[i] = table[x8[i]];
+    }
+}
+
+static void gf256_muladd_mem_neon(const gf256_ctx& ctx, void * GF256_RESTRICT vz, uint8_t y, const void * GF256_RESTRICT vx, int bytes)
+{
+    // Partial product tables; see above
+    const uint8x16_t table_lo_y = vld1q_u8(reinterpret_cast<const uint8_t*>(ctx.MM256_TABLE_LO_Y + y));
+    const uint8x16_t table_hi_y = vld1q_u8(reinterpret_cast<const uint8_t*>(ctx.MM256_TABLE_HI_Y + y));
+    const uint8x16_t clr_mask = vdupq_n_u8(0x0f);
+
+    uint8_t * GF256_RESTRICT z8 = reinterpret_cast<uint8_t*>(vz);
+    const uint8_t * GF256_RESTRICT x8 = reinterpret_cast<const uint8_t*>(vx);
+
+    // Handle multiples of 64 bytes
+    while (bytes >= 64)
+    {
+        const uint8x16_t x0 = vld1q_u8(x8);
+        const uint8x16_t x1 = vld1q_u8(x8 + 16);
+        const uint8x16_t x2 = vld1q_u8(x8 + 32);
+        const uint8x16_t x3 = vld1q_u8(x8 + 48);
+        const uint8x16_t z0 = vld1q_u8(z8);
+        const uint8x16_t z1 = vld1q_u8(z8 + 16);
+        const uint8x16_t z2 = vld1q_u8(z8 + 32);
+        const uint8x16_t z3 = vld1q_u8(z8 + 48);
+        vst1q_u8(z8, veorq_u8(z0, gf256_neon_mul(table_lo_y, table_hi_y, clr_mask, x0)));
+        vst1q_u8(z8 + 16, veorq_u8(z1, gf256_neon_mul(table_lo_y, table_hi_y, clr_mask, x1)));
+        vst1q_u8(z8 + 32, veorq_u8(z2, gf256_neon_mul(table_lo_y, table_hi_y, clr_mask, x2)));
+        vst1q_u8(z8 + 48, veorq_u8(z3, gf256_neon_mul(table_lo_y, table_hi_y, clr_mask, x3)));
+
+        x8 += 64;
+        z8 += 64;
+        bytes -= 64;
+    }
+
+    // Handle multiples of 16 bytes
+    while (bytes >= 16)
+    {
+        const uint8x16_t p0 = gf256_neon_mul(table_lo_y, table_hi_y, clr_mask, vld1q_u8(x8));
+        vst1q_u8(z8, veorq_u8(vld1q_u8(z8), p0));
+
+        x8 += 16;
+        z8 += 16;
+        bytes -= 16;
+    }
+
+    // Handle final bytes
+    const uint8_t * GF256_RESTRICT table = ctx.GF256_MUL_TABLE + ((unsigned)y << 8);
+
+    for (int i = 0; i < bytes; ++i) {
+        z8[i] ^= table[x8[i]];
+    }
+}
+
+static void gf256_add_mem_neon(void * GF256_RESTRICT vx, const void * GF256_RESTRICT vy, int bytes)
+{
+    uint8_t * GF256_RESTRICT x8 = reinterpret_cast<uint8_t*>(vx);
+    const uint8_t * GF256_RESTRICT y8 = reinterpret_cast<const uint8_t*>(vy);
+
+    // Handle multiples of 64 bytes
+    while (bytes >= 64)
+    {
+        const uint8x16_t x0 = vld1q_u8(x8);
+        const uint8x16_t x1 = vld1q_u8(x8 + 16);
+        const uint8x16_t x2 = vld1q_u8(x8 + 32);
+        const uint8x16_t x3 = vld1q_u8(x8 + 48);
+        const uint8x16_t y0 = vld1q_u8(y8);
+        const uint8x16_t y1 = vld1q_u8(y8 + 16);
+        const uint8x16_t y2 = vld1q_u8(y8 + 32);
+        const uint8x16_t y3 = vld1q_u8(y8 + 48);
+        vst1q_u8(x8, veorq_u8(x0, y0));
+        vst1q_u8(x8 + 16, veorq_u8(x1, y1));
+        vst1q_u8(x8 + 32, veorq_u8(x2, y2));
+        vst1q_u8(x8 + 48, veorq_u8(x3, y3));
+
+        x8 += 64;
+        y8 += 64;
+        bytes -= 64;
+    }
+
+    // Handle multiples of 16 bytes
+    while (bytes >= 16)
+    {
+        vst1q_u8(x8, veorq_u8(vld1q_u8(x8), vld1q_u8(y8)));
+
+        x8 += 16;
+        y8 += 16;
+        bytes -= 16;
+    }
+
+    // Handle final bytes
+    for (int i = 0; i < bytes; ++i) {
+        x8[i] ^= y8[i];
+    }
+}
+
+static void gf256_add2_mem_neon(void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, const void * GF256_RESTRICT vy, int bytes)
+{
+    uint8_t * GF256_RESTRICT z8 = reinterpret_cast<uint8_t*>(vz);
+    const uint8_t * GF256_RESTRICT x8 = reinterpret_cast<const uint8_t*>(vx);
+    const uint8_t * GF256_RESTRICT y8 = reinterpret_cast<const uint8_t*>(vy);
+
+    // Handle multiples of 32 bytes
+    while (bytes >= 32)
+    {
+        const uint8x16_t x0 = vld1q_u8(x8);
+        const uint8x16_t x1 = vld1q_u8(x8 + 16);
+        const uint8x16_t y0 = vld1q_u8(y8);
+        const uint8x16_t y1 = vld1q_u8(y8 + 16);
+        const uint8x16_t z0 = vld1q_u8(z8);
+        const uint8x16_t z1 = vld1q_u8(z8 + 16);
+        vst1q_u8(z8, veorq_u8(z0, veorq_u8(x0, y0)));
+        vst1q_u8(z8 + 16, veorq_u8(z1, veorq_u8(x1, y1)));
+
+        x8 += 32;
+        y8 += 32;
+        z8 += 32;
+        bytes -= 32;
+    }
+
+    // Handle multiples of 16 bytes
+    while (bytes >= 16)
+    {
+        vst1q_u8(z8, veorq_u8(vld1q_u8(z8), veorq_u8(vld1q_u8(x8), vld1q_u8(y8))));
+
+        x8 += 16;
+        y8 += 16;
+        z8 += 16;
+        bytes -= 16;
+    }
+
+    // Handle final bytes
+    for (int i = 0; i < bytes; ++i) {
+        z8[i] ^= x8[i] ^ y8[i];
+    }
+}
+
+static void gf256_addset_mem_neon(void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, const void * GF256_RESTRICT vy, int bytes)
+{
+    uint8_t * GF256_RESTRICT z8 = reinterpret_cast<uint8_t*>(vz);
+    const uint8_t * GF256_RESTRICT x8 = reinterpret_cast<const uint8_t*>(vx);
+    const uint8_t * GF256_RESTRICT y8 = reinterpret_cast<const uint8_t*>(vy);
+
+    // Handle multiples of 64 bytes
+    while (bytes >= 64)
+    {
+        const uint8x16_t x0 = vld1q_u8(x8);
+        const uint8x16_t x1 = vld1q_u8(x8 + 16);
+        const uint8x16_t x2 = vld1q_u8(x8 + 32);
+        const uint8x16_t x3 = vld1q_u8(x8 + 48);
+        const uint8x16_t y0 = vld1q_u8(y8);
+        const uint8x16_t y1 = vld1q_u8(y8 + 16);
+        const uint8x16_t y2 = vld1q_u8(y8 + 32);
+        const uint8x16_t y3 = vld1q_u8(y8 + 48);
+        vst1q_u8(z8, veorq_u8(x0, y0));
+        vst1q_u8(z8 + 16, veorq_u8(x1, y1));
+        vst1q_u8(z8 + 32, veorq_u8(x2, y2));
+        vst1q_u8(z8 + 48, veorq_u8(x3, y3));
+
+        x8 += 64;
+        y8 += 64;
+        z8 += 64;
+        bytes -= 64;
+    }
+
+    // Handle multiples of 16 bytes
+    while (bytes >= 16)
+    {
+        vst1q_u8(z8, veorq_u8(vld1q_u8(x8), vld1q_u8(y8)));
+
+        x8 += 16;
+        y8 += 16;
+        z8 += 16;
+        bytes -= 16;
+    }
+
+    // Handle final bytes
+    for (int i = 0; i < bytes; ++i) {
+        z8[i] = x8[i] ^ y8[i];
+    }
+}
+
+static void gf256_memswap_neon(void * GF256_RESTRICT vx, void * GF256_RESTRICT vy, int bytes)
+{
+    uint8_t * GF256_RESTRICT x8 = reinterpret_cast<uint8_t*>(vx);
+    uint8_t * GF256_RESTRICT y8 = reinterpret_cast<uint8_t*>(vy);
+
+    // Handle multiples of 32 bytes
+    while (bytes >= 32)
+    {
+        const uint8x16_t x0 = vld1q_u8(x8);
+        const uint8x16_t x1 = vld1q_u8(x8 + 16);
+        const uint8x16_t y0 = vld1q_u8(y8);
+        const uint8x16_t y1 = vld1q_u8(y8 + 16);
+        vst1q_u8(x8, y0);
+        vst1q_u8(x8 + 16, y1);
+        vst1q_u8(y8, x0);
+        vst1q_u8(y8 + 16, x1);
+
+        x8 += 32;
+        y8 += 32;
+        bytes -= 32;
+    }
+
+    // Handle multiples of 16 bytes
+    while (bytes >= 16)
+    {
+        const uint8x16_t x0 = vld1q_u8(x8);
+        vst1q_u8(x8, vld1q_u8(y8));
+        vst1q_u8(y8, x0);
+
+        x8 += 16;
+        y8 += 16;
+        bytes -= 16;
+    }
+
+    // Handle final bytes
+    uint8_t temp;
+
+    for (int i = 0; i < bytes; ++i) {
+        temp = x8[i]; x8[i] = y8[i]; y8[i] = temp;
+    }
+}
+
+static void gf256_muladd_multi_mem_neon(const gf256_ctx& ctx, void * GF256_RESTRICT vz, const uint8_t * y, const uint8_t * const * x, int count, int bytes, bool add)
+{
+    const uint8x16_t clr_mask = vdupq_n_u8(0x0f);
+    uint8_t * GF256_RESTRICT z8 = reinterpret_cast<uint8_t*>(vz);
+    int offset = 0;
+
+    // Handle multiples of 32 bytes, keeping the sums in registers
+    for (; offset + 32 <= bytes; offset += 32)
+    {
+        uint8x16_t sum0 = add ? vld1q_u8(z8 + offset) : vdupq_n_u8(0);
+        uint8x16_t sum1 = add ? vld1q_u8(z8 + offset + 16) : vdupq_n_u8(0);
+
+        for (int k = 0; k < count; ++k)
         {
-            memset(vz, 0, bytes);
+            const uint8x16_t table_lo_y = vld1q_u8(reinterpret_cast<const uint8_t*>(ctx.MM256_TABLE_LO_Y + y[k]));
+            const uint8x16_t table_hi_y = vld1q_u8(reinterpret_cast<const uint8_t*>(ctx.MM256_TABLE_HI_Y + y[k]));
+            sum0 = veorq_u8(sum0, gf256_neon_mul(table_lo_y, table_hi_y, clr_mask, vld1q_u8(x[k] + offset)));
+            sum1 = veorq_u8(sum1, gf256_neon_mul(table_lo_y, table_hi_y, clr_mask, vld1q_u8(x[k] + offset + 16)));
         }
-        return;
+
+        vst1q_u8(z8 + offset, sum0);
+        vst1q_u8(z8 + offset + 16, sum1);
+    }
+
+    // Handle multiples of 16 bytes
+    for (; offset + 16 <= bytes; offset += 16)
+    {
+        uint8x16_t sum0 = add ? vld1q_u8(z8 + offset) : vdupq_n_u8(0);
+
+        for (int k = 0; k < count; ++k)
+        {
+            const uint8x16_t table_lo_y = vld1q_u8(reinterpret_cast<const uint8_t*>(ctx.MM256_TABLE_LO_Y + y[k]));
+            const uint8x16_t table_hi_y = vld1q_u8(reinterpret_cast<const uint8_t*>(ctx.MM256_TABLE_HI_Y + y[k]));
+            sum0 = veorq_u8(sum0, gf256_neon_mul(table_lo_y, table_hi_y, clr_mask, vld1q_u8(x[k] + offset)));
+        }
+
+        vst1q_u8(z8 + offset, sum0);
+    }
+
+    // Handle final bytes
+    gf256_muladd_multi_bytes(ctx, z8, y, x, count, offset, bytes, add);
+}
+
+static void gf256_add_multi_mem_neon(void * GF256_RESTRICT vz, const uint8_t * const * x, int count, int bytes, bool add)
+{
+    uint8_t * GF256_RESTRICT z8 = reinterpret_cast<uint8_t*>(vz);
+    int offset = 0;
+
+    // Handle multiples of 32 bytes, keeping the sums in registers
+    for (; offset + 32 <= bytes; offset += 32)
+    {
+        uint8x16_t sum0 = add ? vld1q_u8(z8 + offset) : vdupq_n_u8(0);
+        uint8x16_t sum1 = add ? vld1q_u8(z8 + offset + 16) : vdupq_n_u8(0);
+
+        for (int k = 0; k < count; ++k)
+        {
+            sum0 = veorq_u8(sum0, vld1q_u8(x[k] + offset));
+            sum1 = veorq_u8(sum1, vld1q_u8(x[k] + offset + 16));
+        }
+
+        vst1q_u8(z8 + offset, sum0);
+        vst1q_u8(z8 + offset + 16, sum1);
+    }
+
+    // Handle multiples of 16 bytes
+    for (; offset + 16 <= bytes; offset += 16)
+    {
+        uint8x16_t sum0 = add ? vld1q_u8(z8 + offset) : vdupq_n_u8(0);
+
+        for (int k = 0; k < count; ++k) {
+            sum0 = veorq_u8(sum0, vld1q_u8(x[k] + offset));
+        }
+
+        vst1q_u8(z8 + offset, sum0);
+    }
+
+    // Handle final bytes
+    gf256_add_multi_bytes(z8, x, count, offset, bytes, add);
+}
+
+// Fixed destination count so that the tables and pointers stay in registers
+template<int count>
+static void gf256_muladd_multi_dest_neon(const gf256_ctx& ctx, uint8_t * const * z, const uint8_t * y, const uint8_t * GF256_RESTRICT x, int bytes)
+{
+    const uint8x16_t clr_mask = vdupq_n_u8(0x0f);
+    uint8x16_t table_lo_y[count], table_hi_y[count];
+    uint8_t * zk[count];
+
+    for (int k = 0; k < count; ++k)
+    {
+        table_lo_y[k] = vld1q_u8(reinterpret_cast<const uint8_t*>(ctx.MM256_TABLE_LO_Y + y[k]));
+        table_hi_y[k] = vld1q_u8(reinterpret_cast<const uint8_t*>(ctx.MM256_TABLE_HI_Y + y[k]));
+        zk[k] = z[k];
+    }
+
+    int offset = 0;
+
+    // Handle multiples of 16 bytes, splitting each source vector once
+    for (; offset + 16 <= bytes; offset += 16)
+    {
+        const uint8x16_t x0 = vld1q_u8(x + offset);
+        const uint8x16_t l0 = vandq_u8(x0, clr_mask);
+        const uint8x16_t h0 = vshrq_n_u8(x0, 4);
+
+        for (int k = 0; k < count; ++k)
+        {
+            const uint8x16_t p0 = veorq_u8(gf256_neon_lookup(table_lo_y[k], l0), gf256_neon_lookup(table_hi_y[k], h0));
+            vst1q_u8(zk[k] + offset, veorq_u8(vld1q_u8(zk[k] + offset), p0));
+        }
+    }
+
+    // Handle final bytes
+    gf256_muladd_multi_dest_bytes(ctx, zk, y, x, count, offset, bytes);
+}
+
+static void gf256_muladd_multi_dest_mem_neon(const gf256_ctx& ctx, uint8_t * const * z, const uint8_t * y, const uint8_t * GF256_RESTRICT x, int count, int bytes)
+{
+    switch (count)
+    {
+    case 1: gf256_muladd_multi_dest_neon<1>(ctx, z, y, x, bytes); break;
+    case 2: gf256_muladd_multi_dest_neon<2>(ctx, z, y, x, bytes); break;
+    case 3: gf256_muladd_multi_dest_neon<3>(ctx, z, y, x, bytes); break;
+    default: gf256_muladd_multi_dest_neon<4>(ctx, z, y, x, bytes); break;
     }
+}
+
+#else // USE_NEON
 
+//-----------------------------------------------------------------------------
+// Baseline kernels (SSSE3)
+
+static void gf256_mul_mem_ssse3(const gf256_ctx& ctx, void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, uint8_t y, int bytes)
+{
     // Partial product tables; see above
-    const GF256_M128 table_lo_y = _mm_load_si128(MM256_TABLE_LO_Y + y);
-    const GF256_M128 table_hi_y = _mm_load_si128(MM256_TABLE_HI_Y + y);
+    const GF256_M128 table_lo_y = _mm_load_si128(ctx.MM256_TABLE_LO_Y + y);
+    const GF256_M128 table_hi_y = _mm_load_si128(ctx.MM256_TABLE_HI_Y + y);
 
     // clr_mask = 0x0f0f0f0f0f0f0f0f0f0f0f0f0f0f0f0f
     const GF256_M128 clr_mask = _mm_set1_epi8(0x0f);
@@ -357,7 +895,7 @@ void gf256_ctx::gf256_mul_mem(void * GF256_RESTRICT vz, const void * GF256_RESTR
 
     uint8_t * GF256_RESTRICT z8 = reinterpret_cast<uint8_t*>(z16);
     const uint8_t * GF256_RESTRICT x8 = reinterpret_cast<const uint8_t*>(x16);
-    const uint8_t * GF256_RESTRICT table = GF256_MUL_TABLE + ((unsigned)y << 8);
+    const uint8_t * GF256_RESTRICT table = ctx.GF256_MUL_TABLE + ((unsigned)y << 8);
 
     // Handle a block of 8 bytes
     if (bytes >= 8)
@@ -397,21 +935,11 @@ void gf256_ctx::gf256_mul_mem(void * GF256_RESTRICT vz, const void * GF256_RESTR
     }
 }
 
-void gf256_ctx::gf256_muladd_mem(void * GF256_RESTRICT vz, uint8_t y, const void * GF256_RESTRICT vx, int bytes)
+static void gf256_muladd_mem_ssse3(const gf256_ctx& ctx, void * GF256_RESTRICT vz, uint8_t y, const void * GF256_RESTRICT vx, int bytes)
 {
-    // Use a single if-statement to handle special cases
-    if (y <= 1)
-    {
-        if (y == 1)
-        {
-            gf256_add_mem(vz, vx, bytes);
-        }
-        return;
-    }
-
     // Partial product tables; see above
-    const GF256_M128 table_lo_y = _mm_load_si128(MM256_TABLE_LO_Y + y);
-    const GF256_M128 table_hi_y = _mm_load_si128(MM256_TABLE_HI_Y + y);
+    const GF256_M128 table_lo_y = _mm_load_si128(ctx.MM256_TABLE_LO_Y + y);
+    const GF256_M128 table_hi_y = _mm_load_si128(ctx.MM256_TABLE_HI_Y + y);
 
     // clr_mask = 0x0f0f0f0f0f0f0f0f0f0f0f0f0f0f0f0f
     const GF256_M128 clr_mask = _mm_set1_epi8(0x0f);
@@ -440,7 +968,7 @@ void gf256_ctx::gf256_muladd_mem(void * GF256_RESTRICT vz, uint8_t y, const void
 
     uint8_t * GF256_RESTRICT z8 = reinterpret_cast<uint8_t*>(z16);
     const uint8_t * GF256_RESTRICT x8 = reinterpret_cast<const uint8_t*>(x16);
-    const uint8_t * GF256_RESTRICT table = GF256_MUL_TABLE + ((unsigned)y << 8);
+    const uint8_t * GF256_RESTRICT table = ctx.GF256_MUL_TABLE + ((unsigned)y << 8);
 
     // Handle a block of 8 bytes
     if (bytes >= 8)
@@ -480,10 +1008,7 @@ void gf256_ctx::gf256_muladd_mem(void * GF256_RESTRICT vz, uint8_t y, const void
     }
 }
 
-//-----------------------------------------------------------------------------
-// Static operations
-
-void gf256_ctx::gf256_add_mem(void * GF256_RESTRICT vx, const void * GF256_RESTRICT vy, int bytes)
+static void gf256_add_mem_ssse3(void * GF256_RESTRICT vx, const void * GF256_RESTRICT vy, int bytes)
 {
     GF256_M128 * GF256_RESTRICT x16 = reinterpret_cast<GF256_M128*>(vx);
     const GF256_M128 * GF256_RESTRICT y16 = reinterpret_cast<const GF256_M128*>(vy);
@@ -561,7 +1086,7 @@ void gf256_ctx::gf256_add_mem(void * GF256_RESTRICT vx, const void * GF256_RESTR
     }
 }
 
-void gf256_ctx::gf256_add2_mem(void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, const void * GF256_RESTRICT vy, int bytes)
+static void gf256_add2_mem_ssse3(void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, const void * GF256_RESTRICT vy, int bytes)
 {
     GF256_M128 * GF256_RESTRICT z16 = reinterpret_cast<GF256_M128*>(vz);
     const GF256_M128 * GF256_RESTRICT x16 = reinterpret_cast<const GF256_M128*>(vx);
@@ -622,7 +1147,7 @@ void gf256_ctx::gf256_add2_mem(void * GF256_RESTRICT vz, const void * GF256_REST
     }
 }
 
-void gf256_ctx::gf256_addset_mem(void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, const void * GF256_RESTRICT vy, int bytes)
+static void gf256_addset_mem_ssse3(void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, const void * GF256_RESTRICT vy, int bytes)
 {
     GF256_M128 * GF256_RESTRICT z16 = reinterpret_cast<GF256_M128*>(vz);
     const GF256_M128 * GF256_RESTRICT x16 = reinterpret_cast<const GF256_M128*>(vx);
@@ -704,7 +1229,7 @@ void gf256_ctx::gf256_addset_mem(void * GF256_RESTRICT vz, const void * GF256_RE
     }
 }
 
-void gf256_memswap(void * GF256_RESTRICT vx, void * GF256_RESTRICT vy, int bytes)
+static void gf256_memswap_ssse3(void * GF256_RESTRICT vx, void * GF256_RESTRICT vy, int bytes)
 {
     GF256_M128 * GF256_RESTRICT x16 = reinterpret_cast<GF256_M128*>(vx);
     GF256_M128 * GF256_RESTRICT y16 = reinterpret_cast<GF256_M128*>(vy);
@@ -762,3 +1287,1786 @@ void gf256_memswap(void * GF256_RESTRICT vx, void * GF256_RESTRICT vy, int bytes
         temp = x1[i-1]; x1[i-1] = y1[i-1]; y1[i-1] = temp;
     }
 }
+
+static void gf256_muladd_multi_mem_ssse3(const gf256_ctx& ctx, void * GF256_RESTRICT vz, const uint8_t * y, const uint8_t * const * x, int count, int bytes, bool add)
+{
+    // clr_mask = 0x0f0f0f0f0f0f0f0f0f0f0f0f0f0f0f0f
+    const GF256_M128 clr_mask = _mm_set1_epi8(0x0f);
+    uint8_t * GF256_RESTRICT z8 = reinterpret_cast<uint8_t*>(vz);
+    int offset = 0;
+
+    // Handle multiples of 32 bytes, keeping the sums in registers
+    for (; offset + 32 <= bytes; offset += 32)
+    {
+        GF256_M128 * z16 = reinterpret_cast<GF256_M128*>(z8 + offset);
+        GF256_M128 sum0 = add ? _mm_loadu_si128(z16) : _mm_setzero_si128();
+        GF256_M128 sum1 = add ? _mm_loadu_si128(z16 + 1) : _mm_setzero_si128();
+
+        for (int k = 0; k < count; ++k)
+        {
+            // See above comments for details
+            const GF256_M128 table_lo_y = _mm_load_si128(ctx.MM256_TABLE_LO_Y + y[k]);
+            const GF256_M128 table_hi_y = _mm_load_si128(ctx.MM256_TABLE_HI_Y + y[k]);
+            const GF256_M128 * x16 = reinterpret_cast<const GF256_M128*>(x[k] + offset);
+            GF256_M128 x0 = _mm_loadu_si128(x16);
+            GF256_M128 x1 = _mm_loadu_si128(x16 + 1);
+            GF256_M128 l0 = _mm_and_si128(x0, clr_mask);
+            GF256_M128 l1 = _mm_and_si128(x1, clr_mask);
+            x0 = _mm_srli_epi64(x0, 4);
+            x1 = _mm_srli_epi64(x1, 4);
+            GF256_M128 h0 = _mm_and_si128(x0, clr_mask);
+            GF256_M128 h1 = _mm_and_si128(x1, clr_mask);
+            l0 = _mm_shuffle_epi8(table_lo_y, l0);
+            l1 = _mm_shuffle_epi8(table_lo_y, l1);
+            h0 = _mm_shuffle_epi8(table_hi_y, h0);
+            h1 = _mm_shuffle_epi8(table_hi_y, h1);
+            sum0 = _mm_xor_si128(sum0, _mm_xor_si128(l0, h0));
+            sum1 = _mm_xor_si128(sum1, _mm_xor_si128(l1, h1));
+        }
+
+        _mm_storeu_si128(z16, sum0);
+        _mm_storeu_si128(z16 + 1, sum1);
+    }
+
+    // Handle multiples of 16 bytes
+    for (; offset + 16 <= bytes; offset += 16)
+    {
+        GF256_M128 * z16 = reinterpret_cast<GF256_M128*>(z8 + offset);
+        GF256_M128 sum0 = add ? _mm_loadu_si128(z16) : _mm_setzero_si128();
+
+        for (int k = 0; k < count; ++k)
+        {
+            GF256_M128 x0 = _mm_loadu_si128(reinterpret_cast<const GF256_M128*>(x[k] + offset));
+            GF256_M128 l0 = _mm_and_si128(x0, clr_mask);
+            x0 = _mm_srli_epi64(x0, 4);
+            GF256_M128 h0 = _mm_and_si128(x0, clr_mask);
+            l0 = _mm_shuffle_epi8(_mm_load_si128(ctx.MM256_TABLE_LO_Y + y[k]), l0);
+            h0 = _mm_shuffle_epi8(_mm_load_si128(ctx.MM256_TABLE_HI_Y + y[k]), h0);
+            sum0 = _mm_xor_si128(sum0, _mm_xor_si128(l0, h0));
+        }
+
+        _mm_storeu_si128(z16, sum0);
+    }
+
+    // Handle final bytes
+    gf256_muladd_multi_bytes(ctx, z8, y, x, count, offset, bytes, add);
+}
+
+static void gf256_add_multi_mem_ssse3(void * GF256_RESTRICT vz, const uint8_t * const * x, int count, int bytes, bool add)
+{
+    uint8_t * GF256_RESTRICT z8 = reinterpret_cast<uint8_t*>(vz);
+    int offset = 0;
+
+    // Handle multiples of 32 bytes, keeping the sums in registers
+    for (; offset + 32 <= bytes; offset += 32)
+    {
+        GF256_M128 * z16 = reinterpret_cast<GF256_M128*>(z8 + offset);
+        GF256_M128 sum0 = add ? _mm_loadu_si128(z16) : _mm_setzero_si128();
+        GF256_M128 sum1 = add ? _mm_loadu_si128(z16 + 1) : _mm_setzero_si128();
+
+        for (int k = 0; k < count; ++k)
+        {
+            const GF256_M128 * x16 = reinterpret_cast<const GF256_M128*>(x[k] + offset);
+            sum0 = _mm_xor_si128(sum0, _mm_loadu_si128(x16));
+            sum1 = _mm_xor_si128(sum1, _mm_loadu_si128(x16 + 1));
+        }
+
+        _mm_storeu_si128(z16, sum0);
+        _mm_storeu_si128(z16 + 1, sum1);
+    }
+
+    // Handle multiples of 16 bytes
+    for (; offset + 16 <= bytes; offset += 16)
+    {
+        GF256_M128 * z16 = reinterpret_cast<GF256_M128*>(z8 + offset);
+        GF256_M128 sum0 = add ? _mm_loadu_si128(z16) : _mm_setzero_si128();
+
+        for (int k = 0; k < count; ++k) {
+            sum0 = _mm_xor_si128(sum0, _mm_loadu_si128(reinterpret_cast<const GF256_M128*>(x[k] + offset)));
+        }
+
+        _mm_storeu_si128(z16, sum0);
+    }
+
+    // Handle final bytes
+    gf256_add_multi_bytes(z8, x, count, offset, bytes, add);
+}
+
+// Fixed destination count so that the tables and pointers stay in registers
+template<int count>
+static void gf256_muladd_multi_dest_ssse3(const gf256_ctx& ctx, uint8_t * const * z, const uint8_t * y, const uint8_t * GF256_RESTRICT x, int bytes)
+{
+    // clr_mask = 0x0f0f0f0f0f0f0f0f0f0f0f0f0f0f0f0f
+    const GF256_M128 clr_mask = _mm_set1_epi8(0x0f);
+    GF256_M128 table_lo_y[count], table_hi_y[count];
+    uint8_t * zk[count];
+
+    for (int k = 0; k < count; ++k)
+    {
+        table_lo_y[k] = _mm_load_si128(ctx.MM256_TABLE_LO_Y + y[k]);
+        table_hi_y[k] = _mm_load_si128(ctx.MM256_TABLE_HI_Y + y[k]);
+        zk[k] = z[k];
+    }
+
+    int offset = 0;
+
+    // Handle multiples of 16 bytes, splitting each source vector once
+    for (; offset + 16 <= bytes; offset += 16)
+    {
+        // See above comments for details
+        GF256_M128 x0 = _mm_loadu_si128(reinterpret_cast<const GF256_M128*>(x + offset));
+        const GF256_M128 l0 = _mm_and_si128(x0, clr_mask);
+        x0 = _mm_srli_epi64(x0, 4);
+        const GF256_M128 h0 = _mm_and_si128(x0, clr_mask);
+
+        for (int k = 0; k < count; ++k)
+        {
+            GF256_M128 * z16 = reinterpret_cast<GF256_M128*>(zk[k] + offset);
+            const GF256_M128 p0 = _mm_xor_si128(_mm_shuffle_epi8(table_lo_y[k], l0), _mm_shuffle_epi8(table_hi_y[k], h0));
+            _mm_storeu_si128(z16, _mm_xor_si128(_mm_loadu_si128(z16), p0));
+        }
+    }
+
+    // Handle final bytes
+    gf256_muladd_multi_dest_bytes(ctx, zk, y, x, count, offset, bytes);
+}
+
+static void gf256_muladd_multi_dest_mem_ssse3(const gf256_ctx& ctx, uint8_t * const * z, const uint8_t * y, const uint8_t * GF256_RESTRICT x, int count, int bytes)
+{
+    switch (count)
+    {
+    case 1: gf256_muladd_multi_dest_ssse3<1>(ctx, z, y, x, bytes); break;
+    case 2: gf256_muladd_multi_dest_ssse3<2>(ctx, z, y, x, bytes); break;
+    case 3: gf256_muladd_multi_dest_ssse3<3>(ctx, z, y, x, bytes); break;
+    default: gf256_muladd_multi_dest_ssse3<4>(ctx, z, y, x, bytes); break;
+    }
+}
+
+#endif // USE_NEON
+
+//-----------------------------------------------------------------------------
+// AVX2 kernels
+
+#if defined(USE_AVX2)
+
+static GF256_TARGET_AVX2 void gf256_mul_mem_avx2(const gf256_ctx& ctx, void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, uint8_t y, int bytes)
+{
+    // Same tables in both 128-bit lanes
+    const GF256_M256 table_lo_y = _mm256_broadcastsi128_si256(_mm_load_si128(ctx.MM256_TABLE_LO_Y + y));
+    const GF256_M256 table_hi_y = _mm256_broadcastsi128_si256(_mm_load_si128(ctx.MM256_TABLE_HI_Y + y));
+
+    const GF256_M256 clr_mask = _mm256_set1_epi8(0x0f);
+
+    GF256_M256 * GF256_RESTRICT z32 = reinterpret_cast<GF256_M256*>(vz);
+    const GF256_M256 * GF256_RESTRICT x32 = reinterpret_cast<const GF256_M256*>(vx);
+
+    // Handle multiples of 32 bytes
+    while (bytes >= 32)
+    {
+        // See above comments for details
+        GF256_M256 x0 = _mm256_loadu_si256(x32);
+        GF256_M256 l0 = _mm256_and_si256(x0, clr_mask);
+        x0 = _mm256_srli_epi64(x0, 4);
+        GF256_M256 h0 = _mm256_and_si256(x0, clr_mask);
+        l0 = _mm256_shuffle_epi8(table_lo_y, l0);
+        h0 = _mm256_shuffle_epi8(table_hi_y, h0);
+        _mm256_storeu_si256(z32, _mm256_xor_si256(l0, h0));
+
+        x32++;
+        z32++;
+        bytes -= 32;
+    }
+
+    gf256_mul_mem_ssse3(ctx, z32, x32, y, bytes);
+}
+
+static GF256_TARGET_AVX2 void gf256_muladd_mem_avx2(const gf256_ctx& ctx, void * GF256_RESTRICT vz, uint8_t y, const void * GF256_RESTRICT vx, int bytes)
+{
+    // Same tables in both 128-bit lanes
+    const GF256_M256 table_lo_y = _mm256_broadcastsi128_si256(_mm_load_si128(ctx.MM256_TABLE_LO_Y + y));
+    const GF256_M256 table_hi_y = _mm256_broadcastsi128_si256(_mm_load_si128(ctx.MM256_TABLE_HI_Y + y));
+
+    const GF256_M256 clr_mask = _mm256_set1_epi8(0x0f);
+
+    GF256_M256 * GF256_RESTRICT z32 = reinterpret_cast<GF256_M256*>(vz);
+    const GF256_M256 * GF256_RESTRICT x32 = reinterpret_cast<const GF256_M256*>(vx);
+
+    // Handle multiples of 32 bytes
+    while (bytes >= 32)
+    {
+        // See above comments for details
+        GF256_M256 x0 = _mm256_loadu_si256(x32);
+        GF256_M256 l0 = _mm256_and_si256(x0, clr_mask);
+        x0 = _mm256_srli_epi64(x0, 4);
+        GF256_M256 h0 = _mm256_and_si256(x0, clr_mask);
+        l0 = _mm256_shuffle_epi8(table_lo_y, l0);
+        h0 = _mm256_shuffle_epi8(table_hi_y, h0);
+        const GF256_M256 p0 = _mm256_xor_si256(l0, h0);
+        const GF256_M256 z0 = _mm256_loadu_si256(z32);
+        _mm256_storeu_si256(z32, _mm256_xor_si256(p0, z0));
+
+        x32++;
+        z32++;
+        bytes -= 32;
+    }
+
+    gf256_muladd_mem_ssse3(ctx, z32, y, x32, bytes);
+}
+
+static GF256_TARGET_AVX2 void gf256_add_mem_avx2(void * GF256_RESTRICT vx, const void * GF256_RESTRICT vy, int bytes)
+{
+    GF256_M256 * GF256_RESTRICT x32 = reinterpret_cast<GF256_M256*>(vx);
+    const GF256_M256 * GF256_RESTRICT y32 = reinterpret_cast<const GF256_M256*>(vy);
+
+    // Handle multiples of 128 bytes
+    while (bytes >= 128)
+    {
+        GF256_M256 x0 = _mm256_loadu_si256(x32);
+        GF256_M256 x1 = _mm256_loadu_si256(x32 + 1);
+        GF256_M256 x2 = _mm256_loadu_si256(x32 + 2);
+        GF256_M256 x3 = _mm256_loadu_si256(x32 + 3);
+        GF256_M256 y0 = _mm256_loadu_si256(y32);
+        GF256_M256 y1 = _mm256_loadu_si256(y32 + 1);
+        GF256_M256 y2 = _mm256_loadu_si256(y32 + 2);
+        GF256_M256 y3 = _mm256_loadu_si256(y32 + 3);
+
+        _mm256_storeu_si256(x32, _mm256_xor_si256(x0, y0));
+        _mm256_storeu_si256(x32 + 1, _mm256_xor_si256(x1, y1));
+        _mm256_storeu_si256(x32 + 2, _mm256_xor_si256(x2, y2));
+        _mm256_storeu_si256(x32 + 3, _mm256_xor_si256(x3, y3));
+
+        x32 += 4;
+        y32 += 4;
+        bytes -= 128;
+    }
+
+    // Handle multiples of 32 bytes
+    while (bytes >= 32)
+    {
+        // x[i] = x[i] xor y[i]
+        _mm256_storeu_si256(x32,
+            _mm256_xor_si256(
+                _mm256_loadu_si256(x32),
+                _mm256_loadu_si256(y32)));
+
+        x32++;
+        y32++;
+        bytes -= 32;
+    }
+
+    gf256_add_mem_ssse3(x32, y32, bytes);
+}
+
+static GF256_TARGET_AVX2 void gf256_add2_mem_avx2(void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, const void * GF256_RESTRICT vy, int bytes)
+{
+    GF256_M256 * GF256_RESTRICT z32 = reinterpret_cast<GF256_M256*>(vz);
+    const GF256_M256 * GF256_RESTRICT x32 = reinterpret_cast<const GF256_M256*>(vx);
+    const GF256_M256 * GF256_RESTRICT y32 = reinterpret_cast<const GF256_M256*>(vy);
+
+    // Handle multiples of 32 bytes
+    while (bytes >= 32)
+    {
+        // z[i] = z[i] xor x[i] xor y[i]
+        _mm256_storeu_si256(z32,
+            _mm256_xor_si256(
+            _mm256_loadu_si256(z32),
+            _mm256_xor_si256(
+            _mm256_loadu_si256(x32),
+            _mm256_loadu_si256(y32))));
+
+        x32++;
+        y32++;
+        z32++;
+        bytes -= 32;
+    }
+
+    gf256_add2_mem_ssse3(z32, x32, y32, bytes);
+}
+
+static GF256_TARGET_AVX2 void gf256_addset_mem_avx2(void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, const void * GF256_RESTRICT vy, int bytes)
+{
+    GF256_M256 * GF256_RESTRICT z32 = reinterpret_cast<GF256_M256*>(vz);
+    const GF256_M256 * GF256_RESTRICT x32 = reinterpret_cast<const GF256_M256*>(vx);
+    const GF256_M256 * GF256_RESTRICT y32 = reinterpret_cast<const GF256_M256*>(vy);
+
+    // Handle multiples of 128 bytes
+    while (bytes >= 128)
+    {
+        GF256_M256 x0 = _mm256_loadu_si256(x32);
+        GF256_M256 x1 = _mm256_loadu_si256(x32 + 1);
+        GF256_M256 x2 = _mm256_loadu_si256(x32 + 2);
+        GF256_M256 x3 = _mm256_loadu_si256(x32 + 3);
+        GF256_M256 y0 = _mm256_loadu_si256(y32);
+        GF256_M256 y1 = _mm256_loadu_si256(y32 + 1);
+        GF256_M256 y2 = _mm256_loadu_si256(y32 + 2);
+        GF256_M256 y3 = _mm256_loadu_si256(y32 + 3);
+
+        _mm256_storeu_si256(z32, _mm256_xor_si256(x0, y0));
+        _mm256_storeu_si256(z32 + 1, _mm256_xor_si256(x1, y1));
+        _mm256_storeu_si256(z32 + 2, _mm256_xor_si256(x2, y2));
+        _mm256_storeu_si256(z32 + 3, _mm256_xor_si256(x3, y3));
+
+        x32 += 4;
+        y32 += 4;
+        z32 += 4;
+        bytes -= 128;
+    }
+
+    // Handle multiples of 32 bytes
+    while (bytes >= 32)
+    {
+        // z[i] = x[i] xor y[i]
+        _mm256_storeu_si256(z32,
+            _mm256_xor_si256(
+                _mm256_loadu_si256(x32),
+                _mm256_loadu_si256(y32)));
+
+        x32++;
+        y32++;
+        z32++;
+        bytes -= 32;
+    }
+
+    gf256_addset_mem_ssse3(z32, x32, y32, bytes);
+}
+
+static GF256_TARGET_AVX2 void gf256_memswap_avx2(void * GF256_RESTRICT vx, void * GF256_RESTRICT vy, int bytes)
+{
+    GF256_M256 * GF256_RESTRICT x32 = reinterpret_cast<GF256_M256*>(vx);
+    GF256_M256 * GF256_RESTRICT y32 = reinterpret_cast<GF256_M256*>(vy);
+
+    // Handle blocks of 32 bytes
+    while (bytes >= 32)
+    {
+        GF256_M256 x0 = _mm256_loadu_si256(x32);
+        GF256_M256 y0 = _mm256_loadu_si256(y32);
+        _mm256_storeu_si256(x32, y0);
+        _mm256_storeu_si256(y32, x0);
+
+        bytes -= 32;
+        ++x32;
+        ++y32;
+    }
+
+    gf256_memswap_ssse3(x32, y32, bytes);
+}
+
+static GF256_TARGET_AVX2 void gf256_muladd_multi_mem_avx2(const gf256_ctx& ctx, void * GF256_RESTRICT vz, const uint8_t * y, const uint8_t * const * x, int count, int bytes, bool add)
+{
+    const GF256_M256 clr_mask = _mm256_set1_epi8(0x0f);
+    uint8_t * GF256_RESTRICT z8 = reinterpret_cast<uint8_t*>(vz);
+    int offset = 0;
+
+    // Handle multiples of 64 bytes, keeping the sums in registers
+    for (; offset + 64 <= bytes; offset += 64)
+    {
+        GF256_M256 * z32 = reinterpret_cast<GF256_M256*>(z8 + offset);
+        GF256_M256 sum0 = add ? _mm256_loadu_si256(z32) : _mm256_setzero_si256();
+        GF256_M256 sum1 = add ? _mm256_loadu_si256(z32 + 1) : _mm256_setzero_si256();
+
+        for (int k = 0; k < count; ++k)
+        {
+            // See above comments for details
+            const GF256_M256 table_lo_y = _mm256_broadcastsi128_si256(_mm_load_si128(ctx.MM256_TABLE_LO_Y + y[k]));
+            const GF256_M256 table_hi_y = _mm256_broadcastsi128_si256(_mm_load_si128(ctx.MM256_TABLE_HI_Y + y[k]));
+            const GF256_M256 * x32 = reinterpret_cast<const GF256_M256*>(x[k] + offset);
+            GF256_M256 x0 = _mm256_loadu_si256(x32);
+            GF256_M256 x1 = _mm256_loadu_si256(x32 + 1);
+            GF256_M256 l0 = _mm256_and_si256(x0, clr_mask);
+            GF256_M256 l1 = _mm256_and_si256(x1, clr_mask);
+            x0 = _mm256_srli_epi64(x0, 4);
+            x1 = _mm256_srli_epi64(x1, 4);
+            GF256_M256 h0 = _mm256_and_si256(x0, clr_mask);
+            GF256_M256 h1 = _mm256_and_si256(x1, clr_mask);
+            l0 = _mm256_shuffle_epi8(table_lo_y, l0);
+            l1 = _mm256_shuffle_epi8(table_lo_y, l1);
+            h0 = _mm256_shuffle_epi8(table_hi_y, h0);
+            h1 = _mm256_shuffle_epi8(table_hi_y, h1);
+            sum0 = _mm256_xor_si256(sum0, _mm256_xor_si256(l0, h0));
+            sum1 = _mm256_xor_si256(sum1, _mm256_xor_si256(l1, h1));
+        }
+
+        _mm256_storeu_si256(z32, sum0);
+        _mm256_storeu_si256(z32 + 1, sum1);
+    }
+
+    // Handle multiples of 32 bytes
+    for (; offset + 32 <= bytes; offset += 32)
+    {
+        GF256_M256 * z32 = reinterpret_cast<GF256_M256*>(z8 + offset);
+        GF256_M256 sum0 = add ? _mm256_loadu_si256(z32) : _mm256_setzero_si256();
+
+        for (int k = 0; k < count; ++k)
+        {
+            const GF256_M256 table_lo_y = _mm256_broadcastsi128_si256(_mm_load_si128(ctx.MM256_TABLE_LO_Y + y[k]));
+            const GF256_M256 table_hi_y = _mm256_broadcastsi128_si256(_mm_load_si128(ctx.MM256_TABLE_HI_Y + y[k]));
+            GF256_M256 x0 = _mm256_loadu_si256(reinterpret_cast<const GF256_M256*>(x[k] + offset));
+            GF256_M256 l0 = _mm256_and_si256(x0, clr_mask);
+            x0 = _mm256_srli_epi64(x0, 4);
+            GF256_M256 h0 = _mm256_and_si256(x0, clr_mask);
+            l0 = _mm256_shuffle_epi8(table_lo_y, l0);
+            h0 = _mm256_shuffle_epi8(table_hi_y, h0);
+            sum0 = _mm256_xor_si256(sum0, _mm256_xor_si256(l0, h0));
+        }
+
+        _mm256_storeu_si256(z32, sum0);
+    }
+
+    if (offset < bytes)
+    {
+        const uint8_t * xs[GF256_MULTI_MAX];
+        for (int k = 0; k < count; ++k) {
+            xs[k] = x[k] + offset;
+        }
+
+        gf256_muladd_multi_mem_ssse3(ctx, z8 + offset, y, xs, count, bytes - offset, add);
+    }
+}
+
+static GF256_TARGET_AVX2 void gf256_add_multi_mem_avx2(void * GF256_RESTRICT vz, const uint8_t * const * x, int count, int bytes, bool add)
+{
+    uint8_t * GF256_RESTRICT z8 = reinterpret_cast<uint8_t*>(vz);
+    int offset = 0;
+
+    // Handle multiples of 64 bytes, keeping the sums in registers
+    for (; offset + 64 <= bytes; offset += 64)
+    {
+        GF256_M256 * z32 = reinterpret_cast<GF256_M256*>(z8 + offset);
+        GF256_M256 sum0 = add ? _mm256_loadu_si256(z32) : _mm256_setzero_si256();
+        GF256_M256 sum1 = add ? _mm256_loadu_si256(z32 + 1) : _mm256_setzero_si256();
+
+        for (int k = 0; k < count; ++k)
+        {
+            const GF256_M256 * x32 = reinterpret_cast<const GF256_M256*>(x[k] + offset);
+            sum0 = _mm256_xor_si256(sum0, _mm256_loadu_si256(x32));
+            sum1 = _mm256_xor_si256(sum1, _mm256_loadu_si256(x32 + 1));
+        }
+
+        _mm256_storeu_si256(z32, sum0);
+        _mm256_storeu_si256(z32 + 1, sum1);
+    }
+
+    // Handle multiples of 32 bytes
+    for (; offset + 32 <= bytes; offset += 32)
+    {
+        GF256_M256 * z32 = reinterpret_cast<GF256_M256*>(z8 + offset);
+        GF256_M256 sum0 = add ? _mm256_loadu_si256(z32) : _mm256_setzero_si256();
+
+        for (int k = 0; k < count; ++k) {
+            sum0 = _mm256_xor_si256(sum0, _mm256_loadu_si256(reinterpret_cast<const GF256_M256*>(x[k] + offset)));
+        }
+
+        _mm256_storeu_si256(z32, sum0);
+    }
+
+    if (offset < bytes)
+    {
+        const uint8_t * xs[GF256_MULTI_MAX];
+        for (int k = 0; k < count; ++k) {
+            xs[k] = x[k] + offset;
+        }
+
+        gf256_add_multi_mem_ssse3(z8 + offset, xs, count, bytes - offset, add);
+    }
+}
+
+template<int count>
+static GF256_TARGET_AVX2 void gf256_muladd_multi_dest_avx2(const gf256_ctx& ctx, uint8_t * const * z, const uint8_t * y, const uint8_t * GF256_RESTRICT x, int bytes)
+{
+    const GF256_M256 clr_mask = _mm256_set1_epi8(0x0f);
+    GF256_M256 table_lo_y[count], table_hi_y[count];
+    uint8_t * zk[count];
+
+    for (int k = 0; k < count; ++k)
+    {
+        table_lo_y[k] = _mm256_broadcastsi128_si256(_mm_load_si128(ctx.MM256_TABLE_LO_Y + y[k]));
+        table_hi_y[k] = _mm256_broadcastsi128_si256(_mm_load_si128(ctx.MM256_TABLE_HI_Y + y[k]));
+        zk[k] = z[k];
+    }
+
+    int offset = 0;
+
+    // Handle multiples of 32 bytes, splitting each source vector once
+    for (; offset + 32 <= bytes; offset += 32)
+    {
+        // See above comments for details
+        GF256_M256 x0 = _mm256_loadu_si256(reinterpret_cast<const GF256_M256*>(x + offset));
+        const GF256_M256 l0 = _mm256_and_si256(x0, clr_mask);
+        x0 = _mm256_srli_epi64(x0, 4);
+        const GF256_M256 h0 = _mm256_and_si256(x0, clr_mask);
+
+        for (int k = 0; k < count; ++k)
+        {
+            GF256_M256 * z32 = reinterpret_cast<GF256_M256*>(zk[k] + offset);
+            const GF256_M256 p0 = _mm256_xor_si256(_mm256_shuffle_epi8(table_lo_y[k], l0), _mm256_shuffle_epi8(table_hi_y[k], h0));
+            _mm256_storeu_si256(z32, _mm256_xor_si256(_mm256_loadu_si256(z32), p0));
+        }
+    }
+
+    if (offset < bytes)
+    {
+        for (int k = 0; k < count; ++k) {
+            zk[k] += offset;
+        }
+
+        gf256_muladd_multi_dest_mem_ssse3(ctx, zk, y, x + offset, count, bytes - offset);
+    }
+}
+
+static void gf256_muladd_multi_dest_mem_avx2(const gf256_ctx& ctx, uint8_t * const * z, const uint8_t * y, const uint8_t * GF256_RESTRICT x, int count, int bytes)
+{
+    switch (count)
+    {
+    case 1: gf256_muladd_multi_dest_avx2<1>(ctx, z, y, x, bytes); break;
+    case 2: gf256_muladd_multi_dest_avx2<2>(ctx, z, y, x, bytes); break;
+    case 3: gf256_muladd_multi_dest_avx2<3>(ctx, z, y, x, bytes); break;
+    default: gf256_muladd_multi_dest_avx2<4>(ctx, z, y, x, bytes); break;
+    }
+}
+
+#endif // USE_AVX2
+
+//-----------------------------------------------------------------------------
+// AVX-512BW kernels
+
+#if defined(USE_AVX512BW)
+
+// Mask selecting the low 'bytes' bytes of a 512-bit register, for 0 < bytes < 64
+static GF256_FORCE_INLINE __mmask64 gf256_tail_mask64(int bytes)
+{
+    return static_cast<__mmask64>(~0ULL >> (64 - bytes));
+}
+
+static GF256_TARGET_AVX512BW void gf256_mul_mem_avx512bw(const gf256_ctx& ctx, void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, uint8_t y, int bytes)
+{
+    // Same tables in all four 128-bit lanes.
+    // The all-ones maskz form avoids a GCC -Wmaybe-uninitialized false positive.
+    const GF256_M512 table_lo_y = _mm512_maskz_broadcast_i32x4(0xffff, _mm_load_si128(ctx.MM256_TABLE_LO_Y + y));
+    const GF256_M512 table_hi_y = _mm512_maskz_broadcast_i32x4(0xffff, _mm_load_si128(ctx.MM256_TABLE_HI_Y + y));
+
+    const GF256_M512 clr_mask = _mm512_set1_epi8(0x0f);
+
+    GF256_M512 * GF256_RESTRICT z64 = reinterpret_cast<GF256_M512*>(vz);
+    const GF256_M512 * GF256_RESTRICT x64 = reinterpret_cast<const GF256_M512*>(vx);
+
+    // Handle multiples of 64 bytes
+    while (bytes >= 64)
+    {
+        // See above comments for details
+        GF256_M512 x0 = _mm512_loadu_si512(x64);
+        GF256_M512 l0 = _mm512_and_si512(x0, clr_mask);
+        x0 = _mm512_srli_epi16(x0, 4);
+        GF256_M512 h0 = _mm512_and_si512(x0, clr_mask);
+        l0 = _mm512_shuffle_epi8(table_lo_y, l0);
+        h0 = _mm512_shuffle_epi8(table_hi_y, h0);
+        _mm512_storeu_si512(z64, _mm512_xor_si512(l0, h0));
+
+        x64++;
+        z64++;
+        bytes -= 64;
+    }
+
+    // Handle final bytes with masked loads and stores
+    if (bytes > 0)
+    {
+        const __mmask64 mask = gf256_tail_mask64(bytes);
+        GF256_M512 x0 = _mm512_maskz_loadu_epi8(mask, x64);
+        GF256_M512 l0 = _mm512_and_si512(x0, clr_mask);
+        x0 = _mm512_srli_epi16(x0, 4);
+        GF256_M512 h0 = _mm512_and_si512(x0, clr_mask);
+        l0 = _mm512_shuffle_epi8(table_lo_y, l0);
+        h0 = _mm512_shuffle_epi8(table_hi_y, h0);
+        _mm512_mask_storeu_epi8(z64, mask, _mm512_xor_si512(l0, h0));
+    }
+}
+
+static GF256_TARGET_AVX512BW void gf256_muladd_mem_avx512bw(const gf256_ctx& ctx, void * GF256_RESTRICT vz, uint8_t y, const void * GF256_RESTRICT vx, int bytes)
+{
+    // Same tables in all four 128-bit lanes.
+    // The all-ones maskz form avoids a GCC -Wmaybe-uninitialized false positive.
+    const GF256_M512 table_lo_y = _mm512_maskz_broadcast_i32x4(0xffff, _mm_load_si128(ctx.MM256_TABLE_LO_Y + y));
+    const GF256_M512 table_hi_y = _mm512_maskz_broadcast_i32x4(0xffff, _mm_load_si128(ctx.MM256_TABLE_HI_Y + y));
+
+    const GF256_M512 clr_mask = _mm512_set1_epi8(0x0f);
+
+    GF256_M512 * GF256_RESTRICT z64 = reinterpret_cast<GF256_M512*>(vz);
+    const GF256_M512 * GF256_RESTRICT x64 = reinterpret_cast<const GF256_M512*>(vx);
+
+    // Handle multiples of 64 bytes
+    while (bytes >= 64)
+    {
+        // See above comments for details
+        GF256_M512 x0 = _mm512_loadu_si512(x64);
+        GF256_M512 l0 = _mm512_and_si512(x0, clr_mask);
+        x0 = _mm512_srli_epi16(x0, 4);
+        GF256_M512 h0 = _mm512_and_si512(x0, clr_mask);
+        l0 = _mm512_shuffle_epi8(table_lo_y, l0);
+        h0 = _mm512_shuffle_epi8(table_hi_y, h0);
+        const GF256_M512 p0 = _mm512_xor_si512(l0, h0);
+        const GF256_M512 z0 = _mm512_loadu_si512(z64);
+        _mm512_storeu_si512(z64, _mm512_xor_si512(p0, z0));
+
+        x64++;
+        z64++;
+        bytes -= 64;
+    }
+
+    // Handle final bytes with masked loads and stores
+    if (bytes > 0)
+    {
+        const __mmask64 mask = gf256_tail_mask64(bytes);
+        GF256_M512 x0 = _mm512_maskz_loadu_epi8(mask, x64);
+        GF256_M512 l0 = _mm512_and_si512(x0, clr_mask);
+        x0 = _mm512_srli_epi16(x0, 4);
+        GF256_M512 h0 = _mm512_and_si512(x0, clr_mask);
+        l0 = _mm512_shuffle_epi8(table_lo_y, l0);
+        h0 = _mm512_shuffle_epi8(table_hi_y, h0);
+        const GF256_M512 p0 = _mm512_xor_si512(l0, h0);
+        const GF256_M512 z0 = _mm512_maskz_loadu_epi8(mask, z64);
+        _mm512_mask_storeu_epi8(z64, mask, _mm512_xor_si512(p0, z0));
+    }
+}
+
+static GF256_TARGET_AVX512BW void gf256_add_mem_avx512bw(void * GF256_RESTRICT vx, const void * GF256_RESTRICT vy, int bytes)
+{
+    GF256_M512 * GF256_RESTRICT x64 = reinterpret_cast<GF256_M512*>(vx);
+    const GF256_M512 * GF256_RESTRICT y64 = reinterpret_cast<const GF256_M512*>(vy);
+
+    // Handle multiples of 256 bytes
+    while (bytes >= 256)
+    {
+        GF256_M512 x0 = _mm512_loadu_si512(x64);
+        GF256_M512 x1 = _mm512_loadu_si512(x64 + 1);
+        GF256_M512 x2 = _mm512_loadu_si512(x64 + 2);
+        GF256_M512 x3 = _mm512_loadu_si512(x64 + 3);
+        GF256_M512 y0 = _mm512_loadu_si512(y64);
+        GF256_M512 y1 = _mm512_loadu_si512(y64 + 1);
+        GF256_M512 y2 = _mm512_loadu_si512(y64 + 2);
+        GF256_M512 y3 = _mm512_loadu_si512(y64 + 3);
+
+        _mm512_storeu_si512(x64, _mm512_xor_si512(x0, y0));
+        _mm512_storeu_si512(x64 + 1, _mm512_xor_si512(x1, y1));
+        _mm512_storeu_si512(x64 + 2, _mm512_xor_si512(x2, y2));
+        _mm512_storeu_si512(x64 + 3, _mm512_xor_si512(x3, y3));
+
+        x64 += 4;
+        y64 += 4;
+        bytes -= 256;
+    }
+
+    // Handle multiples of 64 bytes
+    while (bytes >= 64)
+    {
+        // x[i] = x[i] xor y[i]
+        _mm512_storeu_si512(x64,
+            _mm512_xor_si512(
+                _mm512_loadu_si512(x64),
+                _mm512_loadu_si512(y64)));
+
+        x64++;
+        y64++;
+        bytes -= 64;
+    }
+
+    // Handle final bytes with masked loads and stores
+    if (bytes > 0)
+    {
+        const __mmask64 mask = gf256_tail_mask64(bytes);
+        _mm512_mask_storeu_epi8(x64, mask,
+            _mm512_xor_si512(
+                _mm512_maskz_loadu_epi8(mask, x64),
+                _mm512_maskz_loadu_epi8(mask, y64)));
+    }
+}
+
+static GF256_TARGET_AVX512BW void gf256_add2_mem_avx512bw(void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, const void * GF256_RESTRICT vy, int bytes)
+{
+    GF256_M512 * GF256_RESTRICT z64 = reinterpret_cast<GF256_M512*>(vz);
+    const GF256_M512 * GF256_RESTRICT x64 = reinterpret_cast<const GF256_M512*>(vx);
+    const GF256_M512 * GF256_RESTRICT y64 = reinterpret_cast<const GF256_M512*>(vy);
+
+    // Handle multiples of 64 bytes
+    while (bytes >= 64)
+    {
+        // z[i] = z[i] xor x[i] xor y[i]
+        _mm512_storeu_si512(z64,
+            _mm512_ternarylogic_epi64(
+                _mm512_loadu_si512(z64),
+                _mm512_loadu_si512(x64),
+                _mm512_loadu_si512(y64), 0x96));
+
+        x64++;
+        y64++;
+        z64++;
+        bytes -= 64;
+    }
+
+    // Handle final bytes with masked loads and stores
+    if (bytes > 0)
+    {
+        const __mmask64 mask = gf256_tail_mask64(bytes);
+        _mm512_mask_storeu_epi8(z64, mask,
+            _mm512_ternarylogic_epi64(
+                _mm512_maskz_loadu_epi8(mask, z64),
+                _mm512_maskz_loadu_epi8(mask, x64),
+                _mm512_maskz_loadu_epi8(mask, y64), 0x96));
+    }
+}
+
+static GF256_TARGET_AVX512BW void gf256_addset_mem_avx512bw(void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, const void * GF256_RESTRICT vy, int bytes)
+{
+    GF256_M512 * GF256_RESTRICT z64 = reinterpret_cast<GF256_M512*>(vz);
+    const GF256_M512 * GF256_RESTRICT x64 = reinterpret_cast<const GF256_M512*>(vx);
+    const GF256_M512 * GF256_RESTRICT y64 = reinterpret_cast<const GF256_M512*>(vy);
+
+    // Handle multiples of 256 bytes
+    while (bytes >= 256)
+    {
+        GF256_M512 x0 = _mm512_loadu_si512(x64);
+        GF256_M512 x1 = _mm512_loadu_si512(x64 + 1);
+        GF256_M512 x2 = _mm512_loadu_si512(x64 + 2);
+        GF256_M512 x3 = _mm512_loadu_si512(x64 + 3);
+        GF256_M512 y0 = _mm512_loadu_si512(y64);
+        GF256_M512 y1 = _mm512_loadu_si512(y64 + 1);
+        GF256_M512 y2 = _mm512_loadu_si512(y64 + 2);
+        GF256_M512 y3 = _mm512_loadu_si512(y64 + 3);
+
+        _mm512_storeu_si512(z64, _mm512_xor_si512(x0, y0));
+        _mm512_storeu_si512(z64 + 1, _mm512_xor_si512(x1, y1));
+        _mm512_storeu_si512(z64 + 2, _mm512_xor_si512(x2, y2));
+        _mm512_storeu_si512(z64 + 3, _mm512_xor_si512(x3, y3));
+
+        x64 += 4;
+        y64 += 4;
+        z64 += 4;
+        bytes -= 256;
+    }
+
+    // Handle multiples of 64 bytes
+    while (bytes >= 64)
+    {
+        // z[i] = x[i] xor y[i]
+        _mm512_storeu_si512(z64,
+            _mm512_xor_si512(
+                _mm512_loadu_si512(x64),
+                _mm512_loadu_si512(y64)));
+
+        x64++;
+        y64++;
+        z64++;
+        bytes -= 64;
+    }
+
+    // Handle final bytes with masked loads and stores
+    if (bytes > 0)
+    {
+        const __mmask64 mask = gf256_tail_mask64(bytes);
+        _mm512_mask_storeu_epi8(z64, mask,
+            _mm512_xor_si512(
+                _mm512_maskz_loadu_epi8(mask, x64),
+                _mm512_maskz_loadu_epi8(mask, y64)));
+    }
+}
+
+static GF256_TARGET_AVX512BW void gf256_memswap_avx512bw(void * GF256_RESTRICT vx, void * GF256_RESTRICT vy, int bytes)
+{
+    GF256_M512 * GF256_RESTRICT x64 = reinterpret_cast<GF256_M512*>(vx);
+    GF256_M512 * GF256_RESTRICT y64 = reinterpret_cast<GF256_M512*>(vy);
+
+    // Handle blocks of 64 bytes
+    while (bytes >= 64)
+    {
+        GF256_M512 x0 = _mm512_loadu_si512(x64);
+        GF256_M512 y0 = _mm512_loadu_si512(y64);
+        _mm512_storeu_si512(x64, y0);
+        _mm512_storeu_si512(y64, x0);
+
+        bytes -= 64;
+        ++x64;
+        ++y64;
+    }
+
+    // Handle final bytes with masked loads and stores
+    if (bytes > 0)
+    {
+        const __mmask64 mask = gf256_tail_mask64(bytes);
+        GF256_M512 x0 = _mm512_maskz_loadu_epi8(mask, x64);
+        GF256_M512 y0 = _mm512_maskz_loadu_epi8(mask, y64);
+        _mm512_mask_storeu_epi8(x64, mask, y0);
+        _mm512_mask_storeu_epi8(y64, mask, x0);
+    }
+}
+
+static GF256_TARGET_AVX512BW void gf256_muladd_multi_mem_avx512bw(const gf256_ctx& ctx, void * GF256_RESTRICT vz, const uint8_t * y, const uint8_t * const * x, int count, int bytes, bool add)
+{
+    const GF256_M512 clr_mask = _mm512_set1_epi8(0x0f);
+    uint8_t * GF256_RESTRICT z8 = reinterpret_cast<uint8_t*>(vz);
+    int offset = 0;
+
+    // Handle multiples of 128 bytes, keeping the sums in registers
+    for (; offset + 128 <= bytes; offset += 128)
+    {
+        GF256_M512 * z64 = reinterpret_cast<GF256_M512*>(z8 + offset);
+        GF256_M512 sum0 = add ? _mm512_loadu_si512(z64) : _mm512_setzero_si512();
+        GF256_M512 sum1 = add ? _mm512_loadu_si512(z64 + 1) : _mm512_setzero_si512();
+
+        for (int k = 0; k < count; ++k)
+        {
+            // See above comments for details
+            const GF256_M512 table_lo_y = _mm512_maskz_broadcast_i32x4(0xffff, _mm_load_si128(ctx.MM256_TABLE_LO_Y + y[k]));
+            const GF256_M512 table_hi_y = _mm512_maskz_broadcast_i32x4(0xffff, _mm_load_si128(ctx.MM256_TABLE_HI_Y + y[k]));
+            const GF256_M512 * x64 = reinterpret_cast<const GF256_M512*>(x[k] + offset);
+            GF256_M512 x0 = _mm512_loadu_si512(x64);
+            GF256_M512 x1 = _mm512_loadu_si512(x64 + 1);
+            GF256_M512 l0 = _mm512_and_si512(x0, clr_mask);
+            GF256_M512 l1 = _mm512_and_si512(x1, clr_mask);
+            x0 = _mm512_srli_epi16(x0, 4);
+            x1 = _mm512_srli_epi16(x1, 4);
+            GF256_M512 h0 = _mm512_and_si512(x0, clr_mask);
+            GF256_M512 h1 = _mm512_and_si512(x1, clr_mask);
+            l0 = _mm512_shuffle_epi8(table_lo_y, l0);
+            l1 = _mm512_shuffle_epi8(table_lo_y, l1);
+            h0 = _mm512_shuffle_epi8(table_hi_y, h0);
+            h1 = _mm512_shuffle_epi8(table_hi_y, h1);
+            sum0 = _mm512_ternarylogic_epi64(sum0, l0, h0, 0x96);
+            sum1 = _mm512_ternarylogic_epi64(sum1, l1, h1, 0x96);
+        }
+
+        _mm512_storeu_si512(z64, sum0);
+        _mm512_storeu_si512(z64 + 1, sum1);
+    }
+
+    // Handle multiples of 64 bytes, final bytes with masked loads and stores
+    for (; offset < bytes; offset += 64)
+    {
+        const __mmask64 mask = bytes - offset >= 64 ? ~(__mmask64) 0 : gf256_tail_mask64(bytes - offset);
+        GF256_M512 sum0 = add ? _mm512_maskz_loadu_epi8(mask, z8 + offset) : _mm512_setzero_si512();
+
+        for (int k = 0; k < count; ++k)
+        {
+            const GF256_M512 table_lo_y = _mm512_maskz_broadcast_i32x4(0xffff, _mm_load_si128(ctx.MM256_TABLE_LO_Y + y[k]));
+            const GF256_M512 table_hi_y = _mm512_maskz_broadcast_i32x4(0xffff, _mm_load_si128(ctx.MM256_TABLE_HI_Y + y[k]));
+            GF256_M512 x0 = _mm512_maskz_loadu_epi8(mask, x[k] + offset);
+            GF256_M512 l0 = _mm512_and_si512(x0, clr_mask);
+            x0 = _mm512_srli_epi16(x0, 4);
+            GF256_M512 h0 = _mm512_and_si512(x0, clr_mask);
+            l0 = _mm512_shuffle_epi8(table_lo_y, l0);
+            h0 = _mm512_shuffle_epi8(table_hi_y, h0);
+            sum0 = _mm512_ternarylogic_epi64(sum0, l0, h0, 0x96);
+        }
+
+        _mm512_mask_storeu_epi8(z8 + offset, mask, sum0);
+    }
+}
+
+static GF256_TARGET_AVX512BW void gf256_add_multi_mem_avx512bw(void * GF256_RESTRICT vz, const uint8_t * const * x, int count, int bytes, bool add)
+{
+    uint8_t * GF256_RESTRICT z8 = reinterpret_cast<uint8_t*>(vz);
+    int offset = 0;
+
+    // Handle multiples of 128 bytes, keeping the sums in registers
+    for (; offset + 128 <= bytes; offset += 128)
+    {
+        GF256_M512 * z64 = reinterpret_cast<GF256_M512*>(z8 + offset);
+        GF256_M512 sum0 = add ? _mm512_loadu_si512(z64) : _mm512_setzero_si512();
+        GF256_M512 sum1 = add ? _mm512_loadu_si512(z64 + 1) : _mm512_setzero_si512();
+
+        for (int k = 0; k < count; ++k)
+        {
+            const GF256_M512 * x64 = reinterpret_cast<const GF256_M512*>(x[k] + offset);
+            sum0 = _mm512_xor_si512(sum0, _mm512_loadu_si512(x64));
+            sum1 = _mm512_xor_si512(sum1, _mm512_loadu_si512(x64 + 1));
+        }
+
+        _mm512_storeu_si512(z64, sum0);
+        _mm512_storeu_si512(z64 + 1, sum1);
+    }
+
+    // Handle multiples of 64 bytes, final bytes with masked loads and stores
+    for (; offset < bytes; offset += 64)
+    {
+        const __mmask64 mask = bytes - offset >= 64 ? ~(__mmask64) 0 : gf256_tail_mask64(bytes - offset);
+        GF256_M512 sum0 = add ? _mm512_maskz_loadu_epi8(mask, z8 + offset) : _mm512_setzero_si512();
+
+        for (int k = 0; k < count; ++k) {
+            sum0 = _mm512_xor_si512(sum0, _mm512_maskz_loadu_epi8(mask, x[k] + offset));
+        }
+
+        _mm512_mask_storeu_epi8(z8 + offset, mask, sum0);
+    }
+}
+
+template<int count>
+static GF256_TARGET_AVX512BW void gf256_muladd_multi_dest_avx512bw(const gf256_ctx& ctx, uint8_t * const * z, const uint8_t * y, const uint8_t * GF256_RESTRICT x, int bytes)
+{
+    const GF256_M512 clr_mask = _mm512_set1_epi8(0x0f);
+    GF256_M512 table_lo_y[count], table_hi_y[count];
+    uint8_t * zk[count];
+
+    for (int k = 0; k < count; ++k)
+    {
+        table_lo_y[k] = _mm512_maskz_broadcast_i32x4(0xffff, _mm_load_si128(ctx.MM256_TABLE_LO_Y + y[k]));
+        table_hi_y[k] = _mm512_maskz_broadcast_i32x4(0xffff, _mm_load_si128(ctx.MM256_TABLE_HI_Y + y[k]));
+        zk[k] = z[k];
+    }
+
+    // Handle multiples of 64 bytes, splitting each source vector once
+    for (int offset = 0; offset < bytes; offset += 64)
+    {
+        // Final bytes use masked loads and stores
+        const __mmask64 mask = bytes - offset >= 64 ? ~(__mmask64) 0 : gf256_tail_mask64(bytes - offset);
+
+        // See above comments for details
+        GF256_M512 x0 = _mm512_maskz_loadu_epi8(mask, x + offset);
+        const GF256_M512 l0 = _mm512_and_si512(x0, clr_mask);
+        x0 = _mm512_srli_epi16(x0, 4);
+        const GF256_M512 h0 = _mm512_and_si512(x0, clr_mask);
+
+        for (int k = 0; k < count; ++k)
+        {
+            const GF256_M512 z0 = _mm512_maskz_loadu_epi8(mask, zk[k] + offset);
+            _mm512_mask_storeu_epi8(zk[k] + offset, mask,
+                _mm512_ternarylogic_epi64(z0, _mm512_shuffle_epi8(table_lo_y[k], l0), _mm512_shuffle_epi8(table_hi_y[k], h0), 0x96));
+        }
+    }
+}
+
+static void gf256_muladd_multi_dest_mem_avx512bw(const gf256_ctx& ctx, uint8_t * const * z, const uint8_t * y, const uint8_t * GF256_RESTRICT x, int count, int bytes)
+{
+    switch (count)
+    {
+    case 1: gf256_muladd_multi_dest_avx512bw<1>(ctx, z, y, x, bytes); break;
+    case 2: gf256_muladd_multi_dest_avx512bw<2>(ctx, z, y, x, bytes); break;
+    case 3: gf256_muladd_multi_dest_avx512bw<3>(ctx, z, y, x, bytes); break;
+    default: gf256_muladd_multi_dest_avx512bw<4>(ctx, z, y, x, bytes); break;
+    }
+}
+
+#endif // USE_AVX512BW
+
+//-----------------------------------------------------------------------------
+// GFNI kernels
+//
+// z[] = x[] * y, or z[] += x[] * y when 'add' is set, using the bit-matrix
+// GF256_AFFINE_TABLE[y].  See the GFNI comments above.  There is one kernel
+// per register width since GFNI comes with AVX2-only CPUs as well.
+
+#if defined(USE_GFNI)
+
+template<bool add>
+static GF256_TARGET_GFNI void gf256_affine_mem_gfni(void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, uint64_t matrix, int bytes)
+{
+    const GF256_M128 matrix16 = _mm_set1_epi64x(static_cast<long long>(matrix));
+
+    GF256_M128 * GF256_RESTRICT z16 = reinterpret_cast<GF256_M128*>(vz);
+    const GF256_M128 * GF256_RESTRICT x16 = reinterpret_cast<const GF256_M128*>(vx);
+
+    // Handle multiples of 16 bytes
+    while (bytes >= 16)
+    {
+        GF256_M128 p0 = _mm_gf2p8affine_epi64_epi8(_mm_loadu_si128(x16), matrix16, 0);
+        if (add) {
+            p0 = _mm_xor_si128(p0, _mm_loadu_si128(z16));
+        }
+        _mm_storeu_si128(z16, p0);
+
+        x16++;
+        z16++;
+        bytes -= 16;
+    }
+
+    // Handle final bytes through a 16-byte buffer
+    if (bytes > 0)
+    {
+        GF256_ALIGNED uint8_t buffer[16] = { 0 };
+        memcpy(buffer, x16, bytes);
+        GF256_M128 p0 = _mm_gf2p8affine_epi64_epi8(_mm_load_si128(reinterpret_cast<const GF256_M128*>(buffer)), matrix16, 0);
+        _mm_store_si128(reinterpret_cast<GF256_M128*>(buffer), p0);
+
+        uint8_t * GF256_RESTRICT z1 = reinterpret_cast<uint8_t*>(z16);
+        for (int i = 0; i < bytes; ++i) {
+            z1[i] = add ? z1[i] ^ buffer[i] : buffer[i];
+        }
+    }
+}
+
+#if defined(USE_AVX2)
+
+template<bool add>
+static GF256_TARGET_GFNI_AVX2 void gf256_affine_mem_gfni_avx2(void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, uint64_t matrix, int bytes)
+{
+    const GF256_M256 matrix32 = _mm256_set1_epi64x(static_cast<long long>(matrix));
+
+    GF256_M256 * GF256_RESTRICT z32 = reinterpret_cast<GF256_M256*>(vz);
+    const GF256_M256 * GF256_RESTRICT x32 = reinterpret_cast<const GF256_M256*>(vx);
+
+    // Handle multiples of 32 bytes
+    while (bytes >= 32)
+    {
+        GF256_M256 p0 = _mm256_gf2p8affine_epi64_epi8(_mm256_loadu_si256(x32), matrix32, 0);
+        if (add) {
+            p0 = _mm256_xor_si256(p0, _mm256_loadu_si256(z32));
+        }
+        _mm256_storeu_si256(z32, p0);
+
+        x32++;
+        z32++;
+        bytes -= 32;
+    }
+
+    gf256_affine_mem_gfni<add>(z32, x32, matrix, bytes);
+}
+
+#endif // USE_AVX2
+
+#if defined(USE_AVX512BW)
+
+template<bool add>
+static GF256_TARGET_GFNI_AVX512BW void gf256_affine_mem_gfni_avx512bw(void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, uint64_t matrix, int bytes)
+{
+    const GF256_M512 matrix64 = _mm512_set1_epi64(static_cast<long long>(matrix));
+
+    GF256_M512 * GF256_RESTRICT z64 = reinterpret_cast<GF256_M512*>(vz);
+    const GF256_M512 * GF256_RESTRICT x64 = reinterpret_cast<const GF256_M512*>(vx);
+
+    // Handle multiples of 64 bytes
+    while (bytes >= 64)
+    {
+        GF256_M512 p0 = _mm512_gf2p8affine_epi64_epi8(_mm512_loadu_si512(x64), matrix64, 0);
+        if (add) {
+            p0 = _mm512_xor_si512(p0, _mm512_loadu_si512(z64));
+        }
+        _mm512_storeu_si512(z64, p0);
+
+        x64++;
+        z64++;
+        bytes -= 64;
+    }
+
+    // Handle final bytes with masked loads and stores
+    if (bytes > 0)
+    {
+        const __mmask64 mask = gf256_tail_mask64(bytes);
+        GF256_M512 p0 = _mm512_gf2p8affine_epi64_epi8(_mm512_maskz_loadu_epi8(mask, x64), matrix64, 0);
+        if (add) {
+            p0 = _mm512_xor_si512(p0, _mm512_maskz_loadu_epi8(mask, z64));
+        }
+        _mm512_mask_storeu_epi8(z64, mask, p0);
+    }
+}
+
+#endif // USE_AVX512BW
+
+// Multi-source versions, see GF256_MULTI_MAX
+static GF256_TARGET_GFNI void gf256_muladd_multi_mem_gfni(const gf256_ctx& ctx, void * GF256_RESTRICT vz, const uint8_t * y, const uint8_t * const * x, int count, int bytes, bool add)
+{
+    uint8_t * GF256_RESTRICT z8 = reinterpret_cast<uint8_t*>(vz);
+    int offset = 0;
+
+    // Handle multiples of 16 bytes, keeping the sum in a register
+    for (; offset + 16 <= bytes; offset += 16)
+    {
+        GF256_M128 * z16 = reinterpret_cast<GF256_M128*>(z8 + offset);
+        GF256_M128 sum = add ? _mm_loadu_si128(z16) : _mm_setzero_si128();
+
+        for (int k = 0; k < count; ++k)
+        {
+            const GF256_M128 x0 = _mm_loadu_si128(reinterpret_cast<const GF256_M128*>(x[k] + offset));
+            const GF256_M128 matrix16 = _mm_set1_epi64x(static_cast<long long>(ctx.GF256_AFFINE_TABLE[y[k]]));
+            sum = _mm_xor_si128(sum, _mm_gf2p8affine_epi64_epi8(x0, matrix16, 0));
+        }
+
+        _mm_storeu_si128(z16, sum);
+    }
+
+    // Handle final bytes
+    gf256_muladd_multi_bytes(ctx, z8, y, x, count, offset, bytes, add);
+}
+
+#if defined(USE_AVX2)
+
+static GF256_TARGET_GFNI_AVX2 void gf256_muladd_multi_mem_gfni_avx2(const gf256_ctx& ctx, void * GF256_RESTRICT vz, const uint8_t * y, const uint8_t * const * x, int count, int bytes, bool add)
+{
+    uint8_t * GF256_RESTRICT z8 = reinterpret_cast<uint8_t*>(vz);
+    int offset = 0;
+
+    // Handle multiples of 64 bytes, keeping the sums in registers
+    for (; offset + 64 <= bytes; offset += 64)
+    {
+        GF256_M256 * z32 = reinterpret_cast<GF256_M256*>(z8 + offset);
+        GF256_M256 sum0 = add ? _mm256_loadu_si256(z32) : _mm256_setzero_si256();
+        GF256_M256 sum1 = add ? _mm256_loadu_si256(z32 + 1) : _mm256_setzero_si256();
+
+        for (int k = 0; k < count; ++k)
+        {
+            const GF256_M256 * x32 = reinterpret_cast<const GF256_M256*>(x[k] + offset);
+            const GF256_M256 matrix32 = _mm256_set1_epi64x(static_cast<long long>(ctx.GF256_AFFINE_TABLE[y[k]]));
+            sum0 = _mm256_xor_si256(sum0, _mm256_gf2p8affine_epi64_epi8(_mm256_loadu_si256(x32), matrix32, 0));
+            sum1 = _mm256_xor_si256(sum1, _mm256_gf2p8affine_epi64_epi8(_mm256_loadu_si256(x32 + 1), matrix32, 0));
+        }
+
+        _mm256_storeu_si256(z32, sum0);
+        _mm256_storeu_si256(z32 + 1, sum1);
+    }
+
+    if (offset < bytes)
+    {
+        const uint8_t * xs[GF256_MULTI_MAX];
+        for (int k = 0; k < count; ++k) {
+            xs[k] = x[k] + offset;
+        }
+
+        gf256_muladd_multi_mem_gfni(ctx, z8 + offset, y, xs, count, bytes - offset, add);
+    }
+}
+
+#endif // USE_AVX2
+
+#if defined(USE_AVX512BW)
+
+static GF256_TARGET_GFNI_AVX512BW void gf256_muladd_multi_mem_gfni_avx512bw(const gf256_ctx& ctx, void * GF256_RESTRICT vz, const uint8_t * y, const uint8_t * const * x, int count, int bytes, bool add)
+{
+    uint8_t * GF256_RESTRICT z8 = reinterpret_cast<uint8_t*>(vz);
+    int offset = 0;
+
+    // Handle multiples of 128 bytes, keeping the sums in registers
+    for (; offset + 128 <= bytes; offset += 128)
+    {
+        GF256_M512 * z64 = reinterpret_cast<GF256_M512*>(z8 + offset);
+        GF256_M512 sum0 = add ? _mm512_loadu_si512(z64) : _mm512_setzero_si512();
+        GF256_M512 sum1 = add ? _mm512_loadu_si512(z64 + 1) : _mm512_setzero_si512();
+
+        for (int k = 0; k < count; ++k)
+        {
+            const GF256_M512 * x64 = reinterpret_cast<const GF256_M512*>(x[k] + offset);
+            const GF256_M512 matrix64 = _mm512_set1_epi64(static_cast<long long>(ctx.GF256_AFFINE_TABLE[y[k]]));
+            sum0 = _mm512_xor_si512(sum0, _mm512_gf2p8affine_epi64_epi8(_mm512_loadu_si512(x64), matrix64, 0));
+            sum1 = _mm512_xor_si512(sum1, _mm512_gf2p8affine_epi64_epi8(_mm512_loadu_si512(x64 + 1), matrix64, 0));
+        }
+
+        _mm512_storeu_si512(z64, sum0);
+        _mm512_storeu_si512(z64 + 1, sum1);
+    }
+
+    // Handle multiples of 64 bytes, final bytes with masked loads and stores
+    for (; offset < bytes; offset += 64)
+    {
+        const __mmask64 mask = bytes - offset >= 64 ? ~(__mmask64) 0 : gf256_tail_mask64(bytes - offset);
+        GF256_M512 sum0 = add ? _mm512_maskz_loadu_epi8(mask, z8 + offset) : _mm512_setzero_si512();
+
+        for (int k = 0; k < count; ++k)
+        {
+            const GF256_M512 matrix64 = _mm512_set1_epi64(static_cast<long long>(ctx.GF256_AFFINE_TABLE[y[k]]));
+            sum0 = _mm512_xor_si512(sum0, _mm512_gf2p8affine_epi64_epi8(_mm512_maskz_loadu_epi8(mask, x[k] + offset), matrix64, 0));
+        }
+
+        _mm512_mask_storeu_epi8(z8 + offset, mask, sum0);
+    }
+}
+
+#endif // USE_AVX512BW
+
+// Fixed destination count so that the matrices and pointers stay in registers
+template<int count>
+static GF256_TARGET_GFNI void gf256_muladd_multi_dest_gfni(const gf256_ctx& ctx, uint8_t * const * z, const uint8_t * y, const uint8_t * GF256_RESTRICT x, int bytes)
+{
+    GF256_M128 matrix16[count];
+    uint8_t * zk[count];
+
+    for (int k = 0; k < count; ++k)
+    {
+        matrix16[k] = _mm_set1_epi64x(static_cast<long long>(ctx.GF256_AFFINE_TABLE[y[k]]));
+        zk[k] = z[k];
+    }
+
+    int offset = 0;
+
+    // Handle multiples of 16 bytes, loading each source vector once
+    for (; offset + 16 <= bytes; offset += 16)
+    {
+        const GF256_M128 x0 = _mm_loadu_si128(reinterpret_cast<const GF256_M128*>(x + offset));
+
+        for (int k = 0; k < count; ++k)
+        {
+            GF256_M128 * z16 = reinterpret_cast<GF256_M128*>(zk[k] + offset);
+            _mm_storeu_si128(z16, _mm_xor_si128(_mm_loadu_si128(z16), _mm_gf2p8affine_epi64_epi8(x0, matrix16[k], 0)));
+        }
+    }
+
+    // Handle final bytes
+    gf256_muladd_multi_dest_bytes(ctx, zk, y, x, count, offset, bytes);
+}
+
+static void gf256_muladd_multi_dest_mem_gfni(const gf256_ctx& ctx, uint8_t * const * z, const uint8_t * y, const uint8_t * GF256_RESTRICT x, int count, int bytes)
+{
+    switch (count)
+    {
+    case 1: gf256_muladd_multi_dest_gfni<1>(ctx, z, y, x, bytes); break;
+    case 2: gf256_muladd_multi_dest_gfni<2>(ctx, z, y, x, bytes); break;
+    case 3: gf256_muladd_multi_dest_gfni<3>(ctx, z, y, x, bytes); break;
+    default: gf256_muladd_multi_dest_gfni<4>(ctx, z, y, x, bytes); break;
+    }
+}
+
+#if defined(USE_AVX2)
+
+template<int count>
+static GF256_TARGET_GFNI_AVX2 void gf256_muladd_multi_dest_gfni_avx2(const gf256_ctx& ctx, uint8_t * const * z, const uint8_t * y, const uint8_t * GF256_RESTRICT x, int bytes)
+{
+    GF256_M256 matrix32[count];
+    uint8_t * zk[count];
+
+    for (int k = 0; k < count; ++k)
+    {
+        matrix32[k] = _mm256_set1_epi64x(static_cast<long long>(ctx.GF256_AFFINE_TABLE[y[k]]));
+        zk[k] = z[k];
+    }
+
+    int offset = 0;
+
+    // Handle multiples of 32 bytes, loading each source vector once
+    for (; offset + 32 <= bytes; offset += 32)
+    {
+        const GF256_M256 x0 = _mm256_loadu_si256(reinterpret_cast<const GF256_M256*>(x + offset));
+
+        for (int k = 0; k < count; ++k)
+        {
+            GF256_M256 * z32 = reinterpret_cast<GF256_M256*>(zk[k] + offset);
+            _mm256_storeu_si256(z32, _mm256_xor_si256(_mm256_loadu_si256(z32), _mm256_gf2p8affine_epi64_epi8(x0, matrix32[k], 0)));
+        }
+    }
+
+    if (offset < bytes)
+    {
+        for (int k = 0; k < count; ++k) {
+            zk[k] += offset;
+        }
+
+        gf256_muladd_multi_dest_mem_gfni(ctx, zk, y, x + offset, count, bytes - offset);
+    }
+}
+
+static void gf256_muladd_multi_dest_mem_gfni_avx2(const gf256_ctx& ctx, uint8_t * const * z, const uint8_t * y, const uint8_t * GF256_RESTRICT x, int count, int bytes)
+{
+    switch (count)
+    {
+    case 1: gf256_muladd_multi_dest_gfni_avx2<1>(ctx, z, y, x, bytes); break;
+    case 2: gf256_muladd_multi_dest_gfni_avx2<2>(ctx, z, y, x, bytes); break;
+    case 3: gf256_muladd_multi_dest_gfni_avx2<3>(ctx, z, y, x, bytes); break;
+    default: gf256_muladd_multi_dest_gfni_avx2<4>(ctx, z, y, x, bytes); break;
+    }
+}
+
+#endif // USE_AVX2
+
+#if defined(USE_AVX512BW)
+
+template<int count>
+static GF256_TARGET_GFNI_AVX512BW void gf256_muladd_multi_dest_gfni_avx512bw(const gf256_ctx& ctx, uint8_t * const * z, const uint8_t * y, const uint8_t * GF256_RESTRICT x, int bytes)
+{
+    GF256_M512 matrix64[count];
+    uint8_t * zk[count];
+
+    for (int k = 0; k < count; ++k)
+    {
+        matrix64[k] = _mm512_set1_epi64(static_cast<long long>(ctx.GF256_AFFINE_TABLE[y[k]]));
+        zk[k] = z[k];
+    }
+
+    // Handle multiples of 64 bytes, loading each source vector once
+    for (int offset = 0; offset < bytes; offset += 64)
+    {
+        // Final bytes use masked loads and stores
+        const __mmask64 mask = bytes - offset >= 64 ? ~(__mmask64) 0 : gf256_tail_mask64(bytes - offset);
+        const GF256_M512 x0 = _mm512_maskz_loadu_epi8(mask, x + offset);
+
+        for (int k = 0; k < count; ++k)
+        {
+            const GF256_M512 z0 = _mm512_maskz_loadu_epi8(mask, zk[k] + offset);
+            _mm512_mask_storeu_epi8(zk[k] + offset, mask, _mm512_xor_si512(z0, _mm512_gf2p8affine_epi64_epi8(x0, matrix64[k], 0)));
+        }
+    }
+}
+
+static void gf256_muladd_multi_dest_mem_gfni_avx512bw(const gf256_ctx& ctx, uint8_t * const * z, const uint8_t * y, const uint8_t * GF256_RESTRICT x, int count, int bytes)
+{
+    switch (count)
+    {
+    case 1: gf256_muladd_multi_dest_gfni_avx512bw<1>(ctx, z, y, x, bytes); break;
+    case 2: gf256_muladd_multi_dest_gfni_avx512bw<2>(ctx, z, y, x, bytes); break;
+    case 3: gf256_muladd_multi_dest_gfni_avx512bw<3>(ctx, z, y, x, bytes); break;
+    default: gf256_muladd_multi_dest_gfni_avx512bw<4>(ctx, z, y, x, bytes); break;
+    }
+}
+
+#endif // USE_AVX512BW
+
+static void gf256_mul_mem_gfni(const gf256_ctx& ctx, void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, uint8_t y, int bytes)
+{
+    gf256_affine_mem_gfni<false>(vz, vx, ctx.GF256_AFFINE_TABLE[y], bytes);
+}
+
+static void gf256_muladd_mem_gfni(const gf256_ctx& ctx, void * GF256_RESTRICT vz, uint8_t y, const void * GF256_RESTRICT vx, int bytes)
+{
+    gf256_affine_mem_gfni<true>(vz, vx, ctx.GF256_AFFINE_TABLE[y], bytes);
+}
+
+#if defined(USE_AVX2)
+
+static void gf256_mul_mem_gfni_avx2(const gf256_ctx& ctx, void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, uint8_t y, int bytes)
+{
+    gf256_affine_mem_gfni_avx2<false>(vz, vx, ctx.GF256_AFFINE_TABLE[y], bytes);
+}
+
+static void gf256_muladd_mem_gfni_avx2(const gf256_ctx& ctx, void * GF256_RESTRICT vz, uint8_t y, const void * GF256_RESTRICT vx, int bytes)
+{
+    gf256_affine_mem_gfni_avx2<true>(vz, vx, ctx.GF256_AFFINE_TABLE[y], bytes);
+}
+
+#endif // USE_AVX2
+
+#if defined(USE_AVX512BW)
+
+static void gf256_mul_mem_gfni_avx512bw(const gf256_ctx& ctx, void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, uint8_t y, int bytes)
+{
+    gf256_affine_mem_gfni_avx512bw<false>(vz, vx, ctx.GF256_AFFINE_TABLE[y], bytes);
+}
+
+static void gf256_muladd_mem_gfni_avx512bw(const gf256_ctx& ctx, void * GF256_RESTRICT vz, uint8_t y, const void * GF256_RESTRICT vx, int bytes)
+{
+    gf256_affine_mem_gfni_avx512bw<true>(vz, vx, ctx.GF256_AFFINE_TABLE[y], bytes);
+}
+
+#endif // USE_AVX512BW
+
+#endif // USE_GFNI
+
+//-----------------------------------------------------------------------------
+// Dispatch
+//
+// The CPU features are read once with cpuid, together with the operating
+// system support for the wider register files (xgetbv).  The kernel table
+// below is then bound to the best kernel of each operation, not going above
+// the tier given by the CM256CC_SIMD environment variable or by
+// gf256_set_simd_level(), for A/B benchmarking and testing.
+
+struct gf256_kernels
+{
+    void (*mul_mem)(const gf256_ctx& ctx, void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, uint8_t y, int bytes);
+    void (*muladd_mem)(const gf256_ctx& ctx, void * GF256_RESTRICT vz, uint8_t y, const void * GF256_RESTRICT vx, int bytes);
+    void (*add_mem)(void * GF256_RESTRICT vx, const void * GF256_RESTRICT vy, int bytes);
+    void (*add2_mem)(void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, const void * GF256_RESTRICT vy, int bytes);
+    void (*addset_mem)(void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, const void * GF256_RESTRICT vy, int bytes);
+    void (*memswap)(void * GF256_RESTRICT vx, void * GF256_RESTRICT vy, int bytes);
+    void (*muladd_multi_mem)(const gf256_ctx& ctx, void * GF256_RESTRICT vz, const uint8_t * y, const uint8_t * const * x, int count, int bytes, bool add);
+    void (*add_multi_mem)(void * GF256_RESTRICT vz, const uint8_t * const * x, int count, int bytes, bool add);
+    void (*muladd_multi_dest_mem)(const gf256_ctx& ctx, uint8_t * const * z, const uint8_t * y, const uint8_t * GF256_RESTRICT x, int count, int bytes);
+};
+
+#if defined(USE_NEON)
+static const gf256_kernels BaselineKernels = {
+    gf256_mul_mem_neon,
+    gf256_muladd_mem_neon,
+    gf256_add_mem_neon,
+    gf256_add2_mem_neon,
+    gf256_addset_mem_neon,
+    gf256_memswap_neon,
+    gf256_muladd_multi_mem_neon,
+    gf256_add_multi_mem_neon,
+    gf256_muladd_multi_dest_mem_neon
+};
+#else
+static const gf256_kernels BaselineKernels = {
+    gf256_mul_mem_ssse3,
+    gf256_muladd_mem_ssse3,
+    gf256_add_mem_ssse3,
+    gf256_add2_mem_ssse3,
+    gf256_addset_mem_ssse3,
+    gf256_memswap_ssse3,
+    gf256_muladd_multi_mem_ssse3,
+    gf256_add_multi_mem_ssse3,
+    gf256_muladd_multi_dest_mem_ssse3
+};
+#endif
+
+static gf256_kernels Kernels = BaselineKernels;
+
+static gf256_ctx::SimdLevel SimdLevelInUse = gf256_ctx::SimdBaseline;
+
+#if defined(USE_SSSE3)
+
+static bool CpuHasAVX2 = false;
+static bool CpuHasAVX512BW = false;
+static bool CpuHasGFNI = false;
+
+static void gf256_cpuid(unsigned leaf, unsigned subleaf, unsigned regs[4])
+{
+#ifdef _MSC_VER
+    int info[4];
+    __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i) {
+        regs[i] = static_cast<unsigned>(info[i]);
+    }
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// Register state enabled by the operating system (XCR0)
+static uint64_t gf256_xgetbv()
+{
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    unsigned eax, edx;
+    __asm__ __volatile__ ("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+    return ((uint64_t) edx << 32) | eax;
+#endif
+}
+
+#endif // USE_SSSE3
+
+static void gf256_cpu_init()
+{
+#if defined(USE_SSSE3)
+    unsigned regs[4]; // eax, ebx, ecx, edx
+
+    gf256_cpuid(0, 0, regs);
+    const unsigned maxLeaf = regs[0];
+
+    gf256_cpuid(1, 0, regs);
+    const bool osxsave = (regs[2] & (1u << 27)) != 0;
+    const uint64_t xcr0 = osxsave ? gf256_xgetbv() : 0;
+    const bool osYmm = (xcr0 & 0x06) == 0x06;  // XMM and YMM state
+    const bool osZmm = (xcr0 & 0xe6) == 0xe6;  // and opmask, ZMM_Hi256, Hi16_ZMM state
+
+    if (maxLeaf >= 7)
+    {
+        gf256_cpuid(7, 0, regs);
+        CpuHasAVX2 = osYmm && (regs[1] & (1u << 5)) != 0;
+        CpuHasAVX512BW = osZmm && (regs[1] & (1u << 16)) != 0 && (regs[1] & (1u << 30)) != 0;
+        CpuHasGFNI = (regs[2] & (1u << 8)) != 0;
+    }
+#endif
+}
+
+static void gf256_bind_kernels(gf256_ctx::SimdLevel maxLevel)
+{
+    gf256_kernels kernels = BaselineKernels;
+    gf256_ctx::SimdLevel level = gf256_ctx::SimdBaseline;
+    (void) maxLevel;
+
+#if defined(USE_AVX2)
+    if (CpuHasAVX2 && maxLevel >= gf256_ctx::SimdAVX2)
+    {
+        kernels.mul_mem = gf256_mul_mem_avx2;
+        kernels.muladd_mem = gf256_muladd_mem_avx2;
+        kernels.add_mem = gf256_add_mem_avx2;
+        kernels.add2_mem = gf256_add2_mem_avx2;
+        kernels.addset_mem = gf256_addset_mem_avx2;
+        kernels.memswap = gf256_memswap_avx2;
+        kernels.muladd_multi_mem = gf256_muladd_multi_mem_avx2;
+        kernels.add_multi_mem = gf256_add_multi_mem_avx2;
+        kernels.muladd_multi_dest_mem = gf256_muladd_multi_dest_mem_avx2;
+        level = gf256_ctx::SimdAVX2;
+    }
+#endif
+#if defined(USE_AVX512BW)
+    if (CpuHasAVX512BW && maxLevel >= gf256_ctx::SimdAVX512BW)
+    {
+        kernels.mul_mem = gf256_mul_mem_avx512bw;
+        kernels.muladd_mem = gf256_muladd_mem_avx512bw;
+        kernels.add_mem = gf256_add_mem_avx512bw;
+        kernels.add2_mem = gf256_add2_mem_avx512bw;
+        kernels.addset_mem = gf256_addset_mem_avx512bw;
+        kernels.memswap = gf256_memswap_avx512bw;
+        kernels.muladd_multi_mem = gf256_muladd_multi_mem_avx512bw;
+        kernels.add_multi_mem = gf256_add_multi_mem_avx512bw;
+        kernels.muladd_multi_dest_mem = gf256_muladd_multi_dest_mem_avx512bw;
+        level = gf256_ctx::SimdAVX512BW;
+    }
+#endif
+#if defined(USE_GFNI)
+    if (CpuHasGFNI && maxLevel >= gf256_ctx::SimdGFNI)
+    {
+        // Widest registers the CPU supports
+        kernels.mul_mem = gf256_mul_mem_gfni;
+        kernels.muladd_mem = gf256_muladd_mem_gfni;
+        kernels.muladd_multi_mem = gf256_muladd_multi_mem_gfni;
+        kernels.muladd_multi_dest_mem = gf256_muladd_multi_dest_mem_gfni;
+#if defined(USE_AVX2)
+        if (CpuHasAVX2)
+        {
+            kernels.mul_mem = gf256_mul_mem_gfni_avx2;
+            kernels.muladd_mem = gf256_muladd_mem_gfni_avx2;
+            kernels.muladd_multi_mem = gf256_muladd_multi_mem_gfni_avx2;
+            kernels.muladd_multi_dest_mem = gf256_muladd_multi_dest_mem_gfni_avx2;
+        }
+#endif
+#if defined(USE_AVX512BW)
+        if (CpuHasAVX512BW)
+        {
+            kernels.mul_mem = gf256_mul_mem_gfni_avx512bw;
+            kernels.muladd_mem = gf256_muladd_mem_gfni_avx512bw;
+            kernels.muladd_multi_mem = gf256_muladd_multi_mem_gfni_avx512bw;
+            kernels.muladd_multi_dest_mem = gf256_muladd_multi_dest_mem_gfni_avx512bw;
+        }
+#endif
+        level = gf256_ctx::SimdGFNI;
+    }
+#endif
+
+    Kernels = kernels;
+    SimdLevelInUse = level;
+}
+
+// Maps the CM256CC_SIMD environment variable to a tier, SimdGFNI if not set
+static gf256_ctx::SimdLevel gf256_env_simd_level()
+{
+    const char *env = getenv("CM256CC_SIMD");
+
+    if (env && *env)
+    {
+        for (int level = gf256_ctx::SimdBaseline; level <= gf256_ctx::SimdGFNI; ++level)
+        {
+            if (strcmp(env, gf256_ctx::gf256_simd_name(static_cast<gf256_ctx::SimdLevel>(level))) == 0) {
+                return static_cast<gf256_ctx::SimdLevel>(level);
+            }
+        }
+
+        fprintf(stderr, "gf256_ctx: ignoring unknown CM256CC_SIMD value: %s\n", env);
+    }
+
+    return gf256_ctx::SimdGFNI;
+}
+
+void gf256_ctx::gf256_architecture_init()
+{
+    // Thread-safe one-time initialization
+    static const bool bound = (gf256_cpu_init(), gf256_bind_kernels(gf256_env_simd_level()), true);
+    (void) bound;
+}
+
+gf256_ctx::SimdLevel gf256_ctx::gf256_simd_supported()
+{
+    gf256_architecture_init();
+    SimdLevel level = SimdBaseline;
+#if defined(USE_AVX2)
+    if (CpuHasAVX2) {
+        level = SimdAVX2;
+    }
+#endif
+#if defined(USE_AVX512BW)
+    if (CpuHasAVX512BW) {
+        level = SimdAVX512BW;
+    }
+#endif
+#if defined(USE_GFNI)
+    if (CpuHasGFNI) {
+        level = SimdGFNI;
+    }
+#endif
+    return level;
+}
+
+gf256_ctx::SimdLevel gf256_ctx::gf256_simd_level()
+{
+    gf256_architecture_init();
+    return SimdLevelInUse;
+}
+
+bool gf256_ctx::gf256_simd_uses_avx2()
+{
+    gf256_architecture_init();
+#if defined(USE_AVX2)
+    return CpuHasAVX2 && SimdLevelInUse >= SimdAVX2;
+#else
+    return false;
+#endif
+}
+
+gf256_ctx::SimdLevel gf256_ctx::gf256_set_simd_level(SimdLevel maxLevel)
+{
+    gf256_architecture_init();
+    gf256_bind_kernels(maxLevel);
+    return SimdLevelInUse;
+}
+
+const char *gf256_ctx::gf256_simd_name(SimdLevel level)
+{
+    switch (level)
+    {
+    case SimdAVX2:
+        return "avx2";
+    case SimdAVX512BW:
+        return "avx512bw";
+    case SimdGFNI:
+        return "gfni";
+    default:
+#if defined(USE_NEON)
+        return "neon";
+#else
+        return "ssse3";
+#endif
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Operations with context
+
+void gf256_ctx::gf256_mul_mem(void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, uint8_t y, int bytes)
+{
+    // Use a single if-statement to handle special cases
+    if (y <= 1)
+    {
+        if (y == 0)
+        {
+            memset(vz, 0, bytes);
+        }
+        else if (vz != vx)
+        {
+            memcpy(vz, vx, bytes);
+        }
+        return;
+    }
+
+    Kernels.mul_mem(*this, vz, vx, y, bytes);
+}
+
+void gf256_ctx::gf256_muladd_mem(void * GF256_RESTRICT vz, uint8_t y, const void * GF256_RESTRICT vx, int bytes)
+{
+    // Use a single if-statement to handle special cases
+    if (y <= 1)
+    {
+        if (y == 1)
+        {
+            gf256_add_mem(vz, vx, bytes);
+        }
+        return;
+    }
+
+    Kernels.muladd_mem(*this, vz, y, vx, bytes);
+}
+
+// Feeds the multi-source kernel with groups of non-zero coefficients
+static void gf256_muladd_multi_groups(const gf256_ctx& ctx, void * GF256_RESTRICT vz, const uint8_t * y, const void * const * vx, int count, int bytes, bool add)
+{
+    const uint8_t * x[GF256_MULTI_MAX];
+    uint8_t c[GF256_MULTI_MAX];
+    int n = 0;
+
+    for (int k = 0; k < count; ++k)
+    {
+        if (y[k] == 0) {
+            continue;
+        }
+
+        x[n] = static_cast<const uint8_t*>(vx[k]);
+        c[n] = y[k];
+
+        if (++n == GF256_MULTI_MAX)
+        {
+            Kernels.muladd_multi_mem(ctx, vz, c, x, n, bytes, add);
+            add = true;
+            n = 0;
+        }
+    }
+
+    if (n > 0)
+    {
+        Kernels.muladd_multi_mem(ctx, vz, c, x, n, bytes, add);
+    }
+    else if (!add)
+    {
+        memset(vz, 0, bytes);
+    }
+}
+
+void gf256_ctx::gf256_muladd_multi_mem(void * GF256_RESTRICT vz, const uint8_t * y, const void * const * vx, int count, int bytes)
+{
+    gf256_muladd_multi_groups(*this, vz, y, vx, count, bytes, true);
+}
+
+void gf256_ctx::gf256_mul_multi_mem(void * GF256_RESTRICT vz, const uint8_t * y, const void * const * vx, int count, int bytes)
+{
+    gf256_muladd_multi_groups(*this, vz, y, vx, count, bytes, false);
+}
+
+void gf256_ctx::gf256_muladd_multi_dest_mem(void * const * vz, const uint8_t * y, const void * GF256_RESTRICT vx, int count, int bytes)
+{
+    uint8_t * z[GF256_MULTI_DEST_MAX];
+    uint8_t c[GF256_MULTI_DEST_MAX];
+    int n = 0;
+
+    // Feed the kernel with groups of non-zero coefficients
+    for (int k = 0; k < count; ++k)
+    {
+        if (y[k] == 0) {
+            continue;
+        }
+
+        z[n] = static_cast<uint8_t*>(vz[k]);
+        c[n] = y[k];
+
+        if (++n == GF256_MULTI_DEST_MAX)
+        {
+            Kernels.muladd_multi_dest_mem(*this, z, c, static_cast<const uint8_t*>(vx), n, bytes);
+            n = 0;
+        }
+    }
+
+    if (n > 0) {
+        Kernels.muladd_multi_dest_mem(*this, z, c, static_cast<const uint8_t*>(vx), n, bytes);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Static operations
+
+void gf256_ctx::gf256_add_mem(void * GF256_RESTRICT vx, const void * GF256_RESTRICT vy, int bytes)
+{
+    Kernels.add_mem(vx, vy, bytes);
+}
+
+void gf256_ctx::gf256_add2_mem(void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, const void * GF256_RESTRICT vy, int bytes)
+{
+    Kernels.add2_mem(vz, vx, vy, bytes);
+}
+
+void gf256_ctx::gf256_addset_mem(void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, const void * GF256_RESTRICT vy, int bytes)
+{
+    Kernels.addset_mem(vz, vx, vy, bytes);
+}
+
+void gf256_ctx::gf256_memswap(void * GF256_RESTRICT vx, void * GF256_RESTRICT vy, int bytes)
+{
+    Kernels.memswap(vx, vy, bytes);
+}
+
+// Feeds the multi-source XOR kernel with groups of sources
+static void gf256_add_multi_groups(void * GF256_RESTRICT vz, const void * const * vx, int count, int bytes, bool add)
+{
+    if (count <= 0)
+    {
+        if (!add) {
+            memset(vz, 0, bytes);
+        }
+        return;
+    }
+
+    for (int k = 0; k < count; k += GF256_MULTI_MAX)
+    {
+        const int n = count - k < GF256_MULTI_MAX ? count - k : GF256_MULTI_MAX;
+        Kernels.add_multi_mem(vz, reinterpret_cast<const uint8_t * const *>(vx + k), n, bytes, add || k > 0);
+    }
+}
+
+void gf256_ctx::gf256_add_multi_mem(void * GF256_RESTRICT vz, const void * const * vx, int count, int bytes)
+{
+    gf256_add_multi_groups(vz, vx, count, bytes, true);
+}
+
+void gf256_ctx::gf256_addset_multi_mem(void * GF256_RESTRICT vz, const void * const * vx, int count, int bytes)
+{
+    gf256_add_multi_groups(vz, vx, count, bytes, false);
+}
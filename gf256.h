@@ -61,6 +61,14 @@
     // Compiler-specific SSE headers
     #include <tmmintrin.h> // SSE3: _mm_shuffle_epi8
     #include <emmintrin.h> // SSE2
+    #include <immintrin.h> // AVX2: _mm256_shuffle_epi8
+
+    // Compiler-specific instruction set selection for a single function
+    #define GF256_TARGET_AVX2
+    #define GF256_TARGET_AVX512BW
+    #define GF256_TARGET_GFNI
+    #define GF256_TARGET_GFNI_AVX2
+    #define GF256_TARGET_GFNI_AVX512BW
 
 #else
 
@@ -79,8 +87,21 @@
     // Compiler-specific SSE headers
     #include <x86intrin.h>
 
+    // Compiler-specific instruction set selection for a single function
+    #define GF256_TARGET_AVX2 __attribute__((target("avx2")))
+    #define GF256_TARGET_AVX512BW __attribute__((target("avx512f,avx512bw")))
+    #define GF256_TARGET_GFNI __attribute__((target("gfni")))
+    #define GF256_TARGET_GFNI_AVX2 __attribute__((target("gfni,avx2")))
+    #define GF256_TARGET_GFNI_AVX512BW __attribute__((target("gfni,avx512f,avx512bw")))
+
 #endif
 
+    // Compiler-specific 256-bit SIMD register keyword
+    #define GF256_M256 __m256i
+
+    // Compiler-specific 512-bit SIMD register keyword
+    #define GF256_M512 __m512i
+
 #elif defined(USE_NEON)
 
     #include "sse2neon.h"
@@ -120,7 +141,7 @@
     #pragma warning(disable: 4324) // warning C4324: 'gf256_ctx' : structure was padded due to __declspec(align())
 #endif
 
-class CM256CC_API gf256_ctx // 141,072 bytes
+class CM256CC_API gf256_ctx // 143,120 bytes
 {
 public:
     gf256_ctx();
@@ -128,6 +149,26 @@ public:
 
     bool isInitialized() const { return initialized; }
 
+    /** SIMD kernel tiers, in increasing order of preference */
+    enum SimdLevel
+    {
+        SimdBaseline, //!< SSSE3 or Neon
+        SimdAVX2,
+        SimdAVX512BW,
+        SimdGFNI
+    };
+
+    /** Best tier supported by both the build and the CPU */
+    static SimdLevel gf256_simd_supported();
+    /** Tier of the kernels in use */
+    static SimdLevel gf256_simd_level();
+    /** Use the best kernels up to maxLevel and return the tier in use. Not thread-safe with running operations. */
+    static SimdLevel gf256_set_simd_level(SimdLevel maxLevel);
+    /** Name of a tier as used by the CM256CC_SIMD environment variable */
+    static const char *gf256_simd_name(SimdLevel level);
+    /** True when the tier in use may run AVX2 code, for the kernels of other fields following the same selection */
+    static bool gf256_simd_uses_avx2();
+
     /** Performs "x[] += y[]" bulk memory XOR operation */
     static void gf256_add_mem(void * GF256_RESTRICT vx, const void * GF256_RESTRICT vy, int bytes);
     /** Performs "z[] += x[] + y[]" bulk memory operation */
@@ -136,6 +177,10 @@ public:
     static void gf256_addset_mem(void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, const void * GF256_RESTRICT vy, int bytes);
     /** Swap two memory buffers in-place */
     static void gf256_memswap(void * GF256_RESTRICT vx, void * GF256_RESTRICT vy, int bytes);
+    /** Performs "z[] += x_0[] + ... + x_(count-1)[]" bulk memory operation, reading and writing z[] once per group of sources */
+    static void gf256_add_multi_mem(void * GF256_RESTRICT vz, const void * const * vx, int count, int bytes);
+    /** Performs "z[] = x_0[] + ... + x_(count-1)[]" bulk memory operation */
+    static void gf256_addset_multi_mem(void * GF256_RESTRICT vz, const void * const * vx, int count, int bytes);
 
     // return x + y
     static GF256_FORCE_INLINE uint8_t gf256_add(const uint8_t x, const uint8_t y)
@@ -174,6 +219,12 @@ public:
     void gf256_mul_mem(void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, uint8_t y, int bytes);
     /** Performs "z[] += x[] * y" bulk memory operation */
     void gf256_muladd_mem(void * GF256_RESTRICT vz, uint8_t y, const void * GF256_RESTRICT vx, int bytes);
+    /** Performs "z[] += x_0[] * y[0] + ... + x_(count-1)[] * y[count-1]" bulk memory operation, reading and writing z[] once per group of sources */
+    void gf256_muladd_multi_mem(void * GF256_RESTRICT vz, const uint8_t * y, const void * const * vx, int count, int bytes);
+    /** Performs "z[] = x_0[] * y[0] + ... + x_(count-1)[] * y[count-1]" bulk memory operation */
+    void gf256_mul_multi_mem(void * GF256_RESTRICT vz, const uint8_t * y, const void * const * vx, int count, int bytes);
+    /** Performs "z_k[] += x[] * y[k]" for k = 0 .. count-1 bulk memory operation, reading x[] once per group of destinations */
+    void gf256_muladd_multi_dest_mem(void * const * vz, const uint8_t * y, const void * GF256_RESTRICT vx, int count, int bytes);
 
     /** Performs "x[] /= y" bulk memory operation */
     GF256_FORCE_INLINE void gf256_div_mem(void * GF256_RESTRICT vz,
@@ -200,6 +251,9 @@ public:
     GF256_ALIGNED GF256_M128 MM256_TABLE_LO_Y[256];
     GF256_ALIGNED GF256_M128 MM256_TABLE_HI_Y[256];
 
+    // GF2P8AFFINEQB bit-matrices: multiplying by y is the 8x8 linear map GF256_AFFINE_TABLE[y]
+    uint64_t GF256_AFFINE_TABLE[256];
+
 private:
     int gf256_init_();
 
@@ -207,7 +261,8 @@ private:
     void gf256_explog_init();                  //!< Construct EXP and LOG tables from polynomial
     void gf256_muldiv_init();                  //!< Initialize MUL and DIV tables using LOG and EXP tables
     void gf256_inv_init();                     //!< Initialize INV table using DIV table
-    void gf256_muladd_mem_init();              //!< Initialize the MM256 tables using gf256_mul()
+    void gf256_muladd_mem_init();              //!< Initialize the MM256 and affine tables using gf256_mul()
+    static void gf256_architecture_init();     //!< Detect CPU features and select the kernels once
 
     static bool IsLittleEndian()
     {
@@ -0,0 +1,495 @@
+/*
+    Copyright (c) 2016 Edouard M. Griffiths.  All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+    * Neither the name of CM256 nor the names of its contributors may be
+      used to endorse or promote products derived from this software without
+      specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include <string.h>
+
+#include "gf65536.h"
+
+// x^16 + x^5 + x^3 + x^2 + 1
+static const unsigned GF65536_POLYNOMIAL = 0x1002D;
+
+// Sources or destinations whose tables are built together, 4 KB of tables
+static const int GF65536_TABLE_GROUP = 32;
+
+gf65536_ctx::gf65536_ctx() :
+    Polynomial(GF65536_POLYNOMIAL),
+    GF65536_LOG_TABLE(nullptr),
+    GF65536_EXP_TABLE(nullptr),
+    initialized(false)
+{
+    gf65536_init_();
+}
+
+gf65536_ctx::~gf65536_ctx()
+{
+    delete[] GF65536_LOG_TABLE;
+    delete[] GF65536_EXP_TABLE;
+}
+
+int gf65536_ctx::gf65536_init_()
+{
+    GF65536_LOG_TABLE = new uint16_t[65536];
+    GF65536_EXP_TABLE = new uint16_t[2 * 65535];
+    GF65536_LOG_TABLE[0] = 0; // Not used
+
+    // Powers of x, which must go through all the non-zero elements
+    unsigned v = 1;
+
+    for (int i = 0; i < 65535; ++i)
+    {
+        if (i > 0 && v == 1) {
+            return -1; // The polynomial is not primitive
+        }
+
+        GF65536_EXP_TABLE[i] = static_cast<uint16_t>(v);
+        GF65536_EXP_TABLE[i + 65535] = static_cast<uint16_t>(v);
+        GF65536_LOG_TABLE[v] = static_cast<uint16_t>(i);
+
+        v <<= 1;
+
+        if (v & 0x10000) {
+            v ^= Polynomial;
+        }
+    }
+
+    if (v != 1) {
+        return -2;
+    }
+
+    // Make sure the SIMD tier is selected before the kernels are used
+    gf256_ctx::gf256_simd_level();
+
+    initialized = true;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Nibble tables
+//
+// The product of y and x = n0 + n1 * 2^4 + n2 * 2^8 + n3 * 2^12 is the sum of
+// T_k[n_k] = y * n_k * 2^(4k) over the four nibbles of x.  T_k[n] is linear in
+// n so the tables are built from the 16 products y * 2^i.  Lo[k] holds the
+// low bytes of T_k and Hi[k] the high bytes.
+
+struct GF256_ALIGNED gf65536_tables
+{
+    uint8_t Lo[4][16];
+    uint8_t Hi[4][16];
+};
+
+// Byte n of GF65536_BIT_MASKS[b] is all ones when bit b of n is set
+static const uint8_t GF256_ALIGNED GF65536_BIT_MASKS[4][16] = {
+    { 0, 0xff, 0, 0xff, 0, 0xff, 0, 0xff, 0, 0xff, 0, 0xff, 0, 0xff, 0, 0xff },
+    { 0, 0, 0xff, 0xff, 0, 0, 0xff, 0xff, 0, 0, 0xff, 0xff, 0, 0, 0xff, 0xff },
+    { 0, 0, 0, 0, 0xff, 0xff, 0xff, 0xff, 0, 0, 0, 0, 0xff, 0xff, 0xff, 0xff },
+    { 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff }
+};
+
+static void gf65536_build_tables(uint16_t y, gf65536_tables& tables)
+{
+    uint16_t basis[16];
+    unsigned v = y;
+
+    for (int i = 0; i < 16; ++i)
+    {
+        basis[i] = static_cast<uint16_t>(v);
+        v <<= 1;
+
+        if (v & 0x10000) {
+            v ^= GF65536_POLYNOMIAL;
+        }
+    }
+
+    // All 16 entries of a table at once: the sum of the basis products
+    // selected by the bits of each entry index
+    const GF256_M128 * masks = reinterpret_cast<const GF256_M128*>(GF65536_BIT_MASKS);
+    GF256_M128 * table_lo = reinterpret_cast<GF256_M128*>(tables.Lo);
+    GF256_M128 * table_hi = reinterpret_cast<GF256_M128*>(tables.Hi);
+
+    for (int k = 0; k < 4; ++k)
+    {
+        GF256_M128 lo = _mm_setzero_si128();
+        GF256_M128 hi = _mm_setzero_si128();
+
+        for (int bit = 0; bit < 4; ++bit)
+        {
+            const GF256_M128 mask = _mm_load_si128(masks + bit);
+            const uint16_t product = basis[4 * k + bit];
+            lo = _mm_xor_si128(lo, _mm_and_si128(mask, _mm_set1_epi8(static_cast<char>(product & 0xff))));
+            hi = _mm_xor_si128(hi, _mm_and_si128(mask, _mm_set1_epi8(static_cast<char>(product >> 8))));
+        }
+
+        _mm_store_si128(table_lo + k, lo);
+        _mm_store_si128(table_hi + k, hi);
+    }
+}
+
+static GF256_FORCE_INLINE uint16_t gf65536_load(const uint8_t* p)
+{
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+static GF256_FORCE_INLINE void gf65536_store(uint8_t* p, uint16_t v)
+{
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+}
+
+
+//-----------------------------------------------------------------------------
+// Word by word kernels, for the final bytes
+
+static void gf65536_muladd_multi_words(const gf65536_ctx& ctx, uint8_t * z, const uint16_t * y, const uint8_t * const * x, int count, int offset, int bytes, bool add)
+{
+    for (; offset + 2 <= bytes; offset += 2)
+    {
+        uint16_t sum = add ? gf65536_load(z + offset) : 0;
+
+        for (int k = 0; k < count; ++k) {
+            sum ^= ctx.gf65536_mul(gf65536_load(x[k] + offset), y[k]);
+        }
+
+        gf65536_store(z + offset, sum);
+    }
+}
+
+static void gf65536_muladd_multi_dest_words(const gf65536_ctx& ctx, uint8_t * const * z, const uint16_t * y, const uint8_t * x, int count, int offset, int bytes)
+{
+    for (; offset + 2 <= bytes; offset += 2)
+    {
+        const uint16_t x0 = gf65536_load(x + offset);
+
+        for (int k = 0; k < count; ++k) {
+            gf65536_store(z[k] + offset, gf65536_load(z[k] + offset) ^ ctx.gf65536_mul(x0, y[k]));
+        }
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// 128-bit kernels (SSSE3, or Neon through sse2neon.h)
+//
+// 32 bytes are 16 elements: their low and high bytes are gathered in two
+// registers, the nibbles of each looked up in the tables, and the low and
+// high bytes of the products interleaved back.  The multi-source kernel sums
+// the products before interleaving them.
+
+// Low and high bytes of the 16 elements of x0, x1
+static GF256_FORCE_INLINE void gf65536_split_128(GF256_M128 x0, GF256_M128 x1, GF256_M128& lo, GF256_M128& hi)
+{
+    const GF256_M128 byte_mask = _mm_set1_epi16(0x00ff);
+    lo = _mm_packus_epi16(_mm_and_si128(x0, byte_mask), _mm_and_si128(x1, byte_mask));
+    hi = _mm_packus_epi16(_mm_srli_epi16(x0, 8), _mm_srli_epi16(x1, 8));
+}
+
+static GF256_FORCE_INLINE void gf65536_nibbles_128(GF256_M128 lo, GF256_M128 hi, GF256_M128 n[4])
+{
+    const GF256_M128 clr_mask = _mm_set1_epi8(0x0f);
+    n[0] = _mm_and_si128(lo, clr_mask);
+    n[1] = _mm_and_si128(_mm_srli_epi16(lo, 4), clr_mask);
+    n[2] = _mm_and_si128(hi, clr_mask);
+    n[3] = _mm_and_si128(_mm_srli_epi16(hi, 4), clr_mask);
+}
+
+// Low and high bytes of the products of the elements of nibbles n by y
+static GF256_FORCE_INLINE void gf65536_lookup_128(const gf65536_tables& tables, const GF256_M128 n[4], GF256_M128& lo, GF256_M128& hi)
+{
+    const GF256_M128 * table_lo = reinterpret_cast<const GF256_M128*>(tables.Lo);
+    const GF256_M128 * table_hi = reinterpret_cast<const GF256_M128*>(tables.Hi);
+
+    lo = _mm_xor_si128(
+            _mm_xor_si128(_mm_shuffle_epi8(_mm_load_si128(table_lo), n[0]), _mm_shuffle_epi8(_mm_load_si128(table_lo + 1), n[1])),
+            _mm_xor_si128(_mm_shuffle_epi8(_mm_load_si128(table_lo + 2), n[2]), _mm_shuffle_epi8(_mm_load_si128(table_lo + 3), n[3])));
+    hi = _mm_xor_si128(
+            _mm_xor_si128(_mm_shuffle_epi8(_mm_load_si128(table_hi), n[0]), _mm_shuffle_epi8(_mm_load_si128(table_hi + 1), n[1])),
+            _mm_xor_si128(_mm_shuffle_epi8(_mm_load_si128(table_hi + 2), n[2]), _mm_shuffle_epi8(_mm_load_si128(table_hi + 3), n[3])));
+}
+
+static void gf65536_muladd_multi_128(const gf65536_ctx& ctx, uint8_t * z, const gf65536_tables * tables, const uint16_t * y, const uint8_t * const * x, int count, int offset, int bytes, bool add)
+{
+    for (; offset + 32 <= bytes; offset += 32)
+    {
+        GF256_M128 * z16 = reinterpret_cast<GF256_M128*>(z + offset);
+        GF256_M128 sum_lo = _mm_setzero_si128();
+        GF256_M128 sum_hi = _mm_setzero_si128();
+
+        for (int k = 0; k < count; ++k)
+        {
+            const GF256_M128 * x16 = reinterpret_cast<const GF256_M128*>(x[k] + offset);
+            GF256_M128 lo, hi, n[4];
+            gf65536_split_128(_mm_loadu_si128(x16), _mm_loadu_si128(x16 + 1), lo, hi);
+            gf65536_nibbles_128(lo, hi, n);
+            gf65536_lookup_128(tables[k], n, lo, hi);
+            sum_lo = _mm_xor_si128(sum_lo, lo);
+            sum_hi = _mm_xor_si128(sum_hi, hi);
+        }
+
+        GF256_M128 z0 = _mm_unpacklo_epi8(sum_lo, sum_hi);
+        GF256_M128 z1 = _mm_unpackhi_epi8(sum_lo, sum_hi);
+
+        if (add)
+        {
+            z0 = _mm_xor_si128(z0, _mm_loadu_si128(z16));
+            z1 = _mm_xor_si128(z1, _mm_loadu_si128(z16 + 1));
+        }
+
+        _mm_storeu_si128(z16, z0);
+        _mm_storeu_si128(z16 + 1, z1);
+    }
+
+    gf65536_muladd_multi_words(ctx, z, y, x, count, offset, bytes, add);
+}
+
+static void gf65536_muladd_multi_dest_128(const gf65536_ctx& ctx, uint8_t * const * z, const gf65536_tables * tables, const uint16_t * y, const uint8_t * x, int count, int offset, int bytes)
+{
+    for (; offset + 32 <= bytes; offset += 32)
+    {
+        const GF256_M128 * x16 = reinterpret_cast<const GF256_M128*>(x + offset);
+        GF256_M128 lo, hi, n[4];
+        gf65536_split_128(_mm_loadu_si128(x16), _mm_loadu_si128(x16 + 1), lo, hi);
+        gf65536_nibbles_128(lo, hi, n);
+
+        for (int k = 0; k < count; ++k)
+        {
+            GF256_M128 * z16 = reinterpret_cast<GF256_M128*>(z[k] + offset);
+            gf65536_lookup_128(tables[k], n, lo, hi);
+            _mm_storeu_si128(z16, _mm_xor_si128(_mm_loadu_si128(z16), _mm_unpacklo_epi8(lo, hi)));
+            _mm_storeu_si128(z16 + 1, _mm_xor_si128(_mm_loadu_si128(z16 + 1), _mm_unpackhi_epi8(lo, hi)));
+        }
+    }
+
+    gf65536_muladd_multi_dest_words(ctx, z, y, x, count, offset, bytes);
+}
+
+
+//-----------------------------------------------------------------------------
+// AVX2 kernels
+//
+// Same as above on 64 bytes.  The pack and unpack instructions work within
+// each 128-bit lane, so splitting then interleaving gives the elements back
+// in place.
+
+#if defined(USE_AVX2)
+
+static GF256_TARGET_AVX2 GF256_FORCE_INLINE void gf65536_split_avx2(GF256_M256 x0, GF256_M256 x1, GF256_M256& lo, GF256_M256& hi)
+{
+    const GF256_M256 byte_mask = _mm256_set1_epi16(0x00ff);
+    lo = _mm256_packus_epi16(_mm256_and_si256(x0, byte_mask), _mm256_and_si256(x1, byte_mask));
+    hi = _mm256_packus_epi16(_mm256_srli_epi16(x0, 8), _mm256_srli_epi16(x1, 8));
+}
+
+static GF256_TARGET_AVX2 GF256_FORCE_INLINE void gf65536_nibbles_avx2(GF256_M256 lo, GF256_M256 hi, GF256_M256 n[4])
+{
+    const GF256_M256 clr_mask = _mm256_set1_epi8(0x0f);
+    n[0] = _mm256_and_si256(lo, clr_mask);
+    n[1] = _mm256_and_si256(_mm256_srli_epi16(lo, 4), clr_mask);
+    n[2] = _mm256_and_si256(hi, clr_mask);
+    n[3] = _mm256_and_si256(_mm256_srli_epi16(hi, 4), clr_mask);
+}
+
+static GF256_TARGET_AVX2 GF256_FORCE_INLINE GF256_M256 gf65536_table_avx2(const uint8_t * table)
+{
+    // Same table in both 128-bit lanes
+    return _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const GF256_M128*>(table)));
+}
+
+static GF256_TARGET_AVX2 GF256_FORCE_INLINE void gf65536_lookup_avx2(const gf65536_tables& tables, const GF256_M256 n[4], GF256_M256& lo, GF256_M256& hi)
+{
+    lo = _mm256_xor_si256(
+            _mm256_xor_si256(_mm256_shuffle_epi8(gf65536_table_avx2(tables.Lo[0]), n[0]), _mm256_shuffle_epi8(gf65536_table_avx2(tables.Lo[1]), n[1])),
+            _mm256_xor_si256(_mm256_shuffle_epi8(gf65536_table_avx2(tables.Lo[2]), n[2]), _mm256_shuffle_epi8(gf65536_table_avx2(tables.Lo[3]), n[3])));
+    hi = _mm256_xor_si256(
+            _mm256_xor_si256(_mm256_shuffle_epi8(gf65536_table_avx2(tables.Hi[0]), n[0]), _mm256_shuffle_epi8(gf65536_table_avx2(tables.Hi[1]), n[1])),
+            _mm256_xor_si256(_mm256_shuffle_epi8(gf65536_table_avx2(tables.Hi[2]), n[2]), _mm256_shuffle_epi8(gf65536_table_avx2(tables.Hi[3]), n[3])));
+}
+
+static GF256_TARGET_AVX2 void gf65536_muladd_multi_avx2(const gf65536_ctx& ctx, uint8_t * z, const gf65536_tables * tables, const uint16_t * y, const uint8_t * const * x, int count, int bytes, bool add)
+{
+    int offset = 0;
+
+    for (; offset + 64 <= bytes; offset += 64)
+    {
+        GF256_M256 * z32 = reinterpret_cast<GF256_M256*>(z + offset);
+        GF256_M256 sum_lo = _mm256_setzero_si256();
+        GF256_M256 sum_hi = _mm256_setzero_si256();
+
+        for (int k = 0; k < count; ++k)
+        {
+            const GF256_M256 * x32 = reinterpret_cast<const GF256_M256*>(x[k] + offset);
+            GF256_M256 lo, hi, n[4];
+            gf65536_split_avx2(_mm256_loadu_si256(x32), _mm256_loadu_si256(x32 + 1), lo, hi);
+            gf65536_nibbles_avx2(lo, hi, n);
+            gf65536_lookup_avx2(tables[k], n, lo, hi);
+            sum_lo = _mm256_xor_si256(sum_lo, lo);
+            sum_hi = _mm256_xor_si256(sum_hi, hi);
+        }
+
+        GF256_M256 z0 = _mm256_unpacklo_epi8(sum_lo, sum_hi);
+        GF256_M256 z1 = _mm256_unpackhi_epi8(sum_lo, sum_hi);
+
+        if (add)
+        {
+            z0 = _mm256_xor_si256(z0, _mm256_loadu_si256(z32));
+            z1 = _mm256_xor_si256(z1, _mm256_loadu_si256(z32 + 1));
+        }
+
+        _mm256_storeu_si256(z32, z0);
+        _mm256_storeu_si256(z32 + 1, z1);
+    }
+
+    gf65536_muladd_multi_128(ctx, z, tables, y, x, count, offset, bytes, add);
+}
+
+static GF256_TARGET_AVX2 void gf65536_muladd_multi_dest_avx2(const gf65536_ctx& ctx, uint8_t * const * z, const gf65536_tables * tables, const uint16_t * y, const uint8_t * x, int count, int bytes)
+{
+    int offset = 0;
+
+    for (; offset + 64 <= bytes; offset += 64)
+    {
+        const GF256_M256 * x32 = reinterpret_cast<const GF256_M256*>(x + offset);
+        GF256_M256 lo, hi, n[4];
+        gf65536_split_avx2(_mm256_loadu_si256(x32), _mm256_loadu_si256(x32 + 1), lo, hi);
+        gf65536_nibbles_avx2(lo, hi, n);
+
+        for (int k = 0; k < count; ++k)
+        {
+            GF256_M256 * z32 = reinterpret_cast<GF256_M256*>(z[k] + offset);
+            gf65536_lookup_avx2(tables[k], n, lo, hi);
+            _mm256_storeu_si256(z32, _mm256_xor_si256(_mm256_loadu_si256(z32), _mm256_unpacklo_epi8(lo, hi)));
+            _mm256_storeu_si256(z32 + 1, _mm256_xor_si256(_mm256_loadu_si256(z32 + 1), _mm256_unpackhi_epi8(lo, hi)));
+        }
+    }
+
+    gf65536_muladd_multi_dest_128(ctx, z, tables, y, x, count, offset, bytes);
+}
+
+#endif // USE_AVX2
+
+
+//-----------------------------------------------------------------------------
+// Bulk operations
+
+// z[] (+)= sum of x_k[] * y[k] for one group of sources
+static void gf65536_muladd_multi_group(const gf65536_ctx& ctx, uint8_t * z, const gf65536_tables * tables, const uint16_t * y, const uint8_t * const * x, int count, int bytes, bool add)
+{
+#if defined(USE_AVX2)
+    if (gf256_ctx::gf256_simd_uses_avx2())
+    {
+        gf65536_muladd_multi_avx2(ctx, z, tables, y, x, count, bytes, add);
+        return;
+    }
+#endif
+    gf65536_muladd_multi_128(ctx, z, tables, y, x, count, 0, bytes, add);
+}
+
+static void gf65536_muladd_multi(const gf65536_ctx& ctx, void * vz, const uint16_t * y, const void * const * vx, int count, int bytes, bool add)
+{
+    uint8_t * z = static_cast<uint8_t*>(vz);
+    const uint8_t * const * x = reinterpret_cast<const uint8_t * const *>(vx);
+    gf65536_tables tables[GF65536_TABLE_GROUP];
+
+    if (count <= 0)
+    {
+        if (!add) {
+            memset(z, 0, bytes);
+        }
+
+        return;
+    }
+
+    // Too short to amortize the tables
+    if (bytes < 32)
+    {
+        gf65536_muladd_multi_words(ctx, z, y, x, count, 0, bytes, add);
+        return;
+    }
+
+    for (int first = 0; first < count; first += GF65536_TABLE_GROUP)
+    {
+        const int groupCount = count - first < GF65536_TABLE_GROUP ? count - first : GF65536_TABLE_GROUP;
+
+        for (int k = 0; k < groupCount; ++k) {
+            gf65536_build_tables(y[first + k], tables[k]);
+        }
+
+        gf65536_muladd_multi_group(ctx, z, tables, y + first, x + first, groupCount, bytes, add || first > 0);
+    }
+}
+
+void gf65536_ctx::gf65536_mul_mem(void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, uint16_t y, int bytes) const
+{
+    gf65536_muladd_multi(*this, vz, &y, &vx, 1, bytes, false);
+}
+
+void gf65536_ctx::gf65536_muladd_mem(void * GF256_RESTRICT vz, uint16_t y, const void * GF256_RESTRICT vx, int bytes) const
+{
+    gf65536_muladd_multi(*this, vz, &y, &vx, 1, bytes, true);
+}
+
+void gf65536_ctx::gf65536_muladd_multi_mem(void * GF256_RESTRICT vz, const uint16_t * y, const void * const * vx, int count, int bytes) const
+{
+    gf65536_muladd_multi(*this, vz, y, vx, count, bytes, true);
+}
+
+void gf65536_ctx::gf65536_mul_multi_mem(void * GF256_RESTRICT vz, const uint16_t * y, const void * const * vx, int count, int bytes) const
+{
+    gf65536_muladd_multi(*this, vz, y, vx, count, bytes, false);
+}
+
+void gf65536_ctx::gf65536_muladd_multi_dest_mem(void * const * vz, const uint16_t * y, const void * GF256_RESTRICT vx, int count, int bytes) const
+{
+    uint8_t * const * z = reinterpret_cast<uint8_t * const *>(vz);
+    const uint8_t * x = static_cast<const uint8_t*>(vx);
+    gf65536_tables tables[GF65536_TABLE_GROUP];
+
+    if (bytes < 32)
+    {
+        gf65536_muladd_multi_dest_words(*this, z, y, x, count, 0, bytes);
+        return;
+    }
+
+    for (int first = 0; first < count; first += GF65536_TABLE_GROUP)
+    {
+        const int groupCount = count - first < GF65536_TABLE_GROUP ? count - first : GF65536_TABLE_GROUP;
+
+        for (int k = 0; k < groupCount; ++k) {
+            gf65536_build_tables(y[first + k], tables[k]);
+        }
+
+#if defined(USE_AVX2)
+        if (gf256_ctx::gf256_simd_uses_avx2())
+        {
+            gf65536_muladd_multi_dest_avx2(*this, z + first, tables, y + first, x, groupCount, bytes);
+            continue;
+        }
+#endif
+        gf65536_muladd_multi_dest_128(*this, z + first, tables, y + first, x, groupCount, 0, bytes);
+    }
+}
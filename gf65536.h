@@ -0,0 +1,135 @@
+/*
+    Copyright (c) 2016 Edouard M. Griffiths.  All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+    * Neither the name of CM256 nor the names of its contributors may be
+      used to endorse or promote products derived from this software without
+      specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifndef GF65536_H
+#define GF65536_H
+
+#include <stdint.h> // uint16_t etc
+#include "gf256.h"
+#include "export.h"
+
+//-----------------------------------------------------------------------------
+// GF(65536) Context
+//
+// Field of the cm65536 codec, GF(2^16) with the generator polynomial
+// x^16 + x^5 + x^3 + x^2 + 1.
+//
+// Field elements are stored in memory as 16-bit little-endian words, so the
+// byte counts of the bulk operations must be even.  Additions are the same
+// XOR as in GF(256): use gf256_ctx::gf256_add_mem() and the like.
+//
+// The bulk multiplications split each element in four nibbles and look each
+// one up in a 16-entry table of products with the constant, held as low and
+// high bytes so that the lookups are the byte shuffles of the GF(256)
+// kernels.  The tables depend on the constant and are built at each call, so
+// the bulk operations are meant for buffers of at least a few hundred bytes.
+// They use AVX2 when the GF(256) kernels in use do.
+
+class CM256CC_API gf65536_ctx
+{
+public:
+    gf65536_ctx();
+    ~gf65536_ctx();
+
+    gf65536_ctx(const gf65536_ctx&) = delete;
+    gf65536_ctx& operator=(const gf65536_ctx&) = delete;
+
+    bool isInitialized() const { return initialized; }
+
+    // return x + y
+    static GF256_FORCE_INLINE uint16_t gf65536_add(const uint16_t x, const uint16_t y)
+    {
+        return x ^ y;
+    }
+
+    // return x * y
+    GF256_FORCE_INLINE uint16_t gf65536_mul(uint16_t x, uint16_t y) const
+    {
+        if (x == 0 || y == 0) {
+            return 0;
+        }
+
+        return GF65536_EXP_TABLE[GF65536_LOG_TABLE[x] + GF65536_LOG_TABLE[y]];
+    }
+
+    // return x / y, y must not be 0
+    GF256_FORCE_INLINE uint16_t gf65536_div(uint16_t x, uint16_t y) const
+    {
+        if (x == 0) {
+            return 0;
+        }
+
+        return GF65536_EXP_TABLE[GF65536_LOG_TABLE[x] + 65535 - GF65536_LOG_TABLE[y]];
+    }
+
+    // return 1 / x, x must not be 0
+    GF256_FORCE_INLINE uint16_t gf65536_inv(uint16_t x) const
+    {
+        return GF65536_EXP_TABLE[65535 - GF65536_LOG_TABLE[x]];
+    }
+
+    // Same Cauchy matrix element as gf256_ctx::getMatrixElement()
+    // Note that for x_i == x_0, this will return 1, so it is better to unroll out the first row.
+    GF256_FORCE_INLINE uint16_t getMatrixElement(const uint16_t x_i, const uint16_t x_0, const uint16_t y_j) const
+    {
+        return gf65536_div(gf65536_add(y_j, x_0), gf65536_add(x_i, y_j));
+    }
+
+    /** Performs "z[] = x[] * y" bulk memory operation */
+    void gf65536_mul_mem(void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, uint16_t y, int bytes) const;
+    /** Performs "z[] += x[] * y" bulk memory operation */
+    void gf65536_muladd_mem(void * GF256_RESTRICT vz, uint16_t y, const void * GF256_RESTRICT vx, int bytes) const;
+    /** Performs "z[] += x_0[] * y[0] + ... + x_(count-1)[] * y[count-1]" bulk memory operation, reading and writing z[] once per group of sources */
+    void gf65536_muladd_multi_mem(void * GF256_RESTRICT vz, const uint16_t * y, const void * const * vx, int count, int bytes) const;
+    /** Performs "z[] = x_0[] * y[0] + ... + x_(count-1)[] * y[count-1]" bulk memory operation */
+    void gf65536_mul_multi_mem(void * GF256_RESTRICT vz, const uint16_t * y, const void * const * vx, int count, int bytes) const;
+    /** Performs "z_k[] += x[] * y[k]" for k = 0 .. count-1 bulk memory operation, reading x[] once per group of destinations */
+    void gf65536_muladd_multi_dest_mem(void * const * vz, const uint16_t * y, const void * GF256_RESTRICT vx, int count, int bytes) const;
+
+    /** Performs "z[] = x[] / y" bulk memory operation */
+    GF256_FORCE_INLINE void gf65536_div_mem(void * GF256_RESTRICT vz, const void * GF256_RESTRICT vx, uint16_t y, int bytes) const
+    {
+        gf65536_mul_mem(vz, vx, gf65536_inv(y), bytes); // Multiply by inverse
+    }
+
+    // Polynomial used, including the x^16 term
+    unsigned Polynomial;
+
+    // Log/Exp tables, the exponents are doubled so that the sum of two logs
+    // needs no reduction
+    uint16_t* GF65536_LOG_TABLE; // 65536 entries
+    uint16_t* GF65536_EXP_TABLE; // 2 * 65535 entries
+
+private:
+    int gf65536_init_();
+
+    bool initialized;
+};
+
+#endif // GF65536_H
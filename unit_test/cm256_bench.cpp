@@ -0,0 +1,1194 @@
+/*
+    Copyright (c) 2016 Edouard M. Griffiths.  All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+    * Neither the name of CM256 nor the names of its contributors may be
+      used to endorse or promote products derived from this software without
+      specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <string>
+
+#include "mainutils.h"
+#include "../cm256.h"
+
+static const int benchBlockSizes[] = { 508, 4096, 65536 };
+static const int benchBlockSizesCount = sizeof(benchBlockSizes) / sizeof(benchBlockSizes[0]);
+
+// Prints a throughput line in MB/s for 'bytes' processed 'iterations' times in 'usecs'
+static void printThroughput(const char *label, int bytes, long long iterations, long long usecs)
+{
+    double mbps = usecs > 0 ? (double) bytes * iterations / (double) usecs : 0.0;
+
+    std::cerr << "  " << std::left << std::setw(24) << label
+            << std::right << std::setw(7) << bytes << " bytes: "
+            << std::fixed << std::setprecision(1) << std::setw(9) << mbps << " MB/s" << std::endl;
+}
+
+// Number of iterations so that each measurement processes about 256 MB
+static long long iterationsFor(int bytes)
+{
+    return (256LL * 1024 * 1024) / bytes;
+}
+
+static void benchKernels(gf256_ctx& gf256Ctx)
+{
+    std::cerr << "gf256 kernels:" << std::endl;
+
+    for (int s = 0; s < benchBlockSizesCount; s++)
+    {
+        const int bytes = benchBlockSizes[s];
+        const long long iterations = iterationsFor(bytes);
+        uint8_t *x = new uint8_t[bytes];
+        uint8_t *y = new uint8_t[bytes];
+        uint8_t *z = new uint8_t[bytes];
+
+        for (int i = 0; i < bytes; i++)
+        {
+            x[i] = rand();
+            y[i] = rand();
+            z[i] = rand();
+        }
+
+        long long ts = getUSecs();
+        for (long long i = 0; i < iterations; i++) {
+            gf256Ctx.gf256_muladd_mem(z, (uint8_t) (2 + (i & 0x7f)), x, bytes);
+        }
+        printThroughput("gf256_muladd_mem", bytes, iterations, getUSecs() - ts);
+
+        ts = getUSecs();
+        for (long long i = 0; i < iterations; i++) {
+            gf256Ctx.gf256_mul_mem(z, x, (uint8_t) (2 + (i & 0x7f)), bytes);
+        }
+        printThroughput("gf256_mul_mem", bytes, iterations, getUSecs() - ts);
+
+        ts = getUSecs();
+        for (long long i = 0; i < iterations; i++) {
+            gf256_ctx::gf256_add_mem(z, x, bytes);
+        }
+        printThroughput("gf256_add_mem", bytes, iterations, getUSecs() - ts);
+
+        ts = getUSecs();
+        for (long long i = 0; i < iterations; i++) {
+            gf256_ctx::gf256_add2_mem(z, x, y, bytes);
+        }
+        printThroughput("gf256_add2_mem", bytes, iterations, getUSecs() - ts);
+
+        ts = getUSecs();
+        for (long long i = 0; i < iterations; i++) {
+            gf256_ctx::gf256_addset_mem(z, x, y, bytes);
+        }
+        printThroughput("gf256_addset_mem", bytes, iterations, getUSecs() - ts);
+
+        ts = getUSecs();
+        for (long long i = 0; i < iterations; i++) {
+            gf256_ctx::gf256_memswap(x, y, bytes);
+        }
+        printThroughput("gf256_memswap", bytes, iterations, getUSecs() - ts);
+
+        // Multi-source operations, throughput counts the bytes of all sources
+        static const int sourceCount = 16;
+        uint8_t *sources = new uint8_t[sourceCount * bytes];
+        const void *sourcePtrs[sourceCount];
+        uint8_t coefs[sourceCount];
+
+        for (int k = 0; k < sourceCount; k++)
+        {
+            sourcePtrs[k] = sources + k * bytes;
+            coefs[k] = (uint8_t) (2 + k);
+        }
+
+        for (int i = 0; i < sourceCount * bytes; i++) {
+            sources[i] = rand();
+        }
+
+        ts = getUSecs();
+        for (long long i = 0; i < iterations / sourceCount; i++) {
+            gf256Ctx.gf256_muladd_multi_mem(z, coefs, sourcePtrs, sourceCount, bytes);
+        }
+        printThroughput("gf256_muladd_multi", bytes, (iterations / sourceCount) * sourceCount, getUSecs() - ts);
+
+        ts = getUSecs();
+        for (long long i = 0; i < iterations / sourceCount; i++) {
+            gf256_ctx::gf256_add_multi_mem(z, sourcePtrs, sourceCount, bytes);
+        }
+        printThroughput("gf256_add_multi", bytes, (iterations / sourceCount) * sourceCount, getUSecs() - ts);
+
+        void *destPtrs[sourceCount];
+        for (int k = 0; k < sourceCount; k++) {
+            destPtrs[k] = sources + k * bytes;
+        }
+
+        ts = getUSecs();
+        for (long long i = 0; i < iterations / sourceCount; i++) {
+            gf256Ctx.gf256_muladd_multi_dest_mem(destPtrs, coefs, x, sourceCount, bytes);
+        }
+        printThroughput("gf256_muladd_multi_dest", bytes, (iterations / sourceCount) * sourceCount, getUSecs() - ts);
+
+        delete[] sources;
+        delete[] x;
+        delete[] y;
+        delete[] z;
+    }
+}
+
+// Encodes and decodes with 'lost' originals replaced by recovery blocks.
+// Throughput is given in original data bytes per second.
+static bool benchCodec(CM256& cm256, int originalCount, int recoveryCount, int blockBytes, int lost)
+{
+    CM256::cm256_encoder_params params = {};
+    params.OriginalCount = originalCount;
+    params.RecoveryCount = recoveryCount;
+    params.BlockBytes = blockBytes;
+
+    uint8_t *originalData = new uint8_t[originalCount * blockBytes];
+    uint8_t *recoveryData = new uint8_t[recoveryCount * blockBytes];
+    uint8_t *decodeData = new uint8_t[originalCount * blockBytes];
+    uint8_t *outputData = new uint8_t[originalCount * blockBytes];
+    CM256::cm256_block blocks[256];
+    void* outputs[256];
+
+    for (int i = 0; i < originalCount * blockBytes; i++) {
+        originalData[i] = rand();
+    }
+
+    for (int i = 0; i < originalCount; i++)
+    {
+        blocks[i].Block = originalData + i * blockBytes;
+        blocks[i].Index = CM256::cm256_get_original_block_index(params, i);
+    }
+
+    const long long frameBytes = (long long) originalCount * blockBytes;
+    const long long iterations = 1 + (64LL * 1024 * 1024) / (frameBytes * recoveryCount);
+    bool ok = true;
+
+    long long ts = getUSecs();
+    for (long long i = 0; i < iterations && ok; i++) {
+        ok = cm256.cm256_encode(params, blocks, recoveryData) == 0;
+    }
+    long long usecs = getUSecs() - ts;
+
+    std::cerr << "  " << originalCount << "+" << recoveryCount << " x " << blockBytes << " bytes:"
+            << " encode: " << std::fixed << std::setprecision(1)
+            << (usecs > 0 ? (double) frameBytes * iterations / usecs : 0.0) << " MB/s"
+            << " (" << (double) usecs / iterations << " us/frame)";
+
+    // Same with the parameters worked out once in a plan
+    CM256::CM256EncoderPlan plan;
+    ok = ok && cm256.cm256_init_encoder_plan(params, plan) == 0;
+
+    ts = getUSecs();
+    for (long long i = 0; i < iterations && ok; i++) {
+        ok = cm256.cm256_encode(plan, blocks, recoveryData) == 0;
+    }
+    usecs = getUSecs() - ts;
+
+    std::cerr << " plan: " << (usecs > 0 ? (double) frameBytes * iterations / usecs : 0.0) << " MB/s"
+            << " (" << (double) usecs / iterations << " us/frame)";
+
+    for (int i = 0; i < originalCount; i++) {
+        outputs[i] = outputData + i * blockBytes;
+    }
+
+    // Decode without then with the decoder cache, the loss pattern is the same
+    // every frame.  Then with the recovered blocks copied into an output
+    // frame, against decoding into it.
+    static const char *decodeLabels[] = { " decode", " cached: ", " copied: ", " outputs: " };
+
+    for (int mode = 0; mode < 4 && ok; mode++)
+    {
+        const bool cached = mode == 1;
+        cm256.setDecoderCacheSize(cached ? 4 : 0);
+        usecs = 0;
+
+        for (long long i = 0; i < iterations && ok; i++)
+        {
+            memcpy(decodeData, originalData, frameBytes);
+
+            for (int j = 0; j < originalCount; j++)
+            {
+                blocks[j].Block = decodeData + j * blockBytes;
+                blocks[j].Index = CM256::cm256_get_original_block_index(params, j);
+            }
+
+            for (int j = 0; j < lost && j < recoveryCount; j++)
+            {
+                memcpy(decodeData + j * blockBytes, recoveryData + j * blockBytes, blockBytes);
+                blocks[j].Index = CM256::cm256_get_recovery_block_index(params, j);
+            }
+
+            ts = getUSecs();
+
+            if (mode == 3)
+            {
+                ok = cm256.cm256_decode(params, blocks, outputs) == 0;
+            }
+            else
+            {
+                ok = cm256.cm256_decode(params, blocks) == 0;
+
+                for (int j = 0; j < lost && j < recoveryCount && mode == 2; j++) {
+                    memcpy(outputs[blocks[j].Index], blocks[j].Block, blockBytes);
+                }
+            }
+
+            usecs += getUSecs() - ts;
+        }
+
+        for (int j = 0; j < originalCount && ok; j++)
+        {
+            if (mode == 3 && j < lost && j < recoveryCount) {
+                ok = memcmp(outputs[j], originalData + j * blockBytes, blockBytes) == 0;
+            } else {
+                ok = memcmp(blocks[j].Block, originalData + blocks[j].Index * blockBytes, blockBytes) == 0;
+            }
+        }
+
+        std::cerr << (mode == 0 ? std::string(decodeLabels[mode]) + "(" + std::to_string(lost) + " lost): " : std::string(decodeLabels[mode]))
+                << std::fixed << std::setprecision(1)
+                << (usecs > 0 ? (double) frameBytes * iterations / usecs : 0.0) << " MB/s"
+                << " (" << (double) usecs / iterations << " us/frame)";
+    }
+
+    std::cerr << (ok ? "" : " FAILED") << std::endl;
+    cm256.setDecoderCacheSize(0);
+
+    for (int i = 0; i < originalCount; i++) {
+        blocks[i].Block = originalData + i * blockBytes;
+    }
+
+    delete[] originalData;
+    delete[] recoveryData;
+    delete[] decodeData;
+    delete[] outputData;
+
+    return ok;
+}
+
+// Encode and decode throughput against block size, one full block at a time
+// and tiled with the automatic tile size. Decoding replaces 'recoveryCount'
+// originals with recovery blocks.
+static bool benchTiling(CM256& cm256, int originalCount, int recoveryCount)
+{
+    static const int blockSizes[] = { 508, 4096, 16384, 65536, 262144 };
+    bool ok = true;
+
+    std::cerr << "  " << originalCount << "+" << recoveryCount << ":" << std::endl;
+
+    for (unsigned int s = 0; s < sizeof(blockSizes) / sizeof(blockSizes[0]) && ok; s++)
+    {
+        CM256::cm256_encoder_params params = {};
+        params.OriginalCount = originalCount;
+        params.RecoveryCount = recoveryCount;
+        params.BlockBytes = blockSizes[s];
+
+        const int frameBytes = originalCount * params.BlockBytes;
+        uint8_t *originalData = new uint8_t[frameBytes];
+        uint8_t *recoveryData = new uint8_t[recoveryCount * params.BlockBytes];
+        uint8_t *decodeData = new uint8_t[frameBytes];
+        CM256::cm256_block blocks[256];
+
+        for (int i = 0; i < frameBytes; i++) {
+            originalData[i] = rand();
+        }
+
+        for (int i = 0; i < originalCount; i++) {
+            blocks[i].Block = originalData + i * params.BlockBytes;
+        }
+
+        const long long iterations = 1 + (64LL * 1024 * 1024) / ((long long) frameBytes * recoveryCount);
+
+        for (int tiled = 0; tiled < 2 && ok; tiled++)
+        {
+            cm256.setTileBytes(tiled ? 0 : params.BlockBytes);
+            char label[32];
+
+            for (int i = 0; i < originalCount; i++) {
+                blocks[i].Block = originalData + i * params.BlockBytes;
+            }
+
+            long long ts = getUSecs();
+            for (long long i = 0; i < iterations && ok; i++) {
+                ok = cm256.cm256_encode(params, blocks, recoveryData) == 0;
+            }
+            long long usecs = getUSecs() - ts;
+
+            snprintf(label, sizeof(label), tiled ? "encode tiled (%d)" : "encode", cm256.cm256_get_tile_bytes(params));
+            printThroughput(label, params.BlockBytes, iterations * originalCount, usecs);
+
+            usecs = 0;
+
+            for (long long i = 0; i < iterations && ok; i++)
+            {
+                memcpy(decodeData, originalData, frameBytes);
+
+                for (int j = 0; j < originalCount; j++)
+                {
+                    blocks[j].Block = decodeData + j * params.BlockBytes;
+                    blocks[j].Index = CM256::cm256_get_original_block_index(params, j);
+                }
+
+                for (int j = 0; j < recoveryCount; j++)
+                {
+                    memcpy(blocks[j].Block, recoveryData + j * params.BlockBytes, params.BlockBytes);
+                    blocks[j].Index = CM256::cm256_get_recovery_block_index(params, j);
+                }
+
+                ts = getUSecs();
+                ok = cm256.cm256_decode(params, blocks) == 0;
+                usecs += getUSecs() - ts;
+            }
+
+            snprintf(label, sizeof(label), tiled ? "decode tiled (%d)" : "decode", cm256.cm256_get_tile_bytes(params));
+            printThroughput(label, params.BlockBytes, iterations * originalCount, usecs);
+        }
+
+        delete[] originalData;
+        delete[] recoveryData;
+        delete[] decodeData;
+    }
+
+    cm256.setTileBytes(0);
+
+    return ok;
+}
+
+// Segmented originals, a header and a payload in separate buffers: copy them
+// into contiguous blocks then encode, against encoding the segments in place
+static bool benchSegments(CM256& cm256, int originalCount, int recoveryCount, int blockBytes, int headerBytes)
+{
+    CM256::cm256_encoder_params params = {};
+    params.OriginalCount = originalCount;
+    params.RecoveryCount = recoveryCount;
+    params.BlockBytes = blockBytes;
+
+    const int payloadBytes = blockBytes - headerBytes;
+    uint8_t *headers = new uint8_t[originalCount * headerBytes];
+    uint8_t *payloads = new uint8_t[originalCount * payloadBytes];
+    uint8_t *stagingData = new uint8_t[originalCount * blockBytes];
+    uint8_t *recoveryData = new uint8_t[recoveryCount * blockBytes];
+    uint8_t *segmentedRecoveryData = new uint8_t[recoveryCount * blockBytes];
+    CM256::cm256_segment segments[256 * 2];
+    CM256::cm256_segmented_block segmentedBlocks[256];
+    CM256::CM256EncoderPlan plan;
+
+    for (int i = 0; i < originalCount * headerBytes; i++) {
+        headers[i] = rand();
+    }
+
+    for (int i = 0; i < originalCount * payloadBytes; i++) {
+        payloads[i] = rand();
+    }
+
+    for (int i = 0; i < originalCount; i++)
+    {
+        segments[2 * i].Data = headers + i * headerBytes;
+        segments[2 * i].Bytes = headerBytes;
+        segments[2 * i + 1].Data = payloads + i * payloadBytes;
+        segments[2 * i + 1].Bytes = payloadBytes;
+        segmentedBlocks[i].Segments = segments + 2 * i;
+        segmentedBlocks[i].SegmentCount = 2;
+    }
+
+    bool ok = cm256.cm256_init_encoder_plan(params, plan) == 0;
+    const long long frameBytes = (long long) originalCount * blockBytes;
+    const long long iterations = 1 + (64LL * 1024 * 1024) / (frameBytes * recoveryCount);
+
+    long long ts = getUSecs();
+    for (long long i = 0; i < iterations && ok; i++)
+    {
+        for (int j = 0; j < originalCount; j++)
+        {
+            memcpy(stagingData + j * blockBytes, headers + j * headerBytes, headerBytes);
+            memcpy(stagingData + j * blockBytes + headerBytes, payloads + j * payloadBytes, payloadBytes);
+        }
+
+        ok = cm256.cm256_encode(plan, stagingData, blockBytes, recoveryData, blockBytes) == 0;
+    }
+    const long long stagedUsecs = getUSecs() - ts;
+
+    ts = getUSecs();
+    for (long long i = 0; i < iterations && ok; i++) {
+        ok = cm256.cm256_encode(plan, segmentedBlocks, segmentedRecoveryData) == 0;
+    }
+    const long long segmentedUsecs = getUSecs() - ts;
+
+    ok = ok && memcmp(recoveryData, segmentedRecoveryData, recoveryCount * blockBytes) == 0;
+
+    std::cerr << "  " << originalCount << "+" << recoveryCount << " x " << headerBytes << "+" << payloadBytes << " bytes:"
+            << std::fixed << std::setprecision(1)
+            << " copy and encode: " << (double) stagedUsecs / iterations << " us/frame"
+            << " segments: " << (double) segmentedUsecs / iterations << " us/frame"
+            << (ok ? "" : " FAILED") << std::endl;
+
+    delete[] headers;
+    delete[] payloads;
+    delete[] stagingData;
+    delete[] recoveryData;
+    delete[] segmentedRecoveryData;
+
+    return ok;
+}
+
+// GF(256) kernels against the XOR-only bit-matrix mode, encoding with plans
+// and decoding with the first 'lost' originals lost
+static bool benchBitMatrix(CM256& cm256, int originalCount, int recoveryCount, int blockBytes, int lost)
+{
+    CM256::cm256_encoder_params params = {};
+    params.OriginalCount = originalCount;
+    params.RecoveryCount = recoveryCount;
+    params.BlockBytes = blockBytes;
+
+    const long long frameBytes = (long long) originalCount * blockBytes;
+    const long long iterations = 1 + (64LL * 1024 * 1024) / (frameBytes * recoveryCount);
+    uint8_t *originalData = new uint8_t[frameBytes];
+    uint8_t *recoveryData = new uint8_t[recoveryCount * blockBytes];
+    uint8_t *decodeData = new uint8_t[frameBytes];
+    CM256::cm256_block blocks[256];
+    CM256::CM256EncoderPlan plan;
+    CM256::CM256BitMatrixPlan bitMatrixPlan;
+    long long usecs[4] = { 0, 0, 0, 0 };
+
+    for (long long i = 0; i < frameBytes; i++) {
+        originalData[i] = rand();
+    }
+
+    bool ok = cm256.cm256_init_encoder_plan(params, plan) == 0
+            && cm256.cm256_init_bitmatrix_plan(params, bitMatrixPlan) == 0;
+
+    for (int mode = 0; mode < 2; mode++)
+    {
+        for (long long i = 0; i < iterations && ok; i++)
+        {
+            for (int j = 0; j < originalCount; j++)
+            {
+                blocks[j].Block = originalData + j * blockBytes;
+                blocks[j].Index = (unsigned char) j;
+            }
+
+            long long ts = getUSecs();
+            ok = (mode == 0 ? cm256.cm256_encode(plan, blocks, recoveryData)
+                    : cm256.cm256_encode_bitmatrix(bitMatrixPlan, blocks, recoveryData)) == 0;
+            usecs[mode] += getUSecs() - ts;
+
+            memcpy(decodeData, originalData, frameBytes);
+
+            for (int j = 0; j < originalCount; j++)
+            {
+                blocks[j].Block = decodeData + j * blockBytes;
+                blocks[j].Index = (unsigned char) (j < lost ? originalCount + j : j);
+
+                if (j < lost) {
+                    memcpy(blocks[j].Block, recoveryData + j * blockBytes, blockBytes);
+                }
+            }
+
+            ts = getUSecs();
+            ok = ok && (mode == 0 ? cm256.cm256_decode(params, blocks) : cm256.cm256_decode_bitmatrix(params, blocks)) == 0;
+            usecs[2 + mode] += getUSecs() - ts;
+        }
+
+        for (int j = 0; j < originalCount && ok; j++) {
+            ok = memcmp(blocks[j].Block, originalData + blocks[j].Index * blockBytes, blockBytes) == 0;
+        }
+    }
+
+    std::cerr << "  " << originalCount << "+" << recoveryCount << " x " << blockBytes << " bytes:"
+            << std::fixed << std::setprecision(1)
+            << " encode gf256: " << (double) frameBytes * iterations / usecs[0] << " MB/s"
+            << " bit-matrix: " << (double) frameBytes * iterations / usecs[1] << " MB/s"
+            << " (" << bitMatrixPlan.XorCount << " XORs, " << bitMatrixPlan.DenseXorCount << " unscheduled)"
+            << " decode (" << lost << " lost) gf256: " << (double) frameBytes * iterations / usecs[2] << " MB/s"
+            << " bit-matrix: " << (double) frameBytes * iterations / usecs[3] << " MB/s"
+            << (ok ? "" : " FAILED") << std::endl;
+
+    delete[] originalData;
+    delete[] recoveryData;
+    delete[] decodeData;
+
+    return ok;
+}
+
+// Encoders with the default and the optimized matrix
+static bool benchMatrices(CM256& cm256, int originalCount, int recoveryCount, int blockBytes)
+{
+    CM256::cm256_encoder_params params = {};
+    params.OriginalCount = originalCount;
+    params.RecoveryCount = recoveryCount;
+    params.BlockBytes = blockBytes;
+
+    const long long frameBytes = (long long) originalCount * blockBytes;
+    const long long iterations = 1 + (64LL * 1024 * 1024) / (frameBytes * recoveryCount);
+    uint8_t *originalData = new uint8_t[frameBytes];
+    uint8_t *recoveryData = new uint8_t[recoveryCount * blockBytes];
+    CM256::cm256_block blocks[256];
+    CM256::CM256EncoderPlan plans[2];
+    CM256::CM256BitMatrixPlan bitMatrixPlans[2];
+    long long usecs[2][2] = { { 0, 0 }, { 0, 0 } };
+    bool ok = true;
+
+    for (long long i = 0; i < frameBytes; i++) {
+        originalData[i] = rand();
+    }
+
+    for (int j = 0; j < originalCount; j++)
+    {
+        blocks[j].Block = originalData + j * blockBytes;
+        blocks[j].Index = (unsigned char) j;
+    }
+
+    for (int m = 0; m < 2; m++)
+    {
+        params.Matrix = m == 0 ? CM256::MatrixDefault : CM256::MatrixOptimized;
+        ok = ok && cm256.cm256_init_encoder_plan(params, plans[m]) == 0
+                && cm256.cm256_init_bitmatrix_plan(params, bitMatrixPlans[m]) == 0;
+    }
+
+    // Alternate the matrices so that both see the same conditions
+    for (long long i = 0; i < iterations && ok; i++)
+    {
+        for (int m = 0; m < 2; m++)
+        {
+            long long ts = getUSecs();
+            ok = ok && cm256.cm256_encode(plans[m], blocks, recoveryData) == 0;
+            usecs[m][0] += getUSecs() - ts;
+
+            ts = getUSecs();
+            ok = ok && cm256.cm256_encode_bitmatrix(bitMatrixPlans[m], blocks, recoveryData) == 0;
+            usecs[m][1] += getUSecs() - ts;
+        }
+    }
+
+    std::cerr << "  " << originalCount << "+" << recoveryCount << " x " << blockBytes << " bytes:"
+            << std::fixed << std::setprecision(1)
+            << " gf256 default: " << (double) frameBytes * iterations / usecs[0][0] << " MB/s"
+            << " optimized: " << (double) frameBytes * iterations / usecs[1][0] << " MB/s"
+            << " bit-matrix default: " << (double) frameBytes * iterations / usecs[0][1] << " MB/s"
+            << " (" << bitMatrixPlans[0].XorCount << " XORs)"
+            << " optimized: " << (double) frameBytes * iterations / usecs[1][1] << " MB/s"
+            << " (" << bitMatrixPlans[1].XorCount << " XORs)"
+            << (ok ? "" : " FAILED") << std::endl;
+
+    delete[] originalData;
+    delete[] recoveryData;
+
+    return ok;
+}
+
+// Decode time of a few erasures against the encode time of one recovery row,
+// with and without the first recovery block (all ones) among the blocks
+// received.  5 erasures go through the LDU decomposition.
+static bool benchSmallErasures(CM256& cm256, int originalCount, int recoveryCount, int blockBytes)
+{
+    CM256::cm256_encoder_params params = {};
+    params.OriginalCount = originalCount;
+    params.RecoveryCount = recoveryCount;
+    params.BlockBytes = blockBytes;
+
+    uint8_t *originalData = new uint8_t[originalCount * blockBytes];
+    uint8_t *recoveryData = new uint8_t[recoveryCount * blockBytes];
+    uint8_t *decodeData = new uint8_t[originalCount * blockBytes];
+    CM256::cm256_block blocks[256];
+
+    for (int i = 0; i < originalCount * blockBytes; i++) {
+        originalData[i] = rand();
+    }
+
+    for (int i = 0; i < originalCount; i++)
+    {
+        blocks[i].Block = originalData + i * blockBytes;
+        blocks[i].Index = CM256::cm256_get_original_block_index(params, i);
+    }
+
+    const long long iterations = 1 + (64LL * 1024 * 1024) / ((long long) originalCount * blockBytes * recoveryCount);
+    bool ok = true;
+
+    long long ts = getUSecs();
+    for (long long i = 0; i < iterations && ok; i++) {
+        ok = cm256.cm256_encode(params, blocks, recoveryData) == 0;
+    }
+    long long usecs = getUSecs() - ts;
+
+    std::cerr << "  " << originalCount << "+" << recoveryCount << " x " << blockBytes << " bytes:"
+            << " encode: " << std::fixed << std::setprecision(2)
+            << (double) usecs / iterations / recoveryCount << " us/row" << std::endl;
+
+    for (int lost = 1; lost <= 5 && ok; lost++)
+    {
+        std::cerr << "   ";
+
+        for (int first = 1; first >= 0 && ok; first--)
+        {
+            const long long decodeIterations = iterations * recoveryCount / lost;
+            usecs = 0;
+
+            for (long long i = 0; i < decodeIterations && ok; i++)
+            {
+                memcpy(decodeData, originalData, (size_t) originalCount * blockBytes);
+
+                for (int j = 0; j < originalCount; j++)
+                {
+                    blocks[j].Block = decodeData + j * blockBytes;
+                    blocks[j].Index = CM256::cm256_get_original_block_index(params, j);
+                }
+
+                // Recovery blocks from the first one, or from the second one
+                for (int j = 0; j < lost; j++)
+                {
+                    memcpy(decodeData + j * blockBytes, recoveryData + (j + 1 - first) * blockBytes, blockBytes);
+                    blocks[j].Index = CM256::cm256_get_recovery_block_index(params, j + 1 - first);
+                }
+
+                ts = getUSecs();
+                ok = cm256.cm256_decode(params, blocks) == 0;
+                usecs += getUSecs() - ts;
+            }
+
+            for (int j = 0; j < originalCount && ok; j++) {
+                ok = memcmp(blocks[j].Block, originalData + blocks[j].Index * blockBytes, blockBytes) == 0;
+            }
+
+            std::cerr << " " << lost << (first ? "" : " (no first row)") << ": "
+                    << std::fixed << std::setprecision(2) << (double) usecs / decodeIterations / lost << " us/row";
+        }
+
+        std::cerr << (ok ? "" : " FAILED") << std::endl;
+    }
+
+    delete[] originalData;
+    delete[] recoveryData;
+    delete[] decodeData;
+
+    return ok;
+}
+
+// Variable-length originals: padding them into full blocks then encoding,
+// against encoding them with their lengths
+static bool benchVariable(CM256& cm256, int originalCount, int recoveryCount, int blockBytes, int minBytes)
+{
+    CM256::cm256_encoder_params params = {};
+    params.OriginalCount = originalCount;
+    params.RecoveryCount = recoveryCount;
+    params.BlockBytes = blockBytes;
+
+    uint8_t *frames = new uint8_t[originalCount * blockBytes];
+    uint8_t *paddedData = new uint8_t[originalCount * blockBytes];
+    uint8_t *recoveryData = new uint8_t[recoveryCount * CM256::cm256_get_variable_recovery_bytes(params)];
+    CM256::cm256_block frameBlocks[256];
+    CM256::cm256_block paddedBlocks[256];
+    int frameBytes[256];
+    long long totalBytes = 0;
+    CM256::CM256EncoderPlan plan;
+
+    for (int i = 0; i < originalCount; i++)
+    {
+        frameBytes[i] = minBytes + rand() % (blockBytes - minBytes + 1);
+        totalBytes += frameBytes[i];
+        frameBlocks[i].Block = frames + i * blockBytes;
+        paddedBlocks[i].Block = paddedData + i * blockBytes;
+
+        for (int j = 0; j < frameBytes[i]; j++) {
+            frames[i * blockBytes + j] = rand();
+        }
+    }
+
+    bool ok = cm256.cm256_init_encoder_plan(params, plan) == 0;
+    const long long iterations = 1 + (64LL * 1024 * 1024) / ((long long) originalCount * blockBytes * recoveryCount);
+
+    long long ts = getUSecs();
+    for (long long i = 0; i < iterations && ok; i++)
+    {
+        for (int j = 0; j < originalCount; j++)
+        {
+            memcpy(paddedBlocks[j].Block, frameBlocks[j].Block, frameBytes[j]);
+            memset((uint8_t*) paddedBlocks[j].Block + frameBytes[j], 0, blockBytes - frameBytes[j]);
+        }
+
+        ok = cm256.cm256_encode(plan, paddedBlocks, recoveryData) == 0;
+    }
+    const long long paddedUsecs = getUSecs() - ts;
+
+    ts = getUSecs();
+    for (long long i = 0; i < iterations && ok; i++) {
+        ok = cm256.cm256_encode_variable(plan, frameBlocks, frameBytes, recoveryData) == 0;
+    }
+    const long long variableUsecs = getUSecs() - ts;
+
+    std::cerr << "  " << originalCount << "+" << recoveryCount << " x " << minBytes << ".." << blockBytes << " bytes"
+            << " (" << totalBytes / originalCount << " average):"
+            << std::fixed << std::setprecision(1)
+            << " pad and encode: " << (double) paddedUsecs / iterations << " us/frame"
+            << " variable: " << (double) variableUsecs / iterations << " us/frame"
+            << (ok ? "" : " FAILED") << std::endl;
+
+    delete[] frames;
+    delete[] paddedData;
+    delete[] recoveryData;
+
+    return ok;
+}
+
+// Batches of small frames: time per frame of one call per frame against one
+// call for the batch.  The difference is the per-call overhead the batch
+// amortizes: validation, coefficient setup and, for the decoder, the matrices
+// of loss patterns that repeat across the frames.
+static bool benchBatch(CM256& cm256, int originalCount, int recoveryCount, int blockBytes, int frameCount)
+{
+    CM256::cm256_encoder_params params = {};
+    params.OriginalCount = originalCount;
+    params.RecoveryCount = recoveryCount;
+    params.BlockBytes = blockBytes;
+
+    const int frameBytes = (originalCount + recoveryCount) * blockBytes;
+    const int lost = recoveryCount < originalCount ? recoveryCount : originalCount;
+    uint8_t *data = new uint8_t[frameCount * frameBytes];
+    CM256::cm256_block *blocks = new CM256::cm256_block[frameCount * originalCount];
+    CM256::cm256_block *received = new CM256::cm256_block[frameCount * originalCount];
+    CM256::cm256_block **frames = new CM256::cm256_block*[frameCount];
+    CM256::cm256_encode_job *jobs = new CM256::cm256_encode_job[frameCount];
+    CM256::CM256EncoderPlan plan;
+
+    for (int i = 0; i < frameCount * frameBytes; i++) {
+        data[i] = rand();
+    }
+
+    // Four loss patterns taking turns
+    for (int f = 0; f < frameCount; f++)
+    {
+        uint8_t *frame = data + f * frameBytes;
+
+        for (int i = 0; i < originalCount; i++)
+        {
+            blocks[f * originalCount + i].Block = frame + i * blockBytes;
+            blocks[f * originalCount + i].Index = (unsigned char) i;
+        }
+
+        jobs[f].Originals = blocks + f * originalCount;
+        jobs[f].RecoveryBlocks = frame + originalCount * blockBytes;
+        frames[f] = received + f * originalCount;
+    }
+
+    memcpy(received, blocks, frameCount * originalCount * sizeof(CM256::cm256_block));
+
+    for (int f = 0; f < frameCount; f++)
+    {
+        for (int k = 0; k < lost; k++)
+        {
+            const int i = (k * 5 + f % 4) % originalCount;
+            received[f * originalCount + i].Block = data + f * frameBytes + (originalCount + k) * blockBytes;
+            received[f * originalCount + i].Index = CM256::cm256_get_recovery_block_index(params, k);
+        }
+    }
+
+    bool ok = cm256.cm256_init_encoder_plan(params, plan) == 0;
+    const long long iterations = 1 + (256LL * 1024 * 1024) / ((long long) frameCount * originalCount * blockBytes * recoveryCount);
+    const long long frameIterations = iterations * frameCount;
+
+    long long ts = getUSecs();
+    for (long long i = 0; i < iterations && ok; i++)
+    {
+        for (int f = 0; f < frameCount && ok; f++) {
+            ok = cm256.cm256_encode(params, jobs[f].Originals, jobs[f].RecoveryBlocks) == 0;
+        }
+    }
+    const long long paramsUsecs = getUSecs() - ts;
+
+    ts = getUSecs();
+    for (long long i = 0; i < iterations && ok; i++)
+    {
+        for (int f = 0; f < frameCount && ok; f++) {
+            ok = cm256.cm256_encode(plan, jobs[f].Originals, jobs[f].RecoveryBlocks) == 0;
+        }
+    }
+    const long long planUsecs = getUSecs() - ts;
+
+    ts = getUSecs();
+    for (long long i = 0; i < iterations && ok; i++) {
+        ok = cm256.cm256_encode_batch(plan, jobs, frameCount) == 0;
+    }
+    const long long batchUsecs = getUSecs() - ts;
+
+    // The decoder overwrites the descriptors, each pass starts from a copy
+    CM256::cm256_block *descriptors = new CM256::cm256_block[frameCount * originalCount];
+    const int descriptorBytes = frameCount * originalCount * sizeof(CM256::cm256_block);
+
+    ts = getUSecs();
+    for (long long i = 0; i < iterations && ok; i++)
+    {
+        memcpy(descriptors, received, descriptorBytes);
+
+        for (int f = 0; f < frameCount && ok; f++) {
+            ok = cm256.cm256_decode(params, descriptors + f * originalCount) == 0;
+        }
+    }
+    const long long decodeUsecs = getUSecs() - ts;
+
+    for (int f = 0; f < frameCount; f++) {
+        frames[f] = descriptors + f * originalCount;
+    }
+
+    ts = getUSecs();
+    for (long long i = 0; i < iterations && ok; i++)
+    {
+        memcpy(descriptors, received, descriptorBytes);
+        ok = cm256.cm256_decode_batch(params, frames, frameCount) == 0;
+    }
+    const long long decodeBatchUsecs = getUSecs() - ts;
+
+    std::cerr << "  " << frameCount << " frames of " << originalCount << "+" << recoveryCount << " x " << blockBytes << " bytes:"
+            << std::fixed << std::setprecision(2)
+            << " encode(params): " << (double) paramsUsecs / frameIterations << " us/frame"
+            << " encode(plan): " << (double) planUsecs / frameIterations << " us/frame"
+            << " batch: " << (double) batchUsecs / frameIterations << " us/frame"
+            << " (" << (double) (paramsUsecs - batchUsecs) / frameIterations << " saved)"
+            << " decode: " << (double) decodeUsecs / frameIterations << " us/frame"
+            << " batch: " << (double) decodeBatchUsecs / frameIterations << " us/frame"
+            << " (" << (double) (decodeUsecs - decodeBatchUsecs) / frameIterations << " saved)"
+            << (ok ? "" : " FAILED") << std::endl;
+
+    delete[] data;
+    delete[] blocks;
+    delete[] received;
+    delete[] descriptors;
+    delete[] frames;
+    delete[] jobs;
+
+    return ok;
+}
+
+// Streaming encoder: time spent in add_original() over the frame and in the
+// last add_original() call, after which the recovery blocks are ready,
+// against cm256_encode() once the frame is complete.
+static bool benchStreamEncoder(CM256& cm256, int originalCount, int recoveryCount, int blockBytes)
+{
+    CM256::cm256_encoder_params params = {};
+    params.OriginalCount = originalCount;
+    params.RecoveryCount = recoveryCount;
+    params.BlockBytes = blockBytes;
+
+    const int frameBytes = originalCount * blockBytes;
+    uint8_t *originalData = new uint8_t[frameBytes];
+    uint8_t *recoveryData = new uint8_t[recoveryCount * blockBytes];
+    CM256::cm256_block blocks[256];
+    CM256::CM256EncoderPlan plan;
+    CM256::CM256StreamEncoder encoder(cm256);
+
+    for (int i = 0; i < frameBytes; i++) {
+        originalData[i] = rand();
+    }
+
+    for (int i = 0; i < originalCount; i++) {
+        blocks[i].Block = originalData + i * blockBytes;
+    }
+
+    bool ok = cm256.cm256_init_encoder_plan(params, plan) == 0;
+    const long long iterations = 1 + (64LL * 1024 * 1024) / ((long long) frameBytes * recoveryCount);
+    long long encodeUsecs = 0, addUsecs = 0, lastUsecs = 0;
+
+    for (long long i = 0; i < iterations && ok; i++)
+    {
+        long long ts = getUSecs();
+        ok = cm256.cm256_encode(plan, blocks, recoveryData) == 0;
+        encodeUsecs += getUSecs() - ts;
+
+        ok = ok && encoder.begin_frame(plan, recoveryData) == 0;
+
+        for (int j = 0; j < originalCount && ok; j++)
+        {
+            ts = getUSecs();
+            ok = encoder.add_original(j, blocks[j].Block) >= 0;
+            long long usecs = getUSecs() - ts;
+            addUsecs += usecs;
+
+            if (j == originalCount - 1) {
+                lastUsecs += usecs;
+            }
+        }
+    }
+
+    std::cerr << "  " << originalCount << "+" << recoveryCount << " x " << blockBytes << " bytes:"
+            << std::fixed << std::setprecision(1)
+            << " cm256_encode: " << (double) encodeUsecs / iterations << " us/frame"
+            << " add_original: " << (double) addUsecs / iterations << " us/frame"
+            << " last add_original: " << (double) lastUsecs / iterations << " us"
+            << (ok ? "" : " FAILED") << std::endl;
+
+    delete[] originalData;
+    delete[] recoveryData;
+
+    return ok;
+}
+
+// Streaming decoder: time spent in add_block() as the blocks arrive and in
+// finish() at the end of the frame, against cm256_decode() at the end of the
+// frame. The first 'lost' originals are replaced by recovery blocks which
+// arrive first.
+static bool benchStreamDecoder(CM256& cm256, int originalCount, int recoveryCount, int blockBytes, int lost)
+{
+    CM256::cm256_encoder_params params = {};
+    params.OriginalCount = originalCount;
+    params.RecoveryCount = recoveryCount;
+    params.BlockBytes = blockBytes;
+
+    const int frameBytes = originalCount * blockBytes;
+    uint8_t *originalData = new uint8_t[frameBytes];
+    uint8_t *recoveryData = new uint8_t[recoveryCount * blockBytes];
+    uint8_t *decodeData = new uint8_t[frameBytes];
+    CM256::cm256_block blocks[256];
+    CM256::CM256StreamDecoder decoder(cm256);
+
+    for (int i = 0; i < frameBytes; i++) {
+        originalData[i] = rand();
+    }
+
+    for (int i = 0; i < originalCount; i++) {
+        blocks[i].Block = originalData + i * blockBytes;
+    }
+
+    bool ok = cm256.cm256_encode(params, blocks, recoveryData) == 0;
+    const long long iterations = 1 + (64LL * 1024 * 1024) / ((long long) frameBytes * recoveryCount);
+    long long addUsecs = 0, finishUsecs = 0, decodeUsecs = 0;
+
+    for (long long i = 0; i < iterations && ok; i++)
+    {
+        for (int pass = 0; pass < 2 && ok; pass++)
+        {
+            memcpy(decodeData, originalData, frameBytes);
+
+            for (int j = 0; j < originalCount; j++)
+            {
+                blocks[j].Block = decodeData + j * blockBytes;
+                blocks[j].Index = CM256::cm256_get_original_block_index(params, j);
+            }
+
+            for (int j = 0; j < lost; j++)
+            {
+                memcpy(blocks[j].Block, recoveryData + j * blockBytes, blockBytes);
+                blocks[j].Index = CM256::cm256_get_recovery_block_index(params, j);
+            }
+
+            long long ts = getUSecs();
+
+            if (pass == 0)
+            {
+                ok = cm256.cm256_decode(params, blocks) == 0;
+                decodeUsecs += getUSecs() - ts;
+            }
+            else
+            {
+                ok = decoder.begin_frame(params) == 0;
+
+                for (int j = 0; j < originalCount && ok; j++) {
+                    ok = decoder.add_block(&blocks[j]) >= 0;
+                }
+
+                long long tf = getUSecs();
+                addUsecs += tf - ts;
+                ok = ok && decoder.finish() == 0;
+                finishUsecs += getUSecs() - tf;
+            }
+        }
+    }
+
+    std::cerr << "  " << originalCount << "+" << recoveryCount << " x " << blockBytes << " bytes, " << lost << " lost:"
+            << std::fixed << std::setprecision(1)
+            << " cm256_decode: " << (double) decodeUsecs / iterations << " us/frame"
+            << " add_block: " << (double) addUsecs / iterations << " us/frame"
+            << " finish: " << (double) finishUsecs / iterations << " us/frame"
+            << (ok ? "" : " FAILED") << std::endl;
+
+    delete[] originalData;
+    delete[] recoveryData;
+    delete[] decodeData;
+
+    return ok;
+}
+
+// Encode and decode throughput with 1 to 8 threads in total, including the
+// calling one. Decoding replaces 'recoveryCount' originals with recovery blocks.
+static bool benchThreads(CM256& cm256, int originalCount, int recoveryCount, int blockBytes)
+{
+    CM256::cm256_encoder_params params = {};
+    params.OriginalCount = originalCount;
+    params.RecoveryCount = recoveryCount;
+    params.BlockBytes = blockBytes;
+
+    const long long frameBytes = (long long) originalCount * blockBytes;
+    uint8_t *originalData = new uint8_t[frameBytes];
+    uint8_t *recoveryData = new uint8_t[(long long) recoveryCount * blockBytes];
+    uint8_t *decodeData = new uint8_t[frameBytes];
+    CM256::cm256_block blocks[256];
+    CM256::CM256EncoderPlan plan;
+    bool ok = cm256.cm256_init_encoder_plan(params, plan) == 0;
+    const long long iterations = 1 + (256LL * 1024 * 1024) / (frameBytes * recoveryCount);
+
+    for (long long i = 0; i < frameBytes; i++) {
+        originalData[i] = rand();
+    }
+
+    for (int pass = 0; pass < 2 && ok; pass++)
+    {
+        std::cerr << "  " << originalCount << "+" << recoveryCount << " x " << blockBytes << " bytes "
+                << (pass ? "decode:" : "encode:");
+
+        for (int threads = 1; threads <= 8 && ok; threads *= 2)
+        {
+            cm256.setThreadCount(threads - 1);
+            long long usecs = 0;
+
+            for (long long i = 0; i < iterations && ok; i++)
+            {
+                if (pass == 0)
+                {
+                    for (int j = 0; j < originalCount; j++) {
+                        blocks[j].Block = originalData + (long long) j * blockBytes;
+                    }
+
+                    long long ts = getUSecs();
+                    ok = cm256.cm256_encode(plan, blocks, recoveryData) == 0;
+                    usecs += getUSecs() - ts;
+                }
+                else
+                {
+                    memcpy(decodeData, originalData, frameBytes);
+
+                    for (int j = 0; j < originalCount; j++)
+                    {
+                        blocks[j].Block = decodeData + (long long) j * blockBytes;
+                        blocks[j].Index = CM256::cm256_get_original_block_index(params, j);
+                    }
+
+                    for (int j = 0; j < recoveryCount; j++)
+                    {
+                        memcpy(blocks[j].Block, recoveryData + (long long) j * blockBytes, blockBytes);
+                        blocks[j].Index = CM256::cm256_get_recovery_block_index(params, j);
+                    }
+
+                    long long ts = getUSecs();
+                    ok = cm256.cm256_decode(params, blocks) == 0;
+                    usecs += getUSecs() - ts;
+                }
+            }
+
+            std::cerr << " " << threads << "T: " << std::fixed << std::setprecision(1)
+                    << (usecs > 0 ? (double) frameBytes * iterations / usecs : 0.0) << " MB/s";
+        }
+
+        std::cerr << std::endl;
+    }
+
+    cm256.setThreadCount(0);
+
+    delete[] originalData;
+    delete[] recoveryData;
+    delete[] decodeData;
+
+    return ok;
+}
+
+int main()
+{
+    CM256 cm256;
+
+    if (!cm256.isInitialized())
+    {
+        std::cerr << "cm256 not initialized" << std::endl;
+        return 1;
+    }
+
+    gf256_ctx gf256Ctx;
+    const gf256_ctx::SimdLevel initialLevel = gf256_ctx::gf256_simd_level();
+    bool ok = true;
+
+    // Compare the SIMD tiers available on this CPU, up to the one in use
+    for (int level = gf256_ctx::SimdBaseline; level <= initialLevel; level++)
+    {
+        if (gf256_ctx::gf256_set_simd_level((gf256_ctx::SimdLevel) level) != level) {
+            continue;
+        }
+
+        std::cerr << "[" << gf256_ctx::gf256_simd_name((gf256_ctx::SimdLevel) level) << "] ";
+        benchKernels(gf256Ctx);
+
+        std::cerr << "[" << gf256_ctx::gf256_simd_name((gf256_ctx::SimdLevel) level) << "] cm256 codec:" << std::endl;
+        ok = benchCodec(cm256, 128, 26, 508, 26) && ok;
+        ok = benchCodec(cm256, 128, 26, 508, 1) && ok;
+        ok = benchCodec(cm256, 100, 30, 1296, 30) && ok;
+        ok = benchCodec(cm256, 32, 8, 65536, 8) && ok;
+
+        std::cerr << "[" << gf256_ctx::gf256_simd_name((gf256_ctx::SimdLevel) level) << "] cm256 tiling:" << std::endl;
+        ok = benchTiling(cm256, 128, 26) && ok;
+        ok = benchTiling(cm256, 32, 8) && ok;
+
+        std::cerr << "[" << gf256_ctx::gf256_simd_name((gf256_ctx::SimdLevel) level) << "] cm256 bit-matrix mode:" << std::endl;
+        ok = benchBitMatrix(cm256, 128, 26, 512, 26) && ok;
+        ok = benchBitMatrix(cm256, 100, 30, 1296, 30) && ok;
+        ok = benchBitMatrix(cm256, 32, 8, 65536, 8) && ok;
+    }
+
+    gf256_ctx::gf256_set_simd_level(initialLevel);
+
+    std::cerr << "[" << gf256_ctx::gf256_simd_name(initialLevel) << "] cm256 matrices:" << std::endl;
+    ok = benchMatrices(cm256, 10, 4, 4096) && ok;
+    ok = benchMatrices(cm256, 32, 8, 65536) && ok;
+    ok = benchMatrices(cm256, 100, 30, 1296) && ok;
+    ok = benchMatrices(cm256, 128, 26, 512) && ok;
+
+    std::cerr << "[" << gf256_ctx::gf256_simd_name(initialLevel) << "] cm256 small erasure counts:" << std::endl;
+    ok = benchSmallErasures(cm256, 128, 26, 508) && ok;
+    ok = benchSmallErasures(cm256, 128, 26, 8192) && ok;
+    ok = benchSmallErasures(cm256, 32, 8, 65536) && ok;
+
+    std::cerr << "[" << gf256_ctx::gf256_simd_name(initialLevel) << "] cm256 segmented originals:" << std::endl;
+    ok = benchSegments(cm256, 128, 26, 508, 24) && ok;
+    ok = benchSegments(cm256, 32, 8, 65536, 64) && ok;
+
+    std::cerr << "[" << gf256_ctx::gf256_simd_name(initialLevel) << "] cm256 variable-length originals:" << std::endl;
+    ok = benchVariable(cm256, 128, 26, 1400, 60) && ok;
+    ok = benchVariable(cm256, 32, 8, 65535, 1024) && ok;
+
+    std::cerr << "[" << gf256_ctx::gf256_simd_name(initialLevel) << "] cm256 batches:" << std::endl;
+    ok = benchBatch(cm256, 8, 2, 64, 256) && ok;
+    ok = benchBatch(cm256, 16, 4, 256, 64) && ok;
+    ok = benchBatch(cm256, 128, 26, 508, 16) && ok;
+
+    std::cerr << "[" << gf256_ctx::gf256_simd_name(initialLevel) << "] cm256 streaming encoder:" << std::endl;
+    ok = benchStreamEncoder(cm256, 128, 26, 508) && ok;
+    ok = benchStreamEncoder(cm256, 32, 8, 65536) && ok;
+
+    std::cerr << "[" << gf256_ctx::gf256_simd_name(initialLevel) << "] cm256 streaming decoder:" << std::endl;
+    ok = benchStreamDecoder(cm256, 128, 26, 508, 26) && ok;
+    ok = benchStreamDecoder(cm256, 128, 26, 508, 4) && ok;
+    ok = benchStreamDecoder(cm256, 32, 8, 65536, 8) && ok;
+
+    std::cerr << "[" << gf256_ctx::gf256_simd_name(initialLevel) << "] cm256 threads:" << std::endl;
+    ok = benchThreads(cm256, 128, 26, 508) && ok;
+    ok = benchThreads(cm256, 128, 26, 8192) && ok;
+    ok = benchThreads(cm256, 32, 8, 1024 * 1024) && ok;
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,412 @@
+/*
+    Copyright (c) 2016 Edouard M. Griffiths.  All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+    * Neither the name of CM256 nor the names of its contributors may be
+      used to endorse or promote products derived from this software without
+      specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * Offline search for the Cauchy parameters of CM256::MatrixOptimized
+ *
+ * The recovery matrix element of row i and column j is
+ *
+ *     a_ij = s_i * (x_0 + y_j) / (x_i + y_j)
+ *
+ * with x_i and y_j distinct values of GF(256) and s_0 = 1 so that the first
+ * row stays all ones.  Any such matrix is MDS, so a row other than the first
+ * can hold a single 1 element at most (two would make a singular 2x2 minor
+ * with the first row).  What the parameters do change is the cost of the
+ * other elements in the bit-matrix mode, where an element c is an 8x8 bit
+ * matrix whose ones are XORs of packets.  The search minimizes the total
+ * number of ones by hill climbing over the x_i and y_j, each row taking its
+ * best s_i, and writes the table compiled into the library.
+ *
+ * Usage: cm256_matrix_search [output file, cm256matrices.h by default]
+ *
+ * The search is seeded so the output only changes with this file.
+ */
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "../gf256.h"
+
+// (original count, recovery count) pairs of the table
+static void tableSizes(std::vector<int>& originalCounts, std::vector<int>& recoveryCounts)
+{
+    for (int k = 2; k <= 32; k++)
+    {
+        for (int m = 2; m <= 8; m++)
+        {
+            originalCounts.push_back(k);
+            recoveryCounts.push_back(m);
+        }
+    }
+
+    static const int largeOriginalCounts[] = { 48, 64, 96, 128 };
+    static const int largeRecoveryCounts[] = { 2, 4, 8, 16, 26, 32 };
+
+    for (int a = 0; a < 4; a++)
+    {
+        for (int b = 0; b < 6; b++)
+        {
+            originalCounts.push_back(largeOriginalCounts[a]);
+            recoveryCounts.push_back(largeRecoveryCounts[b]);
+        }
+    }
+}
+
+// Small deterministic generator so that the table is reproducible
+static unsigned int searchRandom(unsigned int& state)
+{
+    state = state * 1103515245u + 12345u;
+    return state >> 8;
+}
+
+class MatrixSearch
+{
+public:
+    MatrixSearch(gf256_ctx& gf256Ctx, int originalCount, int recoveryCount) :
+        m_gf256Ctx(gf256Ctx),
+        m_k(originalCount),
+        m_m(recoveryCount),
+        m_rowCosts(recoveryCount * 256),
+        m_total(0)
+    {
+        // Ones of the bit matrix of each element
+        for (int c = 0; c < 256; c++)
+        {
+            m_ones[c] = 0;
+
+            for (int j = 0; j < 8; j++)
+            {
+                for (uint8_t product = m_gf256Ctx.gf256_mul((uint8_t) c, (uint8_t) (1 << j)); product; product &= product - 1) {
+                    m_ones[c]++;
+                }
+            }
+        }
+
+        // Start from the parameters of MatrixDefault
+        for (int i = 0; i < m_m; i++) {
+            m_x[i] = (uint8_t) (m_k + i);
+        }
+        for (int j = 0; j < m_k; j++) {
+            m_y[j] = (uint8_t) j;
+        }
+
+        m_defaultOnes = 8 * m_k;
+
+        for (int i = 1; i < m_m; i++) {
+            for (int j = 0; j < m_k; j++) {
+                m_defaultOnes += m_ones[element(i, m_y[j])];
+            }
+        }
+
+        updateAll();
+    }
+
+    // Ones of the default matrix, which has all its s_i at 1
+    int defaultOnes() const { return m_defaultOnes; }
+
+    // Ones of the best matrix found so far
+    int ones() const { return m_total; }
+
+    void run(int iterations, unsigned int seed)
+    {
+        bool used[256];
+        memset(used, 0, sizeof(used));
+
+        for (int i = 0; i < m_m; i++) {
+            used[m_x[i]] = true;
+        }
+        for (int j = 0; j < m_k; j++) {
+            used[m_y[j]] = true;
+        }
+
+        std::vector<int> costs(m_rowCosts.size());
+
+        for (int n = 0; n < iterations; n++)
+        {
+            uint8_t value;
+
+            do {
+                value = (uint8_t) searchRandom(seed);
+            } while (used[value]);
+
+            // Replace one parameter by an unused value, x_0 less often as it
+            // changes every element.  Moves that do not make the matrix worse
+            // are kept so that the search crosses plateaus.
+            const int position = searchRandom(seed) % (m_k + m_m);
+            uint8_t* parameter;
+
+            if (position < m_k)
+            {
+                // y_j changes column j of every row
+                const uint8_t old = m_y[position];
+                int total = 8 * m_k;
+
+                costs = m_rowCosts;
+                m_y[position] = value;
+
+                for (int i = 1; i < m_m; i++)
+                {
+                    int* rowCosts = &costs[i * 256];
+                    const uint8_t before = element(i, old);
+                    const uint8_t after = element(i, value);
+
+                    for (int s = 1; s < 256; s++) {
+                        rowCosts[s] += m_ones[m_gf256Ctx.gf256_mul(after, (uint8_t) s)] - m_ones[m_gf256Ctx.gf256_mul(before, (uint8_t) s)];
+                    }
+
+                    total += best(rowCosts);
+                }
+
+                if (total > m_total)
+                {
+                    m_y[position] = old;
+                    continue;
+                }
+
+                m_rowCosts.swap(costs);
+                m_total = total;
+                parameter = &m_y[position];
+                used[old] = false;
+            }
+            else
+            {
+                const int i = position - m_k;
+
+                if (i == 0 && searchRandom(seed) % 8 != 0) {
+                    continue;
+                }
+
+                const uint8_t old = m_x[i];
+                const int total = m_total;
+
+                costs = m_rowCosts;
+                m_x[i] = value;
+
+                if (i == 0) {
+                    updateAll();
+                } else {
+                    m_total += updateRow(i) - best(&costs[i * 256]);
+                }
+
+                if (m_total > total)
+                {
+                    m_x[i] = old;
+                    m_total = total;
+                    m_rowCosts.swap(costs);
+                    continue;
+                }
+
+                parameter = &m_x[i];
+                used[old] = false;
+            }
+
+            used[*parameter] = true;
+        }
+    }
+
+    // Parameters as stored in the table: x_i, y_j then s_i
+    void write(FILE* file) const
+    {
+        for (int i = 0; i < m_m; i++) {
+            fprintf(file, "%d,", m_x[i]);
+        }
+        for (int j = 0; j < m_k; j++) {
+            fprintf(file, "%d,", m_y[j]);
+        }
+
+        fprintf(file, "1,");
+
+        for (int i = 1; i < m_m; i++)
+        {
+            const int* rowCosts = &m_rowCosts[i * 256];
+            const int cost = best(rowCosts);
+            int s = 1;
+
+            // Among the cheapest scales prefer one giving the row a 1 element
+            for (int candidate = 1; candidate < 256; candidate++)
+            {
+                if (rowCosts[candidate] != cost) {
+                    continue;
+                }
+
+                if (s == 1 && rowCosts[1] != cost) {
+                    s = candidate;
+                }
+
+                for (int j = 0; j < m_k; j++)
+                {
+                    if (m_gf256Ctx.gf256_mul(element(i, m_y[j]), (uint8_t) candidate) == 1)
+                    {
+                        s = candidate;
+                        candidate = 256;
+                        break;
+                    }
+                }
+            }
+
+            fprintf(file, "%d,", s);
+        }
+    }
+
+private:
+    // Element of row i and column y before scaling the row
+    uint8_t element(int i, uint8_t y) const
+    {
+        return m_gf256Ctx.getMatrixElement(m_x[i], m_x[0], y);
+    }
+
+    // Cost of a row with its cheapest scale
+    static int best(const int* rowCosts)
+    {
+        int cost = rowCosts[1];
+
+        for (int s = 2; s < 256; s++)
+        {
+            if (rowCosts[s] < cost) {
+                cost = rowCosts[s];
+            }
+        }
+
+        return cost;
+    }
+
+    // Cost of every scale of row i, returns the cost of the row
+    int updateRow(int i)
+    {
+        int* rowCosts = &m_rowCosts[i * 256];
+        uint8_t elements[256];
+
+        for (int j = 0; j < m_k; j++) {
+            elements[j] = element(i, m_y[j]);
+        }
+
+        for (int s = 1; s < 256; s++)
+        {
+            rowCosts[s] = 0;
+
+            for (int j = 0; j < m_k; j++) {
+                rowCosts[s] += m_ones[m_gf256Ctx.gf256_mul(elements[j], (uint8_t) s)];
+            }
+        }
+
+        return best(rowCosts);
+    }
+
+    void updateAll()
+    {
+        m_total = 8 * m_k;
+
+        for (int i = 1; i < m_m; i++) {
+            m_total += updateRow(i);
+        }
+    }
+
+    gf256_ctx& m_gf256Ctx;
+    int m_k;
+    int m_m;
+    int m_ones[256];
+    uint8_t m_x[256];
+    uint8_t m_y[256];
+    std::vector<int> m_rowCosts;
+    int m_total;
+    int m_defaultOnes;
+};
+
+int main(int argc, char *argv[])
+{
+    gf256_ctx gf256Ctx;
+
+    if (!gf256Ctx.isInitialized())
+    {
+        std::cerr << "gf256 not initialized" << std::endl;
+        return 1;
+    }
+
+    const char *path = argc > 1 ? argv[1] : "cm256matrices.h";
+    FILE *file = fopen(path, "w");
+
+    if (!file)
+    {
+        std::cerr << "cannot open " << path << std::endl;
+        return 1;
+    }
+
+    std::vector<int> originalCounts, recoveryCounts;
+    tableSizes(originalCounts, recoveryCounts);
+
+    fprintf(file, "// Generated by cm256_matrix_search, do not edit.\n");
+    fprintf(file, "//\n");
+    fprintf(file, "// Cauchy parameters of CM256::MatrixOptimized by original and recovery\n");
+    fprintf(file, "// count: x_i of each recovery row, y_j of each original, then the scale\n");
+    fprintf(file, "// s_i of each recovery row.  The comments give the ones of the bit matrices\n");
+    fprintf(file, "// of the default and of the optimized matrix.\n\n");
+    fprintf(file, "#ifndef CM256MATRICES_H\n#define CM256MATRICES_H\n\n");
+    fprintf(file, "static const uint8_t CM256MatrixParameters[] = {\n");
+
+    std::vector<int> offsets;
+    int offset = 0;
+    long long defaultTotal = 0, optimizedTotal = 0;
+
+    for (size_t n = 0; n < originalCounts.size(); n++)
+    {
+        const int k = originalCounts[n];
+        const int m = recoveryCounts[n];
+        MatrixSearch search(gf256Ctx, k, m);
+
+        search.run(20000, 1 + k * 256 + m);
+
+        fprintf(file, "    ");
+        search.write(file);
+        fprintf(file, " // %d+%d: %d -> %d\n", k, m, search.defaultOnes(), search.ones());
+
+        std::cerr << k << "+" << m << ": " << search.defaultOnes() << " -> " << search.ones()
+            << " (" << (100.0 * (search.defaultOnes() - search.ones()) / search.defaultOnes()) << "% fewer ones)" << std::endl;
+
+        defaultTotal += search.defaultOnes();
+        optimizedTotal += search.ones();
+        offsets.push_back(offset);
+        offset += k + 2 * m;
+    }
+
+    fprintf(file, "};\n\n");
+    fprintf(file, "// Original count, recovery count and offset of the parameters, sorted\n");
+    fprintf(file, "static const struct CM256MatrixEntry\n{\n    uint8_t OriginalCount;\n    uint8_t RecoveryCount;\n    uint16_t Offset;\n} CM256MatrixEntries[] = {\n");
+
+    for (size_t n = 0; n < originalCounts.size(); n++) {
+        fprintf(file, "    { %d, %d, %d },\n", originalCounts[n], recoveryCounts[n], offsets[n]);
+    }
+
+    fprintf(file, "};\n\n#endif // CM256MATRICES_H\n");
+    fclose(file);
+
+    std::cerr << "total: " << defaultTotal << " -> " << optimizedTotal << " ones" << std::endl;
+    return 0;
+}
@@ -30,6 +30,7 @@
 #include <sys/time.h>
 
 #include "../cm256.h"
+#include "../cm65536.h"
 
 long long getUSecs()
 {
@@ -87,6 +88,2666 @@ bool validateSolution(CM256::cm256_block_t* blocks, int blockCount, int blockByt
 
 
 
+/**
+ * Checks the bulk gf256 kernels against byte-wise table lookups for every
+ * length up to 300 bytes, including the unaligned SIMD tails.
+ */
+bool testKernelsLevel(gf256_ctx& gf256Ctx)
+{
+    static const int maxBytes = 300;
+    uint8_t x[maxBytes + 1], y[maxBytes + 1], z[maxBytes + 1], expected[maxBytes + 1];
+
+    for (int bytes = 0; bytes <= maxBytes; ++bytes)
+    {
+        for (int k = 0; k < 4; ++k)
+        {
+            const uint8_t c = (uint8_t)(k == 0 ? 0 : k == 1 ? 1 : rand());
+
+            for (int i = 0; i <= maxBytes; ++i)
+            {
+                x[i] = rand();
+                y[i] = rand();
+                z[i] = rand();
+            }
+
+            // z[] = x[] * c, one byte past the end must be left untouched
+            for (int i = 0; i <= maxBytes; ++i) {
+                expected[i] = i < bytes ? gf256Ctx.gf256_mul(x[i], c) : z[i];
+            }
+
+            gf256Ctx.gf256_mul_mem(z, x, c, bytes);
+
+            if (memcmp(z, expected, maxBytes + 1) != 0)
+            {
+                std::cerr << "testKernelsLevel: gf256_mul_mem failed for " << bytes << " bytes, c = " << (int) c << std::endl;
+                return false;
+            }
+
+            // z[] += x[] * c
+            for (int i = 0; i <= maxBytes; ++i) {
+                expected[i] = i < bytes ? z[i] ^ gf256Ctx.gf256_mul(x[i], c) : z[i];
+            }
+
+            gf256Ctx.gf256_muladd_mem(z, c, x, bytes);
+
+            if (memcmp(z, expected, maxBytes + 1) != 0)
+            {
+                std::cerr << "testKernelsLevel: gf256_muladd_mem failed for " << bytes << " bytes, c = " << (int) c << std::endl;
+                return false;
+            }
+        }
+
+        // z[] += x[] + y[]
+        for (int i = 0; i <= maxBytes; ++i) {
+            expected[i] = i < bytes ? z[i] ^ x[i] ^ y[i] : z[i];
+        }
+
+        gf256_ctx::gf256_add2_mem(z, x, y, bytes);
+
+        if (memcmp(z, expected, maxBytes + 1) != 0)
+        {
+            std::cerr << "testKernelsLevel: gf256_add2_mem failed for " << bytes << " bytes" << std::endl;
+            return false;
+        }
+
+        // z[] = x[] + y[]
+        for (int i = 0; i <= maxBytes; ++i) {
+            expected[i] = i < bytes ? x[i] ^ y[i] : z[i];
+        }
+
+        gf256_ctx::gf256_addset_mem(z, x, y, bytes);
+
+        if (memcmp(z, expected, maxBytes + 1) != 0)
+        {
+            std::cerr << "testKernelsLevel: gf256_addset_mem failed for " << bytes << " bytes" << std::endl;
+            return false;
+        }
+
+        // z[] += x[]
+        for (int i = 0; i <= maxBytes; ++i) {
+            expected[i] = i < bytes ? z[i] ^ x[i] : z[i];
+        }
+
+        gf256_ctx::gf256_add_mem(z, x, bytes);
+
+        if (memcmp(z, expected, maxBytes + 1) != 0)
+        {
+            std::cerr << "testKernelsLevel: gf256_add_mem failed for " << bytes << " bytes" << std::endl;
+            return false;
+        }
+
+        // swap x[] and z[]
+        memcpy(expected, x, maxBytes + 1);
+        memcpy(expected, z, bytes);
+        memcpy(y, z, maxBytes + 1);
+        memcpy(y, x, bytes);
+
+        gf256_ctx::gf256_memswap(x, z, bytes);
+
+        if (memcmp(x, expected, maxBytes + 1) != 0 || memcmp(z, y, maxBytes + 1) != 0)
+        {
+            std::cerr << "testKernelsLevel: gf256_memswap failed for " << bytes << " bytes" << std::endl;
+            return false;
+        }
+    }
+
+    // Multi-source operations, with source counts across several groups
+    static const int maxSources = 20;
+    uint8_t sources[maxSources][maxBytes + 1];
+    const void *sourcePtrs[maxSources];
+    uint8_t coefs[maxSources];
+
+    for (int k = 0; k < maxSources; ++k) {
+        sourcePtrs[k] = sources[k];
+    }
+
+    for (int bytes = 0; bytes <= maxBytes; ++bytes)
+    {
+        const int count = bytes % (maxSources + 1);
+
+        for (int k = 0; k < count; ++k)
+        {
+            coefs[k] = (uint8_t)(k % 5 == 0 ? 0 : k % 5 == 1 ? 1 : rand());
+
+            for (int i = 0; i <= maxBytes; ++i) {
+                sources[k][i] = rand();
+            }
+        }
+
+        for (int i = 0; i <= maxBytes; ++i) {
+            z[i] = rand();
+        }
+
+        for (int set = 0; set < 2; ++set)
+        {
+            // z[] (+)= sum x_k[] * c_k
+            for (int i = 0; i <= maxBytes; ++i)
+            {
+                expected[i] = set ? 0 : z[i];
+
+                for (int k = 0; k < count; ++k) {
+                    expected[i] ^= gf256Ctx.gf256_mul(sources[k][i], coefs[k]);
+                }
+
+                if (i >= bytes) {
+                    expected[i] = z[i];
+                }
+            }
+
+            if (set) {
+                gf256Ctx.gf256_mul_multi_mem(z, coefs, sourcePtrs, count, bytes);
+            } else {
+                gf256Ctx.gf256_muladd_multi_mem(z, coefs, sourcePtrs, count, bytes);
+            }
+
+            if (memcmp(z, expected, maxBytes + 1) != 0)
+            {
+                std::cerr << "testKernelsLevel: gf256_mul" << (set ? "" : "add") << "_multi_mem failed for "
+                        << bytes << " bytes, " << count << " sources" << std::endl;
+                return false;
+            }
+
+            // z[] (+)= sum x_k[]
+            for (int i = 0; i <= maxBytes; ++i)
+            {
+                expected[i] = set ? 0 : z[i];
+
+                for (int k = 0; k < count; ++k) {
+                    expected[i] ^= sources[k][i];
+                }
+
+                if (i >= bytes) {
+                    expected[i] = z[i];
+                }
+            }
+
+            if (set) {
+                gf256_ctx::gf256_addset_multi_mem(z, sourcePtrs, count, bytes);
+            } else {
+                gf256_ctx::gf256_add_multi_mem(z, sourcePtrs, count, bytes);
+            }
+
+            if (memcmp(z, expected, maxBytes + 1) != 0)
+            {
+                std::cerr << "testKernelsLevel: gf256_add" << (set ? "set" : "") << "_multi_mem failed for "
+                        << bytes << " bytes, " << count << " sources" << std::endl;
+                return false;
+            }
+        }
+
+        // sources[k][] += x[] * c_k, the sources being used as destinations
+        uint8_t expectedDests[maxSources][maxBytes + 1];
+
+        for (int k = 0; k < count; ++k)
+        {
+            for (int i = 0; i <= maxBytes; ++i) {
+                expectedDests[k][i] = i < bytes ? sources[k][i] ^ gf256Ctx.gf256_mul(x[i], coefs[k]) : sources[k][i];
+            }
+        }
+
+        gf256Ctx.gf256_muladd_multi_dest_mem((void * const *) sourcePtrs, coefs, x, count, bytes);
+
+        for (int k = 0; k < count; ++k)
+        {
+            if (memcmp(sources[k], expectedDests[k], maxBytes + 1) != 0)
+            {
+                std::cerr << "testKernelsLevel: gf256_muladd_multi_dest_mem failed for "
+                        << bytes << " bytes, " << count << " destinations" << std::endl;
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// Checks the kernels of each SIMD tier the CPU supports
+bool testKernels()
+{
+    gf256_ctx gf256Ctx;
+    const gf256_ctx::SimdLevel initialLevel = gf256_ctx::gf256_simd_level();
+    const gf256_ctx::SimdLevel supported = gf256_ctx::gf256_simd_supported();
+    bool ok = true;
+
+    for (int level = gf256_ctx::SimdBaseline; level <= supported && ok; ++level)
+    {
+        if (gf256_ctx::gf256_set_simd_level((gf256_ctx::SimdLevel) level) != level) {
+            continue; // tier not available on this CPU
+        }
+
+        std::cerr << "testKernels: " << gf256_ctx::gf256_simd_name((gf256_ctx::SimdLevel) level) << std::endl;
+        ok = testKernelsLevel(gf256Ctx);
+    }
+
+    gf256_ctx::gf256_set_simd_level(initialLevel);
+    return ok;
+}
+
+// Checks that the tiled encoder output does not depend on the tile size
+bool testTiledEncode()
+{
+    CM256 cm256;
+
+    if (!cm256.isInitialized())
+    {
+        std::cerr << "cm256 not initialized" << std::endl;
+        return false;
+    }
+
+    static const int configs[][3] = {
+        { 128, 26, 508 }, { 32, 8, 65536 + 13 }, { 2, 3, 5000 }, { 1, 2, 3000 }, { 100, 30, 9000 }
+    };
+    static const int tileSizes[] = { 0, 1, 64, 100, 1000, 4096, 0x7fffffff };
+
+    for (unsigned int c = 0; c < sizeof(configs) / sizeof(configs[0]); c++)
+    {
+        CM256::cm256_encoder_params params = {};
+        params.OriginalCount = configs[c][0];
+        params.RecoveryCount = configs[c][1];
+        params.BlockBytes = configs[c][2];
+
+        const int originalBytes = params.OriginalCount * params.BlockBytes;
+        const int recoveryBytes = params.RecoveryCount * params.BlockBytes;
+        uint8_t *originalData = new uint8_t[originalBytes];
+        uint8_t *expected = new uint8_t[recoveryBytes];
+        uint8_t *recoveryData = new uint8_t[recoveryBytes];
+        CM256::cm256_block blocks[256];
+        bool ok = true;
+
+        for (int i = 0; i < originalBytes; i++) {
+            originalData[i] = rand();
+        }
+
+        for (int i = 0; i < params.OriginalCount; i++) {
+            blocks[i].Block = originalData + i * params.BlockBytes;
+        }
+
+        // Reference: one full recovery block at a time
+        cm256.setTileBytes(params.BlockBytes);
+        ok = cm256.cm256_encode(params, blocks, expected) == 0;
+
+        for (unsigned int t = 0; t < sizeof(tileSizes) / sizeof(tileSizes[0]) && ok; t++)
+        {
+            cm256.setTileBytes(tileSizes[t]);
+            memset(recoveryData, 0xa5, recoveryBytes);
+            ok = cm256.cm256_encode(params, blocks, recoveryData) == 0
+                    && memcmp(recoveryData, expected, recoveryBytes) == 0;
+
+            if (!ok)
+            {
+                std::cerr << "testTiledEncode: " << params.OriginalCount << "+" << params.RecoveryCount
+                        << " x " << params.BlockBytes << " failed with " << tileSizes[t] << " bytes tiles"
+                        << " (" << cm256.cm256_get_tile_bytes(params) << " used)" << std::endl;
+            }
+        }
+
+        delete[] originalData;
+        delete[] expected;
+        delete[] recoveryData;
+
+        if (!ok) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Checks that encoding with a plan gives the same output as with the parameters
+bool testEncoderPlan()
+{
+    CM256 cm256;
+
+    if (!cm256.isInitialized())
+    {
+        std::cerr << "cm256 not initialized" << std::endl;
+        return false;
+    }
+
+    static const int configs[][3] = {
+        { 128, 26, 508 }, { 1, 2, 100 }, { 2, 1, 1000 }, { 100, 30, 1296 }, { 200, 56, 77 }
+    };
+
+    CM256::CM256EncoderPlan plan;
+    CM256::cm256_block blocks[256];
+    CM256::cm256_encoder_params params = {};
+
+    // Plan not initialized or invalid parameters
+    params.OriginalCount = 100;
+    params.RecoveryCount = 200;
+    params.BlockBytes = 10;
+
+    if (cm256.cm256_encode(plan, blocks, blocks) == 0
+            || cm256.cm256_init_encoder_plan(params, plan) != -2
+            || cm256.cm256_encode(plan, blocks, blocks) == 0)
+    {
+        std::cerr << "testEncoderPlan: invalid plan accepted" << std::endl;
+        return false;
+    }
+
+    for (unsigned int c = 0; c < sizeof(configs) / sizeof(configs[0]); c++)
+    {
+        params.OriginalCount = configs[c][0];
+        params.RecoveryCount = configs[c][1];
+        params.BlockBytes = configs[c][2];
+
+        const int originalBytes = params.OriginalCount * params.BlockBytes;
+        const int recoveryBytes = params.RecoveryCount * params.BlockBytes;
+        uint8_t *originalData = new uint8_t[originalBytes];
+        uint8_t *expected = new uint8_t[recoveryBytes];
+        uint8_t *recoveryData = new uint8_t[recoveryBytes];
+
+        for (int i = 0; i < originalBytes; i++) {
+            originalData[i] = rand();
+        }
+
+        for (int i = 0; i < params.OriginalCount; i++) {
+            blocks[i].Block = originalData + i * params.BlockBytes;
+        }
+
+        bool ok = cm256.cm256_encode(params, blocks, expected) == 0
+                && cm256.cm256_init_encoder_plan(params, plan) == 0;
+
+        // The plan is reused for several frames
+        for (int frame = 0; frame < 3 && ok; frame++)
+        {
+            memset(recoveryData, frame, recoveryBytes);
+            ok = cm256.cm256_encode(plan, blocks, recoveryData) == 0
+                    && memcmp(recoveryData, expected, recoveryBytes) == 0;
+        }
+
+        if (!ok)
+        {
+            std::cerr << "testEncoderPlan: " << params.OriginalCount << "+" << params.RecoveryCount
+                    << " x " << params.BlockBytes << " failed" << std::endl;
+        }
+
+        delete[] originalData;
+        delete[] expected;
+        delete[] recoveryData;
+
+        if (!ok) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Decodes a 64+16 x 300 bytes frame with the originals from 'first' to
+// 'first' + 'lost' - 1 replaced by recovery blocks
+bool decodeLossPattern(CM256& cm256, int first, int lost)
+{
+    // The parameters are an aggregate
+    CM256::cm256_encoder_params params = { 64, 16, 300, CM256::MatrixDefault };
+
+    uint8_t originalData[64 * 300];
+    uint8_t recoveryData[16 * 300];
+    CM256::cm256_block blocks[256];
+
+    for (int i = 0; i < params.OriginalCount; i++)
+    {
+        for (int j = 0; j < params.BlockBytes; j++) {
+            originalData[i * params.BlockBytes + j] = (uint8_t) (i + j * 13);
+        }
+
+        blocks[i].Block = originalData + i * params.BlockBytes;
+        blocks[i].Index = CM256::cm256_get_original_block_index(params, i);
+    }
+
+    if (cm256.cm256_encode(params, blocks, recoveryData)) {
+        return false;
+    }
+
+    for (int k = 0; k < lost; k++)
+    {
+        blocks[first + k].Block = recoveryData + k * params.BlockBytes;
+        blocks[first + k].Index = CM256::cm256_get_recovery_block_index(params, k);
+    }
+
+    return cm256.cm256_decode(params, blocks) == 0
+            && validateSolution(blocks, params.OriginalCount, params.BlockBytes);
+}
+
+// Checks the decoder cache hits, misses and eviction
+bool testDecoderCache()
+{
+    CM256 cm256;
+
+    if (!cm256.isInitialized())
+    {
+        std::cerr << "cm256 not initialized" << std::endl;
+        return false;
+    }
+
+    unsigned long long hits, misses;
+    cm256.setDecoderCacheSize(2);
+
+    // Patterns A, A, B, A, C (evicts B), B (evicts A), A (evicts C), D (evicts B)
+    static const int patterns[][2] = { { 3, 5 }, { 3, 5 }, { 10, 2 }, { 3, 5 }, { 0, 16 }, { 10, 2 }, { 3, 5 }, { 7, 3 } };
+    static const int expectedHits[] = { 0, 1, 1, 2, 2, 2, 2, 2 };
+
+    for (unsigned int p = 0; p < sizeof(patterns) / sizeof(patterns[0]); p++)
+    {
+        if (!decodeLossPattern(cm256, patterns[p][0], patterns[p][1]))
+        {
+            std::cerr << "testDecoderCache: decode " << p << " failed" << std::endl;
+            return false;
+        }
+
+        cm256.getDecoderCacheStats(hits, misses);
+
+        if (hits != (unsigned long long) expectedHits[p])
+        {
+            std::cerr << "testDecoderCache: " << hits << " hits after decode " << p
+                    << " expected " << expectedHits[p] << std::endl;
+            return false;
+        }
+    }
+
+    if (misses != 6)
+    {
+        std::cerr << "testDecoderCache: " << misses << " misses, expected 6" << std::endl;
+        return false;
+    }
+
+    // A single erasure recovered with the first recovery block needs no matrices
+    if (!decodeLossPattern(cm256, 7, 1))
+    {
+        std::cerr << "testDecoderCache: single erasure decode failed" << std::endl;
+        return false;
+    }
+
+    cm256.getDecoderCacheStats(hits, misses);
+
+    if (hits != 2 || misses != 6)
+    {
+        std::cerr << "testDecoderCache: single erasure decode used the cache" << std::endl;
+        return false;
+    }
+
+    cm256.setDecoderCacheSize(0);
+    cm256.getDecoderCacheStats(hits, misses);
+
+    return cm256.getDecoderCacheSize() == 0 && hits == 0 && misses == 0 && decodeLossPattern(cm256, 3, 5);
+}
+
+// Checks that encoding with worker threads gives the same output as without
+bool testThreadedEncode()
+{
+    CM256 cm256;
+    CM256 sharing;
+
+    if (!cm256.isInitialized() || !sharing.isInitialized())
+    {
+        std::cerr << "cm256 not initialized" << std::endl;
+        return false;
+    }
+
+    // Split by byte ranges, by recovery blocks, and not split
+    static const int configs[][3] = {
+        { 32, 8, 65536 + 13 }, { 200, 50, 1000 }, { 128, 26, 508 }, { 2, 2, 300000 }
+    };
+
+    CM256Pool pool(2);
+    sharing.setThreadPool(&pool);
+
+    for (unsigned int c = 0; c < sizeof(configs) / sizeof(configs[0]); c++)
+    {
+        CM256::cm256_encoder_params params = {};
+        params.OriginalCount = configs[c][0];
+        params.RecoveryCount = configs[c][1];
+        params.BlockBytes = configs[c][2];
+
+        const int originalBytes = params.OriginalCount * params.BlockBytes;
+        const int recoveryBytes = params.RecoveryCount * params.BlockBytes;
+        uint8_t *originalData = new uint8_t[originalBytes];
+        uint8_t *expected = new uint8_t[recoveryBytes];
+        uint8_t *recoveryData = new uint8_t[recoveryBytes];
+        CM256::cm256_block blocks[256];
+
+        for (int i = 0; i < originalBytes; i++) {
+            originalData[i] = rand();
+        }
+
+        for (int i = 0; i < params.OriginalCount; i++) {
+            blocks[i].Block = originalData + i * params.BlockBytes;
+        }
+
+        cm256.setThreadCount(0);
+        bool ok = cm256.cm256_encode(params, blocks, expected) == 0;
+
+        // Owned pool with and without affinity, then the shared pool
+        for (int run = 0; run < 3 && ok; run++)
+        {
+            if (run < 2) {
+                cm256.setThreadCount(3, run == 0 ? -1 : 0);
+            }
+
+            memset(recoveryData, 0, recoveryBytes);
+            ok = (run < 2 ? cm256 : sharing).cm256_encode(params, blocks, recoveryData) == 0
+                    && memcmp(recoveryData, expected, recoveryBytes) == 0;
+        }
+
+        if (!ok)
+        {
+            std::cerr << "testThreadedEncode: " << params.OriginalCount << "+" << params.RecoveryCount
+                    << " x " << params.BlockBytes << " failed" << std::endl;
+        }
+
+        delete[] originalData;
+        delete[] expected;
+        delete[] recoveryData;
+
+        if (!ok) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Checks decoding with worker threads
+bool testThreadedDecode()
+{
+    CM256 cm256;
+
+    if (!cm256.isInitialized())
+    {
+        std::cerr << "cm256 not initialized" << std::endl;
+        return false;
+    }
+
+    // Split by byte ranges, and not split
+    static const int configs[][3] = {
+        { 32, 8, 65536 + 13 }, { 20, 10, 200000 }, { 200, 50, 1000 }
+    };
+
+    cm256.setThreadCount(3);
+
+    for (unsigned int c = 0; c < sizeof(configs) / sizeof(configs[0]); c++)
+    {
+        CM256::cm256_encoder_params params = {};
+        params.OriginalCount = configs[c][0];
+        params.RecoveryCount = configs[c][1];
+        params.BlockBytes = configs[c][2];
+
+        const int originalBytes = params.OriginalCount * params.BlockBytes;
+        uint8_t *originalData = new uint8_t[originalBytes];
+        uint8_t *recoveryData = new uint8_t[params.RecoveryCount * params.BlockBytes];
+        CM256::cm256_block blocks[256];
+
+        for (int i = 0; i < params.OriginalCount; i++)
+        {
+            for (int j = 0; j < params.BlockBytes; j++) {
+                originalData[i * params.BlockBytes + j] = (uint8_t) (i + j * 13);
+            }
+
+            blocks[i].Block = originalData + i * params.BlockBytes;
+            blocks[i].Index = CM256::cm256_get_original_block_index(params, i);
+        }
+
+        bool ok = cm256.cm256_encode(params, blocks, recoveryData) == 0;
+
+        // Lose as many originals as there are recovery blocks, every other one
+        for (int k = 0; k < params.RecoveryCount; k++)
+        {
+            blocks[2 * k].Block = recoveryData + k * params.BlockBytes;
+            blocks[2 * k].Index = CM256::cm256_get_recovery_block_index(params, k);
+        }
+
+        ok = ok && cm256.cm256_decode(params, blocks) == 0
+                && validateSolution(blocks, params.OriginalCount, params.BlockBytes);
+
+        if (!ok)
+        {
+            std::cerr << "testThreadedDecode: " << params.OriginalCount << "+" << params.RecoveryCount
+                    << " x " << params.BlockBytes << " failed" << std::endl;
+        }
+
+        delete[] originalData;
+        delete[] recoveryData;
+
+        if (!ok) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Checks that the streaming encoder gives the same output as cm256_encode()
+// with the originals added in random order
+bool testStreamEncoder()
+{
+    CM256 cm256;
+
+    if (!cm256.isInitialized())
+    {
+        std::cerr << "cm256 not initialized" << std::endl;
+        return false;
+    }
+
+    static const int configs[][3] = {
+        { 1, 2, 100 }, { 2, 1, 1000 }, { 10, 5, 333 }, { 128, 26, 508 }, { 32, 8, 20000 }
+    };
+
+    CM256::CM256StreamEncoder encoder(cm256);
+    uint8_t dummy[1];
+
+    if (encoder.add_original(0, dummy) != -4)
+    {
+        std::cerr << "testStreamEncoder: accepted an original before begin_frame" << std::endl;
+        return false;
+    }
+
+    for (unsigned int c = 0; c < sizeof(configs) / sizeof(configs[0]); c++)
+    {
+        CM256::cm256_encoder_params params = {};
+        params.OriginalCount = configs[c][0];
+        params.RecoveryCount = configs[c][1];
+        params.BlockBytes = configs[c][2];
+
+        const int originalBytes = params.OriginalCount * params.BlockBytes;
+        const int recoveryBytes = params.RecoveryCount * params.BlockBytes;
+        uint8_t *originalData = new uint8_t[originalBytes];
+        uint8_t *expected = new uint8_t[recoveryBytes];
+        uint8_t *recoveryData = new uint8_t[recoveryBytes];
+        CM256::cm256_block blocks[256];
+        CM256::CM256EncoderPlan plan;
+
+        for (int i = 0; i < originalBytes; i++) {
+            originalData[i] = rand();
+        }
+
+        for (int i = 0; i < params.OriginalCount; i++) {
+            blocks[i].Block = originalData + i * params.BlockBytes;
+        }
+
+        bool ok = cm256.cm256_encode(params, blocks, expected) == 0
+                && cm256.cm256_init_encoder_plan(params, plan) == 0;
+
+        for (int trial = 0; trial < 5 && ok; trial++)
+        {
+            int order[256];
+
+            for (int i = 0; i < params.OriginalCount; i++) {
+                order[i] = i;
+            }
+
+            for (int i = params.OriginalCount - 1; i > 0; i--)
+            {
+                int k = rand() % (i + 1);
+                int t = order[i];
+                order[i] = order[k];
+                order[k] = t;
+            }
+
+            memset(recoveryData, trial, recoveryBytes);
+            ok = encoder.begin_frame(plan, recoveryData) == 0;
+
+            for (int i = 0; i < params.OriginalCount && ok; i++)
+            {
+                const int result = encoder.add_original(order[i], blocks[order[i]].Block);
+                ok = result == (i == params.OriginalCount - 1 ? 1 : 0);
+
+                // Repeated and out of range indices are refused
+                if (ok && result == 0) {
+                    ok = encoder.add_original(order[i], blocks[order[i]].Block) == -5
+                            && encoder.add_original(params.OriginalCount, blocks[0].Block) == -5;
+                }
+            }
+
+            ok = ok && encoder.is_complete() && memcmp(recoveryData, expected, recoveryBytes) == 0;
+        }
+
+        if (!ok)
+        {
+            std::cerr << "testStreamEncoder: " << params.OriginalCount << "+" << params.RecoveryCount
+                    << " x " << params.BlockBytes << " failed" << std::endl;
+        }
+
+        delete[] originalData;
+        delete[] expected;
+        delete[] recoveryData;
+
+        if (!ok) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Checks the streaming decoder with blocks arriving in random order
+bool testStreamDecoder()
+{
+    CM256 cm256;
+
+    if (!cm256.isInitialized())
+    {
+        std::cerr << "cm256 not initialized" << std::endl;
+        return false;
+    }
+
+    static const int configs[][3] = {
+        { 1, 2, 100 }, { 2, 1, 1000 }, { 10, 5, 333 }, { 128, 26, 508 }, { 32, 8, 20000 }
+    };
+
+    // Exercise the decoder cache with matrices that have no original elimination rows
+    cm256.setDecoderCacheSize(4);
+    CM256::CM256StreamDecoder decoder(cm256);
+    CM256::cm256_block block;
+
+    block.Block = &block;
+    block.Index = 0;
+
+    if (decoder.add_block(&block) != -4 || decoder.finish() != -4)
+    {
+        std::cerr << "testStreamDecoder: accepted a block before begin_frame" << std::endl;
+        return false;
+    }
+
+    for (unsigned int c = 0; c < sizeof(configs) / sizeof(configs[0]); c++)
+    {
+        CM256::cm256_encoder_params params = {};
+        params.OriginalCount = configs[c][0];
+        params.RecoveryCount = configs[c][1];
+        params.BlockBytes = configs[c][2];
+
+        const int blockCount = params.OriginalCount + params.RecoveryCount;
+        uint8_t *encodedData = new uint8_t[blockCount * params.BlockBytes];
+        uint8_t *receivedData = new uint8_t[blockCount * params.BlockBytes];
+        CM256::cm256_block blocks[256];
+        bool ok = true;
+
+        for (int i = 0; i < params.OriginalCount; i++)
+        {
+            for (int j = 0; j < params.BlockBytes; j++) {
+                encodedData[i * params.BlockBytes + j] = (uint8_t) (i + j * 13);
+            }
+
+            blocks[i].Block = encodedData + i * params.BlockBytes;
+        }
+
+        ok = cm256.cm256_encode(params, blocks, encodedData + params.OriginalCount * params.BlockBytes) == 0;
+
+        for (int trial = 0; trial < 20 && ok; trial++)
+        {
+            // Arrival order: a random permutation of all the blocks, the first
+            // 'lost' originals in it are dropped
+            int order[256];
+            int lost = rand() % (params.RecoveryCount + 1);
+
+            for (int i = 0; i < blockCount; i++) {
+                order[i] = i;
+            }
+
+            for (int i = blockCount - 1; i > 0; i--)
+            {
+                int k = rand() % (i + 1);
+                int t = order[i];
+                order[i] = order[k];
+                order[k] = t;
+            }
+
+            memcpy(receivedData, encodedData, blockCount * params.BlockBytes);
+            ok = decoder.begin_frame(params) == 0;
+            int result = 0;
+
+            for (int i = 0; i < blockCount && ok; i++)
+            {
+                const int index = order[i];
+
+                if (index < params.OriginalCount && lost > 0)
+                {
+                    lost--;
+                    continue;
+                }
+
+                blocks[index].Block = receivedData + index * params.BlockBytes;
+                blocks[index].Index = (unsigned char) index;
+                const int previous = result;
+                result = decoder.add_block(&blocks[index]);
+                ok = result == 0 || result == 1;
+
+                // A repeated block is refused until the frame is complete
+                if (ok && previous == 0 && result == 0) {
+                    ok = decoder.add_block(&blocks[index]) == -5;
+                }
+            }
+
+            // Collect the blocks that were used into the order the decoder saw them
+            CM256::cm256_block* used[256];
+            int usedCount = 0;
+
+            for (int i = 0; i < blockCount && ok; i++)
+            {
+                if (blocks[order[i]].Block == receivedData + order[i] * params.BlockBytes && usedCount < params.OriginalCount) {
+                    used[usedCount++] = &blocks[order[i]];
+                }
+            }
+
+            ok = ok && result == 1 && decoder.finish() == 0;
+
+            // Every original is in one of the blocks used
+            uint8_t seen[256] = { 0 };
+
+            for (int i = 0; i < usedCount && ok; i++)
+            {
+                const int index = used[i]->Index;
+                const uint8_t* data = (const uint8_t*) used[i]->Block;
+                ok = index < params.OriginalCount && !seen[index];
+                seen[index] = 1;
+
+                for (int j = 0; j < params.BlockBytes && ok; j++) {
+                    ok = data[j] == (uint8_t) (index + j * 13);
+                }
+            }
+
+            // Poison the block pointers so that the next trial only sees its own blocks
+            for (int i = 0; i < blockCount; i++) {
+                blocks[i].Block = nullptr;
+            }
+
+            if (!ok)
+            {
+                std::cerr << "testStreamDecoder: " << params.OriginalCount << "+" << params.RecoveryCount
+                        << " x " << params.BlockBytes << " trial " << trial << " failed" << std::endl;
+            }
+        }
+
+        delete[] encodedData;
+        delete[] receivedData;
+
+        if (!ok) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Checks decoding into output blocks against the originals, with and without
+// preserving the recovery blocks, and with the streaming decoder
+bool testDecodeOutputs()
+{
+    CM256 cm256;
+
+    if (!cm256.isInitialized())
+    {
+        std::cerr << "cm256 not initialized" << std::endl;
+        return false;
+    }
+
+    static const int configs[][3] = {
+        { 1, 2, 100 }, { 2, 1, 1000 }, { 10, 1, 333 }, { 10, 5, 333 }, { 128, 26, 508 }, { 32, 8, 20000 }
+    };
+
+    // Several tiles per block for the largest blocks
+    cm256.setTileBytes(4096);
+    CM256::CM256StreamDecoder decoder(cm256);
+
+    for (unsigned int c = 0; c < sizeof(configs) / sizeof(configs[0]); c++)
+    {
+        CM256::cm256_encoder_params params = {};
+        params.OriginalCount = configs[c][0];
+        params.RecoveryCount = configs[c][1];
+        params.BlockBytes = configs[c][2];
+
+        const int blockCount = params.OriginalCount + params.RecoveryCount;
+        const int recoveryBytes = params.RecoveryCount * params.BlockBytes;
+        uint8_t *encodedData = new uint8_t[blockCount * params.BlockBytes];
+        uint8_t *receivedData = new uint8_t[blockCount * params.BlockBytes];
+        uint8_t *outputData = new uint8_t[params.OriginalCount * params.BlockBytes];
+        CM256::cm256_block blocks[256];
+        void* outputs[256];
+        bool ok = true;
+
+        for (int i = 0; i < params.OriginalCount; i++)
+        {
+            for (int j = 0; j < params.BlockBytes; j++) {
+                encodedData[i * params.BlockBytes + j] = (uint8_t) (i * 7 + j * 11);
+            }
+
+            blocks[i].Block = encodedData + i * params.BlockBytes;
+        }
+
+        ok = cm256.cm256_encode(params, blocks, encodedData + params.OriginalCount * params.BlockBytes) == 0;
+
+        for (int trial = 0; trial < 30 && ok; trial++)
+        {
+            // The first 'lost' originals are replaced by as many recovery blocks
+            // picked at random, and only their outputs are given
+            int lost = 1 + rand() % params.RecoveryCount;
+            const int mode = trial % 3; // 0: in place, 1: preserving, 2: streaming
+            uint8_t recoveryUsed[256] = { 0 };
+            uint8_t indices[256];
+
+            if (lost > params.OriginalCount) {
+                lost = params.OriginalCount;
+            }
+
+            memcpy(receivedData, encodedData, blockCount * params.BlockBytes);
+            memset(outputData, 0xA5, params.OriginalCount * params.BlockBytes);
+
+            for (int i = 0; i < params.OriginalCount; i++)
+            {
+                int index = i;
+
+                if (i < lost)
+                {
+                    do {
+                        index = params.OriginalCount + rand() % params.RecoveryCount;
+                    } while (recoveryUsed[index - params.OriginalCount]);
+
+                    recoveryUsed[index - params.OriginalCount] = 1;
+                }
+
+                blocks[i].Block = receivedData + index * params.BlockBytes;
+                blocks[i].Index = (unsigned char) index;
+                indices[i] = (uint8_t) index;
+                outputs[i] = i < lost ? outputData + i * params.BlockBytes : nullptr;
+            }
+
+            if (mode == 2)
+            {
+                ok = decoder.begin_frame(params) == 0;
+
+                for (int i = 0; i < params.OriginalCount && ok; i++) {
+                    ok = decoder.add_block(&blocks[i]) >= 0;
+                }
+
+                ok = ok && decoder.finish(outputs) == 0;
+            }
+            else
+            {
+                ok = cm256.cm256_decode(params, blocks, outputs, mode == 1) == 0;
+            }
+
+            // The lost originals are in the outputs, the other blocks were not moved
+            for (int i = 0; i < params.OriginalCount && ok; i++) {
+                ok = memcmp(i < lost ? outputData + i * params.BlockBytes : blocks[i].Block,
+                        encodedData + i * params.BlockBytes, params.BlockBytes) == 0;
+            }
+
+            for (int i = 0; i < params.OriginalCount && ok; i++) {
+                ok = blocks[i].Index == indices[i];
+            }
+
+            if (ok && mode == 1) {
+                ok = memcmp(receivedData + params.OriginalCount * params.BlockBytes,
+                        encodedData + params.OriginalCount * params.BlockBytes, recoveryBytes) == 0;
+            }
+
+            if (!ok)
+            {
+                std::cerr << "testDecodeOutputs: " << params.OriginalCount << "+" << params.RecoveryCount
+                        << " x " << params.BlockBytes << " trial " << trial << " mode " << mode << " failed" << std::endl;
+            }
+        }
+
+        // An output needed but missing is refused
+        if (ok && params.OriginalCount > 1)
+        {
+            memcpy(receivedData, encodedData, blockCount * params.BlockBytes);
+
+            for (int i = 0; i < params.OriginalCount; i++)
+            {
+                blocks[i].Block = receivedData + (i == 0 ? params.OriginalCount : i) * params.BlockBytes;
+                blocks[i].Index = (unsigned char) (i == 0 ? params.OriginalCount : i);
+                outputs[i] = nullptr;
+            }
+
+            ok = cm256.cm256_decode(params, blocks, outputs, true) == -3;
+
+            if (!ok) {
+                std::cerr << "testDecodeOutputs: accepted a null output" << std::endl;
+            }
+        }
+
+        delete[] encodedData;
+        delete[] receivedData;
+        delete[] outputData;
+
+        if (!ok) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Checks the strided encoders and decoder against the block descriptor ones,
+// with the blocks in packets that have a header
+bool testStridedCodec()
+{
+    CM256 cm256;
+
+    if (!cm256.isInitialized())
+    {
+        std::cerr << "cm256 not initialized" << std::endl;
+        return false;
+    }
+
+    static const int configs[][3] = {
+        { 1, 2, 100 }, { 2, 1, 1000 }, { 10, 5, 333 }, { 128, 26, 508 }, { 32, 8, 20000 }
+    };
+    static const int headerBytes = 7;
+
+    for (unsigned int c = 0; c < sizeof(configs) / sizeof(configs[0]); c++)
+    {
+        CM256::cm256_encoder_params params = {};
+        params.OriginalCount = configs[c][0];
+        params.RecoveryCount = configs[c][1];
+        params.BlockBytes = configs[c][2];
+
+        const int blockCount = params.OriginalCount + params.RecoveryCount;
+        const int stride = headerBytes + params.BlockBytes;
+        uint8_t *packets = new uint8_t[blockCount * stride];
+        uint8_t *received = new uint8_t[params.OriginalCount * stride];
+        uint8_t *recoveryData = new uint8_t[params.RecoveryCount * params.BlockBytes];
+        CM256::cm256_block blocks[256];
+        CM256::CM256EncoderPlan plan;
+        CM256::CM256StreamEncoder encoder(cm256);
+        unsigned char indices[256];
+        bool ok = true;
+
+        memset(packets, 0x5A, blockCount * stride);
+
+        for (int i = 0; i < params.OriginalCount; i++)
+        {
+            for (int j = 0; j < params.BlockBytes; j++) {
+                packets[i * stride + headerBytes + j] = (uint8_t) (i * 5 + j * 3);
+            }
+
+            blocks[i].Block = packets + i * stride + headerBytes;
+        }
+
+        ok = cm256.cm256_encode(params, blocks, recoveryData) == 0;
+
+        // Strided with the parameters, a plan, and the streaming encoder
+        ok = ok && cm256.cm256_init_encoder_plan(params, plan) == 0;
+
+        for (int mode = 0; mode < 3 && ok; mode++)
+        {
+            uint8_t *recoveryPackets = packets + params.OriginalCount * stride;
+            memset(recoveryPackets, 0, params.RecoveryCount * stride);
+
+            if (mode == 0)
+            {
+                ok = cm256.cm256_encode(params, packets + headerBytes, stride, recoveryPackets + headerBytes, stride) == 0;
+            }
+            else if (mode == 1)
+            {
+                ok = cm256.cm256_encode(plan, packets + headerBytes, stride, recoveryPackets + headerBytes, stride) == 0;
+            }
+            else
+            {
+                ok = encoder.begin_frame(plan, recoveryPackets + headerBytes, stride) == 0;
+
+                for (int i = params.OriginalCount - 1; i >= 0 && ok; i--) {
+                    ok = encoder.add_original(i, packets + i * stride + headerBytes) >= 0;
+                }
+
+                ok = ok && encoder.is_complete();
+            }
+
+            // The recovery blocks match and the headers were not written
+            for (int i = 0; i < params.RecoveryCount && ok; i++)
+            {
+                ok = memcmp(recoveryPackets + i * stride + headerBytes, recoveryData + i * params.BlockBytes, params.BlockBytes) == 0;
+
+                for (int j = 0; j < headerBytes && ok; j++) {
+                    ok = recoveryPackets[i * stride + j] == 0;
+                }
+            }
+
+            if (!ok) {
+                std::cerr << "testStridedCodec: encode mode " << mode << " failed" << std::endl;
+            }
+        }
+
+        // Receive a frame with the first originals lost, the recovery packets
+        // first, and decode it in place
+        const int lost = params.RecoveryCount < params.OriginalCount ? params.RecoveryCount : params.OriginalCount;
+
+        for (int i = 0; i < params.OriginalCount && ok; i++)
+        {
+            const int index = i < lost ? params.OriginalCount + i : i;
+            memcpy(received + i * stride, packets + index * stride, stride);
+            indices[i] = (unsigned char) index;
+        }
+
+        ok = ok && cm256.cm256_decode(params, received + headerBytes, stride, indices) == 0;
+
+        for (int i = 0; i < params.OriginalCount && ok; i++) {
+            ok = memcmp(received + i * stride + headerBytes, packets + indices[i] * stride + headerBytes, params.BlockBytes) == 0
+                    && indices[i] < params.OriginalCount;
+        }
+
+        if (!ok) {
+            std::cerr << "testStridedCodec: decode failed" << std::endl;
+        }
+
+        // Overlapping blocks are refused
+        if (ok && (cm256.cm256_encode(params, packets, params.BlockBytes - 1, packets, stride) != -1
+                || cm256.cm256_decode(params, received, params.BlockBytes - 1, indices) != -1))
+        {
+            std::cerr << "testStridedCodec: accepted a stride below the block size" << std::endl;
+            ok = false;
+        }
+
+        delete[] packets;
+        delete[] received;
+        delete[] recoveryData;
+
+        if (!ok)
+        {
+            std::cerr << "testStridedCodec: " << params.OriginalCount << "+" << params.RecoveryCount
+                    << " x " << params.BlockBytes << " failed" << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Checks encoding segmented originals against the same data in contiguous
+// blocks, with random segment boundaries including empty segments
+bool testSegmentedEncode()
+{
+    CM256 cm256;
+
+    if (!cm256.isInitialized())
+    {
+        std::cerr << "cm256 not initialized" << std::endl;
+        return false;
+    }
+
+    static const int configs[][3] = {
+        { 1, 2, 100 }, { 2, 1, 1000 }, { 10, 5, 333 }, { 128, 26, 508 }, { 32, 8, 20000 }
+    };
+    static const int maxSegments = 6;
+
+    for (unsigned int c = 0; c < sizeof(configs) / sizeof(configs[0]); c++)
+    {
+        CM256::cm256_encoder_params params = {};
+        params.OriginalCount = configs[c][0];
+        params.RecoveryCount = configs[c][1];
+        params.BlockBytes = configs[c][2];
+
+        const int frameBytes = params.OriginalCount * params.BlockBytes;
+        const int recoveryBytes = params.RecoveryCount * params.BlockBytes;
+        uint8_t *originalData = new uint8_t[frameBytes];
+        uint8_t *segmentData = new uint8_t[frameBytes];
+        uint8_t *expectedData = new uint8_t[recoveryBytes];
+        uint8_t *recoveryData = new uint8_t[recoveryBytes];
+        CM256::cm256_block blocks[256];
+        CM256::cm256_segment segments[256 * maxSegments];
+        CM256::cm256_segmented_block segmentedBlocks[256];
+        bool ok = true;
+
+        for (int i = 0; i < frameBytes; i++) {
+            originalData[i] = (uint8_t) rand();
+        }
+
+        for (int i = 0; i < params.OriginalCount; i++) {
+            blocks[i].Block = originalData + i * params.BlockBytes;
+        }
+
+        ok = cm256.cm256_encode(params, blocks, expectedData) == 0;
+
+        for (int trial = 0; trial < 10 && ok; trial++)
+        {
+            // Split each original at random points into segments stored out of
+            // order in another buffer: last segment first
+            for (int i = 0; i < params.OriginalCount; i++)
+            {
+                const int segmentCount = 1 + rand() % maxSegments;
+                CM256::cm256_segment* blockSegments = segments + i * maxSegments;
+                int cuts[maxSegments + 1];
+
+                cuts[0] = 0;
+                cuts[segmentCount] = params.BlockBytes;
+
+                // Sorted random cuts
+                for (int k = 1; k < segmentCount; k++)
+                {
+                    int cut = rand() % (params.BlockBytes + 1);
+                    int m = k;
+
+                    for (; m > 1 && cuts[m - 1] > cut; m--) {
+                        cuts[m] = cuts[m - 1];
+                    }
+
+                    cuts[m] = cut;
+                }
+                uint8_t* storage = segmentData + (i + 1) * params.BlockBytes;
+
+                for (int k = 0; k < segmentCount; k++)
+                {
+                    const int bytes = cuts[k + 1] - cuts[k];
+                    storage -= bytes;
+                    memcpy(storage, originalData + i * params.BlockBytes + cuts[k], bytes);
+                    blockSegments[k].Data = bytes ? storage : nullptr;
+                    blockSegments[k].Bytes = bytes;
+                }
+
+                segmentedBlocks[i].Segments = blockSegments;
+                segmentedBlocks[i].SegmentCount = segmentCount;
+            }
+
+            memset(recoveryData, 0, recoveryBytes);
+            cm256.setThreadCount(trial % 2 ? 2 : 0);
+            ok = cm256.cm256_encode(params, segmentedBlocks, recoveryData) == 0
+                    && memcmp(recoveryData, expectedData, recoveryBytes) == 0;
+
+            if (!ok)
+            {
+                std::cerr << "testSegmentedEncode: " << params.OriginalCount << "+" << params.RecoveryCount
+                        << " x " << params.BlockBytes << " trial " << trial << " failed" << std::endl;
+            }
+        }
+
+        // Segments that do not add up to the block size are refused
+        if (ok)
+        {
+            segments[0].Bytes++;
+
+            if (cm256.cm256_encode(params, segmentedBlocks, recoveryData) != -5)
+            {
+                std::cerr << "testSegmentedEncode: accepted segments of the wrong size" << std::endl;
+                ok = false;
+            }
+        }
+
+        cm256.setThreadCount(0);
+        delete[] originalData;
+        delete[] segmentData;
+        delete[] expectedData;
+        delete[] recoveryData;
+
+        if (!ok) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Checks variable-length originals: the recovery data against the encoder on
+// zero-padded copies, and the decoder recovering the data and the lengths.
+// Each original has a buffer of its own length so that reading its padding
+// would be noticed by memory checkers.
+bool testVariableBlocks()
+{
+    CM256 cm256;
+
+    if (!cm256.isInitialized())
+    {
+        std::cerr << "cm256 not initialized" << std::endl;
+        return false;
+    }
+
+    static const int configs[][3] = {
+        { 1, 2, 100 }, { 2, 1, 1000 }, { 10, 5, 333 }, { 128, 26, 1400 }, { 32, 8, 20000 }
+    };
+
+    for (unsigned int c = 0; c < sizeof(configs) / sizeof(configs[0]); c++)
+    {
+        CM256::cm256_encoder_params params = {};
+        params.OriginalCount = configs[c][0];
+        params.RecoveryCount = configs[c][1];
+        params.BlockBytes = configs[c][2];
+
+        const int recoveryBytes = CM256::cm256_get_variable_recovery_bytes(params);
+        uint8_t *paddedData = new uint8_t[params.OriginalCount * params.BlockBytes];
+        uint8_t *expectedData = new uint8_t[params.RecoveryCount * params.BlockBytes];
+        uint8_t *recoveryData = new uint8_t[params.RecoveryCount * recoveryBytes];
+        uint8_t *receivedRecovery = new uint8_t[params.RecoveryCount * recoveryBytes];
+        uint8_t *originalData[256];
+        int originalBytes[256];
+        int receivedBytes[256];
+        CM256::cm256_block blocks[256];
+        bool ok = true;
+
+        for (int trial = 0; trial < 10 && ok; trial++)
+        {
+            memset(paddedData, 0, params.OriginalCount * params.BlockBytes);
+
+            for (int i = 0; i < params.OriginalCount; i++)
+            {
+                // Empty and full blocks included
+                const int pick = rand() % 8;
+                originalBytes[i] = pick == 0 ? 0 : pick == 1 ? params.BlockBytes : rand() % (params.BlockBytes + 1);
+                originalData[i] = new uint8_t[originalBytes[i]];
+
+                for (int j = 0; j < originalBytes[i]; j++) {
+                    originalData[i][j] = paddedData[i * params.BlockBytes + j] = (uint8_t) rand();
+                }
+
+                blocks[i].Block = paddedData + i * params.BlockBytes;
+            }
+
+            ok = cm256.cm256_encode(params, blocks, expectedData) == 0;
+
+            for (int i = 0; i < params.OriginalCount; i++) {
+                blocks[i].Block = originalData[i];
+            }
+
+            ok = ok && cm256.cm256_encode_variable(params, blocks, originalBytes, recoveryData) == 0;
+
+            for (int i = 0; i < params.RecoveryCount && ok; i++) {
+                ok = memcmp(recoveryData + i * recoveryBytes, expectedData + i * params.BlockBytes, params.BlockBytes) == 0;
+            }
+
+            // Lose up to RecoveryCount originals picked at random
+            int lost = 0;
+
+            for (int i = 0; i < params.OriginalCount && ok; i++)
+            {
+                if (lost < params.RecoveryCount && rand() % 3 == 0)
+                {
+                    memcpy(receivedRecovery + lost * recoveryBytes, recoveryData + lost * recoveryBytes, recoveryBytes);
+                    blocks[i].Block = receivedRecovery + lost * recoveryBytes;
+                    blocks[i].Index = CM256::cm256_get_recovery_block_index(params, lost);
+                    receivedBytes[i] = -1;
+                    lost++;
+                }
+                else
+                {
+                    blocks[i].Index = CM256::cm256_get_original_block_index(params, i);
+                    receivedBytes[i] = originalBytes[i];
+                }
+            }
+
+            ok = ok && cm256.cm256_decode_variable(params, blocks, receivedBytes) == 0;
+
+            for (int i = 0; i < params.OriginalCount && ok; i++)
+            {
+                const int index = blocks[i].Index;
+                ok = index < params.OriginalCount && receivedBytes[i] == originalBytes[index]
+                        && memcmp(blocks[i].Block, paddedData + index * params.BlockBytes, receivedBytes[i]) == 0;
+            }
+
+            if (!ok)
+            {
+                std::cerr << "testVariableBlocks: " << params.OriginalCount << "+" << params.RecoveryCount
+                        << " x " << params.BlockBytes << " trial " << trial << " failed" << std::endl;
+            }
+
+            for (int i = 0; i < params.OriginalCount; i++) {
+                delete[] originalData[i];
+            }
+        }
+
+        delete[] paddedData;
+        delete[] expectedData;
+        delete[] recoveryData;
+        delete[] receivedRecovery;
+
+        if (!ok) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Checks batch encoding and decoding against frame by frame calls, with and
+// without threads, loss patterns repeating across the frames and a frame
+// that cannot be decoded
+bool testBatch()
+{
+    CM256 cm256;
+
+    if (!cm256.isInitialized())
+    {
+        std::cerr << "cm256 not initialized" << std::endl;
+        return false;
+    }
+
+    static const int configs[][3] = {
+        { 1, 2, 100 }, { 2, 1, 1000 }, { 10, 5, 333 }, { 128, 26, 508 }, { 32, 8, 20000 }
+    };
+    static const int frameCount = 13;
+
+    for (unsigned int c = 0; c < sizeof(configs) / sizeof(configs[0]); c++)
+    {
+        CM256::cm256_encoder_params params = {};
+        params.OriginalCount = configs[c][0];
+        params.RecoveryCount = configs[c][1];
+        params.BlockBytes = configs[c][2];
+
+        const int frameBytes = (params.OriginalCount + params.RecoveryCount) * params.BlockBytes;
+        uint8_t *data = new uint8_t[frameCount * frameBytes];
+        uint8_t *expected = new uint8_t[params.RecoveryCount * params.BlockBytes];
+        CM256::cm256_block *blocks = new CM256::cm256_block[frameCount * params.OriginalCount];
+        CM256::cm256_block *frames[frameCount];
+        CM256::cm256_encode_job jobs[frameCount];
+        bool ok = true;
+
+        for (int f = 0; f < frameCount; f++)
+        {
+            uint8_t *frame = data + f * frameBytes;
+
+            for (int i = 0; i < params.OriginalCount * params.BlockBytes; i++) {
+                frame[i] = (uint8_t) (f * 31 + i * 7 + i / params.BlockBytes);
+            }
+
+            for (int i = 0; i < params.OriginalCount; i++)
+            {
+                blocks[f * params.OriginalCount + i].Block = frame + i * params.BlockBytes;
+                blocks[f * params.OriginalCount + i].Index = (unsigned char) i;
+            }
+
+            jobs[f].Originals = blocks + f * params.OriginalCount;
+            jobs[f].RecoveryBlocks = frame + params.OriginalCount * params.BlockBytes;
+            frames[f] = blocks + f * params.OriginalCount;
+        }
+
+        for (int run = 0; run < 2 && ok; run++)
+        {
+            cm256.setThreadCount(run == 0 ? 0 : 3);
+
+            for (int f = 0; f < frameCount; f++) {
+                memset(jobs[f].RecoveryBlocks, 0, params.RecoveryCount * params.BlockBytes);
+            }
+
+            ok = cm256.cm256_encode_batch(params, jobs, frameCount) == 0;
+
+            for (int f = 0; f < frameCount && ok; f++)
+            {
+                ok = cm256.cm256_encode(params, jobs[f].Originals, expected) == 0
+                        && memcmp(jobs[f].RecoveryBlocks, expected, params.RecoveryCount * params.BlockBytes) == 0;
+            }
+
+            if (!ok) {
+                std::cerr << "testBatch: encode run " << run << " failed" << std::endl;
+            }
+        }
+
+        // Lose originals in one of three patterns, and make frame 5
+        // undecodable by repeating the index of a received original
+        uint8_t *received = new uint8_t[frameCount * frameBytes];
+        const int lost = params.RecoveryCount < params.OriginalCount ? params.RecoveryCount : params.OriginalCount;
+        const bool duplicate = params.OriginalCount - lost >= 2;
+        memcpy(received, data, frameCount * frameBytes);
+
+        for (int f = 0; f < frameCount && ok; f++)
+        {
+            uint8_t *frame = received + f * frameBytes;
+            CM256::cm256_block *first = nullptr;
+
+            for (int k = 0; k < lost; k++)
+            {
+                const int i = (k * 3 + f % 3) % params.OriginalCount;
+                blocks[f * params.OriginalCount + i].Block = frame + (params.OriginalCount + k) * params.BlockBytes;
+                blocks[f * params.OriginalCount + i].Index = CM256::cm256_get_recovery_block_index(params, k);
+            }
+
+            for (int i = 0; i < params.OriginalCount && f == 5 && duplicate; i++)
+            {
+                CM256::cm256_block& block = blocks[f * params.OriginalCount + i];
+
+                if (block.Index >= params.OriginalCount) {
+                    continue;
+                }
+
+                if (first)
+                {
+                    block.Index = first->Index;
+                    break;
+                }
+
+                first = &block;
+            }
+        }
+
+        const int result = ok ? cm256.cm256_decode_batch(params, frames, frameCount) : 0;
+
+        if (ok && result != (duplicate ? -5 : 0))
+        {
+            std::cerr << "testBatch: decode returned " << result << std::endl;
+            ok = false;
+        }
+
+        for (int f = 0; f < frameCount && ok; f++)
+        {
+            if (f == 5 && duplicate) {
+                continue;
+            }
+
+            for (int i = 0; i < params.OriginalCount && ok; i++)
+            {
+                const CM256::cm256_block& block = blocks[f * params.OriginalCount + i];
+                ok = block.Index < params.OriginalCount
+                        && memcmp(block.Block, data + f * frameBytes + block.Index * params.BlockBytes, params.BlockBytes) == 0;
+            }
+
+            if (!ok) {
+                std::cerr << "testBatch: frame " << f << " not decoded" << std::endl;
+            }
+        }
+
+        cm256.setThreadCount(0);
+        delete[] data;
+        delete[] expected;
+        delete[] blocks;
+        delete[] received;
+
+        if (!ok)
+        {
+            std::cerr << "testBatch: " << params.OriginalCount << "+" << params.RecoveryCount
+                    << " x " << params.BlockBytes << " failed" << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Checks the GF(65536) field and its bulk operations against word by word
+// products, on each SIMD tier the CPU supports
+// Checks the bit-matrix mode against the GF(256) products, bit-sliced, and
+// with random sets of received blocks
+bool testBitMatrix()
+{
+    CM256 cm256;
+    gf256_ctx gf256Ctx;
+
+    if (!cm256.isInitialized() || !gf256Ctx.isInitialized())
+    {
+        std::cerr << "cm256 not initialized" << std::endl;
+        return false;
+    }
+
+    static const int configs[][3] = {
+        { 1, 2, 80 }, { 2, 1, 64 }, { 10, 5, 808 }, { 128, 26, 1296 }, { 100, 30, 4096 },
+        { 200, 55, 8000 }, { 32, 8, 65536 }, { 128, 128, 16 }
+    };
+
+    for (unsigned int c = 0; c < sizeof(configs) / sizeof(configs[0]); c++)
+    {
+        CM256::cm256_encoder_params params = {};
+        params.OriginalCount = configs[c][0];
+        params.RecoveryCount = configs[c][1];
+        params.BlockBytes = configs[c][2];
+
+        const int blockCount = params.OriginalCount + params.RecoveryCount;
+        const int packetBytes = params.BlockBytes / 8;
+        uint8_t *data = new uint8_t[blockCount * params.BlockBytes];
+        uint8_t *received = new uint8_t[params.OriginalCount * params.BlockBytes];
+        CM256::cm256_block *blocks = new CM256::cm256_block[params.OriginalCount];
+        int *indices = new int[blockCount];
+        CM256::CM256BitMatrixPlan plan;
+        bool ok = true;
+
+        for (int i = 0; i < params.OriginalCount * params.BlockBytes; i++) {
+            data[i] = rand();
+        }
+
+        for (int i = 0; i < params.OriginalCount; i++)
+        {
+            blocks[i].Block = data + i * params.BlockBytes;
+            blocks[i].Index = CM256::cm256_get_original_block_index(params, i);
+        }
+
+        uint8_t *recovery = data + params.OriginalCount * params.BlockBytes;
+        ok = cm256.cm256_init_bitmatrix_plan(params, plan) == 0
+                && cm256.cm256_encode_bitmatrix(plan, blocks, recovery) == 0
+                && plan.XorCount <= plan.DenseXorCount;
+
+        // Element of bit position t of a block: bit t of each of its packets
+        for (int r = 0; r < params.RecoveryCount && ok && params.OriginalCount > 1; r++)
+        {
+            for (int t = 0; t < 8 * packetBytes && ok; t += 7)
+            {
+                uint8_t expected = 0, actual = 0;
+
+                for (int b = 0; b < 8; b++) {
+                    actual |= ((recovery[r * params.BlockBytes + b * packetBytes + t / 8] >> (t % 8)) & 1) << b;
+                }
+
+                for (int j = 0; j < params.OriginalCount; j++)
+                {
+                    uint8_t element = 0;
+
+                    for (int b = 0; b < 8; b++) {
+                        element |= ((data[j * params.BlockBytes + b * packetBytes + t / 8] >> (t % 8)) & 1) << b;
+                    }
+
+                    const uint8_t coefficient = gf256Ctx.getMatrixElement((uint8_t) (params.OriginalCount + r), (uint8_t) params.OriginalCount, (uint8_t) j);
+                    expected ^= gf256Ctx.gf256_mul(element, coefficient);
+                }
+
+                ok = actual == expected;
+            }
+        }
+
+        if (!ok) {
+            std::cerr << "testBitMatrix: encode failed" << std::endl;
+        }
+
+        // Receive a random set of OriginalCount blocks out of all, in random order
+        for (int i = 0; i < blockCount; i++) {
+            indices[i] = i;
+        }
+
+        for (int i = 0; i < params.OriginalCount; i++) {
+            std::swap(indices[i], indices[i + rand() % (blockCount - i)]);
+        }
+
+        for (int i = 0; i < params.OriginalCount; i++)
+        {
+            blocks[i].Block = received + i * params.BlockBytes;
+            blocks[i].Index = (unsigned char) indices[i];
+            memcpy(blocks[i].Block, data + indices[i] * params.BlockBytes, params.BlockBytes);
+        }
+
+        ok = ok && cm256.cm256_decode_bitmatrix(params, blocks) == 0;
+
+        for (int i = 0; i < params.OriginalCount && ok; i++)
+        {
+            ok = blocks[i].Index < params.OriginalCount
+                    && memcmp(blocks[i].Block, data + blocks[i].Index * params.BlockBytes, params.BlockBytes) == 0;
+        }
+
+        if (!ok) {
+            std::cerr << "testBitMatrix: decode failed" << std::endl;
+        }
+
+        delete[] data;
+        delete[] received;
+        delete[] blocks;
+        delete[] indices;
+
+        if (!ok)
+        {
+            std::cerr << "testBitMatrix: " << params.OriginalCount << "+" << params.RecoveryCount
+                    << " x " << params.BlockBytes << " failed" << std::endl;
+            return false;
+        }
+    }
+
+    // The packets need a block size multiple of 8
+    CM256::cm256_encoder_params params = {};
+    CM256::CM256BitMatrixPlan plan;
+    params.OriginalCount = 10;
+    params.RecoveryCount = 2;
+    params.BlockBytes = 100;
+
+    if (cm256.cm256_init_bitmatrix_plan(params, plan) != -1)
+    {
+        std::cerr << "testBitMatrix: accepted a block size not multiple of 8" << std::endl;
+        return false;
+    }
+
+    // A recovery block given twice leaves the erasures without a solution
+    uint8_t repeated[8 * 64] = { 0 };
+    CM256::cm256_block repeatedBlocks[8];
+    params.OriginalCount = 8;
+    params.RecoveryCount = 8;
+    params.BlockBytes = 64;
+
+    for (int i = 0; i < params.OriginalCount; i++)
+    {
+        repeatedBlocks[i].Block = repeated + i * params.BlockBytes;
+        repeatedBlocks[i].Index = (unsigned char) (i == 7 ? 14 : params.OriginalCount + i);
+    }
+
+    if (cm256.cm256_decode_bitmatrix(params, repeatedBlocks) != -5 || cm256.cm256_decode(params, repeatedBlocks) != -5)
+    {
+        std::cerr << "testBitMatrix: accepted a repeated recovery block" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// Checks the codes of MatrixOptimized: elements, first row, round trips with
+// the decoders and fewer XORs than the default matrix in the bit-matrix mode
+bool testMatrixOptimized()
+{
+    CM256 cm256;
+    gf256_ctx gf256Ctx;
+
+    if (!cm256.isInitialized() || !gf256Ctx.isInitialized())
+    {
+        std::cerr << "cm256 not initialized" << std::endl;
+        return false;
+    }
+
+    // Tabulated, contained in a tabulated code, and larger than the table
+    static const int configs[][3] = {
+        { 10, 5, 1000 }, { 2, 2, 64 }, { 128, 26, 1296 }, { 40, 3, 512 }, { 200, 20, 800 }
+    };
+
+    cm256.setDecoderCacheSize(4);
+
+    for (unsigned int c = 0; c < sizeof(configs) / sizeof(configs[0]); c++)
+    {
+        CM256::cm256_encoder_params params = {};
+        params.OriginalCount = configs[c][0];
+        params.RecoveryCount = configs[c][1];
+        params.BlockBytes = configs[c][2];
+        params.Matrix = CM256::MatrixOptimized;
+
+        const int blockCount = params.OriginalCount + params.RecoveryCount;
+        const bool tabulated = c < 4;
+        uint8_t *data = new uint8_t[blockCount * params.BlockBytes];
+        uint8_t *defaultRecovery = new uint8_t[params.RecoveryCount * params.BlockBytes];
+        uint8_t *received = new uint8_t[params.OriginalCount * params.BlockBytes];
+        CM256::cm256_block *blocks = new CM256::cm256_block[params.OriginalCount];
+        int *indices = new int[blockCount];
+        CM256::CM256Matrix matrix;
+        bool ok = matrix.Initialize(params) && matrix.Scaled == tabulated;
+
+        for (int i = 0; i < params.OriginalCount * params.BlockBytes; i++) {
+            data[i] = rand();
+        }
+
+        for (int i = 0; i < params.OriginalCount; i++)
+        {
+            blocks[i].Block = data + i * params.BlockBytes;
+            blocks[i].Index = CM256::cm256_get_original_block_index(params, i);
+        }
+
+        uint8_t *recovery = data + params.OriginalCount * params.BlockBytes;
+        ok = ok && cm256.cm256_encode(params, blocks, recovery) == 0;
+
+        // Recovery bytes against the elements, the first row being all ones
+        for (int r = 0; r < params.RecoveryCount && ok; r++)
+        {
+            for (int t = 0; t < params.BlockBytes && ok; t += 13)
+            {
+                uint8_t expected = 0;
+
+                for (int j = 0; j < params.OriginalCount; j++)
+                {
+                    const uint8_t element = matrix.Element(gf256Ctx, params.OriginalCount + r, j);
+                    ok = ok && (r > 0 || element == 1);
+                    expected ^= gf256Ctx.gf256_mul(data[j * params.BlockBytes + t], element);
+                }
+
+                ok = ok && recovery[r * params.BlockBytes + t] == expected;
+            }
+        }
+
+        // The tabulated codes have other recovery blocks than the default matrix
+        params.Matrix = CM256::MatrixDefault;
+        ok = ok && cm256.cm256_encode(params, blocks, defaultRecovery) == 0
+                && (memcmp(defaultRecovery + params.BlockBytes, recovery + params.BlockBytes, (params.RecoveryCount - 1) * params.BlockBytes) != 0) == tabulated;
+        params.Matrix = CM256::MatrixOptimized;
+
+        if (!ok) {
+            std::cerr << "testMatrixOptimized: encode failed" << std::endl;
+        }
+
+        // Decode random sets of OriginalCount blocks, twice each to go through the cache
+        for (int trial = 0; trial < 6 && ok; trial++)
+        {
+            if (trial % 2 == 0)
+            {
+                for (int i = 0; i < blockCount; i++) {
+                    indices[i] = i;
+                }
+
+                for (int i = 0; i < params.OriginalCount; i++) {
+                    std::swap(indices[i], indices[i + rand() % (blockCount - i)]);
+                }
+            }
+
+            for (int i = 0; i < params.OriginalCount; i++)
+            {
+                blocks[i].Block = received + i * params.BlockBytes;
+                blocks[i].Index = (unsigned char) indices[i];
+                memcpy(blocks[i].Block, data + indices[i] * params.BlockBytes, params.BlockBytes);
+            }
+
+            if (trial < 4)
+            {
+                ok = cm256.cm256_decode(params, blocks) == 0;
+            }
+            else
+            {
+                CM256::CM256StreamDecoder decoder(cm256);
+                ok = decoder.begin_frame(params) == 0;
+
+                for (int i = 0; i < params.OriginalCount && ok; i++) {
+                    ok = decoder.add_block(&blocks[i]) == (i == params.OriginalCount - 1 ? 1 : 0);
+                }
+
+                ok = ok && decoder.finish() == 0;
+            }
+
+            for (int i = 0; i < params.OriginalCount && ok; i++)
+            {
+                ok = blocks[i].Index < params.OriginalCount
+                        && memcmp(blocks[i].Block, data + blocks[i].Index * params.BlockBytes, params.BlockBytes) == 0;
+            }
+        }
+
+        if (!ok) {
+            std::cerr << "testMatrixOptimized: decode failed" << std::endl;
+        }
+
+        // Bit-matrix mode: fewer XORs, and a round trip
+        CM256::CM256BitMatrixPlan plan, defaultPlan;
+        params.Matrix = CM256::MatrixDefault;
+        ok = ok && cm256.cm256_init_bitmatrix_plan(params, defaultPlan) == 0;
+        params.Matrix = CM256::MatrixOptimized;
+        ok = ok && cm256.cm256_init_bitmatrix_plan(params, plan) == 0
+                && (plan.DenseXorCount < defaultPlan.DenseXorCount) == tabulated;
+
+        for (int i = 0; i < params.OriginalCount; i++)
+        {
+            blocks[i].Block = data + i * params.BlockBytes;
+            blocks[i].Index = CM256::cm256_get_original_block_index(params, i);
+        }
+
+        ok = ok && cm256.cm256_encode_bitmatrix(plan, blocks, recovery) == 0;
+
+        for (int i = 0; i < params.OriginalCount; i++)
+        {
+            const int index = i < params.RecoveryCount ? params.OriginalCount + params.RecoveryCount - 1 - i : i;
+            blocks[i].Block = received + i * params.BlockBytes;
+            blocks[i].Index = (unsigned char) index;
+            memcpy(blocks[i].Block, data + index * params.BlockBytes, params.BlockBytes);
+        }
+
+        ok = ok && cm256.cm256_decode_bitmatrix(params, blocks) == 0;
+
+        for (int i = 0; i < params.OriginalCount && ok; i++)
+        {
+            ok = blocks[i].Index < params.OriginalCount
+                    && memcmp(blocks[i].Block, data + blocks[i].Index * params.BlockBytes, params.BlockBytes) == 0;
+        }
+
+        delete[] data;
+        delete[] defaultRecovery;
+        delete[] received;
+        delete[] blocks;
+        delete[] indices;
+
+        if (!ok)
+        {
+            std::cerr << "testMatrixOptimized: " << params.OriginalCount << "+" << params.RecoveryCount
+                    << " x " << params.BlockBytes << " failed" << std::endl;
+            return false;
+        }
+    }
+
+    // The optimized parameters depend on the recovery count, so a cached loss
+    // pattern of one code must not be used for the other
+    CM256 cached;
+    cached.setDecoderCacheSize(4);
+
+    for (int recoveryCount = 3; recoveryCount <= 4; recoveryCount++)
+    {
+        CM256::cm256_encoder_params params = {};
+        CM256::cm256_block blocks[10];
+        uint8_t originalData[10 * 64];
+        uint8_t recoveryData[4 * 64];
+        params.OriginalCount = 10;
+        params.RecoveryCount = recoveryCount;
+        params.BlockBytes = 64;
+        params.Matrix = CM256::MatrixOptimized;
+
+        for (int i = 0; i < params.OriginalCount; i++)
+        {
+            for (int j = 0; j < params.BlockBytes; j++) {
+                originalData[i * params.BlockBytes + j] = (uint8_t) (i + j * 13);
+            }
+
+            blocks[i].Block = originalData + i * params.BlockBytes;
+            blocks[i].Index = (unsigned char) i;
+        }
+
+        bool ok = cached.cm256_encode(params, blocks, recoveryData) == 0;
+
+        // Originals 1 and 2 replaced by the recovery blocks of index 11 and 12
+        for (int k = 1; k <= 2; k++)
+        {
+            blocks[k].Block = recoveryData + k * params.BlockBytes;
+            blocks[k].Index = (unsigned char) (params.OriginalCount + k);
+        }
+
+        if (!ok || cached.cm256_decode(params, blocks) != 0 || !validateSolution(blocks, params.OriginalCount, params.BlockBytes))
+        {
+            std::cerr << "testMatrixOptimized: cached decode of 10+" << recoveryCount << " failed" << std::endl;
+            return false;
+        }
+    }
+
+    // Unknown matrix types are rejected
+    CM256::cm256_encoder_params params = {};
+    CM256::cm256_block block;
+    uint8_t data[64];
+    params.OriginalCount = 1;
+    params.RecoveryCount = 1;
+    params.BlockBytes = sizeof(data);
+    params.Matrix = (CM256::MatrixType) 7;
+    block.Block = data;
+    block.Index = 0;
+
+    if (cm256.cm256_encode(params, &block, data) != -1 || cm256.cm256_decode(params, &block) != -1)
+    {
+        std::cerr << "testMatrixOptimized: accepted an unknown matrix type" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// Checks the decodes of 1 to 4 erasures, which do not use the LDU
+// decomposition, with and without the first recovery block, in place and into
+// outputs, with both matrices and with byte ranges split across threads
+bool testSmallErasures()
+{
+    CM256 cm256;
+
+    if (!cm256.isInitialized())
+    {
+        std::cerr << "cm256 not initialized" << std::endl;
+        return false;
+    }
+
+    static const int configs[][3] = {
+        { 2, 2, 64 }, { 3, 6, 100 }, { 10, 5, 3000 }, { 128, 26, 1296 }, { 32, 8, 70000 }
+    };
+
+    cm256.setThreadCount(2);
+
+    for (unsigned int c = 0; c < sizeof(configs) / sizeof(configs[0]); c++)
+    {
+        for (int matrix = 0; matrix < 2; matrix++)
+        {
+            CM256::cm256_encoder_params params = {};
+            params.OriginalCount = configs[c][0];
+            params.RecoveryCount = configs[c][1];
+            params.BlockBytes = configs[c][2];
+            params.Matrix = matrix ? CM256::MatrixOptimized : CM256::MatrixDefault;
+
+            const int blockCount = params.OriginalCount + params.RecoveryCount;
+            const int recoveryBytes = params.RecoveryCount * params.BlockBytes;
+            uint8_t *encodedData = new uint8_t[blockCount * params.BlockBytes];
+            uint8_t *receivedData = new uint8_t[blockCount * params.BlockBytes];
+            uint8_t *outputData = new uint8_t[params.OriginalCount * params.BlockBytes];
+            CM256::cm256_block blocks[256];
+            void* outputs[256];
+            bool ok = true;
+
+            for (int i = 0; i < params.OriginalCount; i++)
+            {
+                for (int j = 0; j < params.BlockBytes; j++) {
+                    encodedData[i * params.BlockBytes + j] = (uint8_t) (i * 5 + j * 3 + matrix);
+                }
+
+                blocks[i].Block = encodedData + i * params.BlockBytes;
+            }
+
+            ok = cm256.cm256_encode(params, blocks, encodedData + params.OriginalCount * params.BlockBytes) == 0;
+
+            // 5 erasures for the boundary with the LDU decomposition
+            for (int lost = 1; lost <= 5 && lost <= params.OriginalCount && ok; lost++)
+            {
+                for (int parity = 0; parity < 2 && ok; parity++)
+                {
+                    // Without the first recovery block there are fewer rows to pick from
+                    if (!parity && lost >= params.RecoveryCount) {
+                        continue;
+                    }
+                    if (lost > params.RecoveryCount) {
+                        continue;
+                    }
+
+                    for (int mode = 0; mode < 3 && ok; mode++) // 0: in place, 1: outputs, 2: preserving
+                    {
+                        uint8_t erased[256] = { 0 };
+                        uint8_t recoveryUsed[256] = { 0 };
+
+                        memcpy(receivedData, encodedData, blockCount * params.BlockBytes);
+                        memset(outputData, 0xA5, params.OriginalCount * params.BlockBytes);
+
+                        for (int k = 0; k < lost; k++)
+                        {
+                            int original, recovery;
+
+                            do {
+                                original = rand() % params.OriginalCount;
+                            } while (erased[original]);
+
+                            if (parity && k == 0)
+                            {
+                                recovery = 0;
+                            }
+                            else
+                            {
+                                do {
+                                    recovery = 1 + rand() % (params.RecoveryCount - 1);
+                                } while (recoveryUsed[recovery]);
+                            }
+
+                            erased[original] = 1;
+                            recoveryUsed[recovery] = 1;
+                            blocks[original].Block = receivedData + (params.OriginalCount + recovery) * params.BlockBytes;
+                            blocks[original].Index = (unsigned char) (params.OriginalCount + recovery);
+                        }
+
+                        for (int i = 0; i < params.OriginalCount; i++)
+                        {
+                            if (!erased[i])
+                            {
+                                blocks[i].Block = receivedData + i * params.BlockBytes;
+                                blocks[i].Index = (unsigned char) i;
+                            }
+
+                            outputs[i] = erased[i] ? outputData + i * params.BlockBytes : nullptr;
+                        }
+
+                        if (mode == 0)
+                        {
+                            uint8_t seen[256] = { 0 };
+                            ok = cm256.cm256_decode(params, blocks) == 0;
+
+                            for (int i = 0; i < params.OriginalCount && ok; i++)
+                            {
+                                const int index = blocks[i].Index;
+                                ok = index < params.OriginalCount && !seen[index]
+                                        && memcmp(blocks[i].Block, encodedData + index * params.BlockBytes, params.BlockBytes) == 0;
+                                seen[index] = 1;
+                            }
+                        }
+                        else
+                        {
+                            ok = cm256.cm256_decode(params, blocks, outputs, mode == 2) == 0;
+
+                            for (int i = 0; i < params.OriginalCount && ok; i++) {
+                                ok = memcmp(erased[i] ? outputData + i * params.BlockBytes : blocks[i].Block,
+                                        encodedData + i * params.BlockBytes, params.BlockBytes) == 0;
+                            }
+
+                            if (ok && mode == 2) {
+                                ok = memcmp(receivedData + params.OriginalCount * params.BlockBytes,
+                                        encodedData + params.OriginalCount * params.BlockBytes, recoveryBytes) == 0;
+                            }
+                        }
+
+                        if (!ok)
+                        {
+                            std::cerr << "testSmallErasures: " << params.OriginalCount << "+" << params.RecoveryCount
+                                    << " x " << params.BlockBytes << " matrix " << matrix << " lost " << lost
+                                    << " parity " << parity << " mode " << mode << " failed" << std::endl;
+                        }
+                    }
+                }
+            }
+
+            delete[] encodedData;
+            delete[] receivedData;
+            delete[] outputData;
+
+            if (!ok) {
+                return false;
+            }
+        }
+    }
+
+
+    // A recovery block given twice, with all the originals lost, leaves the
+    // erasures without a solution: the decode fails and caches nothing
+    CM256::cm256_encoder_params params = {};
+    CM256::cm256_block blocks[3];
+    uint8_t data[3 * 64] = { 0 };
+    static const unsigned char repeatedIndices[] = { 3, 4, 4 };
+    unsigned long long hits, misses;
+    params.OriginalCount = 3;
+    params.RecoveryCount = 6;
+    params.BlockBytes = 64;
+    cm256.setDecoderCacheSize(4);
+
+    for (int i = 0; i < params.OriginalCount; i++)
+    {
+        blocks[i].Block = data + i * params.BlockBytes;
+        blocks[i].Index = repeatedIndices[i];
+    }
+
+    if (cm256.cm256_decode(params, blocks) != -5 || (cm256.getDecoderCacheStats(hits, misses), hits + misses != 0))
+    {
+        std::cerr << "testSmallErasures: accepted a repeated recovery block" << std::endl;
+        return false;
+    }
+
+    // Distinct rows can be singular too: a recovery index past the code keeps
+    // its index as parameter, which may be the parameter of a row of the
+    // optimized matrix, only scaled differently
+    CM256::CM256Matrix optimized;
+    int singularCount = 0;
+    params.Matrix = CM256::MatrixOptimized;
+    optimized.Initialize(params);
+
+    for (int r = params.OriginalCount; r < params.OriginalCount + params.RecoveryCount; r++)
+    {
+        const int twin = optimized.Parameter[r];
+
+        if (twin < params.OriginalCount + params.RecoveryCount) {
+            continue;
+        }
+
+        blocks[0].Index = (unsigned char) r;
+        blocks[1].Index = (unsigned char) (r == params.OriginalCount ? r + 1 : params.OriginalCount);
+        blocks[2].Index = (unsigned char) twin;
+        singularCount++;
+
+        // Twice, the first failure must not have cached the matrix
+        if (cm256.cm256_decode(params, blocks) != -5 || cm256.cm256_decode(params, blocks) != -5
+                || (cm256.getDecoderCacheStats(hits, misses), hits != 0))
+        {
+            std::cerr << "testSmallErasures: accepted singular recovery rows" << std::endl;
+            return false;
+        }
+    }
+
+    return singularCount > 0;
+}
+
+bool testGf65536()
+{
+    gf65536_ctx gf65536Ctx;
+
+    if (!gf65536Ctx.isInitialized())
+    {
+        std::cerr << "gf65536 not initialized" << std::endl;
+        return false;
+    }
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        const uint16_t a = (uint16_t) (rand() % 65535 + 1);
+        const uint16_t b = (uint16_t) rand();
+        const uint16_t c = (uint16_t) rand();
+
+        if (gf65536Ctx.gf65536_mul(a, gf65536Ctx.gf65536_inv(a)) != 1
+            || gf65536Ctx.gf65536_div(gf65536Ctx.gf65536_mul(b, a), a) != b
+            || gf65536Ctx.gf65536_mul(a, b ^ c) != (gf65536Ctx.gf65536_mul(a, b) ^ gf65536Ctx.gf65536_mul(a, c)))
+        {
+            std::cerr << "testGf65536: field check failed for " << a << " " << b << " " << c << std::endl;
+            return false;
+        }
+    }
+
+    static const int lengths[] = { 0, 2, 30, 32, 34, 62, 64, 66, 96, 126, 1000, 4098 };
+    static const int counts[] = { 1, 3, 33, 70 };
+    static const int maxBytes = 4098;
+    static const int maxCount = 70;
+    const gf256_ctx::SimdLevel initialLevel = gf256_ctx::gf256_simd_level();
+    const gf256_ctx::SimdLevel supported = gf256_ctx::gf256_simd_supported();
+    uint8_t *x = new uint8_t[maxCount * maxBytes];
+    uint8_t *z = new uint8_t[maxCount * maxBytes];
+    uint8_t *expected = new uint8_t[maxCount * maxBytes];
+    const void *sources[maxCount];
+    void *destinations[maxCount];
+    uint16_t y[maxCount];
+    bool ok = true;
+
+    for (int level = gf256_ctx::SimdBaseline; level <= supported && ok; ++level)
+    {
+        if (gf256_ctx::gf256_set_simd_level((gf256_ctx::SimdLevel) level) != level) {
+            continue; // tier not available on this CPU
+        }
+
+        std::cerr << "testGf65536: " << gf256_ctx::gf256_simd_name((gf256_ctx::SimdLevel) level)
+                << (gf256_ctx::gf256_simd_uses_avx2() ? " (avx2)" : "") << std::endl;
+
+        for (unsigned int l = 0; l < sizeof(lengths) / sizeof(lengths[0]) && ok; ++l)
+        {
+            for (unsigned int c = 0; c < sizeof(counts) / sizeof(counts[0]) && ok; ++c)
+            {
+                const int bytes = lengths[l];
+                const int count = counts[c];
+
+                for (int i = 0; i < count * maxBytes; ++i)
+                {
+                    x[i] = rand();
+                    z[i] = rand();
+                }
+
+                for (int k = 0; k < count; ++k)
+                {
+                    y[k] = (uint16_t) (k == 0 ? 1 : k == 1 ? 0 : rand());
+                    sources[k] = x + k * maxBytes;
+                    destinations[k] = z + k * maxBytes;
+                }
+
+                // z_0 = sum of x_k * y_k, then z_0 += the same sum
+                for (int i = 0; i < bytes; i += 2)
+                {
+                    uint16_t sum = 0;
+
+                    for (int k = 0; k < count; ++k) {
+                        sum ^= gf65536Ctx.gf65536_mul((uint16_t) (x[k * maxBytes + i] | (x[k * maxBytes + i + 1] << 8)), y[k]);
+                    }
+
+                    expected[i] = (uint8_t) sum;
+                    expected[i + 1] = (uint8_t) (sum >> 8);
+                }
+
+                gf65536Ctx.gf65536_mul_multi_mem(z, y, sources, count, bytes);
+                ok = memcmp(z, expected, bytes) == 0;
+                gf65536Ctx.gf65536_muladd_multi_mem(z, y, sources, count, bytes);
+
+                for (int i = 0; i < bytes && ok; ++i) {
+                    ok = z[i] == 0;
+                }
+
+                if (!ok)
+                {
+                    std::cerr << "testGf65536: multi-source " << count << " x " << bytes << " failed" << std::endl;
+                    break;
+                }
+
+                // z_k += x_0 * y_k, checked against the single source kernels
+                memcpy(expected, z, count * maxBytes);
+                gf65536Ctx.gf65536_muladd_multi_dest_mem(destinations, y, x, count, bytes);
+
+                for (int k = 0; k < count && ok; ++k)
+                {
+                    uint8_t *e = expected + k * maxBytes;
+                    gf65536Ctx.gf65536_muladd_mem(e, y[k], x, bytes);
+                    ok = memcmp(z + k * maxBytes, e, bytes) == 0;
+
+                    if (ok && y[k] != 0)
+                    {
+                        gf65536Ctx.gf65536_mul_mem(e, x, y[k], bytes);
+                        gf65536Ctx.gf65536_div_mem(e, e, y[k], bytes);
+                        ok = memcmp(e, x, bytes) == 0;
+                    }
+                }
+
+                if (!ok) {
+                    std::cerr << "testGf65536: multi-destination " << count << " x " << bytes << " failed" << std::endl;
+                }
+            }
+        }
+    }
+
+    gf256_ctx::gf256_set_simd_level(initialLevel);
+    delete[] x;
+    delete[] z;
+    delete[] expected;
+
+    return ok;
+}
+
+// Checks that the GF(65536) codec recovers random erasures, including codes
+// of more than 256 blocks and one using the largest block index
+bool testCm65536Codec()
+{
+    CM65536 cm65536;
+
+    if (!cm65536.isInitialized())
+    {
+        std::cerr << "cm65536 not initialized" << std::endl;
+        return false;
+    }
+
+    static const int configs[][3] = {
+        { 1, 2, 100 }, { 2, 1, 1000 }, { 10, 5, 334 }, { 128, 26, 508 }, { 300, 60, 200 },
+        { 1000, 200, 1296 }, { 4000, 100, 64 }, { 32, 8, 20000 }, { 65500, 36, 2 }
+    };
+
+    for (unsigned int c = 0; c < sizeof(configs) / sizeof(configs[0]); c++)
+    {
+        CM65536::cm65536_encoder_params params;
+        params.OriginalCount = configs[c][0];
+        params.RecoveryCount = configs[c][1];
+        params.BlockBytes = configs[c][2];
+
+        const int blockCount = params.OriginalCount + params.RecoveryCount;
+        uint8_t *data = new uint8_t[(size_t) blockCount * params.BlockBytes];
+        CM65536::cm65536_block *blocks = new CM65536::cm65536_block[params.OriginalCount];
+        bool ok = true;
+
+        for (int i = 0; i < params.OriginalCount * params.BlockBytes; i++) {
+            data[i] = rand();
+        }
+
+        for (int i = 0; i < params.OriginalCount; i++)
+        {
+            blocks[i].Block = data + i * params.BlockBytes;
+            blocks[i].Index = CM65536::cm65536_get_original_block_index(params, i);
+        }
+
+        uint8_t *recovery = data + params.OriginalCount * params.BlockBytes;
+        ok = cm65536.cm65536_encode(params, blocks, recovery) == 0;
+
+        // Each recovery block alone agrees with the whole encode
+        uint8_t *single = new uint8_t[params.BlockBytes];
+
+        for (int k = 0; k < params.RecoveryCount && ok && params.OriginalCount < 4000; k++)
+        {
+            cm65536.cm65536_encode_block(params, blocks, CM65536::cm65536_get_recovery_block_index(params, k), single);
+            ok = memcmp(single, recovery + k * params.BlockBytes, params.BlockBytes) == 0;
+        }
+
+        if (!ok) {
+            std::cerr << "testCm65536Codec: encode failed" << std::endl;
+        }
+
+        // Lose as many random originals as there are recovery blocks, using
+        // the last recovery blocks first
+        const int lost = params.RecoveryCount < params.OriginalCount ? params.RecoveryCount : params.OriginalCount;
+        uint8_t *received = new uint8_t[(size_t) params.OriginalCount * params.BlockBytes];
+        memcpy(received, data, (size_t) params.OriginalCount * params.BlockBytes);
+
+        for (int i = 0; i < params.OriginalCount; i++) {
+            blocks[i].Block = received + i * params.BlockBytes;
+        }
+
+        for (int k = 0; k < lost && ok; k++)
+        {
+            int i;
+
+            do {
+                i = rand() % params.OriginalCount;
+            } while (blocks[i].Index >= params.OriginalCount);
+
+            const int r = params.RecoveryCount - 1 - k;
+            memcpy(blocks[i].Block, recovery + r * params.BlockBytes, params.BlockBytes);
+            blocks[i].Index = CM65536::cm65536_get_recovery_block_index(params, r);
+        }
+
+        ok = ok && cm65536.cm65536_decode(params, blocks) == 0;
+
+        for (int i = 0; i < params.OriginalCount && ok; i++)
+        {
+            ok = blocks[i].Index < params.OriginalCount
+                    && memcmp(blocks[i].Block, data + blocks[i].Index * params.BlockBytes, params.BlockBytes) == 0;
+        }
+
+        if (!ok) {
+            std::cerr << "testCm65536Codec: decode failed" << std::endl;
+        }
+
+        delete[] data;
+        delete[] blocks;
+        delete[] single;
+        delete[] received;
+
+        if (!ok)
+        {
+            std::cerr << "testCm65536Codec: " << params.OriginalCount << "+" << params.RecoveryCount
+                    << " x " << params.BlockBytes << " failed" << std::endl;
+            return false;
+        }
+    }
+
+    // Repeated recovery rows are rejected instead of decoded
+    {
+        CM65536::cm65536_encoder_params params;
+        params.OriginalCount = 10;
+        params.RecoveryCount = 5;
+        params.BlockBytes = 16;
+
+        uint8_t data[10 * 16], recovery[5 * 16];
+        CM65536::cm65536_block blocks[10];
+
+        for (int i = 0; i < (int) sizeof(data); i++) {
+            data[i] = rand();
+        }
+
+        for (int i = 0; i < params.OriginalCount; i++)
+        {
+            blocks[i].Block = data + i * params.BlockBytes;
+            blocks[i].Index = CM65536::cm65536_get_original_block_index(params, i);
+        }
+
+        if (cm65536.cm65536_encode(params, blocks, recovery) != 0)
+        {
+            std::cerr << "testCm65536Codec: encode for repeated rows failed" << std::endl;
+            return false;
+        }
+
+        for (int i = 0; i < 2; i++)
+        {
+            memcpy(blocks[i].Block, recovery + params.BlockBytes, params.BlockBytes);
+            blocks[i].Index = CM65536::cm65536_get_recovery_block_index(params, 1);
+        }
+
+        if (cm65536.cm65536_decode(params, blocks) != -5)
+        {
+            std::cerr << "testCm65536Codec: accepted a repeated recovery row" << std::endl;
+            return false;
+        }
+    }
+
+    // Invalid parameters
+    CM65536::cm65536_encoder_params params;
+    CM65536::cm65536_block block;
+    uint8_t buffer[8];
+    block.Block = buffer;
+    block.Index = 0;
+    params.OriginalCount = 1;
+    params.RecoveryCount = 1;
+    params.BlockBytes = 7;
+
+    if (cm65536.cm65536_encode(params, &block, buffer) != -1)
+    {
+        std::cerr << "testCm65536Codec: accepted an odd block size" << std::endl;
+        return false;
+    }
+
+    params.OriginalCount = 65000;
+    params.RecoveryCount = 537;
+    params.BlockBytes = 8;
+
+    if (cm65536.cm65536_encode(params, &block, buffer) != -2)
+    {
+        std::cerr << "testCm65536Codec: accepted more than 65536 blocks" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// Checks the additive FFT engine with random sets of received blocks
+bool testCm65536FFT()
+{
+    CM65536 cm65536;
+
+    if (!cm65536.isInitialized())
+    {
+        std::cerr << "cm65536 not initialized" << std::endl;
+        return false;
+    }
+
+    cm65536.setEngine(CM65536::EngineFFT);
+
+    static const int configs[][3] = {
+        { 1, 2, 100 }, { 2, 1, 1000 }, { 5, 3, 16 }, { 10, 5, 334 }, { 128, 26, 508 }, { 17, 64, 40 },
+        { 1000, 200, 1296 }, { 4000, 100, 64 }, { 32, 8, 20000 }, { 65472, 36, 2 }, { 32768, 32768, 2 }
+    };
+
+    for (unsigned int c = 0; c < sizeof(configs) / sizeof(configs[0]); c++)
+    {
+        CM65536::cm65536_encoder_params params;
+        params.OriginalCount = configs[c][0];
+        params.RecoveryCount = configs[c][1];
+        params.BlockBytes = configs[c][2];
+
+        const int blockCount = params.OriginalCount + params.RecoveryCount;
+        uint8_t *data = new uint8_t[(size_t) blockCount * params.BlockBytes];
+        uint8_t *received = new uint8_t[(size_t) params.OriginalCount * params.BlockBytes];
+        CM65536::cm65536_block *blocks = new CM65536::cm65536_block[params.OriginalCount];
+        int *indices = new int[blockCount];
+        bool ok = true;
+
+        for (size_t i = 0; i < (size_t) params.OriginalCount * params.BlockBytes; i++) {
+            data[i] = rand();
+        }
+
+        for (int i = 0; i < params.OriginalCount; i++)
+        {
+            blocks[i].Block = data + (size_t) i * params.BlockBytes;
+            blocks[i].Index = CM65536::cm65536_get_original_block_index(params, i);
+        }
+
+        uint8_t *recovery = data + (size_t) params.OriginalCount * params.BlockBytes;
+        ok = cm65536.cm65536_encode(params, blocks, recovery) == 0;
+
+        if (!ok) {
+            std::cerr << "testCm65536FFT: encode failed" << std::endl;
+        }
+
+        // Receive a random set of OriginalCount blocks out of all, in random order
+        for (int i = 0; i < blockCount; i++) {
+            indices[i] = i;
+        }
+
+        for (int i = 0; i < params.OriginalCount; i++) {
+            std::swap(indices[i], indices[i + rand() % (blockCount - i)]);
+        }
+
+        for (int i = 0; i < params.OriginalCount; i++)
+        {
+            blocks[i].Block = received + (size_t) i * params.BlockBytes;
+            blocks[i].Index = (uint16_t) indices[i];
+            memcpy(blocks[i].Block, data + (size_t) indices[i] * params.BlockBytes, params.BlockBytes);
+        }
+
+        ok = ok && cm65536.cm65536_decode(params, blocks) == 0;
+
+        for (int i = 0; i < params.OriginalCount && ok; i++)
+        {
+            ok = blocks[i].Index < params.OriginalCount
+                    && memcmp(blocks[i].Block, data + (size_t) blocks[i].Index * params.BlockBytes, params.BlockBytes) == 0;
+        }
+
+        if (!ok) {
+            std::cerr << "testCm65536FFT: decode failed" << std::endl;
+        }
+
+        delete[] data;
+        delete[] received;
+        delete[] blocks;
+        delete[] indices;
+
+        if (!ok)
+        {
+            std::cerr << "testCm65536FFT: " << params.OriginalCount << "+" << params.RecoveryCount
+                    << " x " << params.BlockBytes << " failed" << std::endl;
+            return false;
+        }
+    }
+
+    // The recovery count is rounded up to a power of 2 within the field
+    CM65536::cm65536_encoder_params params;
+    CM65536::cm65536_block block;
+    uint8_t buffer[8];
+    block.Block = buffer;
+    block.Index = 0;
+    params.OriginalCount = 65300;
+    params.RecoveryCount = 236;
+    params.BlockBytes = 8;
+
+    if (cm65536.cm65536_encode(params, &block, buffer) != -2)
+    {
+        std::cerr << "testCm65536FFT: accepted a code larger than the field" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// Checks the tiled decoder with several tile sizes and erasure counts
+bool testTiledDecode()
+{
+    CM256 cm256;
+
+    if (!cm256.isInitialized())
+    {
+        std::cerr << "cm256 not initialized" << std::endl;
+        return false;
+    }
+
+    static const int configs[][3] = {
+        { 128, 26, 508 }, { 32, 8, 65536 + 13 }, { 2, 3, 5000 }, { 100, 30, 9000 }
+    };
+    static const int tileSizes[] = { 0, 1, 64, 1000, 4096, 1 << 30, 0x7fffffff };
+
+    for (unsigned int c = 0; c < sizeof(configs) / sizeof(configs[0]); c++)
+    {
+        CM256::cm256_encoder_params params = {};
+        params.OriginalCount = configs[c][0];
+        params.RecoveryCount = configs[c][1];
+        params.BlockBytes = configs[c][2];
+
+        const int originalBytes = params.OriginalCount * params.BlockBytes;
+        uint8_t *originalData = new uint8_t[originalBytes];
+        uint8_t *recoveryData = new uint8_t[params.RecoveryCount * params.BlockBytes];
+        uint8_t *decodeData = new uint8_t[originalBytes];
+        CM256::cm256_block blocks[256];
+        bool ok = true;
+
+        for (int i = 0; i < params.OriginalCount; i++)
+        {
+            for (int j = 0; j < params.BlockBytes; j++) {
+                originalData[i * params.BlockBytes + j] = (uint8_t) (i + j * 13);
+            }
+
+            blocks[i].Block = originalData + i * params.BlockBytes;
+        }
+
+        ok = cm256.cm256_encode(params, blocks, recoveryData) == 0;
+
+        for (unsigned int t = 0; t < sizeof(tileSizes) / sizeof(tileSizes[0]) && ok; t++)
+        {
+            // Lose from 2 to RecoveryCount originals, spread over the frame
+            for (int lost = 2; lost <= params.RecoveryCount && lost <= params.OriginalCount && ok; lost += 3)
+            {
+                memcpy(decodeData, originalData, originalBytes);
+
+                for (int i = 0; i < params.OriginalCount; i++)
+                {
+                    blocks[i].Block = decodeData + i * params.BlockBytes;
+                    blocks[i].Index = CM256::cm256_get_original_block_index(params, i);
+                }
+
+                for (int k = 0; k < lost; k++)
+                {
+                    const int i = (k * params.OriginalCount) / lost;
+                    const int r = params.RecoveryCount - 1 - k;
+                    memcpy(blocks[i].Block, recoveryData + r * params.BlockBytes, params.BlockBytes);
+                    blocks[i].Index = CM256::cm256_get_recovery_block_index(params, r);
+                }
+
+                cm256.setTileBytes(tileSizes[t]);
+                ok = cm256.cm256_decode(params, blocks) == 0
+                        && validateSolution(blocks, params.OriginalCount, params.BlockBytes);
+
+                if (!ok)
+                {
+                    std::cerr << "testTiledDecode: " << params.OriginalCount << "+" << params.RecoveryCount
+                            << " x " << params.BlockBytes << " with " << lost << " lost failed with "
+                            << tileSizes[t] << " bytes tiles" << std::endl;
+                }
+            }
+        }
+
+        delete[] originalData;
+        delete[] recoveryData;
+        delete[] decodeData;
+
+        if (!ok) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool ExampleFileUsage()
 {
     CM256 cm256;
@@ -96,7 +2757,7 @@ bool ExampleFileUsage()
         return false;
     }
 
-    CM256::cm256_encoder_params params;
+    CM256::cm256_encoder_params params = {};
 
     // Number of bytes per file block
     params.BlockBytes = 1296;
@@ -202,7 +2863,7 @@ bool example2()
         return false;
     }
 
-    CM256::cm256_encoder_params params;
+    CM256::cm256_encoder_params params = {};
 
     // Number of bytes per file block
     params.BlockBytes = sizeof(ProtectedBlock);
@@ -214,8 +2875,6 @@ bool example2()
     params.RecoveryCount = 32;
 
     SuperBlock* txBuffer = new SuperBlock[params.OriginalCount+params.RecoveryCount];
-    ProtectedBlock* txRecovery = new ProtectedBlock[params.RecoveryCount];
-    CM256::cm256_block *txDescriptorBlocks = new CM256::cm256_block[params.OriginalCount+params.RecoveryCount];
     int frameCount = 0;
 
     // Fill original data
@@ -232,27 +2891,23 @@ bool example2()
             {
                 txBuffer[i].protectedBlock.data[j] = i;
             }
-
-            txDescriptorBlocks[i].Block = (void *) &txBuffer[i].protectedBlock;
-            txDescriptorBlocks[i].Index = txBuffer[i].blockIndex;
         }
         else
         {
             memset((void *) &txBuffer[i].protectedBlock, 0, sizeof(ProtectedBlock));
-            txDescriptorBlocks[i].Block = (void *) &txBuffer[i].protectedBlock;
-            txDescriptorBlocks[i].Index = i;
         }
     }
 
-    // Generate recovery data
+    // Generate recovery data straight into the payload of the blocks sent after the originals
 
     long long ts = getUSecs();
 
-    if (cm256.cm256_encode(params, txDescriptorBlocks, txRecovery))
+    if (cm256.cm256_encode(params,
+            &txBuffer[0].protectedBlock, sizeof(SuperBlock),
+            &txBuffer[params.OriginalCount].protectedBlock, sizeof(SuperBlock)))
     {
         std::cerr << "example2: encode failed" << std::endl;
         delete[] txBuffer;
-        delete[] txRecovery;
         return false;
     }
 
@@ -260,14 +2915,8 @@ bool example2()
 
     std::cerr << "Encoded in " << usecs << " microseconds" << std::endl;
 
-    // insert recovery data in sent data
-    for (int i = 0; i < params.RecoveryCount; i++)
-    {
-        txBuffer[params.OriginalCount+i].protectedBlock = txRecovery[i];
-    }
-
     SuperBlock* rxBuffer = new SuperBlock[params.OriginalCount];
-    CM256::cm256_block rxDescriptorBlocks[params.OriginalCount];
+    unsigned char rxIndices[params.OriginalCount];
     int k = 0;
 
     for (int i = 0; i < params.OriginalCount+params.RecoveryCount; i++)
@@ -277,8 +2926,7 @@ bool example2()
             if (i % 5 != 4)
             {
                 rxBuffer[k] = txBuffer[i];
-                rxDescriptorBlocks[k].Block = (void *) &rxBuffer[k].protectedBlock;
-                rxDescriptorBlocks[k].Index = rxBuffer[k].blockIndex;
+                rxIndices[k] = rxBuffer[k].blockIndex;
                 k++;
             }
         }
@@ -286,10 +2934,9 @@ bool example2()
 
     ts = getUSecs();
 
-    if (cm256.cm256_decode(params, rxDescriptorBlocks))
+    if (cm256.cm256_decode(params, &rxBuffer[0].protectedBlock, sizeof(SuperBlock), rxIndices))
     {
         delete[] txBuffer;
-        delete[] txRecovery;
         delete[] rxBuffer;
 
         return false;
@@ -307,9 +2954,7 @@ bool example2()
 
     std::cerr << "Decoded in " << usecs << " microseconds" << std::endl;
 
-    delete[] txDescriptorBlocks;
     delete[] txBuffer;
-    delete[] txRecovery;
     delete[] rxBuffer;
 
     return true;
@@ -353,7 +2998,7 @@ bool example3()
         return false;
     }
 
-    CM256::cm256_encoder_params params;
+    CM256::cm256_encoder_params params = {};
 
     // Number of bytes per file block
     params.BlockBytes = sizeof(ProtectedBlock);
@@ -365,8 +3010,6 @@ bool example3()
     params.RecoveryCount = 32;
 
     SuperBlock* txBuffer = new SuperBlock[params.OriginalCount+params.RecoveryCount];
-    ProtectedBlock* txRecovery = new ProtectedBlock[params.RecoveryCount];
-    CM256::cm256_block txDescriptorBlocks[params.OriginalCount+params.RecoveryCount];
     int frameCount = 0;
 
     // Fill original data
@@ -383,20 +3026,18 @@ bool example3()
         {
             memset((void *) &txBuffer[i].protectedBlock, 0, sizeof(ProtectedBlock));
         }
-
-        txDescriptorBlocks[i].Block = (void *) &txBuffer[i].protectedBlock;
-        txDescriptorBlocks[i].Index = txBuffer[i].header.blockIndex;
     }
 
-    // Generate recovery data
+    // Generate recovery data straight into the payload of the blocks sent after the originals
 
     long long ts = getUSecs();
 
-    if (cm256.cm256_encode(params, txDescriptorBlocks, txRecovery))
+    if (cm256.cm256_encode(params,
+            &txBuffer[0].protectedBlock, sizeof(SuperBlock),
+            &txBuffer[params.OriginalCount].protectedBlock, sizeof(SuperBlock)))
     {
         std::cerr << "example2: encode failed" << std::endl;
         delete[] txBuffer;
-        delete[] txRecovery;
         return false;
     }
 
@@ -404,12 +3045,6 @@ bool example3()
 
     std::cerr << "Encoded in " << usecs << " microseconds" << std::endl;
 
-    // insert recovery data in sent data
-    for (int i = 0; i < params.RecoveryCount; i++)
-    {
-        txBuffer[params.OriginalCount+i].protectedBlock = txRecovery[i];
-    }
-
     SuperBlock* rxBuffer = new SuperBlock[params.OriginalCount + params.RecoveryCount]; // received blocks
     int k = 0;
 
@@ -459,7 +3094,6 @@ bool example3()
     if (cm256.cm256_decode(params, rxDescriptorBlocks))
     {
         delete[] txBuffer;
-        delete[] txRecovery;
         delete[] rxBuffer;
         delete[] samplesBuffer;
         delete[] recoveryBuffer;
@@ -485,7 +3119,6 @@ bool example3()
     std::cerr << "Decoded in " << usecs << " microseconds" << std::endl;
 
     delete[] txBuffer;
-    delete[] txRecovery;
     delete[] rxBuffer;
     delete[] samplesBuffer;
     delete[] recoveryBuffer;
@@ -530,7 +3163,7 @@ bool example4()
         return false;
     }
 
-    CM256::cm256_encoder_params params;
+    CM256::cm256_encoder_params params = {};
 
     // Number of bytes per file block
     params.BlockBytes = sizeof(ProtectedBlock);
@@ -542,8 +3175,6 @@ bool example4()
     params.RecoveryCount = 25;
 
     SuperBlock txBuffer[256];
-    ProtectedBlock txRecovery[256];
-    CM256::cm256_block txDescriptorBlocks[256];
     int frameCount = 0;
 
     // Fill original data
@@ -551,8 +3182,6 @@ bool example4()
     {
         txBuffer[i].header.frameIndex = frameCount;
         txBuffer[i].header.blockIndex = i;
-        txDescriptorBlocks[i].Block = (void *) &txBuffer[i].protectedBlock;
-        txDescriptorBlocks[i].Index = txBuffer[i].header.blockIndex;
 
         if (i < params.OriginalCount)
         {
@@ -569,11 +3198,13 @@ bool example4()
 
     }
 
-    // Generate recovery data
+    // Generate recovery data straight into the payload of the blocks sent after the originals
 
     long long ts = getUSecs();
 
-    if (cm256.cm256_encode(params, txDescriptorBlocks, txRecovery))
+    if (cm256.cm256_encode(params,
+            &txBuffer[0].protectedBlock, sizeof(SuperBlock),
+            &txBuffer[params.OriginalCount].protectedBlock, sizeof(SuperBlock)))
     {
         std::cerr << "example2: encode failed" << std::endl;
         return false;
@@ -583,12 +3214,6 @@ bool example4()
 
     std::cerr << "Encoded in " << usecs << " microseconds" << std::endl;
 
-    // insert recovery data in sent data
-    for (int i = 0; i < params.RecoveryCount; i++)
-    {
-        txBuffer[params.OriginalCount+i].protectedBlock = txRecovery[i];
-    }
-
     SuperBlock* rxBuffer = new SuperBlock[256]; // received blocks
     int nbRxBlocks = 0;
 
@@ -751,6 +3376,187 @@ bool example4()
 
 int main()
 {
+    std::cerr << "testKernels:" << std::endl;
+
+    if (!testKernels())
+    {
+        std::cerr << "testKernels failed" << std::endl << std::endl;
+        return 1;
+    }
+
+    std::cerr << "testKernels successful" << std::endl << std::endl;
+    std::cerr << "testTiledEncode:" << std::endl;
+
+    if (!testTiledEncode())
+    {
+        std::cerr << "testTiledEncode failed" << std::endl << std::endl;
+        return 1;
+    }
+
+    std::cerr << "testTiledEncode successful" << std::endl << std::endl;
+    std::cerr << "testEncoderPlan:" << std::endl;
+
+    if (!testEncoderPlan())
+    {
+        std::cerr << "testEncoderPlan failed" << std::endl << std::endl;
+        return 1;
+    }
+
+    std::cerr << "testEncoderPlan successful" << std::endl << std::endl;
+    std::cerr << "testTiledDecode:" << std::endl;
+
+    if (!testTiledDecode())
+    {
+        std::cerr << "testTiledDecode failed" << std::endl << std::endl;
+        return 1;
+    }
+
+    std::cerr << "testTiledDecode successful" << std::endl << std::endl;
+    std::cerr << "testDecoderCache:" << std::endl;
+
+    if (!testDecoderCache())
+    {
+        std::cerr << "testDecoderCache failed" << std::endl << std::endl;
+        return 1;
+    }
+
+    std::cerr << "testDecoderCache successful" << std::endl << std::endl;
+    std::cerr << "testThreadedEncode:" << std::endl;
+
+    if (!testThreadedEncode())
+    {
+        std::cerr << "testThreadedEncode failed" << std::endl << std::endl;
+        return 1;
+    }
+
+    std::cerr << "testThreadedEncode successful" << std::endl << std::endl;
+    std::cerr << "testThreadedDecode:" << std::endl;
+
+    if (!testThreadedDecode())
+    {
+        std::cerr << "testThreadedDecode failed" << std::endl << std::endl;
+        return 1;
+    }
+
+    std::cerr << "testThreadedDecode successful" << std::endl << std::endl;
+    std::cerr << "testStreamEncoder:" << std::endl;
+
+    if (!testStreamEncoder())
+    {
+        std::cerr << "testStreamEncoder failed" << std::endl << std::endl;
+        return 1;
+    }
+
+    std::cerr << "testStreamEncoder successful" << std::endl << std::endl;
+    std::cerr << "testStreamDecoder:" << std::endl;
+
+    if (!testStreamDecoder())
+    {
+        std::cerr << "testStreamDecoder failed" << std::endl << std::endl;
+        return 1;
+    }
+
+    std::cerr << "testStreamDecoder successful" << std::endl << std::endl;
+    std::cerr << "testDecodeOutputs:" << std::endl;
+
+    if (!testDecodeOutputs())
+    {
+        std::cerr << "testDecodeOutputs failed" << std::endl << std::endl;
+        return 1;
+    }
+
+    std::cerr << "testDecodeOutputs successful" << std::endl << std::endl;
+    std::cerr << "testStridedCodec:" << std::endl;
+
+    if (!testStridedCodec())
+    {
+        std::cerr << "testStridedCodec failed" << std::endl << std::endl;
+        return 1;
+    }
+
+    std::cerr << "testStridedCodec successful" << std::endl << std::endl;
+    std::cerr << "testSegmentedEncode:" << std::endl;
+
+    if (!testSegmentedEncode())
+    {
+        std::cerr << "testSegmentedEncode failed" << std::endl << std::endl;
+        return 1;
+    }
+
+    std::cerr << "testSegmentedEncode successful" << std::endl << std::endl;
+    std::cerr << "testVariableBlocks:" << std::endl;
+
+    if (!testVariableBlocks())
+    {
+        std::cerr << "testVariableBlocks failed" << std::endl << std::endl;
+        return 1;
+    }
+
+    std::cerr << "testVariableBlocks successful" << std::endl << std::endl;
+    std::cerr << "testBatch:" << std::endl;
+
+    if (!testBatch())
+    {
+        std::cerr << "testBatch failed" << std::endl << std::endl;
+        return 1;
+    }
+
+    std::cerr << "testBatch successful" << std::endl << std::endl;
+    std::cerr << "testBitMatrix:" << std::endl;
+
+    if (!testBitMatrix())
+    {
+        std::cerr << "testBitMatrix failed" << std::endl << std::endl;
+        return 1;
+    }
+
+    std::cerr << "testBitMatrix successful" << std::endl << std::endl;
+
+    std::cerr << "testMatrixOptimized:" << std::endl;
+
+    if (!testMatrixOptimized())
+    {
+        std::cerr << "testMatrixOptimized failed" << std::endl << std::endl;
+        return 1;
+    }
+
+    std::cerr << "testMatrixOptimized successful" << std::endl << std::endl;
+    std::cerr << "testSmallErasures:" << std::endl;
+
+    if (!testSmallErasures())
+    {
+        std::cerr << "testSmallErasures failed" << std::endl << std::endl;
+        return 1;
+    }
+
+    std::cerr << "testSmallErasures successful" << std::endl << std::endl;
+    std::cerr << "testGf65536:" << std::endl;
+
+    if (!testGf65536())
+    {
+        std::cerr << "testGf65536 failed" << std::endl << std::endl;
+        return 1;
+    }
+
+    std::cerr << "testGf65536 successful" << std::endl << std::endl;
+    std::cerr << "testCm65536Codec:" << std::endl;
+
+    if (!testCm65536Codec())
+    {
+        std::cerr << "testCm65536Codec failed" << std::endl << std::endl;
+        return 1;
+    }
+
+    std::cerr << "testCm65536Codec successful" << std::endl << std::endl;
+    std::cerr << "testCm65536FFT:" << std::endl;
+
+    if (!testCm65536FFT())
+    {
+        std::cerr << "testCm65536FFT failed" << std::endl << std::endl;
+        return 1;
+    }
+
+    std::cerr << "testCm65536FFT successful" << std::endl << std::endl;
     std::cerr << "ExampleFileUsage:" << std::endl;
 
     if (!ExampleFileUsage())
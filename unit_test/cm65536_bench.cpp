@@ -0,0 +1,337 @@
+/*
+    Copyright (c) 2016 Edouard M. Griffiths.  All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+    * Neither the name of CM256 nor the names of its contributors may be
+      used to endorse or promote products derived from this software without
+      specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cstring>
+
+#include "mainutils.h"
+#include "../cm256.h"
+#include "../cm65536.h"
+
+// Number of iterations so that each measurement processes about 'megabytes' MB
+static long long iterationsFor(long long bytes, int megabytes)
+{
+    return 1 + ((long long) megabytes * 1024 * 1024) / bytes;
+}
+
+static double megabytesPerSecond(long long bytes, long long iterations, long long usecs)
+{
+    return usecs > 0 ? (double) bytes * iterations / (double) usecs : 0.0;
+}
+
+// z[] += x[] * y and z[] += sum of 16 x_k[] * y_k in both fields
+static void benchKernels(gf256_ctx& gf256Ctx, gf65536_ctx& gf65536Ctx)
+{
+    static const int blockSizes[] = { 508, 4096, 65536 };
+    static const int sourceCount = 16;
+
+    for (unsigned int s = 0; s < sizeof(blockSizes) / sizeof(blockSizes[0]); s++)
+    {
+        const int bytes = blockSizes[s];
+        uint8_t *x = new uint8_t[sourceCount * bytes];
+        uint8_t *z = new uint8_t[bytes];
+        const void *sources[sourceCount];
+        uint8_t y8[sourceCount];
+        uint16_t y16[sourceCount];
+
+        for (int i = 0; i < sourceCount * bytes; i++) {
+            x[i] = rand();
+        }
+
+        for (int k = 0; k < sourceCount; k++)
+        {
+            sources[k] = x + k * bytes;
+            y8[k] = (uint8_t) (rand() % 255 + 1);
+            y16[k] = (uint16_t) (rand() % 65535 + 1);
+        }
+
+        memset(z, 0, bytes);
+        const long long iterations = iterationsFor(bytes, 256);
+        const long long multiIterations = iterationsFor((long long) bytes * sourceCount, 256);
+
+        long long ts = getUSecs();
+        for (long long i = 0; i < iterations; i++) {
+            gf256Ctx.gf256_muladd_mem(z, y8[i & 15], x, bytes);
+        }
+        const long long usecs256 = getUSecs() - ts;
+
+        ts = getUSecs();
+        for (long long i = 0; i < iterations; i++) {
+            gf65536Ctx.gf65536_muladd_mem(z, y16[i & 15], x, bytes);
+        }
+        const long long usecs65536 = getUSecs() - ts;
+
+        ts = getUSecs();
+        for (long long i = 0; i < multiIterations; i++) {
+            gf256Ctx.gf256_muladd_multi_mem(z, y8, sources, sourceCount, bytes);
+        }
+        const long long multiUsecs256 = getUSecs() - ts;
+
+        ts = getUSecs();
+        for (long long i = 0; i < multiIterations; i++) {
+            gf65536Ctx.gf65536_muladd_multi_mem(z, y16, sources, sourceCount, bytes);
+        }
+        const long long multiUsecs65536 = getUSecs() - ts;
+
+        std::cerr << "  " << std::setw(6) << bytes << " bytes:" << std::fixed << std::setprecision(1)
+                << " muladd gf256: " << megabytesPerSecond(bytes, iterations, usecs256) << " MB/s"
+                << " gf65536: " << megabytesPerSecond(bytes, iterations, usecs65536) << " MB/s"
+                << " muladd_multi x" << sourceCount << " gf256: " << megabytesPerSecond((long long) bytes * sourceCount, multiIterations, multiUsecs256) << " MB/s"
+                << " gf65536: " << megabytesPerSecond((long long) bytes * sourceCount, multiIterations, multiUsecs65536) << " MB/s"
+                << std::endl;
+
+        delete[] x;
+        delete[] z;
+    }
+}
+
+// Encode then decode with CM65536 with the first 'lost' originals lost,
+// adding the times to encodeUsecs and decodeUsecs
+static bool runCm65536(CM65536& cm65536, int originalCount, int recoveryCount, int blockBytes, int lost, long long iterations,
+        long long& encodeUsecs, long long& decodeUsecs)
+{
+    const long long frameBytes = (long long) originalCount * blockBytes;
+    uint8_t *originalData = new uint8_t[frameBytes];
+    uint8_t *recoveryData = new uint8_t[(long long) recoveryCount * blockBytes];
+    uint8_t *decodeData = new uint8_t[frameBytes];
+    CM65536::cm65536_block *blocks = new CM65536::cm65536_block[originalCount];
+    bool ok = true;
+
+    for (long long i = 0; i < frameBytes; i++) {
+        originalData[i] = rand();
+    }
+
+    CM65536::cm65536_encoder_params params;
+    params.OriginalCount = originalCount;
+    params.RecoveryCount = recoveryCount;
+    params.BlockBytes = blockBytes;
+
+    for (long long i = 0; i < iterations && ok; i++)
+    {
+        for (int j = 0; j < originalCount; j++)
+        {
+            blocks[j].Block = originalData + j * blockBytes;
+            blocks[j].Index = (uint16_t) j;
+        }
+
+        long long ts = getUSecs();
+        ok = cm65536.cm65536_encode(params, blocks, recoveryData) == 0;
+        encodeUsecs += getUSecs() - ts;
+
+        memcpy(decodeData, originalData, frameBytes);
+
+        for (int j = 0; j < originalCount; j++)
+        {
+            blocks[j].Block = decodeData + (long long) j * blockBytes;
+            blocks[j].Index = (uint16_t) (j < lost ? originalCount + j : j);
+
+            if (j < lost) {
+                memcpy(blocks[j].Block, recoveryData + (long long) j * blockBytes, blockBytes);
+            }
+        }
+
+        ts = getUSecs();
+        ok = ok && cm65536.cm65536_decode(params, blocks) == 0;
+        decodeUsecs += getUSecs() - ts;
+    }
+
+    for (int j = 0; j < originalCount && ok; j++) {
+        ok = memcmp(blocks[j].Block, originalData + (long long) blocks[j].Index * blockBytes, blockBytes) == 0;
+    }
+
+    delete[] originalData;
+    delete[] recoveryData;
+    delete[] decodeData;
+    delete[] blocks;
+
+    return ok;
+}
+
+// Encode then decode with the first 'recoveryCount' originals lost, in MB/s of
+// original data.  CM256 is run too when the code fits in GF(256).
+static bool benchCodec(CM256& cm256, CM65536& cm65536, int originalCount, int recoveryCount, int blockBytes)
+{
+    const long long frameBytes = (long long) originalCount * blockBytes;
+    const int lost = recoveryCount < originalCount ? recoveryCount : originalCount;
+    const long long iterations = iterationsFor(frameBytes * recoveryCount, 64);
+    uint8_t *originalData = new uint8_t[frameBytes];
+    uint8_t *recoveryData = new uint8_t[(long long) recoveryCount * blockBytes];
+    uint8_t *decodeData = new uint8_t[frameBytes];
+    bool ok = true;
+
+    for (long long i = 0; i < frameBytes; i++) {
+        originalData[i] = rand();
+    }
+
+    std::cerr << "  " << originalCount << "+" << recoveryCount << " x " << blockBytes << " bytes:" << std::fixed << std::setprecision(1);
+
+    if (originalCount + recoveryCount <= 256)
+    {
+        CM256::cm256_encoder_params params = {};
+        params.OriginalCount = originalCount;
+        params.RecoveryCount = recoveryCount;
+        params.BlockBytes = blockBytes;
+        CM256::cm256_block blocks256[256];
+        long long encodeUsecs = 0, decodeUsecs = 0;
+
+        for (long long i = 0; i < iterations && ok; i++)
+        {
+            for (int j = 0; j < originalCount; j++)
+            {
+                blocks256[j].Block = originalData + j * blockBytes;
+                blocks256[j].Index = (unsigned char) j;
+            }
+
+            long long ts = getUSecs();
+            ok = cm256.cm256_encode(params, blocks256, recoveryData) == 0;
+            encodeUsecs += getUSecs() - ts;
+
+            memcpy(decodeData, originalData, frameBytes);
+
+            for (int j = 0; j < originalCount; j++)
+            {
+                blocks256[j].Block = decodeData + j * blockBytes;
+                blocks256[j].Index = (unsigned char) (j < lost ? originalCount + j : j);
+
+                if (j < lost) {
+                    memcpy(blocks256[j].Block, recoveryData + j * blockBytes, blockBytes);
+                }
+            }
+
+            ts = getUSecs();
+            ok = ok && cm256.cm256_decode(params, blocks256) == 0;
+            decodeUsecs += getUSecs() - ts;
+        }
+
+        for (int j = 0; j < originalCount && ok; j++) {
+            ok = memcmp(blocks256[j].Block, originalData + blocks256[j].Index * blockBytes, blockBytes) == 0;
+        }
+
+        std::cerr << " cm256 encode: " << megabytesPerSecond(frameBytes, iterations, encodeUsecs) << " MB/s"
+                << " decode: " << megabytesPerSecond(frameBytes, iterations, decodeUsecs) << " MB/s";
+    }
+
+    long long encodeUsecs = 0, decodeUsecs = 0;
+    ok = ok && runCm65536(cm65536, originalCount, recoveryCount, blockBytes, lost, iterations, encodeUsecs, decodeUsecs);
+
+    std::cerr << " cm65536 encode: " << megabytesPerSecond(frameBytes, iterations, encodeUsecs) << " MB/s"
+            << " decode (" << lost << " lost): " << megabytesPerSecond(frameBytes, iterations, decodeUsecs) << " MB/s"
+            << (ok ? "" : " FAILED") << std::endl;
+
+    delete[] originalData;
+    delete[] recoveryData;
+    delete[] decodeData;
+
+    return ok;
+}
+
+// Same with the Cauchy and the FFT engines of CM65536, the FFT one losing
+// recovery blocks past the erasures as the Cauchy one
+static bool benchEngines(CM65536& cauchy, CM65536& fft, int originalCount, int recoveryCount, int blockBytes)
+{
+    const long long frameBytes = (long long) originalCount * blockBytes;
+    const int lost = recoveryCount < originalCount ? recoveryCount : originalCount;
+    const long long iterations = iterationsFor(frameBytes * recoveryCount, 64);
+    long long cauchyEncodeUsecs = 0, cauchyDecodeUsecs = 0, fftEncodeUsecs = 0, fftDecodeUsecs = 0;
+    bool ok = runCm65536(cauchy, originalCount, recoveryCount, blockBytes, lost, iterations, cauchyEncodeUsecs, cauchyDecodeUsecs);
+    ok = ok && runCm65536(fft, originalCount, recoveryCount, blockBytes, lost, iterations, fftEncodeUsecs, fftDecodeUsecs);
+
+    std::cerr << "  " << originalCount << "+" << recoveryCount << " x " << blockBytes << " bytes:" << std::fixed << std::setprecision(1)
+            << " encode Cauchy: " << megabytesPerSecond(frameBytes, iterations, cauchyEncodeUsecs) << " MB/s"
+            << " FFT: " << megabytesPerSecond(frameBytes, iterations, fftEncodeUsecs) << " MB/s"
+            << " decode (" << lost << " lost) Cauchy: " << megabytesPerSecond(frameBytes, iterations, cauchyDecodeUsecs) << " MB/s"
+            << " FFT: " << megabytesPerSecond(frameBytes, iterations, fftDecodeUsecs) << " MB/s"
+            << (ok ? "" : " FAILED") << std::endl;
+
+    return ok;
+}
+
+int main()
+{
+    CM256 cm256;
+    CM65536 cm65536;
+
+    if (!cm256.isInitialized() || !cm65536.isInitialized())
+    {
+        std::cerr << "codecs not initialized" << std::endl;
+        return 1;
+    }
+
+    gf256_ctx gf256Ctx;
+    gf65536_ctx gf65536Ctx;
+    const gf256_ctx::SimdLevel initialLevel = gf256_ctx::gf256_simd_level();
+    bool ok = true;
+
+    // The GF(65536) kernels have a 128-bit and an AVX2 version, compare both
+    // with the GF(256) kernels of the same tier
+    for (int level = gf256_ctx::SimdBaseline; level <= initialLevel; level++)
+    {
+        if (gf256_ctx::gf256_set_simd_level((gf256_ctx::SimdLevel) level) != level) {
+            continue;
+        }
+
+        const char *name = gf256_ctx::gf256_simd_name((gf256_ctx::SimdLevel) level);
+
+        std::cerr << "[" << name << "] kernels:" << std::endl;
+        benchKernels(gf256Ctx, gf65536Ctx);
+
+        std::cerr << "[" << name << "] codecs, sizes both fields support:" << std::endl;
+        ok = benchCodec(cm256, cm65536, 128, 26, 508) && ok;
+        ok = benchCodec(cm256, cm65536, 100, 30, 1296) && ok;
+        ok = benchCodec(cm256, cm65536, 200, 50, 1024) && ok;
+        ok = benchCodec(cm256, cm65536, 32, 8, 65536) && ok;
+    }
+
+    gf256_ctx::gf256_set_simd_level(initialLevel);
+
+    std::cerr << "[" << gf256_ctx::gf256_simd_name(initialLevel) << "] cm65536 beyond 256 blocks:" << std::endl;
+    ok = benchCodec(cm256, cm65536, 1000, 200, 1296) && ok;
+    ok = benchCodec(cm256, cm65536, 4000, 400, 1024) && ok;
+    ok = benchCodec(cm256, cm65536, 20000, 1000, 256) && ok;
+
+    // Crossover of the engines: the Cauchy cost grows with the recovery
+    // count, the FFT one with its logarithm
+    CM65536 cm65536FFT;
+    cm65536FFT.setEngine(CM65536::EngineFFT);
+
+    std::cerr << "[" << gf256_ctx::gf256_simd_name(initialLevel) << "] cm65536 engines:" << std::endl;
+    static const int engineConfigs[][3] = {
+        { 16, 2, 1024 }, { 32, 4, 1024 }, { 128, 8, 1024 }, { 128, 32, 1024 }, { 256, 16, 1024 }, { 256, 64, 1024 },
+        { 1024, 32, 1024 }, { 1024, 128, 1024 }, { 1024, 512, 1024 },
+        { 4096, 64, 256 }, { 4096, 512, 256 }, { 16384, 256, 64 }, { 16384, 2048, 64 }
+    };
+
+    for (unsigned int c = 0; c < sizeof(engineConfigs) / sizeof(engineConfigs[0]); c++) {
+        ok = benchEngines(cm65536, cm65536FFT, engineConfigs[c][0], engineConfigs[c][1], engineConfigs[c][2]) && ok;
+    }
+
+    return ok ? 0 : 1;
+}
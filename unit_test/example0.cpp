@@ -38,7 +38,7 @@ bool example0_rx(const std::string& filename, const std::string& refFilename)
 #pragma pack(push, 1)
     struct FileHeader
     {
-        CM256::cm256_encoder_params m_cm256Params;
+        CM256::cm256_encoder_params m_cm256Params = {};
         int m_txBlocks;
     };
 #pragma pack(pop)
@@ -70,8 +70,9 @@ bool example0_rx(const std::string& filename, const std::string& refFilename)
 
     Sample *samplesBuffer = new Sample[nbSamplesPerBlock * (fileHeader.m_cm256Params.OriginalCount)];
     ProtectedBlock* retrievedDataBuffer = (ProtectedBlock *) samplesBuffer;
-    ProtectedBlock* recoveryBuffer = new ProtectedBlock[fileHeader.m_cm256Params.OriginalCount];
     CM256::cm256_block rxDescriptorBlocks[fileHeader.m_cm256Params.OriginalCount];
+    void* outputs[256];
+    bool received[256] = { false };
     int recoveryCount = 0;
     int nbBlocks = 0;
 
@@ -87,11 +88,11 @@ bool example0_rx(const std::string& filename, const std::string& refFilename)
             {
                 retrievedDataBuffer[blockIndex] = rxBuffer[i].protectedBlock;
                 rxDescriptorBlocks[i].Block = (void *) &retrievedDataBuffer[blockIndex];
+                received[blockIndex] = true;
             }
-            else // it's a recovery block
+            else // it's a recovery block, decoded from where it was received
             {
-                recoveryBuffer[recoveryCount] = rxBuffer[i].protectedBlock;
-                rxDescriptorBlocks[i].Block = (void *) &recoveryBuffer[recoveryCount];
+                rxDescriptorBlocks[i].Block = (void *) &rxBuffer[i].protectedBlock;
                 recoveryCount++;
             }
         }
@@ -102,13 +103,17 @@ bool example0_rx(const std::string& filename, const std::string& refFilename)
         {
             if (recoveryCount > 0)
             {
+                // The missing blocks are decoded straight into their place
+                for (int ib = 0; ib < fileHeader.m_cm256Params.OriginalCount; ib++) {
+                    outputs[ib] = (void *) &retrievedDataBuffer[ib];
+                }
+
                 long long ts = getUSecs();
 
-                if (cm256.cm256_decode(fileHeader.m_cm256Params, rxDescriptorBlocks))
+                if (cm256.cm256_decode(fileHeader.m_cm256Params, rxDescriptorBlocks, outputs))
                 {
                     delete[] rxBuffer;
                     delete[] samplesBuffer;
-                    delete[] recoveryBuffer;
 
                     return false;
                 }
@@ -116,11 +121,13 @@ bool example0_rx(const std::string& filename, const std::string& refFilename)
                 long long usecs = getUSecs() - ts;
                 std::cerr << "recover missing blocks..." << std::endl;
 
-                for (int ir = 0; ir < recoveryCount; ir++) // recover missing blocks
+                for (int blockIndex = 0, ir = 0; blockIndex < fileHeader.m_cm256Params.OriginalCount; blockIndex++) // recovered blocks
                 {
-                    int blockIndex = rxDescriptorBlocks[fileHeader.m_cm256Params.OriginalCount - recoveryCount + ir].Index;
-                    retrievedDataBuffer[blockIndex] = recoveryBuffer[ir];
-                    std::cerr << ir << ":" << blockIndex << ": " << recoveryBuffer[ir].samples[0].i << std::endl;
+                    if (!received[blockIndex])
+                    {
+                        std::cerr << ir << ":" << blockIndex << ": " << retrievedDataBuffer[blockIndex].samples[0].i << std::endl;
+                        ir++;
+                    }
                 }
 
                 std::cerr << "Decoded in " << usecs << " microseconds" << std::endl;
@@ -176,7 +183,6 @@ bool example0_rx(const std::string& filename, const std::string& refFilename)
 
     delete[] refBuffer;
     delete[] samplesBuffer;
-    delete[] recoveryBuffer;
     delete[] rxBuffer;
 
     return true;
@@ -212,14 +218,14 @@ bool example0_tx(const std::string& filename, const std::string& refFilename)
 
     struct FileHeader
     {
-        CM256::cm256_encoder_params m_cm256Params;
+        CM256::cm256_encoder_params m_cm256Params = {};
         int m_txBlocks;
     };
 #pragma pack(pop)
 
     CM256 cm256;
 
-    CM256::cm256_encoder_params params;
+    CM256::cm256_encoder_params params = {};
 
     // Number of bytes per file block
     params.BlockBytes = sizeof(ProtectedBlock);
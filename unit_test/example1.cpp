@@ -33,12 +33,19 @@
 #include "example1.h"
 
 
-Example1Tx::Example1Tx(int samplesPerBlock, int nbOriginalBlocks, int nbFecBlocks)
+Example1Tx::Example1Tx(int samplesPerBlock, int nbOriginalBlocks, int nbFecBlocks) :
+    m_encoder(m_cm256)
 {
     m_params.BlockBytes = samplesPerBlock * sizeof(Sample);
     m_params.OriginalCount = nbOriginalBlocks;
     m_params.RecoveryCount = nbFecBlocks;
+    m_params.Matrix = CM256::MatrixDefault;
     m_cm256_OK = m_cm256.isInitialized();
+
+    // Parameters are the same for every frame
+    if (m_cm256_OK && m_params.RecoveryCount > 0) {
+        m_cm256.cm256_init_encoder_plan(m_params, m_encoderPlan);
+    }
 }
 
 Example1Tx::~Example1Tx()
@@ -49,6 +56,11 @@ void Example1Tx::makeDataBlocks(SuperBlock *txBlocks, uint16_t frameNumber)
 {
     std::srand(frameNumber);
 
+    // Recovery blocks are computed as the data blocks are made, straight
+    // into the payload of the blocks that follow them
+    bool encode = m_cm256_OK && (m_params.RecoveryCount > 0)
+            && (m_encoder.begin_frame(m_encoderPlan, &txBlocks[m_params.OriginalCount].protectedBlock, sizeof(SuperBlock)) == 0);
+
     for (int iblock = 0; iblock < m_params.OriginalCount; iblock++)
     {
         txBlocks[iblock].header.frameIndex = frameNumber;
@@ -73,6 +85,10 @@ void Example1Tx::makeDataBlocks(SuperBlock *txBlocks, uint16_t frameNumber)
 				txBlocks[iblock].protectedBlock.samples[isample].q = std::rand();
 			}
         }
+
+        if (encode) {
+            m_encoder.add_original(iblock, &txBlocks[iblock].protectedBlock);
+        }
     }
 }
 
@@ -80,15 +96,9 @@ bool Example1Tx::makeFecBlocks(SuperBlock *txBlocks, uint16_t frameIndex)
 {
 	if (m_params.RecoveryCount > 0)
 	{
-	    for (int i = 0; i < m_params.OriginalCount; i++)
-	    {
-	        m_txDescriptorBlocks[i].Block = (void *) &txBlocks[i].protectedBlock;
-	        m_txDescriptorBlocks[i].Index = i;
-	    }
-
 	    if (m_cm256_OK)
 	    {
-	        if (m_cm256.cm256_encode(m_params, m_txDescriptorBlocks, m_txRecovery))
+	        if (!m_encoder.is_complete()) // recovery blocks are made with the data blocks
 	        {
 	            std::cerr << "example2: encode failed" << std::endl;
 	            return false;
@@ -98,7 +108,6 @@ bool Example1Tx::makeFecBlocks(SuperBlock *txBlocks, uint16_t frameIndex)
 	        {
 	            txBlocks[i + m_params.OriginalCount].header.blockIndex = i + m_params.OriginalCount;
 	            txBlocks[i + m_params.OriginalCount].header.frameIndex = frameIndex;
-	            txBlocks[i + m_params.OriginalCount].protectedBlock = m_txRecovery[i];
 	        }
 	    }
 	}
@@ -130,6 +139,7 @@ void Example1Tx::transmitBlocks(SuperBlock *txBlocks,
 }
 
 Example1Rx::Example1Rx(int samplesPerBlock, int nbOriginalBlocks, int nbFecBlocks) :
+    m_decoder(m_cm256),
     m_frameHead(0),
     m_frameCount(0),
     m_blockCount(0),
@@ -140,8 +150,14 @@ Example1Rx::Example1Rx(int samplesPerBlock, int nbOriginalBlocks, int nbFecBlock
     m_params.BlockBytes = samplesPerBlock * sizeof(Sample);
     m_params.OriginalCount = nbOriginalBlocks;
     m_params.RecoveryCount = nbFecBlocks;
+    m_params.Matrix = CM256::MatrixDefault;
     m_currentMeta.init();
-    m_cm256_OK = m_cm256.isInitialized();
+    m_cm256_OK = m_cm256.isInitialized() && (m_decoder.begin_frame(m_params) == 0);
+
+    // Recovered blocks are decoded straight into their data slot
+    for (int i = 0; i < 128; i++) {
+        m_outputs[i] = (void *) &m_data[i];
+    }
 }
 
 Example1Rx::~Example1Rx()
@@ -163,6 +179,10 @@ void Example1Rx::processBlock(SuperBlock& superBlock)
         m_dataCount = 0;
         m_recoveryCount = 0;
         m_frameHead = superBlock.header.frameIndex;
+
+        if (m_cm256_OK) {
+            m_decoder.begin_frame(m_params);
+        }
     }
 
     if (m_blockCount < m_params.OriginalCount) // not enough to decode => store data
@@ -216,6 +236,12 @@ void Example1Rx::processBlock(SuperBlock& superBlock)
             m_descriptorBlocks[m_blockCount].Index = blockIndex;
             m_recoveryCount++;
         }
+
+        // The decoding work is done as the blocks arrive
+        if (m_cm256_OK && (m_decoder.add_block(&m_descriptorBlocks[m_blockCount]) < 0))
+        {
+            std::cerr << "Example1Rx::processBlock: CM256 invalid block " << blockIndex << std::endl;
+        }
     }
 
     m_blockCount++;
@@ -224,22 +250,30 @@ void Example1Rx::processBlock(SuperBlock& superBlock)
     {
         if (m_cm256_OK && (m_recoveryCount > 0)) // FEC necessary
         {
-            if (m_cm256.cm256_decode(m_params, m_descriptorBlocks)) // failure to decode
+            if (m_decoder.finish(m_outputs)) // failure to decode
             {
                 std::cerr << "Example1Rx::processBlock: CM256 decode error" << std::endl;
             }
             else // success to decode
             {
-                std::cerr << "Example1Rx::processBlock: CM256 decode success: ";
+                bool received[128] = { false };
 
-                int recoveryStart = m_dataCount;
+                for (int ib = 0; ib < m_blockCount; ib++)
+                {
+                    if (m_descriptorBlocks[ib].Index < m_params.OriginalCount) {
+                        received[m_descriptorBlocks[ib].Index] = true;
+                    }
+                }
+
+                std::cerr << "Example1Rx::processBlock: CM256 decode success: ";
 
-                for (int ir = 0; ir < m_recoveryCount; ir++)
+                for (int blockIndex = 0; blockIndex < m_params.OriginalCount; blockIndex++)
                 {
-                    int blockIndex = m_descriptorBlocks[recoveryStart + ir].Index;
-                    std::cerr << blockIndex << " ";
-                    m_data[blockIndex] = *((ProtectedBlock *) m_descriptorBlocks[recoveryStart + ir].Block);
-                    m_dataCount++;
+                    if (!received[blockIndex]) // recovered data
+                    {
+                        std::cerr << blockIndex << " ";
+                        m_dataCount++;
+                    }
                 }
 
                 std::cerr << std::endl;
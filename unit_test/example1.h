@@ -54,8 +54,8 @@ protected:
     CM256 m_cm256;
     bool m_cm256_OK;
     CM256::cm256_encoder_params m_params;
-    CM256::cm256_block m_txDescriptorBlocks[256];
-    ProtectedBlock m_txRecovery[128];
+    CM256::CM256EncoderPlan m_encoderPlan;
+    CM256::CM256StreamEncoder m_encoder;
     UDPSocket m_socket;
 };
 
@@ -71,6 +71,7 @@ private:
     bool checkData();
 
     CM256 m_cm256;
+    CM256::CM256StreamDecoder m_decoder;
     uint16_t m_frameHead;
     uint64_t m_frameCount;
     int m_blockCount;
@@ -83,6 +84,7 @@ private:
     CM256::cm256_block m_descriptorBlocks[256];
     ProtectedBlock m_data[128];
     ProtectedBlock m_recovery[128];
+    void *m_outputs[128];
 };
 
 bool example1_tx(const std::string& dataaddress, int dataport, std::vector<int> &blockExclusionList, std::atomic_bool& stopFlag);